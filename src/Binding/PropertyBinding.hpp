@@ -18,6 +18,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "../Core/SlabAllocator.hpp"
+
 namespace DeclarativeUI::Binding {
 
 // **Forward declarations**
@@ -55,6 +57,8 @@ enum class UpdateMode {
  */
 class IPropertyBinding {
 public:
+    DECLARATIVE_UI_SLAB_ALLOCATED
+
     /**
      * @brief Virtual destructor.
      */
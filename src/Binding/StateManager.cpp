@@ -10,8 +10,18 @@
 #include <QElapsedTimer>
 #include <algorithm>
 
+#include "../Core/MemoryResource.hpp"
+
 namespace DeclarativeUI::Binding {
 
+StateManager::StateManager()
+    : states_(Core::shared_pool_resource()),
+      dependencies_(Core::shared_pool_resource()),
+      dependents_(Core::shared_pool_resource()),
+      computed_values_(Core::shared_pool_resource()),
+      state_data_(Core::shared_pool_resource()),
+      pending_updates_(Core::shared_pool_resource()) {}
+
 StateManager &StateManager::instance() {
     static StateManager instance;
     return instance;
@@ -523,7 +533,7 @@ void StateManager::loadState(const QString& filename) {
         for (const auto& depValue : depsArray) {
             deps.push_back(depValue.toString());
         }
-        dependencies_[key] = deps;
+        dependencies_[key].assign(deps.begin(), deps.end());
     }
 
     qDebug() << "📂 State loaded from:" << filename;
@@ -16,9 +16,12 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <vector>
 
+#include "../Core/SlabAllocator.hpp"
+
 namespace DeclarativeUI::Binding {
 
 /**
@@ -32,6 +35,8 @@ class ReactivePropertyBase : public QObject {
     Q_OBJECT
 
 public:
+    DECLARATIVE_UI_SLAB_ALLOCATED
+
     /**
      * @brief Constructs a ReactivePropertyBase.
      * @param parent Parent QObject.
@@ -387,7 +392,7 @@ signals:
     void performanceWarning(const QString& key, qint64 time_ms);
 
 private:
-    StateManager() = default;
+    StateManager();
 
     /**
      * @struct StateInfo
@@ -407,22 +412,24 @@ private:
         int update_count = 0;          ///< Number of updates performed.
     };
 
-    std::unordered_map<QString, StateInfo>
+    // Node-based maps churn small allocations on every add/remove; they
+    // draw from the shared size-class pool (Core::shared_pool_resource()).
+    std::pmr::unordered_map<QString, StateInfo>
         states_;  ///< Map of state keys to StateInfo.
-    std::unordered_map<QString, std::vector<QString>>
+    std::pmr::unordered_map<QString, std::pmr::vector<QString>>
         dependencies_;  ///< Map of state dependencies.
-    std::unordered_map<QString, std::vector<QString>>
+    std::pmr::unordered_map<QString, std::pmr::vector<QString>>
         dependents_;  ///< Map of state dependents.
-    std::unordered_map<QString, std::function<QVariant()>>
+    std::pmr::unordered_map<QString, std::function<QVariant()>>
         computed_values_;  ///< Map of computed value functions for dependent states.
-    std::unordered_map<QString, QVariant>
+    std::pmr::unordered_map<QString, QVariant>
         state_data_;  ///< Map of state keys to current values for quick access.
 
     bool batching_ = false;    ///< Whether batch update mode is active.
     bool debug_mode_ = false;  ///< Whether debug mode is enabled.
     bool performance_monitoring_ =
         false;  ///< Whether performance monitoring is enabled.
-    std::vector<std::function<void()>>
+    std::pmr::vector<std::function<void()>>
         pending_updates_;  ///< Pending updates for batch mode.
 
     // **Thread synchronization**
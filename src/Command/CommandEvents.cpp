@@ -185,7 +185,10 @@ std::unique_ptr<CommandEvent> CustomEvent::clone() const {
 }
 
 // **CommandEventDispatcher implementation**
-CommandEventDispatcher::CommandEventDispatcher(QObject* parent) : QObject(parent) {
+CommandEventDispatcher::CommandEventDispatcher(QObject* parent)
+    : QObject(parent),
+      handlers_(Core::shared_pool_resource()),
+      command_handlers_(Core::shared_pool_resource()) {
     qDebug() << "⚡ CommandEventDispatcher initialized";
 }
 
@@ -390,8 +393,11 @@ void CommandEventDispatcher::processEvent(const CommandEvent& event) {
             }
         }
         
-        // Get handlers for this event
-        auto handlers = getHandlersForEvent(event);
+        // Get handlers for this event; the list lives on the dispatch arena
+        // and is released in O(1) when the scope ends (nested dispatches
+        // from handlers open nested scopes)
+        Core::ArenaScope scratch(dispatch_arena_);
+        auto handlers = getHandlersForEvent(event, &dispatch_resource_);
         
         // Sort handlers by priority (higher priority first)
         std::sort(handlers.begin(), handlers.end(),
@@ -428,8 +434,9 @@ void CommandEventDispatcher::processEvent(const CommandEvent& event) {
     }
 }
 
-std::vector<CommandEventDispatcher::HandlerInfo*> CommandEventDispatcher::getHandlersForEvent(const CommandEvent& event) {
-    std::vector<HandlerInfo*> result;
+std::pmr::vector<CommandEventDispatcher::HandlerInfo*> CommandEventDispatcher::getHandlersForEvent(
+    const CommandEvent& event, std::pmr::memory_resource* resource) {
+    std::pmr::vector<HandlerInfo*> result(resource);
     
     BaseUICommand* source = event.getSource();
     if (!source) {
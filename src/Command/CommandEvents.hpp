@@ -7,10 +7,13 @@
 #include <QDateTime>
 #include <QUuid>
 #include <memory>
+#include <memory_resource>
 #include <functional>
 #include <unordered_map>
 #include <vector>
 
+#include "../Core/MemoryManager.hpp"
+#include "../Core/MemoryResource.hpp"
 #include "UICommand.hpp"
 
 // **Hash specialization for QUuid to use with std::unordered_map**
@@ -82,6 +85,8 @@ enum class CommandEventPriority {
 // **Command Event - abstract base for all command events**
 class CommandEvent {
 public:
+    DECLARATIVE_UI_SLAB_ALLOCATED
+
     explicit CommandEvent(CommandEventType type, BaseUICommand* source = nullptr);
     virtual ~CommandEvent() = default;
     
@@ -312,13 +317,17 @@ signals:
     void eventHandlingError(const CommandEvent& event, const QString& error);
     
 private:
-    // **Handler storage**
+    // **Handler storage** (node churn goes to the shared size-class pool)
     struct HandlerInfo {
         BaseUICommand* command;
         EventHandlerRegistration registration;
     };
-    std::unordered_map<QUuid, HandlerInfo> handlers_;
-    std::unordered_map<BaseUICommand*, std::vector<QUuid>> command_handlers_;
+    std::pmr::unordered_map<QUuid, HandlerInfo> handlers_;
+    std::pmr::unordered_map<BaseUICommand*, std::pmr::vector<QUuid>> command_handlers_;
+    
+    // **Per-dispatch scratch memory**, rolled back after each processEvent()
+    Core::ChunkedArena dispatch_arena_{4096};
+    Core::ChunkedArenaResource dispatch_resource_{dispatch_arena_};
     
     // **Global filters and interceptors**
     std::vector<std::pair<CommandEventFilter, CommandEventPriority>> global_filters_;
@@ -331,7 +340,8 @@ private:
     
     // **Helper methods**
     void processEvent(const CommandEvent& event);
-    std::vector<HandlerInfo*> getHandlersForEvent(const CommandEvent& event);
+    std::pmr::vector<HandlerInfo*> getHandlersForEvent(const CommandEvent& event,
+                                                       std::pmr::memory_resource* resource);
     bool passesGlobalFilters(const CommandEvent& event);
     void handleError(const CommandEvent& event, const QString& error);
     
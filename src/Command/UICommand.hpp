@@ -12,6 +12,7 @@
 #include <type_traits>
 
 #include "../Core/UIElement.hpp"
+#include "../Core/SlabAllocator.hpp"
 #include "../Binding/StateManager.hpp"
 
 namespace DeclarativeUI::Command::UI {
@@ -43,6 +44,8 @@ class UICommandState : public QObject {
     Q_OBJECT
     
 public:
+    DECLARATIVE_UI_SLAB_ALLOCATED
+
     explicit UICommandState(QObject* parent = nullptr);
     virtual ~UICommandState() = default;
     
@@ -90,6 +93,8 @@ class BaseUICommand : public QObject {
     Q_OBJECT
     
 public:
+    DECLARATIVE_UI_SLAB_ALLOCATED
+
     explicit BaseUICommand(QObject* parent = nullptr);
     virtual ~BaseUICommand() = default;
     
@@ -1,211 +1,1415 @@
 #include "CacheManager.hpp"
 
+#include <QCborMap>
+#include <QCborValue>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QRegularExpression>
+#include <QStringList>
+#include <QVariant>
 #include <algorithm>
+#include <cstdint>
 #include <mutex>
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "ParallelProcessor.hpp"
+
 namespace DeclarativeUI::Core {
 
+namespace {
+
+/**
+ * @brief Reads of a compressed entry after which it joins the hot tier.
+ */
+constexpr size_t kHotPromotionReads = 2;
+
+/**
+ * @brief Upper bound on FrequencySketch words (8 MiB of counters).
+ */
+constexpr size_t kMaxSketchWords = size_t(1) << 20;
+
+/**
+ * @brief Layout constants for memory estimation (64-bit Qt 6).
+ * - kArrayDataHeader: QArrayData in front of QString/QByteArray/QList data.
+ * - kCborContainerBytes: QCborContainerPrivate behind QJsonObject/QJsonArray.
+ * - kCborElementBytes: one QtCbor::Element per key or value.
+ * - kVariantInlineBytes: QVariant payloads up to this size are stored inline.
+ * - kObjectPrivateBytes / kWidgetPrivateBytes: QObjectPrivate and
+ *   QWidgetPrivate (with QWidgetData), which dominate a widget's footprint.
+ * - kSharedControlBlockBytes: shared_ptr control block with deleter.
+ */
+constexpr size_t kArrayDataHeader = 16;
+constexpr size_t kCborContainerBytes = 64;
+constexpr size_t kCborElementBytes = 16;
+constexpr size_t kVariantInlineBytes = 3 * sizeof(void*);
+constexpr size_t kObjectPrivateBytes = 128;
+constexpr size_t kWidgetPrivateBytes = 768;
+constexpr size_t kSharedControlBlockBytes = 32;
+
+/**
+ * @brief Bytes a malloc() of size bytes really consumes: glibc adds an
+ * 8-byte chunk header and rounds to 16.
+ */
+size_t heapBlock(size_t bytes) {
+    return bytes == 0 ? 0 : (bytes + 8 + 15) & ~size_t(15);
+}
+
+/**
+ * @brief CBOR containers keep US-ASCII strings as bytes and others as UTF-16,
+ * each behind an 8-byte length.
+ */
+size_t cborStringBytes(const QString& text) {
+    const bool ascii = std::all_of(text.cbegin(), text.cend(), [](QChar c) {
+        return c.unicode() < 0x80;
+    });
+    return 8 + static_cast<size_t>(text.size()) * (ascii ? 1 : 2);
+}
+
+size_t jsonContainerBytes(size_t elements, size_t string_bytes) {
+    return heapBlock(kCborContainerBytes) +
+           heapBlock(kArrayDataHeader + elements * kCborElementBytes) +
+           heapBlock(string_bytes > 0 ? kArrayDataHeader + string_bytes : 0);
+}
+
+size_t jsonArrayBytes(const QJsonArray& array);
+size_t jsonObjectBytes(const QJsonObject& object);
+
+/**
+ * @brief Add a value's share to its parent container: strings live in the
+ * parent's byte buffer, objects and arrays own a container of their own.
+ */
+void accumulateJsonValue(const QJsonValue& value, size_t& string_bytes,
+                         size_t& nested_bytes) {
+    switch (value.type()) {
+        case QJsonValue::String:
+            string_bytes += cborStringBytes(value.toString());
+            break;
+        case QJsonValue::Object:
+            nested_bytes += jsonObjectBytes(value.toObject());
+            break;
+        case QJsonValue::Array:
+            nested_bytes += jsonArrayBytes(value.toArray());
+            break;
+        default:
+            break;  // Numbers, booleans and null live in the element
+    }
+}
+
+size_t jsonArrayBytes(const QJsonArray& array) {
+    if (array.isEmpty()) {
+        return 0;
+    }
+    size_t string_bytes = 0;
+    size_t nested_bytes = 0;
+    for (const QJsonValue& value : array) {
+        accumulateJsonValue(value, string_bytes, nested_bytes);
+    }
+    return jsonContainerBytes(static_cast<size_t>(array.size()),
+                              string_bytes) +
+           nested_bytes;
+}
+
+size_t jsonObjectBytes(const QJsonObject& object) {
+    if (object.isEmpty()) {
+        return 0;
+    }
+    size_t string_bytes = 0;
+    size_t nested_bytes = 0;
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+        string_bytes += cborStringBytes(it.key());
+        accumulateJsonValue(it.value(), string_bytes, nested_bytes);
+    }
+    return jsonContainerBytes(static_cast<size_t>(object.size()) * 2,
+                              string_bytes) +
+           nested_bytes;
+}
+
+/**
+ * @brief A QObject's own allocation, its private data and its name.
+ */
+size_t objectBytes(const QObject* object) {
+    size_t bytes = CacheSizeEstimator<QString>::estimate(object->objectName());
+    if (object->isWidgetType()) {
+        const auto* widget = static_cast<const QWidget*>(object);
+        bytes += heapBlock(sizeof(QWidget)) + heapBlock(kWidgetPrivateBytes) +
+                 CacheSizeEstimator<QString>::estimate(widget->styleSheet());
+    } else {
+        bytes += heapBlock(sizeof(QObject)) + heapBlock(kObjectPrivateBytes);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Bytes currently handed out by the allocator, when it can tell.
+ */
+std::optional<size_t> allocatorBytesInUse() {
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return std::nullopt;
+#endif
+}
+
+/**
+ * @brief Derive an independent 64-bit hash per count-min sketch row.
+ */
+inline uint64_t sketchRowHash(size_t hash, unsigned row) {
+    static constexpr uint64_t kSeeds[4] = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+        0xcbf29ce484222325ULL};
+    uint64_t h = (static_cast<uint64_t>(hash) + kSeeds[row]) *
+                 0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 29);
+}
+
+/**
+ * @brief Modification time and size of a file; content_hash is left zero.
+ */
+PersistentCacheStamp fileMetadataStamp(const QFileInfo& info) {
+    PersistentCacheStamp stamp;
+    stamp.modified_ms = info.lastModified().toMSecsSinceEpoch();
+    stamp.file_size = static_cast<quint64>(info.size());
+    return stamp;
+}
+
+inline bool sameFileMetadata(const PersistentCacheStamp& a,
+                             const PersistentCacheStamp& b) {
+    return a.modified_ms == b.modified_ms && a.file_size == b.file_size;
+}
+
+/**
+ * @brief Replace a typed cache with a sharded one using the same limits.
+ */
+template <typename CacheType>
+void rebuildWithShards(std::shared_ptr<CacheType>& cache, size_t shard_count) {
+    if (!cache)
+        return;
+
+    auto rebuilt = std::make_shared<CacheType>(
+        cache->maxSize(), cache->maxMemoryBytes() / (1024 * 1024), shard_count);
+    rebuilt->setEvictionPolicy(cache->evictionPolicy());
+    rebuilt->setNegativeCacheTTL(cache->negativeCacheTTL());
+    rebuilt->setTTL(cache->defaultTTL());
+    const auto compression = cache->compressionSettings();
+    if (compression.enabled) {
+        rebuilt->enableCompression(true, compression.threshold_bytes,
+                                   compression.hot_entries);
+    }
+    cache = std::move(rebuilt);
+}
+
+/**
+ * @brief Per-cache statistics block shared by both getCacheStatistics()
+ * overloads.
+ */
+template <typename CacheType>
+QJsonObject cacheStatisticsToJson(const CacheType& cache) {
+    const auto snapshot = cache->getStatistics();
+
+    QJsonObject stats;
+    stats["size"] = static_cast<qint64>(cache->size());
+    stats["memory_usage"] = static_cast<qint64>(cache->memoryUsage());
+    stats["shard_count"] = static_cast<qint64>(cache->shardCount());
+    stats["hit_ratio"] = snapshot.getHitRatio();
+    stats["storage_bytes"] = static_cast<qint64>(snapshot.storage_bytes);
+    stats["expirations"] = static_cast<qint64>(snapshot.expirations);
+    stats["compression_enabled"] = cache->compressionSettings().enabled;
+    stats["compressed_entries"] =
+        static_cast<qint64>(snapshot.compressed_entries);
+    stats["compression_ratio"] = snapshot.getCompressionRatio();
+    stats["decompressions"] = static_cast<qint64>(snapshot.decompressions);
+    stats["avg_decompress_us"] = snapshot.getAverageDecompressMicros();
+    stats["hot_tier_hits"] = static_cast<qint64>(snapshot.hot_tier_hits);
+    stats["loader_calls"] = static_cast<qint64>(snapshot.loader_calls);
+    stats["coalesced_loads"] = static_cast<qint64>(snapshot.coalesced_loads);
+    stats["negative_cache_hits"] =
+        static_cast<qint64>(snapshot.negative_cache_hits);
+    return stats;
+}
+
+}  // namespace
+
+// **FrequencySketch implementation**
+void FrequencySketch::ensureCapacity(size_t max_entries) {
+    if (table_size_ > 0)
+        return;
+
+    size_t words = 8;
+    while (words < max_entries && words < kMaxSketchWords) {
+        words <<= 1;
+    }
+
+    table_ = std::make_unique<std::atomic<uint64_t>[]>(words);
+    table_size_ = words;
+    table_mask_ = words - 1;
+    sample_size_ = 10 * std::max<size_t>(max_entries, 1);
+}
+
+unsigned FrequencySketch::frequency(size_t hash) const {
+    if (table_size_ == 0)
+        return 0;
+
+    unsigned frequency = 15;
+    for (unsigned row = 0; row < 4; ++row) {
+        const uint64_t h = sketchRowHash(hash, row);
+        const size_t index = static_cast<size_t>(h) & table_mask_;
+        const unsigned nibble = row * 4 + static_cast<unsigned>((h >> 40) & 3);
+        const uint64_t word = table_[index].load(std::memory_order_relaxed);
+        frequency = std::min(
+            frequency, static_cast<unsigned>((word >> (nibble * 4)) & 0xF));
+    }
+    return frequency;
+}
+
+void FrequencySketch::increment(size_t hash) {
+    if (table_size_ == 0)
+        return;
+
+    bool added = false;
+    for (unsigned row = 0; row < 4; ++row) {
+        const uint64_t h = sketchRowHash(hash, row);
+        const size_t index = static_cast<size_t>(h) & table_mask_;
+        const unsigned nibble = row * 4 + static_cast<unsigned>((h >> 40) & 3);
+        added |= incrementAt(index, nibble);
+    }
+
+    if (added &&
+        additions_.fetch_add(1, std::memory_order_relaxed) + 1 >=
+            sample_size_) {
+        age();
+    }
+}
+
+bool FrequencySketch::incrementAt(size_t index, unsigned nibble) {
+    const unsigned shift = nibble * 4;
+    const uint64_t mask = uint64_t(0xF) << shift;
+    uint64_t word = table_[index].load(std::memory_order_relaxed);
+    while ((word & mask) != mask) {
+        if (table_[index].compare_exchange_weak(word,
+                                                word + (uint64_t(1) << shift),
+                                                std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;  // Counter saturated
+}
+
+void FrequencySketch::age() {
+    // Only the thread that wins the reset performs the halving
+    size_t additions = additions_.load(std::memory_order_relaxed);
+    if (additions < sample_size_ ||
+        !additions_.compare_exchange_strong(additions, additions / 2,
+                                            std::memory_order_relaxed)) {
+        return;
+    }
+
+    for (size_t i = 0; i < table_size_; ++i) {
+        uint64_t word = table_[i].load(std::memory_order_relaxed);
+        while (!table_[i].compare_exchange_weak(
+            word, (word >> 1) & 0x7777777777777777ULL,
+            std::memory_order_relaxed)) {
+        }
+    }
+}
+
+// **CacheValueCodec specializations**
+QByteArray CacheValueCodec<QByteArray>::encode(const QByteArray& value) {
+    return value;
+}
+
+QByteArray CacheValueCodec<QByteArray>::decode(const QByteArray& bytes) {
+    return bytes;
+}
+
+QByteArray CacheValueCodec<QString>::encode(const QString& value) {
+    return value.toUtf8();
+}
+
+QString CacheValueCodec<QString>::decode(const QByteArray& bytes) {
+    return QString::fromUtf8(bytes);
+}
+
+QByteArray CacheValueCodec<QJsonObject>::encode(const QJsonObject& value) {
+    // CBOR is denser than JSON text and cheaper to turn back into an object
+    return QCborMap::fromJsonObject(value).toCborValue().toCbor();
+}
+
+QJsonObject CacheValueCodec<QJsonObject>::decode(const QByteArray& bytes) {
+    return QCborValue::fromCbor(bytes).toMap().toJsonObject();
+}
+
+// **Size estimators**
+size_t CacheSizeEstimator<QByteArray>::estimate(const QByteArray& value) {
+    // Empty and fromRawData() arrays own no block
+    const auto capacity = static_cast<size_t>(value.capacity());
+    return capacity > 0 ? heapBlock(kArrayDataHeader + capacity + 1) : 0;
+}
+
+size_t CacheSizeEstimator<QString>::estimate(const QString& value) {
+    const auto capacity = static_cast<size_t>(value.capacity());
+    return capacity > 0
+               ? heapBlock(kArrayDataHeader + (capacity + 1) * sizeof(QChar))
+               : 0;
+}
+
+size_t CacheSizeEstimator<QVariant>::estimate(const QVariant& value) {
+    switch (value.typeId()) {
+        case QMetaType::UnknownType:
+            return 0;
+        case QMetaType::QString:
+            return CacheSizeEstimator<QString>::estimate(value.toString());
+        case QMetaType::QByteArray:
+            return CacheSizeEstimator<QByteArray>::estimate(
+                value.toByteArray());
+        case QMetaType::QJsonObject:
+            return jsonObjectBytes(value.toJsonObject());
+        case QMetaType::QStringList: {
+            const QStringList list = value.toStringList();
+            size_t bytes = heapBlock(kArrayDataHeader +
+                                     list.capacity() * sizeof(QString));
+            for (const QString& item : list) {
+                bytes += CacheSizeEstimator<QString>::estimate(item);
+            }
+            return bytes;
+        }
+        case QMetaType::QVariantList: {
+            const QVariantList list = value.toList();
+            size_t bytes = heapBlock(kArrayDataHeader +
+                                     list.capacity() * sizeof(QVariant));
+            for (const QVariant& item : list) {
+                bytes += estimate(item);
+            }
+            return bytes;
+        }
+        default: {
+            // Larger payloads move to a ref-counted block on the heap
+            const auto type_size =
+                static_cast<size_t>(value.metaType().sizeOf());
+            return type_size > kVariantInlineBytes ? heapBlock(8 + type_size)
+                                                   : 0;
+        }
+    }
+}
+
+size_t CacheSizeEstimator<QJsonObject>::estimate(const QJsonObject& value) {
+    return jsonObjectBytes(value);
+}
+
+size_t CacheSizeEstimator<std::shared_ptr<QWidget>>::estimate(
+    const std::shared_ptr<QWidget>& value) {
+    if (!value) {
+        return 0;
+    }
+
+    // Layouts, actions and child widgets are owned through the object tree
+    size_t bytes = kSharedControlBlockBytes + objectBytes(value.get());
+    for (const QObject* child : value->findChildren<QObject*>()) {
+        bytes += objectBytes(child);
+    }
+    return bytes;
+}
+
 // **LRUCache template implementation**
 template <typename Key, typename Value>
-LRUCache<Key, Value>::LRUCache(size_t max_size, size_t max_memory_mb)
-    : max_size_(max_size), max_memory_bytes_(max_memory_mb * 1024 * 1024) {}
+LRUCache<Key, Value>::LRUCache(size_t max_size, size_t max_memory_mb,
+                               size_t shard_count)
+    : max_size_(max_size), max_memory_bytes_(max_memory_mb * 1024 * 1024) {
+    // Round up to a power of two so the shard index is a plain shift
+    size_t shards = 1;
+    size_t shard_bits = 0;
+    while (shards < std::max<size_t>(shard_count, 1)) {
+        shards <<= 1;
+        ++shard_bits;
+    }
+    shard_shift_ = 64 - shard_bits;
+
+    shards_.reserve(shards);
+    for (size_t i = 0; i < shards; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->max_size = std::max<size_t>((max_size_ + shards - 1) / shards, 1);
+        shard->max_memory_bytes = (max_memory_bytes_ + shards - 1) / shards;
+        // WTinyLFU split: 1% window, main divided 20% probation/80% protected
+        shard->window_capacity = std::max<size_t>(shard->max_size / 100, 1);
+        shard->protected_capacity =
+            (shard->max_size - std::min(shard->window_capacity,
+                                        shard->max_size)) *
+            4 / 5;
+        shards_.push_back(std::move(shard));
+    }
+}
+
+template <typename Key, typename Value>
+size_t LRUCache<Key, Value>::hashKey(const Key& key) {
+    return static_cast<size_t>(qHash(key));
+}
+
+template <typename Key, typename Value>
+size_t LRUCache<Key, Value>::shardIndex(size_t hash) const {
+    if (shards_.size() == 1) {
+        return 0;
+    }
+
+    // Fibonacci hashing: take the high bits so shard selection does not
+    // correlate with the low bits used for bucket selection inside the shard
+    const auto mixed =
+        static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(mixed >> shard_shift_);
+}
+
+template <typename Key, typename Value>
+typename LRUCache<Key, Value>::Shard& LRUCache<Key, Value>::shardFor(
+    size_t hash) const {
+    return *shards_[shardIndex(hash)];
+}
 
 template <typename Key, typename Value>
 bool LRUCache<Key, Value>::put(const Key& key, const Value& value,
                                const QDateTime& expires_at) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-
-    statistics_.total_requests.fetch_add(1);
-
-    // Remove existing entry if present
-    auto existing_it = cache_.find(key);
-    if (existing_it != cache_.end()) {
-        // Update existing entry
-        existing_it->second->data = value;
-        existing_it->second->last_accessed = QDateTime::currentDateTime();
-        existing_it->second->expires_at = expires_at;
-        existing_it->second->is_dirty = false;
-        updateAccessOrder(key);
-        return true;
-    }
+    return store(key, value, expiryFor(expires_at), true);
+}
 
-    // Create new entry
-    auto entry = std::make_shared<CacheEntryType>();
-    entry->data = value;
-    entry->created_at = QDateTime::currentDateTime();
-    entry->last_accessed = entry->created_at;
-    entry->expires_at = expires_at;
-    entry->memory_size.store(calculateMemorySize(value));
+template <typename Key, typename Value>
+bool LRUCache<Key, Value>::put(const Key& key, const Value& value,
+                               std::chrono::milliseconds ttl) {
+    return store(key, value, std::chrono::steady_clock::now() + ttl, true);
+}
 
-    // Check memory constraints
-    if (entry->memory_size.load() > max_memory_bytes_) {
-        return false;  // Value too large for cache
+template <typename Key, typename Value>
+bool LRUCache<Key, Value>::store(
+    const Key& key, const Value& value,
+    std::chrono::steady_clock::time_point expires_at, bool count_request) {
+    const size_t hash = hashKey(key);
+    Shard& shard = shardFor(hash);
+
+    // Compress and measure before taking the lock so writers do not stall
+    // readers
+    auto packed = packValue(value);
+    const size_t charge = entryCharge(key, value, packed);
+
+    if (negative_ttl_ms_.load(std::memory_order_relaxed) > 0) {
+        forgetNegative(shard, key);
     }
 
-    cache_[key] = entry;
-    access_order_.push_front(key);
-    access_iterators_[key] = access_order_.begin();
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    if (count_request) {
+        shard.statistics.total_requests.fetch_add(1);
+    }
 
-    statistics_.total_memory_usage.fetch_add(entry->memory_size.load());
+    if (!insertLocked(shard, key, hash, value, std::move(packed), charge,
+                      expires_at)) {
+        return false;  // Value too large for cache
+    }
 
     // Evict if necessary
-    evictIfNeeded();
+    evictIfNeeded(shard);
 
     return true;
 }
 
+template <typename Key, typename Value>
+std::chrono::steady_clock::time_point LRUCache<Key, Value>::expiryFor(
+    const QDateTime& expires_at) const {
+    const auto now = std::chrono::steady_clock::now();
+    if (expires_at.isValid()) {
+        return now + std::chrono::milliseconds(
+                         QDateTime::currentDateTime().msecsTo(expires_at));
+    }
+
+    const auto ttl_ms = default_ttl_ms_.load(std::memory_order_relaxed);
+    return ttl_ms > 0 ? now + std::chrono::milliseconds(ttl_ms)
+                      : std::chrono::steady_clock::time_point::max();
+}
+
 template <typename Key, typename Value>
 std::optional<Value> LRUCache<Key, Value>::get(const Key& key) {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const size_t hash = hashKey(key);
+    Shard& shard = shardFor(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
 
-    statistics_.total_requests.fetch_add(1);
+    shard.statistics.total_requests.fetch_add(1);
 
-    auto it = cache_.find(key);
-    if (it == cache_.end()) {
-        statistics_.cache_misses.fetch_add(1);
+    recordFrequency(shard, hash);
+
+    uint32_t slot = findSlot(shard, key, hash);
+    if (slot == kNil) {
+        shard.statistics.cache_misses.fetch_add(1);
         return std::nullopt;
     }
 
-    auto& entry = it->second;
-
     // Check if expired
-    if (entry->isExpired()) {
+    if (shard.slab[slot].entry.isExpired()) {
         lock.unlock();
-        std::unique_lock<std::shared_mutex> write_lock(mutex_);
-        auto it_recheck = cache_.find(key);  // Re-find after lock upgrade
-        if (it_recheck != cache_.end()) {
-            statistics_.total_memory_usage.fetch_sub(
-                it_recheck->second->memory_size.load());
-            cache_.erase(it_recheck);
-            // Remove from access order
-            auto access_it = access_iterators_.find(key);
-            if (access_it != access_iterators_.end()) {
-                access_order_.erase(access_it->second);
-                access_iterators_.erase(access_it);
-            }
+        std::unique_lock<std::shared_mutex> write_lock(shard.mutex);
+        slot = findSlot(shard, key, hash);  // Re-find after lock upgrade
+        if (slot != kNil && shard.slab[slot].entry.isExpired()) {
+            eraseSlot(shard, slot);
+            shard.statistics.expirations.fetch_add(1);
         }
-        statistics_.cache_misses.fetch_add(1);
+        shard.statistics.cache_misses.fetch_add(1);
         return std::nullopt;
     }
 
+    // Cold compressed entry: inflate outside the lock, then revisit the slot
+    // to update recency and possibly promote it into the hot tier
+    if (shard.slab[slot].compressed && shard.slab[slot].hot_pos == kNil) {
+        const QByteArray packed = shard.slab[slot].packed;
+        const uint32_t version = shard.slab[slot].version;
+        CacheEntryType& entry = shard.slab[slot].entry;
+        entry.markReferenced();
+        const bool promote = entry.access_count.load(
+                                 std::memory_order_relaxed) >=
+                             kHotPromotionReads;
+        shard.statistics.cache_hits.fetch_add(1);
+        lock.unlock();
+
+        Value value = unpackValue(shard, packed);
+
+        if (promote || !usesClockRecency()) {
+            std::unique_lock<std::shared_mutex> write_lock(shard.mutex);
+            slot = findSlot(shard, key, hash);
+            // Only act if the slot still holds the payload we inflated
+            if (slot != kNil && shard.slab[slot].version == version) {
+                if (!usesClockRecency()) {
+                    shard.slab[slot].entry.last_accessed =
+                        std::chrono::steady_clock::now();
+                    recordHitLocked(shard, slot);
+                }
+                if (promote && shard.slab[slot].hot_pos == kNil) {
+                    promoteHot(shard, slot, value);
+                }
+            }
+        }
+        return value;
+    }
+
+    if (shard.slab[slot].compressed) {
+        shard.statistics.hot_tier_hits.fetch_add(1);
+    }
+
+    // Sharded mode: record the hit with the CLOCK reference bit so readers
+    // never need the exclusive lock
+    if (usesClockRecency()) {
+        shard.slab[slot].entry.markReferenced();
+        shard.statistics.cache_hits.fetch_add(1);
+        return shard.slab[slot].entry.data;
+    }
+
     // Need to upgrade to exclusive lock for updating access order
     lock.unlock();
-    std::unique_lock<std::shared_mutex> write_lock(mutex_);
+    std::unique_lock<std::shared_mutex> write_lock(shard.mutex);
 
     // Re-find entry after lock upgrade
-    auto it_recheck = cache_.find(key);
-    if (it_recheck == cache_.end() || it_recheck->second->isExpired()) {
-        statistics_.cache_misses.fetch_add(1);
+    slot = findSlot(shard, key, hash);
+    if (slot == kNil || shard.slab[slot].entry.isExpired()) {
+        shard.statistics.cache_misses.fetch_add(1);
         return std::nullopt;
     }
 
     // Update access information
-    it_recheck->second->touch();
-    updateAccessOrder(key);
+    shard.slab[slot].entry.touch();
+    recordHitLocked(shard, slot);
+
+    shard.statistics.cache_hits.fetch_add(1);
+
+    // Demoted from the hot tier while the lock was released
+    if (shard.slab[slot].compressed && shard.slab[slot].hot_pos == kNil) {
+        const QByteArray packed = shard.slab[slot].packed;
+        write_lock.unlock();
+        return unpackValue(shard, packed);
+    }
+    return shard.slab[slot].entry.data;
+}
+
+template <typename Key, typename Value>
+std::optional<Value> LRUCache<Key, Value>::peek(const Key& key) {
+    const size_t hash = hashKey(key);
+    Shard& shard = shardFor(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    const uint32_t slot = findSlot(shard, key, hash);
+    if (slot == kNil || shard.slab[slot].entry.isExpired()) {
+        return std::nullopt;
+    }
+    if (shard.slab[slot].compressed && shard.slab[slot].hot_pos == kNil) {
+        const QByteArray packed = shard.slab[slot].packed;
+        lock.unlock();
+        return unpackValue(shard, packed);
+    }
+    return shard.slab[slot].entry.data;
+}
+
+template <typename Key, typename Value>
+Value LRUCache<Key, Value>::getOrCompute(const Key& key,
+                                         const std::function<Value()>& loader,
+                                         bool* hit) {
+    if (hit)
+        *hit = false;
+
+    if (auto cached = get(key)) {
+        if (hit)
+            *hit = true;
+        return std::move(*cached);
+    }
+
+    const size_t hash = hashKey(key);
+    Shard& shard = shardFor(hash);
+    std::promise<Value> promise;
+
+    {
+        // Lock order: flight_mutex before the shard mutex, never the reverse
+        std::unique_lock<std::mutex> flight_lock(shard.flight_mutex);
+
+        auto failure = shard.negative.find(key);
+        if (failure != shard.negative.end()) {
+            if (std::chrono::steady_clock::now() < failure->second.expires_at) {
+                shard.statistics.negative_cache_hits.fetch_add(1);
+                std::rethrow_exception(failure->second.error);
+            }
+            shard.negative.erase(failure);
+        }
+
+        auto pending = shard.in_flight.find(key);
+        if (pending != shard.in_flight.end()) {
+            std::shared_future<Value> result = pending->second;
+            flight_lock.unlock();
+            shard.statistics.coalesced_loads.fetch_add(1);
+            return result.get();
+        }
+
+        // Another load may have completed between the miss and the lock;
+        // peek, so the miss above stays the only access counted
+        if (auto cached = peek(key)) {
+            if (hit)
+                *hit = true;
+            return std::move(*cached);
+        }
+
+        shard.in_flight.emplace(key, promise.get_future().share());
+    }
+
+    shard.statistics.loader_calls.fetch_add(1);
+
+    try {
+        Value value = loader();
+
+        // Publish before retiring the in-flight entry so late callers hit;
+        // the lookup that missed already counted this request
+        store(key, value, expiryFor(QDateTime()), false);
+        {
+            std::lock_guard<std::mutex> flight_lock(shard.flight_mutex);
+            shard.in_flight.erase(key);
+        }
+        promise.set_value(value);
+        return value;
+    } catch (...) {
+        const std::exception_ptr error = std::current_exception();
+        {
+            std::lock_guard<std::mutex> flight_lock(shard.flight_mutex);
+            shard.in_flight.erase(key);
+
+            const int64_t ttl_ms = negative_ttl_ms_.load();
+            if (ttl_ms > 0) {
+                shard.negative[key] = NegativeEntry{
+                    error, std::chrono::steady_clock::now() +
+                               std::chrono::milliseconds(ttl_ms)};
+            }
+        }
+        promise.set_exception(error);
+        throw;
+    }
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::forgetNegative(Shard& shard, const Key& key) {
+    std::lock_guard<std::mutex> flight_lock(shard.flight_mutex);
+    shard.negative.erase(key);
+}
 
-    statistics_.cache_hits.fetch_add(1);
-    return it_recheck->second->data;
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::setNegativeCacheTTL(std::chrono::milliseconds ttl) {
+    negative_ttl_ms_.store(std::max<int64_t>(ttl.count(), 0));
+
+    if (ttl.count() <= 0) {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> flight_lock(shard->flight_mutex);
+            shard->negative.clear();
+        }
+    }
 }
 
 template <typename Key, typename Value>
 bool LRUCache<Key, Value>::contains(const Key& key) const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    auto it = cache_.find(key);
-    return it != cache_.end() && !it->second->isExpired();
+    const size_t hash = hashKey(key);
+    const Shard& shard = shardFor(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const uint32_t slot = findSlot(shard, key, hash);
+    return slot != kNil && !shard.slab[slot].entry.isExpired();
+}
+
+template <typename Key, typename Value>
+std::optional<std::chrono::steady_clock::time_point>
+LRUCache<Key, Value>::expiryOf(const Key& key) const {
+    const size_t hash = hashKey(key);
+    const Shard& shard = shardFor(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const uint32_t slot = findSlot(shard, key, hash);
+    if (slot == kNil || shard.slab[slot].entry.isExpired()) {
+        return std::nullopt;
+    }
+    return shard.slab[slot].entry.expires_at;
 }
 
 template <typename Key, typename Value>
 bool LRUCache<Key, Value>::remove(const Key& key) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
+    const size_t hash = hashKey(key);
+    Shard& shard = shardFor(hash);
+    if (negative_ttl_ms_.load(std::memory_order_relaxed) > 0) {
+        forgetNegative(shard, key);
+    }
 
-    auto it = cache_.find(key);
-    if (it == cache_.end()) {
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    const uint32_t slot = findSlot(shard, key, hash);
+    if (slot == kNil) {
         return false;
     }
 
-    statistics_.total_memory_usage.fetch_sub(it->second->memory_size.load());
+    eraseSlot(shard, slot);
+    return true;
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::clear() {
+    for (auto& shard : shards_) {
+        {
+            std::lock_guard<std::mutex> flight_lock(shard->flight_mutex);
+            shard->negative.clear();
+        }
+
+        std::unique_lock<std::shared_mutex> lock(shard->mutex);
+        // Release the storage too; clear() is not on the hot path
+        shard->slab = std::vector<Slot>();
+        shard->index = std::vector<IndexCell>();
+        shard->live = 0;
+        shard->free_head = kNil;
+        shard->lists.fill(RecencyList{});
+        shard->admission_candidate = kNil;
+        std::fill(shard->hot_ring.begin(), shard->hot_ring.end(), kNil);
+        shard->hot_cursor = 0;
+        // Keep current_tick: it tracks the clock, not the contents
+        shard->wheel.buckets.fill(kNil);
+        shard->wheel.scheduled = 0;
+        shard->statistics.total_memory_usage.store(0);
+        shard->statistics.storage_bytes.store(0);
+        shard->statistics.compressed_entries.store(0);
+        shard->statistics.uncompressed_bytes.store(0);
+        shard->statistics.compressed_bytes.store(0);
+    }
+}
+
+// **Slab and index primitives**
+template <typename Key, typename Value>
+uint32_t LRUCache<Key, Value>::findSlot(const Shard& shard, const Key& key,
+                                        size_t hash) const {
+    if (shard.index.empty()) {
+        return kNil;
+    }
+
+    const size_t mask = shard.index.size() - 1;
+    for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+        const IndexCell& cell = shard.index[pos];
+        if (cell.slot == kNil) {
+            return kNil;
+        }
+        if (cell.hash == hash && shard.slab[cell.slot].key == key) {
+            return cell.slot;
+        }
+    }
+}
+
+template <typename Key, typename Value>
+uint32_t LRUCache<Key, Value>::acquireSlot(Shard& shard) {
+    if (shard.free_head != kNil) {
+        const uint32_t slot = shard.free_head;
+        shard.free_head = shard.slab[slot].next;
+        shard.statistics.slot_reuses.fetch_add(1);
+        return slot;
+    }
+
+    const size_t capacity = shard.slab.capacity();
+    shard.slab.emplace_back();
+    if (shard.slab.capacity() != capacity) {
+        shard.statistics.storage_allocations.fetch_add(1);
+        shard.statistics.storage_bytes.fetch_add(
+            (shard.slab.capacity() - capacity) * sizeof(Slot));
+    }
+    return static_cast<uint32_t>(shard.slab.size() - 1);
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::indexInsert(Shard& shard, size_t hash,
+                                       uint32_t slot) {
+    // Keep the load factor at or below 1/2 so probe sequences stay short
+    if ((shard.live + 1) * 2 > shard.index.size()) {
+        std::vector<IndexCell> old_index(
+            std::max<size_t>(shard.index.size() * 2, 16));
+        old_index.swap(shard.index);
+        shard.statistics.storage_allocations.fetch_add(1);
+        shard.statistics.storage_bytes.fetch_add(
+            (shard.index.size() - old_index.size()) * sizeof(IndexCell));
+
+        const size_t mask = shard.index.size() - 1;
+        for (const IndexCell& cell : old_index) {
+            if (cell.slot == kNil)
+                continue;
+            size_t pos = cell.hash & mask;
+            while (shard.index[pos].slot != kNil) {
+                pos = (pos + 1) & mask;
+            }
+            shard.index[pos] = cell;
+        }
+    }
+
+    const size_t mask = shard.index.size() - 1;
+    size_t pos = hash & mask;
+    while (shard.index[pos].slot != kNil) {
+        pos = (pos + 1) & mask;
+    }
+    shard.index[pos] = IndexCell{hash, slot};
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::indexErase(Shard& shard, size_t hash,
+                                      uint32_t slot) {
+    const size_t mask = shard.index.size() - 1;
+    size_t hole = hash & mask;
+    while (shard.index[hole].slot != slot) {
+        hole = (hole + 1) & mask;
+    }
+
+    // Backward-shift deletion: pull later members of the probe run into the
+    // hole so lookups never need tombstones
+    for (size_t pos = (hole + 1) & mask; shard.index[pos].slot != kNil;
+         pos = (pos + 1) & mask) {
+        const size_t home = shard.index[pos].hash & mask;
+        const bool movable = hole <= pos ? (home <= hole || home > pos)
+                                         : (home <= hole && home > pos);
+        if (movable) {
+            shard.index[hole] = shard.index[pos];
+            hole = pos;
+        }
+    }
+    shard.index[hole] = IndexCell{};
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::linkFront(Shard& shard, uint32_t slot) {
+    Slot& s = shard.slab[slot];
+    RecencyList& list = shard.lists[s.segment];
+    s.prev = kNil;
+    s.next = list.head;
+    if (list.head != kNil) {
+        shard.slab[list.head].prev = slot;
+    }
+    list.head = slot;
+    if (list.tail == kNil) {
+        list.tail = slot;
+    }
+    ++list.size;
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::unlink(Shard& shard, uint32_t slot) {
+    Slot& s = shard.slab[slot];
+    RecencyList& list = shard.lists[s.segment];
+    if (s.prev != kNil) {
+        shard.slab[s.prev].next = s.next;
+    } else {
+        list.head = s.next;
+    }
+    if (s.next != kNil) {
+        shard.slab[s.next].prev = s.prev;
+    } else {
+        list.tail = s.prev;
+    }
+    s.prev = kNil;
+    s.next = kNil;
+    --list.size;
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::moveToSegment(Shard& shard, uint32_t slot,
+                                         Segment segment) {
+    unlink(shard, slot);
+    shard.slab[slot].segment = segment;
+    linkFront(shard, slot);
+}
 
-    // Remove from access order
-    auto access_it = access_iterators_.find(key);
-    if (access_it != access_iterators_.end()) {
-        access_order_.erase(access_it->second);
-        access_iterators_.erase(access_it);
+template <typename Key, typename Value>
+bool LRUCache<Key, Value>::insertLocked(Shard& shard, const Key& key,
+                                        size_t hash, const Value& value,
+                                        std::optional<PackedValue> packed,
+                                        size_t charge,
+                                        std::chrono::steady_clock::time_point
+                                            expires_at) {
+    const size_t new_size = charge;
+    if (new_size > max_memory_bytes_) {
+        return false;
+    }
+    // Larger than this shard's share: the rest of the shard makes room and
+    // the entry is kept on its own (see evictIfNeeded())
+    if (new_size > shard.max_memory_bytes) {
+        while (shard.live > 0) {
+            evictOne(shard);
+        }
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+
+    auto store_payload = [&](Slot& s) {
+        ++s.version;
+        if (packed) {
+            s.entry.data = Value();
+            s.compressed = true;
+            s.raw_size = packed->raw_size;
+            s.packed = std::move(packed->bytes);
+            shard.statistics.compressed_entries.fetch_add(1);
+            shard.statistics.uncompressed_bytes.fetch_add(s.raw_size);
+            shard.statistics.compressed_bytes.fetch_add(s.packed.size());
+        } else {
+            s.entry.data = value;
+        }
+        s.entry.memory_size.store(new_size);
+        shard.statistics.total_memory_usage.fetch_add(new_size);
+    };
+
+    // Update existing entry in place if present
+    uint32_t slot = findSlot(shard, key, hash);
+    if (slot != kNil) {
+        releasePayload(shard, slot);
+        Slot& s = shard.slab[slot];
+        shard.statistics.total_memory_usage.fetch_sub(
+            s.entry.memory_size.load());
+        store_payload(s);
+        s.entry.last_accessed = now;
+        if (s.entry.expires_at != expires_at) {
+            cancelExpiry(shard, slot);
+            s.entry.expires_at = expires_at;
+            scheduleExpiry(shard, slot);
+        }
+        s.entry.is_dirty = false;
+        recordFrequency(shard, hash);
+        recordHitLocked(shard, slot);
+        return true;
     }
 
-    cache_.erase(it);
+    slot = acquireSlot(shard);
+    Slot& s = shard.slab[slot];
+    s.key = key;
+    s.hash = hash;
+    s.occupied = true;
+    store_payload(s);
+    s.entry.created_at = now;
+    s.entry.last_accessed = now;
+    s.entry.expires_at = expires_at;
+    scheduleExpiry(shard, slot);
+    s.entry.access_count.store(0, std::memory_order_relaxed);
+    s.entry.referenced.store(false, std::memory_order_relaxed);
+    s.entry.is_dirty = false;
+
+    // WTinyLFU admits every new key into the window first
+    s.segment = eviction_policy_.load() == EvictionPolicy::WTinyLFU ? kWindow
+                                                                    : kMain;
+    recordFrequency(shard, hash);
+
+    indexInsert(shard, hash, slot);
+    linkFront(shard, slot);
+    ++shard.live;
+
+    // Window overflow moves to probation, where it waits to be judged
+    if (s.segment == kWindow &&
+        shard.lists[kWindow].size > shard.window_capacity) {
+        shard.admission_candidate = shard.lists[kWindow].tail;
+        moveToSegment(shard, shard.admission_candidate, kMain);
+    }
     return true;
 }
 
+// **Compression and hot tier**
 template <typename Key, typename Value>
-void LRUCache<Key, Value>::clear() {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    cache_.clear();
-    access_order_.clear();
-    access_iterators_.clear();
-    statistics_.total_memory_usage.store(0);
+bool LRUCache<Key, Value>::enableCompression(bool enabled,
+                                             size_t threshold_bytes,
+                                             size_t hot_entries) {
+    if constexpr (!CacheValueCodec<Value>::supported) {
+        return false;
+    } else {
+        compression_threshold_.store(threshold_bytes);
+        hot_entries_.store(hot_entries);
+        compression_enabled_.store(enabled);
+
+        const size_t per_shard_hot =
+            (hot_entries + shards_.size() - 1) / shards_.size();
+        for (auto& shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard->mutex);
+            for (uint32_t slot : shard->hot_ring) {
+                if (slot != kNil) {
+                    demoteHot(*shard, slot);
+                }
+            }
+            shard->hot_ring.assign(per_shard_hot, kNil);
+            shard->hot_cursor = 0;
+        }
+        return true;
+    }
 }
 
 template <typename Key, typename Value>
-void LRUCache<Key, Value>::evictIfNeeded() {
-    while (cache_.size() > max_size_ ||
-           statistics_.total_memory_usage.load() > max_memory_bytes_) {
-        switch (eviction_policy_) {
-            case EvictionPolicy::LRU:
-                evictLRU();
-                break;
-            case EvictionPolicy::LFU:
-                evictLFU();
-                break;
-            case EvictionPolicy::TTL:
-                evictExpired();
-                break;
-            default:
-                evictLRU();
-                break;
+typename LRUCache<Key, Value>::CompressionSettings
+LRUCache<Key, Value>::compressionSettings() const {
+    CompressionSettings settings;
+    settings.enabled = compression_enabled_.load();
+    settings.threshold_bytes = compression_threshold_.load();
+    settings.hot_entries = hot_entries_.load();
+    return settings;
+}
+
+template <typename Key, typename Value>
+std::optional<typename LRUCache<Key, Value>::PackedValue>
+LRUCache<Key, Value>::packValue(const Value& value) const {
+    if constexpr (CacheValueCodec<Value>::supported) {
+        if (!compression_enabled_.load(std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+
+        QByteArray raw = CacheValueCodec<Value>::encode(value);
+        if (static_cast<size_t>(raw.size()) <
+            compression_threshold_.load(std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+
+        PackedValue packed;
+        packed.bytes = qCompress(raw);
+        packed.raw_size = static_cast<size_t>(raw.size());
+
+        // Keep incompressible data as is
+        if (static_cast<size_t>(packed.bytes.size()) >= packed.raw_size) {
+            return std::nullopt;
+        }
+        return packed;
+    } else {
+        return std::nullopt;
+    }
+}
+
+template <typename Key, typename Value>
+Value LRUCache<Key, Value>::unpackValue(Shard& shard,
+                                        const QByteArray& packed) const {
+    if constexpr (CacheValueCodec<Value>::supported) {
+        const auto start = std::chrono::steady_clock::now();
+        Value value = CacheValueCodec<Value>::decode(qUncompress(packed));
+        const auto elapsed =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start);
+
+        shard.statistics.decompressions.fetch_add(1);
+        shard.statistics.decompress_time_ns.fetch_add(
+            static_cast<size_t>(elapsed.count()));
+        return value;
+    } else {
+        return Value();
+    }
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::releasePayload(Shard& shard, uint32_t slot) {
+    Slot& s = shard.slab[slot];
+    if (!s.compressed)
+        return;
+
+    if (s.hot_pos != kNil) {
+        demoteHot(shard, slot);
+    }
+
+    shard.statistics.compressed_entries.fetch_sub(1);
+    shard.statistics.uncompressed_bytes.fetch_sub(s.raw_size);
+    shard.statistics.compressed_bytes.fetch_sub(s.packed.size());
+    s.packed = QByteArray();
+    s.raw_size = 0;
+    s.compressed = false;
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::promoteHot(Shard& shard, uint32_t slot,
+                                      const Value& value) {
+    if (shard.hot_ring.empty())
+        return;
+
+    // The hot tier is a small FIFO ring; the oldest promotion makes room
+    const size_t pos = shard.hot_cursor;
+    shard.hot_cursor = (shard.hot_cursor + 1) % shard.hot_ring.size();
+    if (shard.hot_ring[pos] != kNil) {
+        demoteHot(shard, shard.hot_ring[pos]);
+    }
+
+    Slot& s = shard.slab[slot];
+    const size_t hot_size = calculateMemorySize(value);
+    s.entry.data = value;
+    s.entry.memory_size.fetch_add(hot_size);
+    s.hot_pos = static_cast<uint32_t>(pos);
+    shard.hot_ring[pos] = slot;
+    shard.statistics.total_memory_usage.fetch_add(hot_size);
+
+    evictIfNeeded(shard);
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::demoteHot(Shard& shard, uint32_t slot) {
+    Slot& s = shard.slab[slot];
+    const size_t hot_size = calculateMemorySize(s.entry.data);
+    s.entry.data = Value();
+    s.entry.memory_size.fetch_sub(hot_size);
+    shard.statistics.total_memory_usage.fetch_sub(hot_size);
+
+    shard.hot_ring[s.hot_pos] = kNil;
+    s.hot_pos = kNil;
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::eraseSlot(Shard& shard, uint32_t slot) {
+    releasePayload(shard, slot);
+
+    Slot& s = shard.slab[slot];
+    shard.statistics.total_memory_usage.fetch_sub(s.entry.memory_size.load());
+
+    indexErase(shard, s.hash, slot);
+    unlink(shard, slot);
+    cancelExpiry(shard, slot);
+    --shard.live;
+    if (shard.admission_candidate == slot) {
+        shard.admission_candidate = kNil;
+    }
+
+    // Drop the payload now (e.g. widget references) but keep the slot
+    s.key = Key();
+    s.entry.data = Value();
+    s.occupied = false;
+    s.next = shard.free_head;
+    shard.free_head = slot;
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::evictIfNeeded(Shard& shard) {
+    // A lone entry may exceed the shard's share, up to the whole limit
+    while (shard.live > shard.max_size ||
+           (shard.live > 1 && shard.statistics.total_memory_usage.load() >
+                                  shard.max_memory_bytes)) {
+        evictOne(shard);
+    }
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::evictOne(Shard& shard) {
+    const size_t size_before = shard.live;
+
+    switch (eviction_policy_.load()) {
+        case EvictionPolicy::LFU:
+            evictLFU(shard);
+            break;
+        case EvictionPolicy::TTL:
+            evictExpired(shard);
+            break;
+        case EvictionPolicy::FIFO:
+            // Hits never reorder, so the tail is the oldest insertion
+            evictLRU(shard);
+            break;
+        case EvictionPolicy::WTinyLFU:
+            evictTinyLFU(shard);
+            break;
+        default:
+            if (usesClockRecency()) {
+                evictClock(shard);
+            } else {
+                evictLRU(shard);
+            }
+            break;
+    }
+
+    // TTL eviction may find nothing expired; fall back to recency
+    if (shard.live == size_before) {
+        evictLRU(shard);
+    }
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::evictLRU(Shard& shard) {
+    // Only WTinyLFU populates the window/protected lists; fall back to them
+    // once the main list is empty
+    for (Segment segment : {kMain, kWindow, kProtected}) {
+        const uint32_t tail = shard.lists[segment].tail;
+        if (tail != kNil) {
+            eraseSlot(shard, tail);
+            shard.statistics.evictions.fetch_add(1);
+            return;
         }
+    }
+}
 
-        if (cache_.empty())
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::evictClock(Shard& shard) {
+    // Second-chance sweep from the cold end: referenced entries get their bit
+    // cleared and move to the hot end, the first unreferenced one is evicted.
+    // After one full pass every bit is clear, so this always terminates.
+    RecencyList& main = shard.lists[kMain];
+    for (size_t scanned = 0; scanned <= main.size && main.tail != kNil;
+         ++scanned) {
+        const uint32_t tail = main.tail;
+        if (!shard.slab[tail].entry.referenced.exchange(
+                false, std::memory_order_relaxed)) {
             break;
+        }
+        unlink(shard, tail);
+        linkFront(shard, tail);
     }
+
+    evictLRU(shard);
 }
 
 template <typename Key, typename Value>
-void LRUCache<Key, Value>::evictLRU() {
-    if (access_order_.empty())
+void LRUCache<Key, Value>::evictTinyLFU(Shard& shard) {
+    RecencyList& window = shard.lists[kWindow];
+    RecencyList& probation = shard.lists[kMain];
+
+    // The newest window emigrant is the candidate that must earn its place
+    // against the probation victim
+    uint32_t candidate = shard.admission_candidate;
+    shard.admission_candidate = kNil;
+    if (candidate != kNil && shard.slab[candidate].segment != kMain) {
+        candidate = kNil;  // Promoted by a hit since it left the window
+    }
+    while (window.size > shard.window_capacity) {
+        candidate = window.tail;
+        moveToSegment(shard, candidate, kMain);
+    }
+
+    // Sharded mode records hits only as reference bits; promote referenced
+    // probation entries lazily before picking a victim
+    if (usesClockRecency()) {
+        for (size_t remaining = probation.size; remaining > 0; --remaining) {
+            const uint32_t tail = probation.tail;
+            if (tail == candidate ||
+                !shard.slab[tail].entry.referenced.exchange(
+                    false, std::memory_order_relaxed)) {
+                break;
+            }
+            promoteToProtected(shard, tail);
+        }
+    }
+
+    const uint32_t victim = probation.tail;
+    if (victim == kNil) {
+        evictLRU(shard);
         return;
+    }
+
+    uint32_t loser = victim;
+    if (candidate != kNil && candidate != victim) {
+        const unsigned candidate_frequency =
+            shard.sketch.frequency(shard.slab[candidate].hash);
+        const unsigned victim_frequency =
+            shard.sketch.frequency(shard.slab[victim].hash);
+        loser = candidate_frequency > victim_frequency ? victim : candidate;
+    }
+
+    eraseSlot(shard, loser);
+    shard.statistics.evictions.fetch_add(1);
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::recordTinyLfuHit(Shard& shard, uint32_t slot) {
+    if (shard.slab[slot].segment == kMain) {
+        promoteToProtected(shard, slot);
+    } else {
+        updateAccessOrder(shard, slot);
+    }
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::promoteToProtected(Shard& shard, uint32_t slot) {
+    moveToSegment(shard, slot, kProtected);
 
-    Key key_to_evict = access_order_.back();
-    access_order_.pop_back();
+    RecencyList& protected_list = shard.lists[kProtected];
+    while (protected_list.size > shard.protected_capacity) {
+        moveToSegment(shard, protected_list.tail, kMain);
+    }
+}
 
-    auto it = cache_.find(key_to_evict);
-    if (it != cache_.end()) {
-        statistics_.total_memory_usage.fetch_sub(
-            it->second->memory_size.load());
-        statistics_.evictions.fetch_add(1);
-        cache_.erase(it);
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::mergeSegments(Shard& shard) {
+    // Keep relative recency: protected, then window, then probation entries
+    shard.admission_candidate = kNil;
+    for (Segment segment : {kWindow, kProtected}) {
+        while (shard.lists[segment].tail != kNil) {
+            moveToSegment(shard, shard.lists[segment].tail, kMain);
+        }
     }
+}
 
-    access_iterators_.erase(key_to_evict);
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::recordHitLocked(Shard& shard, uint32_t slot) {
+    switch (eviction_policy_.load()) {
+        case EvictionPolicy::FIFO:
+            break;
+        case EvictionPolicy::WTinyLFU:
+            recordTinyLfuHit(shard, slot);
+            break;
+        default:
+            updateAccessOrder(shard, slot);
+            break;
+    }
 }
 
 template <typename Key, typename Value>
-void LRUCache<Key, Value>::updateAccessOrder(const Key& key) {
-    auto access_it = access_iterators_.find(key);
-    if (access_it != access_iterators_.end()) {
-        access_order_.erase(access_it->second);
+void LRUCache<Key, Value>::recordFrequency(Shard& shard, size_t hash) {
+    if (eviction_policy_.load(std::memory_order_relaxed) ==
+        EvictionPolicy::WTinyLFU) {
+        shard.sketch.increment(hash);
     }
+}
+
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::updateAccessOrder(Shard& shard, uint32_t slot) {
+    if (shard.lists[shard.slab[slot].segment].head == slot)
+        return;
 
-    access_order_.push_front(key);
-    access_iterators_[key] = access_order_.begin();
+    unlink(shard, slot);
+    linkFront(shard, slot);
 }
 
 template <typename Key, typename Value>
 size_t LRUCache<Key, Value>::calculateMemorySize(const Value& value) const {
-    // Simplified memory calculation - in practice, this would be more
-    // sophisticated
-    return sizeof(Value) + 64;  // Base overhead estimate
+    return CacheSizeEstimator<Value>::estimate(value);
+}
+
+template <typename Key, typename Value>
+size_t LRUCache<Key, Value>::entryCharge(
+    const Key& key, const Value& value,
+    const std::optional<PackedValue>& packed) const {
+    // Compressed entries hold the payload next to an empty value
+    const size_t value_bytes =
+        packed ? calculateMemorySize(Value()) +
+                     CacheSizeEstimator<QByteArray>::estimate(packed->bytes)
+               : calculateMemorySize(value);
+    return CacheSizeEstimator<Key>::estimate(key) + value_bytes;
 }
 
 // **CacheManager implementation**
@@ -227,18 +1431,23 @@ CacheManager::CacheManager(QObject* parent) : QObject(parent) {
     memory_monitor_timer_->start();
 }
 
-CacheManager::~CacheManager() = default;
+CacheManager::~CacheManager() {
+    // Refresh tasks capture this; let them finish before members go away
+    waitForRefreshes();
+    std::lock_guard<std::mutex> lock(refresh_mutex_);
+    refresh_processor_.reset();
+}
 
 void CacheManager::initializeDefaultCaches() {
     widget_cache_ =
-        std::make_unique<WidgetCache>(1000, 50);  // 50MB for widgets
+        std::make_shared<WidgetCache>(1000, 50);  // 50MB for widgets
     stylesheet_cache_ =
-        std::make_unique<StylesheetCache>(500, 10);  // 10MB for stylesheets
+        std::make_shared<StylesheetCache>(500, 10);  // 10MB for stylesheets
     property_cache_ =
-        std::make_unique<PropertyCache>(2000, 5);  // 5MB for properties
+        std::make_shared<PropertyCache>(2000, 5);  // 5MB for properties
     file_content_cache_ =
-        std::make_unique<FileContentCache>(200, 20);      // 20MB for files
-    json_cache_ = std::make_unique<JSONCache>(1000, 15);  // 15MB for JSON
+        std::make_shared<FileContentCache>(200, 20);      // 20MB for files
+    json_cache_ = std::make_shared<JSONCache>(1000, 15);  // 15MB for JSON
 
     // Enable all default caches
     enabled_caches_.insert("widgets");
@@ -265,100 +1474,531 @@ std::shared_ptr<QWidget> CacheManager::getCachedWidget(const QString& key) {
             emit cacheHit("widgets", key);
             return result.value();
         } else {
-            emit cacheMiss("widgets", key);
+            emit cacheMiss("widgets", key);
+        }
+    }
+    return nullptr;
+}
+
+void CacheManager::cacheStylesheet(const QString& key,
+                                   const QString& stylesheet) {
+    if (enabled_caches_.count("stylesheets") && stylesheet_cache_) {
+        bool success = stylesheet_cache_->put(key, stylesheet);
+        if (success) {
+            emit cacheHit("stylesheets", key);
+        }
+    }
+}
+
+QString CacheManager::getCachedStylesheet(const QString& key) {
+    if (enabled_caches_.count("stylesheets") && stylesheet_cache_) {
+        auto result = stylesheet_cache_->get(key);
+        if (result.has_value()) {
+            emit cacheHit("stylesheets", key);
+            return result.value();
+        } else {
+            emit cacheMiss("stylesheets", key);
+        }
+    }
+    return QString();
+}
+
+void CacheManager::cacheProperty(const QString& key, const QVariant& value) {
+    if (enabled_caches_.count("properties") && property_cache_) {
+        bool success = property_cache_->put(key, value);
+        if (success) {
+            emit cacheHit("properties", key);
+        }
+    }
+}
+
+QVariant CacheManager::getCachedProperty(const QString& key) {
+    if (enabled_caches_.count("properties") && property_cache_) {
+        auto result = property_cache_->get(key);
+        if (result.has_value()) {
+            emit cacheHit("properties", key);
+            return result.value();
+        } else {
+            emit cacheMiss("properties", key);
+        }
+    }
+    return QVariant();
+}
+
+void CacheManager::cacheFileContent(const QString& file_path,
+                                    const QByteArray& content) {
+    if (enabled_caches_.count("files") && file_content_cache_) {
+        bool success = file_content_cache_->put(file_path, content);
+        if (success) {
+            if (refresh_ahead_enabled_.load()) {
+                // Remember the file's identity so changes trigger a refresh
+                const QFileInfo info(file_path);
+                std::lock_guard<std::mutex> lock(refresh_mutex_);
+                if (info.exists()) {
+                    file_content_stamps_[file_path] = fileMetadataStamp(info);
+                } else {
+                    file_content_stamps_.erase(file_path);
+                }
+            }
+            emit cacheHit("files", file_path);
+        }
+    }
+}
+
+QByteArray CacheManager::getCachedFileContent(const QString& file_path) {
+    if (enabled_caches_.count("files") && file_content_cache_) {
+        auto result = file_content_cache_->get(file_path);
+        if (result.has_value()) {
+            emit cacheHit("files", file_path);
+            if (refresh_ahead_enabled_.load()) {
+                refreshFileContentIfNeeded(file_path);
+            }
+            return result.value();
+        } else {
+            emit cacheMiss("files", file_path);
+        }
+    }
+    return QByteArray();
+}
+
+void CacheManager::cacheJSON(const QString& key, const QJsonObject& json) {
+    if (enabled_caches_.count("json") && json_cache_) {
+        bool success = json_cache_->put(key, json);
+        if (success) {
+            emit cacheHit("json", key);
+        }
+    }
+}
+
+QJsonObject CacheManager::getCachedJSON(const QString& key) {
+    if (enabled_caches_.count("json") && json_cache_) {
+        auto result = json_cache_->get(key);
+        if (result.has_value()) {
+            emit cacheHit("json", key);
+            return result.value();
+        } else {
+            emit cacheMiss("json", key);
+        }
+    }
+    return QJsonObject();
+}
+
+template <typename CacheType>
+typename CacheType::ValueType CacheManager::getOrComputeIn(
+    const QString& cache_name, const std::shared_ptr<CacheType>& cache,
+    const QString& key,
+    const std::function<typename CacheType::ValueType()>& loader) {
+    if (!enabled_caches_.count(cache_name) || !cache) {
+        return loader();
+    }
+
+    bool hit = false;
+    auto value = cache->getOrCompute(key, loader, &hit);
+
+    // Refreshes re-read the file the key names rather than calling loader,
+    // which may capture the caller's locals and is not kept past this call
+    if constexpr (std::is_same_v<CacheType, FileContentCache>) {
+        if (refresh_ahead_enabled_.load()) {
+            if (hit) {
+                refreshFileContentIfNeeded(key);
+            } else {
+                const QFileInfo info(key);
+                std::lock_guard<std::mutex> lock(refresh_mutex_);
+                if (info.exists()) {
+                    file_content_stamps_[key] = fileMetadataStamp(info);
+                }
+            }
+        }
+    } else if constexpr (std::is_same_v<CacheType, JSONCache>) {
+        if (hit && refresh_ahead_enabled_.load()) {
+            const auto expiry = cache->expiryOf(key);
+            if (expiry && inRefreshWindow(*expiry) &&
+                QFileInfo(key).canonicalFilePath() == key) {
+                scheduleRefresh(cache_name, key, *expiry, false,
+                                [this, key]() { return reloadJSONFile(key); });
+            }
+        }
+    }
+
+    if (hit) {
+        emit cacheHit(cache_name, key);
+    } else {
+        emit cacheMiss(cache_name, key);
+    }
+    return value;
+}
+
+std::shared_ptr<QWidget> CacheManager::getOrComputeWidget(
+    const QString& key,
+    const std::function<std::shared_ptr<QWidget>()>& loader) {
+    return getOrComputeIn("widgets", widget_cache_, key, loader);
+}
+
+QString CacheManager::getOrComputeStylesheet(
+    const QString& key, const std::function<QString()>& loader) {
+    return getOrComputeIn("stylesheets", stylesheet_cache_, key, loader);
+}
+
+QVariant CacheManager::getOrComputeProperty(
+    const QString& key, const std::function<QVariant()>& loader) {
+    return getOrComputeIn("properties", property_cache_, key, loader);
+}
+
+QByteArray CacheManager::getOrComputeFileContent(
+    const QString& file_path, const std::function<QByteArray()>& loader) {
+    return getOrComputeIn("files", file_content_cache_, file_path,
+                          loader);
+}
+
+QJsonObject CacheManager::getOrComputeJSON(
+    const QString& key, const std::function<QJsonObject()>& loader) {
+    return getOrComputeIn("json", json_cache_, key, loader);
+}
+
+void CacheManager::cacheJSONFile(const QString& file_path,
+                                 const QByteArray& content,
+                                 const QJsonObject& json) {
+    if (!enabled_caches_.count("json") || !json_cache_) {
+        return;
+    }
+
+    QFileInfo info(file_path);
+    if (!info.exists()) {
+        return;
+    }
+    const QString key = info.canonicalFilePath();
+
+    PersistentCacheStamp stamp = fileMetadataStamp(info);
+    stamp.content_hash = PersistentCacheStore::hashContent(content);
+
+    json_cache_->put(key, json);
+
+    std::lock_guard<std::mutex> lock(json_store_mutex_);
+    json_file_stamps_[key] = stamp;
+    if (json_store_) {
+        json_store_->put(key, stamp,
+                         CacheValueCodec<QJsonObject>::encode(json));
+    }
+}
+
+std::optional<QJsonObject> CacheManager::getCachedJSONFile(
+    const QString& file_path) {
+    if (!enabled_caches_.count("json") || !json_cache_) {
+        return std::nullopt;
+    }
+
+    QFileInfo info(file_path);
+    if (!info.exists()) {
+        return std::nullopt;
+    }
+    const QString key = info.canonicalFilePath();
+    const PersistentCacheStamp current = fileMetadataStamp(info);
+
+    const bool refresh_ahead = refresh_ahead_enabled_.load();
+    auto reload = [this, key]() { return reloadJSONFile(key); };
+
+    std::unique_lock<std::mutex> lock(json_store_mutex_);
+    auto stamp_it = json_file_stamps_.find(key);
+    if (stamp_it != json_file_stamps_.end()) {
+        if (sameFileMetadata(stamp_it->second, current)) {
+            auto result = json_cache_->get(key);
+            if (result.has_value()) {
+                lock.unlock();
+                emit cacheHit("json", key);
+                if (refresh_ahead) {
+                    const auto expiry = json_cache_->expiryOf(key);
+                    if (expiry && inRefreshWindow(*expiry)) {
+                        scheduleRefresh("json", key, *expiry, false, reload);
+                    }
+                }
+                return result;
+            }
+        } else if (const auto expiry = json_cache_->expiryOf(key);
+                   refresh_ahead && expiry) {
+            // Keep serving the old parse while the pool re-parses the file
+            auto result = json_cache_->get(key);
+            if (result.has_value()) {
+                lock.unlock();
+                stale_reads_.fetch_add(1);
+                emit cacheHit("json", key);
+                scheduleRefresh("json", key, *expiry, true, reload);
+                return result;
+            }
+        } else {
+            // The file changed since it was cached
+            json_file_stamps_.erase(stamp_it);
+            json_cache_->remove(key);
+            if (json_store_) {
+                json_store_->remove(key);
+            }
         }
     }
-    return nullptr;
-}
 
-void CacheManager::cacheStylesheet(const QString& key,
-                                   const QString& stylesheet) {
-    if (enabled_caches_.count("stylesheets") && stylesheet_cache_) {
-        bool success = stylesheet_cache_->put(key, stylesheet);
-        if (success) {
-            emit cacheHit("stylesheets", key);
+    // Evicted from memory or never loaded: fall back to the disk tier
+    if (json_store_) {
+        auto stored = json_store_->stamp(key);
+        if (stored && sameFileMetadata(*stored, current)) {
+            auto payload = json_store_->payload(key);
+            if (payload) {
+                QJsonObject json =
+                    CacheValueCodec<QJsonObject>::decode(*payload);
+                json_cache_->put(key, json);
+                json_file_stamps_[key] = *stored;
+                ++json_disk_hits_;
+                lock.unlock();
+                emit cacheHit("json", key);
+                return json;
+            }
+        } else if (stored) {
+            json_store_->remove(key);
         }
     }
+
+    lock.unlock();
+    emit cacheMiss("json", key);
+    return std::nullopt;
 }
 
-QString CacheManager::getCachedStylesheet(const QString& key) {
-    if (enabled_caches_.count("stylesheets") && stylesheet_cache_) {
-        auto result = stylesheet_cache_->get(key);
-        if (result.has_value()) {
-            emit cacheHit("stylesheets", key);
-            return result.value();
-        } else {
-            emit cacheMiss("stylesheets", key);
-        }
+bool CacheManager::enablePersistentJSONCache(const QString& store_path,
+                                             size_t max_size_mb,
+                                             bool verify_content) {
+    auto store = std::make_unique<PersistentCacheStore>(
+        store_path, max_size_mb * 1024 * 1024);
+    if (!store->open()) {
+        return false;
     }
-    return QString();
+
+    {
+        std::lock_guard<std::mutex> lock(json_store_mutex_);
+        json_store_ = std::move(store);
+        json_disk_hits_ = 0;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const size_t warmed = warmJSONCacheFromStore(verify_content);
+
+    qDebug() << "🔧 Persistent JSON cache" << store_path << "warmed" << warmed
+             << "entries in" << timer.elapsed() << "ms";
+    return true;
 }
 
-void CacheManager::cacheProperty(const QString& key, const QVariant& value) {
-    if (enabled_caches_.count("properties") && property_cache_) {
-        bool success = property_cache_->put(key, value);
-        if (success) {
-            emit cacheHit("properties", key);
+size_t CacheManager::warmJSONCacheFromStore(bool verify_content) {
+    std::lock_guard<std::mutex> lock(json_store_mutex_);
+    if (!json_store_ || !json_cache_) {
+        return 0;
+    }
+
+    size_t warmed = 0;
+    std::vector<QString> stale;
+
+    json_store_->forEach([&](const PersistentCacheStore::RecordView& record) {
+        QFileInfo info(record.key);
+        if (!info.exists() ||
+            !sameFileMetadata(record.stamp, fileMetadataStamp(info))) {
+            stale.push_back(record.key);
+            return;
+        }
+
+        if (verify_content) {
+            QFile file(record.key);
+            if (!file.open(QIODevice::ReadOnly) ||
+                PersistentCacheStore::hashContent(file.readAll()) !=
+                    record.stamp.content_hash) {
+                stale.push_back(record.key);
+                return;
+            }
         }
+
+        json_cache_->put(record.key,
+                         CacheValueCodec<QJsonObject>::decode(record.payload));
+        json_file_stamps_[record.key] = record.stamp;
+        ++warmed;
+    });
+
+    for (const QString& key : stale) {
+        json_store_->remove(key);
     }
+
+    warmed_json_entries_ = warmed;
+    return warmed;
 }
 
-QVariant CacheManager::getCachedProperty(const QString& key) {
-    if (enabled_caches_.count("properties") && property_cache_) {
-        auto result = property_cache_->get(key);
-        if (result.has_value()) {
-            emit cacheHit("properties", key);
-            return result.value();
-        } else {
-            emit cacheMiss("properties", key);
+void CacheManager::disablePersistentJSONCache() {
+    std::lock_guard<std::mutex> lock(json_store_mutex_);
+    json_store_.reset();
+}
+
+void CacheManager::enableRefreshAhead(bool enabled,
+                                      std::chrono::milliseconds ttl,
+                                      double refresh_fraction) {
+    if (!enabled) {
+        refresh_ahead_enabled_.store(false);
+        waitForRefreshes();
+        if (file_content_cache_)
+            file_content_cache_->setTTL(std::chrono::milliseconds(0));
+        if (json_cache_)
+            json_cache_->setTTL(std::chrono::milliseconds(0));
+        qDebug() << "🔧 Cache refresh-ahead disabled";
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(refresh_mutex_);
+        if (!refresh_processor_) {
+            refresh_processor_ = std::make_unique<ParallelProcessor>();
         }
     }
-    return QVariant();
+
+    const double fraction = std::clamp(refresh_fraction, 0.0, 1.0);
+    refresh_window_ms_.store(std::max<int64_t>(
+        1, static_cast<int64_t>(static_cast<double>(ttl.count()) * fraction)));
+    if (file_content_cache_)
+        file_content_cache_->setTTL(ttl);
+    if (json_cache_)
+        json_cache_->setTTL(ttl);
+    refresh_ahead_enabled_.store(true);
+
+    qDebug() << "🔧 Cache refresh-ahead enabled, ttl" << ttl.count()
+             << "ms, window" << refresh_window_ms_.load() << "ms";
 }
 
-void CacheManager::cacheFileContent(const QString& file_path,
-                                    const QByteArray& content) {
-    if (enabled_caches_.count("files") && file_content_cache_) {
-        bool success = file_content_cache_->put(file_path, content);
-        if (success) {
-            emit cacheHit("files", file_path);
-        }
+void CacheManager::waitForRefreshes() {
+    std::unique_lock<std::mutex> lock(refresh_mutex_);
+    refresh_done_.wait(lock, [this]() { return refreshes_in_flight_ == 0; });
+}
+
+bool CacheManager::inRefreshWindow(
+    std::chrono::steady_clock::time_point expiry) const {
+    if (expiry == std::chrono::steady_clock::time_point::max()) {
+        return false;
     }
+    const std::chrono::milliseconds window(refresh_window_ms_.load());
+    return std::chrono::steady_clock::now() + window >= expiry;
 }
 
-QByteArray CacheManager::getCachedFileContent(const QString& file_path) {
-    if (enabled_caches_.count("files") && file_content_cache_) {
-        auto result = file_content_cache_->get(file_path);
-        if (result.has_value()) {
-            emit cacheHit("files", file_path);
-            return result.value();
-        } else {
-            emit cacheMiss("files", file_path);
-        }
+void CacheManager::scheduleRefresh(const QString& cache_name,
+                                   const QString& key,
+                                   std::chrono::steady_clock::time_point expiry,
+                                   bool stale, std::function<bool()> reload) {
+    const QString pending_key = cache_name + ':' + key;
+
+    std::lock_guard<std::mutex> lock(refresh_mutex_);
+    if (!refresh_processor_ || !refreshes_pending_.insert(pending_key).second) {
+        return;
     }
-    return QByteArray();
+    ++refreshes_in_flight_;
+    refreshes_scheduled_.fetch_add(1);
+
+    refresh_processor_->submitBackgroundTask(
+        QString(), [this, pending_key, expiry, stale,
+                    reload = std::move(reload)]() {
+            bool reloaded = false;
+            try {
+                reloaded = reload();
+            } catch (...) {
+                // Counted below; the old entry stays until it expires
+            }
+
+            if (!reloaded) {
+                refresh_failures_.fetch_add(1);
+            } else if (stale) {
+                refreshes_served_stale_.fetch_add(1);
+            } else if (std::chrono::steady_clock::now() <= expiry) {
+                refreshed_in_time_.fetch_add(1);
+            } else {
+                refreshed_late_.fetch_add(1);
+            }
+
+            {
+                std::lock_guard<std::mutex> done_lock(refresh_mutex_);
+                refreshes_pending_.erase(pending_key);
+                --refreshes_in_flight_;
+            }
+            refresh_done_.notify_all();
+        });
 }
 
-void CacheManager::cacheJSON(const QString& key, const QJsonObject& json) {
-    if (enabled_caches_.count("json") && json_cache_) {
-        bool success = json_cache_->put(key, json);
-        if (success) {
-            emit cacheHit("json", key);
+void CacheManager::refreshFileContentIfNeeded(const QString& file_path) {
+    std::optional<PersistentCacheStamp> recorded;
+    {
+        std::lock_guard<std::mutex> lock(refresh_mutex_);
+        auto it = file_content_stamps_.find(file_path);
+        if (it != file_content_stamps_.end()) {
+            recorded = it->second;
         }
     }
+
+    const auto expiry = file_content_cache_->expiryOf(file_path);
+    if (!expiry) {
+        return;
+    }
+
+    const bool stale =
+        recorded &&
+        !sameFileMetadata(*recorded, fileMetadataStamp(QFileInfo(file_path)));
+    if (stale) {
+        stale_reads_.fetch_add(1);
+    }
+    if (stale || inRefreshWindow(*expiry)) {
+        scheduleRefresh("files", file_path, *expiry, stale,
+                        [this, file_path]() {
+                            return reloadFileContent(file_path);
+                        });
+    }
 }
 
-QJsonObject CacheManager::getCachedJSON(const QString& key) {
-    if (enabled_caches_.count("json") && json_cache_) {
-        auto result = json_cache_->get(key);
-        if (result.has_value()) {
-            emit cacheHit("json", key);
-            return result.value();
-        } else {
-            emit cacheMiss("json", key);
+bool CacheManager::reloadFileContent(const QString& file_path) {
+    // Stamp before reading: a change racing with the read is seen next time
+    const PersistentCacheStamp stamp = fileMetadataStamp(QFileInfo(file_path));
+
+    QFile file(file_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        file_content_cache_->remove(file_path);
+        std::lock_guard<std::mutex> lock(refresh_mutex_);
+        file_content_stamps_.erase(file_path);
+        return false;
+    }
+    const QByteArray content = file.readAll();
+
+    file_content_cache_->put(file_path, content);
+    std::lock_guard<std::mutex> lock(refresh_mutex_);
+    file_content_stamps_[file_path] = stamp;
+    return true;
+}
+
+bool CacheManager::reloadJSONFile(const QString& file_path) {
+    QFile file(file_path);
+    QJsonParseError error;
+    QJsonDocument document;
+    if (file.open(QIODevice::ReadOnly)) {
+        const QByteArray content = file.readAll();
+        document = QJsonDocument::fromJson(content, &error);
+        if (error.error == QJsonParseError::NoError && document.isObject()) {
+            cacheJSONFile(file_path, content, document.object());
+            return true;
         }
     }
-    return QJsonObject();
+
+    // Missing or unparsable: drop the entry so the next reader goes through
+    // the regular parser and sees the error
+    json_cache_->remove(file_path);
+    std::lock_guard<std::mutex> lock(json_store_mutex_);
+    json_file_stamps_.erase(file_path);
+    if (json_store_) {
+        json_store_->remove(file_path);
+    }
+    return false;
+}
+
+bool CacheManager::isPersistentJSONCacheEnabled() const {
+    std::lock_guard<std::mutex> lock(json_store_mutex_);
+    return json_store_ != nullptr;
+}
+
+bool CacheManager::compactPersistentJSONCache() {
+    std::lock_guard<std::mutex> lock(json_store_mutex_);
+    return json_store_ && json_store_->compact();
 }
 
 void CacheManager::invalidateAll() {
@@ -425,27 +2065,77 @@ size_t CacheManager::calculateTotalMemoryUsage() const {
 }
 
 void CacheManager::evictFromLargestCache() {
-    // Find the cache using the most memory and evict from it
-    size_t max_memory = 0;
-    std::string largest_cache;
-
-    if (widget_cache_ && widget_cache_->memoryUsage() > max_memory) {
-        max_memory = widget_cache_->memoryUsage();
-        largest_cache = "widgets";
+    // Trim the cache holding the most memory by the overshoot, largest first,
+    // so one bulky cache does not force evictions everywhere. A few rounds
+    // cover caches whose storage cannot shrink below their share.
+    const size_t limit = global_memory_limit_bytes_.load();
+    for (int round = 0; round < 5; ++round) {
+        const size_t total = calculateTotalMemoryUsage();
+        if (total <= limit)
+            return;
+
+        size_t max_memory = 0;
+        QString largest_cache;
+        std::function<size_t(size_t)> trim_largest;
+        auto consider = [&](const QString& name, auto* cache) {
+            if (cache && cache->memoryUsage() > max_memory) {
+                max_memory = cache->memoryUsage();
+                largest_cache = name;
+                trim_largest = [cache](size_t target) {
+                    return cache->trimMemory(target);
+                };
+            }
+        };
+        consider("widgets", widget_cache_.get());
+        consider("stylesheets", stylesheet_cache_.get());
+        consider("properties", property_cache_.get());
+        consider("files", file_content_cache_.get());
+        consider("json", json_cache_.get());
+
+        if (!trim_largest)
+            return;
+
+        const size_t excess = total - limit;
+        const size_t evicted =
+            trim_largest(max_memory > excess ? max_memory - excess : 0);
+        qDebug() << "🔧 Evicted" << evicted << "entries from" << largest_cache
+                 << "to relieve memory pressure";
+        if (evicted == 0)
+            return;
     }
+}
 
-    if (file_content_cache_ &&
-        file_content_cache_->memoryUsage() > max_memory) {
-        max_memory = file_content_cache_->memoryUsage();
-        largest_cache = "files";
-    }
+void CacheManager::beginMemoryValidation() {
+    std::unique_lock<std::shared_mutex> lock(global_mutex_);
+    validation_tracked_baseline_ = calculateTotalMemoryUsage();
+    validation_allocator_baseline_ = allocatorBytesInUse();
+    memory_validation_active_ = true;
+}
 
-    // Evict from the largest cache
-    if (largest_cache == "widgets" && widget_cache_) {
-        widget_cache_->cleanup();
-    } else if (largest_cache == "files" && file_content_cache_) {
-        file_content_cache_->cleanup();
+QJsonObject CacheManager::memoryValidationReport() const {
+    std::shared_lock<std::shared_mutex> lock(global_mutex_);
+
+    QJsonObject report;
+    report["active"] = memory_validation_active_;
+    report["supported"] = validation_allocator_baseline_.has_value();
+    if (!memory_validation_active_)
+        return report;
+
+    const auto tracked = static_cast<qint64>(calculateTotalMemoryUsage()) -
+                         static_cast<qint64>(validation_tracked_baseline_);
+    report["tracked_delta"] = tracked;
+
+    const auto allocator_now = allocatorBytesInUse();
+    if (validation_allocator_baseline_ && allocator_now) {
+        const auto allocated = static_cast<qint64>(*allocator_now) -
+                               static_cast<qint64>(
+                                   *validation_allocator_baseline_);
+        report["allocator_delta"] = allocated;
+        // 1.0 means the estimators match the allocator exactly
+        report["accuracy"] =
+            allocated > 0 ? static_cast<double>(tracked) / allocated : 0.0;
     }
+    return report;
 }
 
 QJsonObject CacheManager::getCacheStatistics() const {
@@ -456,57 +2146,92 @@ QJsonObject CacheManager::getCacheStatistics() const {
         static_cast<qint64>(calculateTotalMemoryUsage());
     stats["global_memory_limit"] =
         static_cast<qint64>(global_memory_limit_bytes_.load());
+    const QJsonObject validation = memoryValidationReport();
+    if (validation["active"].toBool()) {
+        stats["memory_validation"] = validation;
+    }
 
     // Individual cache statistics
     QJsonObject cache_stats;
 
     if (widget_cache_) {
-        QJsonObject widget_stats;
-        widget_stats["size"] = static_cast<qint64>(widget_cache_->size());
-        widget_stats["memory_usage"] =
-            static_cast<qint64>(widget_cache_->memoryUsage());
-        cache_stats["widget_cache"] = widget_stats;
+        cache_stats["widget_cache"] = cacheStatisticsToJson(widget_cache_);
     }
 
     if (stylesheet_cache_) {
-        QJsonObject stylesheet_stats;
-        stylesheet_stats["size"] =
-            static_cast<qint64>(stylesheet_cache_->size());
-        stylesheet_stats["memory_usage"] =
-            static_cast<qint64>(stylesheet_cache_->memoryUsage());
-        cache_stats["stylesheet_cache"] = stylesheet_stats;
+        cache_stats["stylesheet_cache"] =
+            cacheStatisticsToJson(stylesheet_cache_);
     }
 
     if (property_cache_) {
-        QJsonObject property_stats;
-        property_stats["size"] = static_cast<qint64>(property_cache_->size());
-        property_stats["memory_usage"] =
-            static_cast<qint64>(property_cache_->memoryUsage());
-        cache_stats["property_cache"] = property_stats;
+        cache_stats["property_cache"] = cacheStatisticsToJson(property_cache_);
+    }
+
+    if (file_content_cache_) {
+        cache_stats["file_cache"] = cacheStatisticsToJson(file_content_cache_);
+    }
+
+    if (json_cache_) {
+        cache_stats["json_cache"] = cacheStatisticsToJson(json_cache_);
     }
 
     stats["caches"] = cache_stats;
+
+    qint64 coalesced_loads = 0;
+    for (auto it = cache_stats.constBegin(); it != cache_stats.constEnd();
+         ++it) {
+        coalesced_loads += it.value().toObject()["coalesced_loads"].toInteger();
+    }
+    stats["coalesced_loads"] = coalesced_loads;
+
+    std::lock_guard<std::mutex> store_lock(json_store_mutex_);
+    if (json_store_) {
+        const PersistentCacheStatistics disk = json_store_->statistics();
+        QJsonObject persistent;
+        persistent["file_size"] = static_cast<qint64>(disk.file_size);
+        persistent["live_bytes"] = static_cast<qint64>(disk.live_bytes);
+        persistent["live_records"] = static_cast<qint64>(disk.live_records);
+        persistent["compactions"] = static_cast<qint64>(disk.compactions);
+        persistent["dropped_records"] =
+            static_cast<qint64>(disk.dropped_records);
+        persistent["recovered_bytes"] =
+            static_cast<qint64>(disk.recovered_bytes);
+        persistent["warmed_entries"] =
+            static_cast<qint64>(warmed_json_entries_);
+        persistent["disk_hits"] = static_cast<qint64>(json_disk_hits_);
+        stats["persistent_json_cache"] = persistent;
+    }
+
+    if (refresh_ahead_enabled_.load() || refreshes_scheduled_.load() > 0) {
+        QJsonObject refresh;
+        refresh["enabled"] = refresh_ahead_enabled_.load();
+        refresh["scheduled"] = static_cast<qint64>(refreshes_scheduled_.load());
+        refresh["refreshed_in_time"] =
+            static_cast<qint64>(refreshed_in_time_.load());
+        refresh["refreshed_late"] = static_cast<qint64>(refreshed_late_.load());
+        refresh["served_stale"] =
+            static_cast<qint64>(refreshes_served_stale_.load());
+        refresh["stale_reads"] = static_cast<qint64>(stale_reads_.load());
+        refresh["failed"] = static_cast<qint64>(refresh_failures_.load());
+        stats["refresh_ahead"] = refresh;
+    }
     return stats;
 }
 
 QJsonObject CacheManager::getCacheStatistics(const QString& cache_name) const {
-    QJsonObject stats;
-
     if (cache_name == "widgets" && widget_cache_) {
-        stats["size"] = static_cast<qint64>(widget_cache_->size());
-        stats["memory_usage"] =
-            static_cast<qint64>(widget_cache_->memoryUsage());
+        return cacheStatisticsToJson(widget_cache_);
     } else if (cache_name == "stylesheets" && stylesheet_cache_) {
-        stats["size"] = static_cast<qint64>(stylesheet_cache_->size());
-        stats["memory_usage"] =
-            static_cast<qint64>(stylesheet_cache_->memoryUsage());
+        return cacheStatisticsToJson(stylesheet_cache_);
     } else if (cache_name == "properties" && property_cache_) {
-        stats["size"] = static_cast<qint64>(property_cache_->size());
-        stats["memory_usage"] =
-            static_cast<qint64>(property_cache_->memoryUsage());
+        return cacheStatisticsToJson(property_cache_);
+    } else if (cache_name == "files" && file_content_cache_) {
+        return cacheStatisticsToJson(file_content_cache_);
+    } else if (cache_name == "json" && json_cache_) {
+        return cacheStatisticsToJson(json_cache_);
     }
 
-    return stats;
+    return QJsonObject();
 }
 
 void CacheManager::initializeCache(const QString& cache_name, size_t max_size,
@@ -515,22 +2240,22 @@ void CacheManager::initializeCache(const QString& cache_name, size_t max_size,
 
     // For now, we only support the predefined cache types
     if (cache_name == "widgets" && !widget_cache_) {
-        widget_cache_ = std::make_unique<WidgetCache>(max_size, max_memory_mb);
+        widget_cache_ = std::make_shared<WidgetCache>(max_size, max_memory_mb);
         enabled_caches_.insert("widgets");
     } else if (cache_name == "stylesheets" && !stylesheet_cache_) {
         stylesheet_cache_ =
-            std::make_unique<StylesheetCache>(max_size, max_memory_mb);
+            std::make_shared<StylesheetCache>(max_size, max_memory_mb);
         enabled_caches_.insert("stylesheets");
     } else if (cache_name == "properties" && !property_cache_) {
         property_cache_ =
-            std::make_unique<PropertyCache>(max_size, max_memory_mb);
+            std::make_shared<PropertyCache>(max_size, max_memory_mb);
         enabled_caches_.insert("properties");
     } else if (cache_name == "files" && !file_content_cache_) {
         file_content_cache_ =
-            std::make_unique<FileContentCache>(max_size, max_memory_mb);
+            std::make_shared<FileContentCache>(max_size, max_memory_mb);
         enabled_caches_.insert("files");
     } else if (cache_name == "json" && !json_cache_) {
-        json_cache_ = std::make_unique<JSONCache>(max_size, max_memory_mb);
+        json_cache_ = std::make_shared<JSONCache>(max_size, max_memory_mb);
         enabled_caches_.insert("json");
     }
 
@@ -556,6 +2281,23 @@ void CacheManager::setCachePolicy(const QString& cache_name,
     }
 }
 
+void CacheManager::setNegativeCacheTTL(const QString& cache_name,
+                                       std::chrono::milliseconds ttl) {
+    std::shared_lock<std::shared_mutex> lock(global_mutex_);
+
+    if (cache_name == "widgets" && widget_cache_) {
+        widget_cache_->setNegativeCacheTTL(ttl);
+    } else if (cache_name == "stylesheets" && stylesheet_cache_) {
+        stylesheet_cache_->setNegativeCacheTTL(ttl);
+    } else if (cache_name == "properties" && property_cache_) {
+        property_cache_->setNegativeCacheTTL(ttl);
+    } else if (cache_name == "files" && file_content_cache_) {
+        file_content_cache_->setNegativeCacheTTL(ttl);
+    } else if (cache_name == "json" && json_cache_) {
+        json_cache_->setNegativeCacheTTL(ttl);
+    }
+}
+
 void CacheManager::enableCache(const QString& cache_name, bool enabled) {
     std::unique_lock<std::shared_mutex> lock(global_mutex_);
 
@@ -704,10 +2446,47 @@ void CacheManager::setCleanupInterval(int seconds) {
 
 void CacheManager::enableCompressionForCache(const QString& cache_name,
                                              bool enabled) {
-    // Compression is not implemented in this basic version
-    // This is a placeholder for future enhancement
+    std::shared_lock<std::shared_mutex> lock(global_mutex_);
+
+    // Only byte, string and JSON payloads have a codec
+    bool supported = false;
+    if (cache_name == "stylesheets" && stylesheet_cache_) {
+        supported = stylesheet_cache_->enableCompression(enabled);
+    } else if (cache_name == "files" && file_content_cache_) {
+        supported = file_content_cache_->enableCompression(enabled);
+    } else if (cache_name == "json" && json_cache_) {
+        supported = json_cache_->enableCompression(enabled);
+    }
+
+    if (!supported) {
+        qWarning() << "🔥 Compression not supported for cache" << cache_name;
+        return;
+    }
+
     qDebug() << "🔧 Compression for cache" << cache_name
-             << (enabled ? "enabled" : "disabled") << "(not implemented)";
+             << (enabled ? "enabled" : "disabled");
+}
+
+void CacheManager::setCacheShardCount(const QString& cache_name,
+                                      size_t shard_count) {
+    // File and UI file reloads write through the members being replaced
+    waitForRefreshes();
+    std::unique_lock<std::shared_mutex> lock(global_mutex_);
+
+    if (cache_name == "widgets") {
+        rebuildWithShards(widget_cache_, shard_count);
+    } else if (cache_name == "stylesheets") {
+        rebuildWithShards(stylesheet_cache_, shard_count);
+    } else if (cache_name == "properties") {
+        rebuildWithShards(property_cache_, shard_count);
+    } else if (cache_name == "files") {
+        rebuildWithShards(file_content_cache_, shard_count);
+    } else if (cache_name == "json") {
+        rebuildWithShards(json_cache_, shard_count);
+    }
+
+    qDebug() << "🔧 Cache" << cache_name << "sharded into" << shard_count
+             << "shards";
 }
 
 void CacheManager::setGlobalMemoryLimit(size_t limit_mb) {
@@ -718,58 +2497,76 @@ void CacheManager::setGlobalMemoryLimit(size_t limit_mb) {
 // **Additional LRUCache method implementations**
 template <typename Key, typename Value>
 void LRUCache<Key, Value>::setEvictionPolicy(EvictionPolicy policy) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    eviction_policy_ = policy;
+    // Hold every shard lock so no insert lands in a segment that is about to
+    // be merged, and the sketch exists before WTinyLFU is observable
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    locks.reserve(shards_.size());
+    for (auto& shard : shards_) {
+        locks.emplace_back(shard->mutex);
+    }
+
+    const EvictionPolicy previous = eviction_policy_.load();
+    for (auto& shard : shards_) {
+        if (policy == EvictionPolicy::WTinyLFU) {
+            shard->sketch.ensureCapacity(shard->max_size);
+        } else if (previous == EvictionPolicy::WTinyLFU) {
+            mergeSegments(*shard);
+        }
+    }
+
+    eviction_policy_.store(policy);
 }
 
 template <typename Key, typename Value>
 void LRUCache<Key, Value>::setTTL(std::chrono::milliseconds ttl) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    default_ttl_ = ttl;
+    default_ttl_ms_.store(ttl.count());
 }
 
 template <typename Key, typename Value>
 void LRUCache<Key, Value>::enableAutoCleanup(bool enabled) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    auto_cleanup_enabled_ = enabled;
+    auto_cleanup_enabled_.store(enabled);
 }
 
 template <typename Key, typename Value>
 void LRUCache<Key, Value>::putBatch(
     const std::unordered_map<Key, Value>& items) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-
+    // Group items by shard so each shard lock is taken once
+    struct PendingItem {
+        const Key* key;
+        const Value* value;
+        size_t hash;
+        std::optional<PackedValue> packed;
+        size_t charge;
+    };
+    std::vector<std::vector<PendingItem>> per_shard(shards_.size());
+    const bool forget_failures = negative_ttl_ms_.load() > 0;
     for (const auto& pair : items) {
-        QDateTime expires_at;
-        if (default_ttl_.count() > 0) {
-            expires_at =
-                QDateTime::currentDateTime().addMSecs(default_ttl_.count());
+        const size_t hash = hashKey(pair.first);
+        if (forget_failures) {
+            forgetNegative(*shards_[shardIndex(hash)], pair.first);
         }
+        auto packed = packValue(pair.second);
+        const size_t charge = entryCharge(pair.first, pair.second, packed);
+        per_shard[shardIndex(hash)].push_back(PendingItem{
+            &pair.first, &pair.second, hash, std::move(packed), charge});
+    }
 
-        // Create new entry
-        auto entry = std::make_shared<CacheEntryType>();
-        entry->data = pair.second;
-        entry->created_at = QDateTime::currentDateTime();
-        entry->last_accessed = entry->created_at;
-        entry->expires_at = expires_at;
-        entry->memory_size.store(calculateMemorySize(pair.second));
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        if (per_shard[i].empty())
+            continue;
 
-        // Remove existing entry if present
-        auto existing_it = cache_.find(pair.first);
-        if (existing_it != cache_.end()) {
-            statistics_.total_memory_usage.fetch_sub(
-                existing_it->second->memory_size.load());
-            cache_.erase(existing_it);
-        }
+        Shard& shard = *shards_[i];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
 
-        cache_[pair.first] = entry;
-        access_order_.push_front(pair.first);
-        access_iterators_[pair.first] = access_order_.begin();
+        for (PendingItem& item : per_shard[i]) {
+            insertLocked(shard, *item.key, item.hash, *item.value,
+                         std::move(item.packed), item.charge,
+                         expiryFor(QDateTime()));
 
-        statistics_.total_memory_usage.fetch_add(entry->memory_size.load());
+            // Evict per item so admission decisions see every new key
+            evictIfNeeded(shard);
+        }
     }
-
-    evictIfNeeded();
 }
 
 template <typename Key, typename Value>
@@ -789,51 +2586,75 @@ std::unordered_map<Key, Value> LRUCache<Key, Value>::getBatch(
 
 template <typename Key, typename Value>
 CacheStatisticsSnapshot LRUCache<Key, Value>::getStatistics() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-
     CacheStatisticsSnapshot stats;
-    stats.total_requests = statistics_.total_requests.load();
-    stats.cache_hits = statistics_.cache_hits.load();
-    stats.cache_misses = statistics_.cache_misses.load();
-    stats.evictions = statistics_.evictions.load();
-    stats.total_memory_usage = statistics_.total_memory_usage.load();
-    stats.max_memory_usage = statistics_.max_memory_usage.load();
+
+    for (const auto& shard : shards_) {
+        const CacheStatistics& s = shard->statistics;
+        stats.total_requests += s.total_requests.load();
+        stats.cache_hits += s.cache_hits.load();
+        stats.cache_misses += s.cache_misses.load();
+        stats.evictions += s.evictions.load();
+        stats.expirations += s.expirations.load();
+        stats.total_memory_usage += s.total_memory_usage.load();
+        stats.max_memory_usage += s.max_memory_usage.load();
+        stats.storage_allocations += s.storage_allocations.load();
+        stats.storage_bytes += s.storage_bytes.load();
+        stats.slot_reuses += s.slot_reuses.load();
+        stats.compressed_entries += s.compressed_entries.load();
+        stats.uncompressed_bytes += s.uncompressed_bytes.load();
+        stats.compressed_bytes += s.compressed_bytes.load();
+        stats.decompressions += s.decompressions.load();
+        stats.decompress_time_ns += s.decompress_time_ns.load();
+        stats.hot_tier_hits += s.hot_tier_hits.load();
+        stats.loader_calls += s.loader_calls.load();
+        stats.coalesced_loads += s.coalesced_loads.load();
+        stats.negative_cache_hits += s.negative_cache_hits.load();
+    }
 
     return stats;
 }
 
 template <typename Key, typename Value>
 double LRUCache<Key, Value>::getHitRatio() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    return statistics_.getHitRatio();
+    return getStatistics().getHitRatio();
 }
 
 template <typename Key, typename Value>
 void LRUCache<Key, Value>::optimize() {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-
-    // Remove expired entries first
-    cleanup();
-
-    // Rebuild access order to ensure consistency
-    access_order_.clear();
-    access_iterators_.clear();
-
-    // Sort entries by last accessed time (most recent first)
-    std::vector<std::pair<Key, std::shared_ptr<CacheEntryType>>> sorted_entries;
-    for (const auto& pair : cache_) {
-        sorted_entries.push_back(pair);
-    }
-
-    std::sort(sorted_entries.begin(), sorted_entries.end(),
-              [](const auto& a, const auto& b) {
-                  return a.second->last_accessed > b.second->last_accessed;
-              });
+    for (auto& shard_ptr : shards_) {
+        Shard& shard = *shard_ptr;
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        // Remove expired entries first
+        evictExpired(shard);
+
+        // CLOCK ordering is maintained by reference bits and WTinyLFU order
+        // by segments, not timestamps
+        if (usesClockRecency() ||
+            eviction_policy_.load() == EvictionPolicy::WTinyLFU)
+            continue;
+
+        // Rebuild access order to ensure consistency
+        std::vector<uint32_t> sorted_slots;
+        sorted_slots.reserve(shard.live);
+        for (uint32_t slot = shard.lists[kMain].head; slot != kNil;
+             slot = shard.slab[slot].next) {
+            sorted_slots.push_back(slot);
+        }
 
-    // Rebuild access order
-    for (const auto& pair : sorted_entries) {
-        access_order_.push_back(pair.first);
-        access_iterators_[pair.first] = std::prev(access_order_.end());
+        // Sort entries by last accessed time (most recent first)
+        std::stable_sort(sorted_slots.begin(), sorted_slots.end(),
+                         [&shard](uint32_t a, uint32_t b) {
+                             return shard.slab[a].entry.last_accessed >
+                                    shard.slab[b].entry.last_accessed;
+                         });
+
+        // Relink in sorted order
+        shard.lists[kMain] = RecencyList{};
+        for (auto it = sorted_slots.rbegin(); it != sorted_slots.rend();
+             ++it) {
+            linkFront(shard, *it);
+        }
     }
 }
 
@@ -844,121 +2665,239 @@ void LRUCache<Key, Value>::preload(
     putBatch(items);
 }
 
-// **Template instantiations for common types**
-template class LRUCache<QString, std::shared_ptr<QWidget>>;
-template class LRUCache<QString, QString>;
-template class LRUCache<QString, QVariant>;
-template class LRUCache<QString, QByteArray>;
-template class LRUCache<QString, QJsonObject>;
-
-// **Template method implementations**
 template <typename Key, typename Value>
 void LRUCache<Key, Value>::cleanup() {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-
-    std::vector<Key> expired_keys;
-
-    // Find all expired entries
-    for (const auto& pair : cache_) {
-        if (pair.second->isExpired()) {
-            expired_keys.push_back(pair.first);
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& shard : shards_) {
+        {
+            std::lock_guard<std::mutex> flight_lock(shard->flight_mutex);
+            std::erase_if(shard->negative, [now](const auto& item) {
+                return item.second.expires_at <= now;
+            });
         }
-    }
 
-    // Remove expired entries
-    for (const auto& key : expired_keys) {
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            statistics_.total_memory_usage.fetch_sub(
-                it->second->memory_size.load());
-            statistics_.evictions.fetch_add(1);
-            cache_.erase(it);
+        std::unique_lock<std::shared_mutex> lock(shard->mutex);
+        evictExpired(*shard);
+    }
+}
 
-            // Remove from access order
-            auto access_it = access_iterators_.find(key);
-            if (access_it != access_iterators_.end()) {
-                access_order_.erase(access_it->second);
-                access_iterators_.erase(access_it);
-            }
+template <typename Key, typename Value>
+size_t LRUCache<Key, Value>::trimMemory(size_t target_bytes) {
+    // Slot and index storage does not shrink when entries go, so only the
+    // entries' charges are trimmed, to what the target leaves beside it
+    size_t storage = 0;
+    for (const auto& shard : shards_) {
+        storage += shard->statistics.storage_bytes.load();
+    }
+    const size_t entry_target =
+        target_bytes > storage ? target_bytes - storage : 0;
+    const size_t shard_target = entry_target / shards_.size();
+    const auto now = std::chrono::steady_clock::now();
+
+    size_t evicted = 0;
+    for (auto& shard_ptr : shards_) {
+        Shard& shard = *shard_ptr;
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        evicted += advanceWheel(shard, now);
+        while (shard.live > 0 &&
+               shard.statistics.total_memory_usage.load() > shard_target) {
+            const size_t size_before = shard.live;
+            evictOne(shard);
+            evicted += size_before - shard.live;
         }
     }
+    return evicted;
 }
 
 template <typename Key, typename Value>
 size_t LRUCache<Key, Value>::memoryUsage() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    return statistics_.total_memory_usage.load();
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->statistics.total_memory_usage.load() +
+                 shard->statistics.storage_bytes.load();
+    }
+    return total;
 }
 
 template <typename Key, typename Value>
 size_t LRUCache<Key, Value>::size() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    return cache_.size();
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard->mutex);
+        total += shard->live;
+    }
+    return total;
 }
 
 template <typename Key, typename Value>
-void LRUCache<Key, Value>::evictExpired() {
-    std::vector<Key> expired_keys;
+void LRUCache<Key, Value>::evictExpired(Shard& shard) {
+    advanceWheel(shard, std::chrono::steady_clock::now());
+}
 
-    // Find all expired entries
-    for (const auto& pair : cache_) {
-        if (pair.second->isExpired()) {
-            expired_keys.push_back(pair.first);
-        }
+// **Timing wheel**
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::scheduleExpiry(Shard& shard, uint32_t slot) {
+    Slot& s = shard.slab[slot];
+    if (!s.entry.hasExpiry()) {
+        return;
     }
 
-    // Remove expired entries
-    for (const auto& key : expired_keys) {
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            statistics_.total_memory_usage.fetch_sub(
-                it->second->memory_size.load());
-            statistics_.evictions.fetch_add(1);
-            cache_.erase(it);
+    TimerWheel& wheel = shard.wheel;
 
-            // Remove from access order
-            auto access_it = access_iterators_.find(key);
-            if (access_it != access_iterators_.end()) {
-                access_order_.erase(access_it->second);
-                access_iterators_.erase(access_it);
-            }
+    // Round up so an entry is never reported due before its deadline; past
+    // deadlines go to the next tick since current_tick is already processed
+    uint64_t tick = wheel.current_tick + 1;
+    if (s.entry.expires_at > wheel_origin_) {
+        const auto offset = s.entry.expires_at - wheel_origin_;
+        const auto ticks =
+            (offset + kWheelTick - std::chrono::nanoseconds(1)) / kWheelTick;
+        tick = std::max<uint64_t>(tick, static_cast<uint64_t>(ticks));
+    }
+
+    const uint64_t delta = tick - wheel.current_tick;
+    uint16_t bucket = kOverflowBucket;
+    for (unsigned level = 0; level < kWheelLevels; ++level) {
+        if (delta < (uint64_t{1} << (kWheelBits * (level + 1)))) {
+            bucket = static_cast<uint16_t>(
+                level * kWheelSlots +
+                ((tick >> (kWheelBits * level)) & (kWheelSlots - 1)));
+            break;
         }
     }
+
+    s.timer_bucket = bucket;
+    s.timer_prev = kNil;
+    s.timer_next = wheel.buckets[bucket];
+    if (s.timer_next != kNil) {
+        shard.slab[s.timer_next].timer_prev = slot;
+    }
+    wheel.buckets[bucket] = slot;
+    ++wheel.scheduled;
 }
 
 template <typename Key, typename Value>
-void LRUCache<Key, Value>::evictLFU() {
-    if (cache_.empty())
+void LRUCache<Key, Value>::cancelExpiry(Shard& shard, uint32_t slot) {
+    Slot& s = shard.slab[slot];
+    if (s.timer_bucket == kNoTimer) {
         return;
+    }
+
+    if (s.timer_prev != kNil) {
+        shard.slab[s.timer_prev].timer_next = s.timer_next;
+    } else {
+        shard.wheel.buckets[s.timer_bucket] = s.timer_next;
+    }
+    if (s.timer_next != kNil) {
+        shard.slab[s.timer_next].timer_prev = s.timer_prev;
+    }
+
+    s.timer_prev = kNil;
+    s.timer_next = kNil;
+    s.timer_bucket = kNoTimer;
+    --shard.wheel.scheduled;
+}
+
+template <typename Key, typename Value>
+size_t LRUCache<Key, Value>::advanceWheel(
+    Shard& shard, std::chrono::steady_clock::time_point now) {
+    TimerWheel& wheel = shard.wheel;
+    if (now <= wheel_origin_) {
+        return 0;
+    }
+    const auto target_tick =
+        static_cast<uint64_t>((now - wheel_origin_) / kWheelTick);
+
+    // Detach a bucket and hand each of its slots to fn
+    auto drain = [&](uint16_t bucket, auto&& fn) {
+        uint32_t slot = wheel.buckets[bucket];
+        wheel.buckets[bucket] = kNil;
+        while (slot != kNil) {
+            Slot& s = shard.slab[slot];
+            const uint32_t next = s.timer_next;
+            s.timer_prev = kNil;
+            s.timer_next = kNil;
+            s.timer_bucket = kNoTimer;
+            --wheel.scheduled;
+            fn(slot);
+            slot = next;
+        }
+    };
+
+    size_t expired = 0;
+    auto expire = [&](uint32_t slot) {
+        eraseSlot(shard, slot);
+        shard.statistics.evictions.fetch_add(1);
+        shard.statistics.expirations.fetch_add(1);
+        ++expired;
+    };
+
+    while (wheel.current_tick < target_tick) {
+        if (wheel.scheduled == 0) {
+            wheel.current_tick = target_tick;
+            break;
+        }
+
+        const uint64_t tick = ++wheel.current_tick;
+
+        // When a level wraps, redistribute the next bucket of the level above
+        // (or the overflow bucket) into the finer levels below
+        for (unsigned level = 1; level <= kWheelLevels; ++level) {
+            if ((tick >> (kWheelBits * (level - 1))) & (kWheelSlots - 1)) {
+                break;
+            }
+            const uint16_t bucket =
+                level == kWheelLevels
+                    ? kOverflowBucket
+                    : static_cast<uint16_t>(
+                          level * kWheelSlots +
+                          ((tick >> (kWheelBits * level)) &
+                           (kWheelSlots - 1)));
+            // Entries due at exactly this tick expire here rather than being
+            // pushed to the next one
+            drain(bucket, [&](uint32_t slot) {
+                if (shard.slab[slot].entry.isExpired(now)) {
+                    expire(slot);
+                } else {
+                    scheduleExpiry(shard, slot);
+                }
+            });
+        }
 
-    // Find entry with lowest access count
-    auto min_it = cache_.begin();
-    size_t min_access_count = min_it->second->access_count.load();
+        drain(static_cast<uint16_t>(tick & (kWheelSlots - 1)), expire);
+    }
+    return expired;
+}
 
-    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
-        size_t access_count = it->second->access_count.load();
+template <typename Key, typename Value>
+void LRUCache<Key, Value>::evictLFU(Shard& shard) {
+    // Find entry with lowest access count; walking from the LRU end makes
+    // recency the tie-breaker
+    uint32_t min_slot = kNil;
+    size_t min_access_count = std::numeric_limits<size_t>::max();
+
+    for (uint32_t slot = shard.lists[kMain].tail; slot != kNil;
+         slot = shard.slab[slot].prev) {
+        const size_t access_count = shard.slab[slot].entry.access_count.load();
         if (access_count < min_access_count) {
             min_access_count = access_count;
-            min_it = it;
+            min_slot = slot;
         }
     }
 
-    // Remove the least frequently used entry
-    Key key_to_evict = min_it->first;
-    statistics_.total_memory_usage.fetch_sub(
-        min_it->second->memory_size.load());
-    statistics_.evictions.fetch_add(1);
-    cache_.erase(min_it);
+    if (min_slot == kNil)
+        return;
 
-    // Remove from access order
-    auto access_it = access_iterators_.find(key_to_evict);
-    if (access_it != access_iterators_.end()) {
-        access_order_.erase(access_it->second);
-        access_iterators_.erase(access_it);
-    }
+    // Remove the least frequently used entry
+    eraseSlot(shard, min_slot);
+    shard.statistics.evictions.fetch_add(1);
 }
 
-// Note: All template methods are instantiated via the "template class"
-// declarations above
+// **Template instantiations for common types**
+template class LRUCache<QString, std::shared_ptr<QWidget>>;
+template class LRUCache<QString, QString>;
+template class LRUCache<QString, QVariant>;
+template class LRUCache<QString, QByteArray>;
+template class LRUCache<QString, QJsonObject>;
 
 }  // namespace DeclarativeUI::Core
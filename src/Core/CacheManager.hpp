@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QDateTime>
+#include <QByteArray>
 #include <QJsonObject>
 #include <QMutex>
 #include <QObject>
@@ -9,15 +10,25 @@
 #include <QTimer>
 #include <QWidget>
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
 #include <functional>
-#include <list>
+#include <future>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <variant>
+#include <vector>
+
+#include "PersistentCache.hpp"
 
 namespace DeclarativeUI::Core {
 
@@ -40,8 +51,11 @@ namespace DeclarativeUI::Core {
  *
  * Notes:
  * - Thread-safety: LRUCache uses an internal shared_mutex for concurrent reads
- * and exclusive writes.
- * - Time: uses QDateTime for timestamps and std::chrono for TTL configuration.
+ * and exclusive writes. In sharded mode the keyspace is split across
+ * independently locked shards, and hits only take a shared lock.
+ * - Time: entry timestamps use std::chrono::steady_clock, so TTLs are immune
+ * to wall-clock adjustments. put() still accepts a QDateTime expiry, which is
+ * converted on insertion.
  */
 
 /**
@@ -49,31 +63,72 @@ namespace DeclarativeUI::Core {
  *
  * @tparam T The stored value type.
  *
- * The entry maintains creation, last-accessed and optional expiry timestamps,
- * as well as an atomic access counter and best-effort memory size estimate. The
- * structure is lightweight so it can be stored in shared_ptr for safe
- * concurrent usage.
+ * The entry maintains creation, last-accessed and optional expiry timestamps
+ * on the monotonic steady_clock, as well as an atomic access counter and
+ * best-effort memory size estimate. The structure is lightweight and movable
+ * so LRUCache can store it inline in its slot slab.
  */
 template <typename T>
 struct CacheEntry {
-    T data;                  /**< The stored value. */
-    QDateTime created_at;    /**< Timestamp when the entry was created. */
-    QDateTime last_accessed; /**< Timestamp of the most recent access. */
-    QDateTime expires_at;    /**< Optional expiry timestamp; invalid() means no
-                                expiry. */
+    using Clock = std::chrono::steady_clock;
+
+    T data;                       /**< The stored value. */
+    Clock::time_point created_at; /**< When the entry was created. */
+    Clock::time_point last_accessed; /**< Most recent access. */
+    Clock::time_point expires_at =
+        Clock::time_point::max(); /**< Expiry; max() means no expiry. */
     std::atomic<size_t> access_count{
         0}; /**< Number of times the entry has been touched. */
     std::atomic<size_t> memory_size{
         0};                /**< Best-effort memory footprint in bytes. */
+    std::atomic<bool> referenced{
+        false};            /**< CLOCK reference bit set by hits in sharded
+                              mode and cleared by the eviction sweep. */
     bool is_dirty = false; /**< Flag for user-managed dirty state (e.g. lazy
                               persistence). */
 
+    CacheEntry() = default;
+
+    /**
+     * @brief Move the entry; atomics are transferred by value.
+     *
+     * Only used while the owning cache holds its exclusive lock (slab growth).
+     */
+    CacheEntry(CacheEntry&& other) noexcept
+        : data(std::move(other.data)),
+          created_at(other.created_at),
+          last_accessed(other.last_accessed),
+          expires_at(other.expires_at),
+          access_count(other.access_count.load(std::memory_order_relaxed)),
+          memory_size(other.memory_size.load(std::memory_order_relaxed)),
+          referenced(other.referenced.load(std::memory_order_relaxed)),
+          is_dirty(other.is_dirty) {}
+
+    CacheEntry& operator=(CacheEntry&& other) noexcept {
+        data = std::move(other.data);
+        created_at = other.created_at;
+        last_accessed = other.last_accessed;
+        expires_at = other.expires_at;
+        access_count.store(other.access_count.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+        memory_size.store(other.memory_size.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+        referenced.store(other.referenced.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+        is_dirty = other.is_dirty;
+        return *this;
+    }
+
+    /**
+     * @brief Returns true if the entry carries an expiry time.
+     */
+    bool hasExpiry() const { return expires_at != Clock::time_point::max(); }
+
     /**
      * @brief Returns true if the entry is expired based on expires_at.
      */
-    bool isExpired() const {
-        return expires_at.isValid() &&
-               QDateTime::currentDateTime() > expires_at;
+    bool isExpired(Clock::time_point now = Clock::now()) const {
+        return hasExpiry() && now > expires_at;
     }
 
     /**
@@ -82,9 +137,102 @@ struct CacheEntry {
      * Updates last_accessed and increments access_count atomically.
      */
     void touch() {
-        last_accessed = QDateTime::currentDateTime();
+        last_accessed = Clock::now();
         access_count.fetch_add(1);
     }
+
+    /**
+     * @brief Record a hit without mutating non-atomic metadata.
+     *
+     * Safe to call while holding only a shared lock: sets the CLOCK reference
+     * bit and bumps access_count, leaving last_accessed untouched.
+     */
+    void markReferenced() {
+        referenced.store(true, std::memory_order_relaxed);
+        access_count.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Serialization hook used by LRUCache to compress values.
+ *
+ * Specialize with `supported = true` and static encode()/decode() members
+ * converting between the value and a byte payload. Value types without a
+ * specialization are never compressed.
+ */
+template <typename T>
+struct CacheValueCodec {
+    static constexpr bool supported = false;
+};
+
+template <>
+struct CacheValueCodec<QByteArray> {
+    static constexpr bool supported = true;
+    static QByteArray encode(const QByteArray& value);
+    static QByteArray decode(const QByteArray& bytes);
+};
+
+template <>
+struct CacheValueCodec<QString> {
+    static constexpr bool supported = true;
+    static QByteArray encode(const QString& value); /**< UTF-8. */
+    static QString decode(const QByteArray& bytes);
+};
+
+template <>
+struct CacheValueCodec<QJsonObject> {
+    static constexpr bool supported = true;
+    static QByteArray encode(const QJsonObject& value); /**< CBOR. */
+    static QJsonObject decode(const QByteArray& bytes);
+};
+
+/**
+ * @brief Memory estimator used by LRUCache to charge entries.
+ *
+ * estimate() returns the heap bytes owned by a value beyond sizeof(T),
+ * including allocator block overhead; the inline part lives in the cache's
+ * slot slab, which is accounted separately. Implicitly shared payloads are
+ * charged in full. Specialize for custom value types; the primary template
+ * assumes the value owns no heap memory.
+ */
+template <typename T>
+struct CacheSizeEstimator {
+    static size_t estimate(const T&) { return 0; }
+};
+
+template <>
+struct CacheSizeEstimator<QByteArray> {
+    static size_t estimate(const QByteArray& value); /**< Uses capacity(). */
+};
+
+template <>
+struct CacheSizeEstimator<QString> {
+    static size_t estimate(const QString& value); /**< Uses capacity(). */
+};
+
+template <>
+struct CacheSizeEstimator<QVariant> {
+    static size_t estimate(const QVariant& value);
+};
+
+template <>
+struct CacheSizeEstimator<QJsonObject> {
+    /**
+     * @brief Walks the tree, modelling Qt's CBOR container layout: one
+     * element per key and value, string bytes and one container per nested
+     * object or array.
+     */
+    static size_t estimate(const QJsonObject& value);
+};
+
+template <>
+struct CacheSizeEstimator<std::shared_ptr<QWidget>> {
+    /**
+     * @brief The control block, the widget and every QObject below it with
+     * their private data. Walks the object tree, so call it on the thread
+     * owning the widget.
+     */
+    static size_t estimate(const std::shared_ptr<QWidget>& value);
 };
 
 /**
@@ -97,13 +245,57 @@ struct CacheEntry {
  * - TTL: Time To Live — evict entries when their TTL expires.
  * - Adaptive: Heuristic-driven policy that can mix LRU/LFU based on runtime
  * signals.
+ * - WTinyLFU: Window TinyLFU — a small LRU window in front of a segmented
+ * (probation/protected) main LRU; a window victim only displaces a main victim
+ * if a count-min sketch estimates it is accessed more often. Scan resistant,
+ * O(1) eviction.
  */
 enum class EvictionPolicy {
     LRU,      ///< Least Recently Used
     LFU,      ///< Least Frequently Used
     FIFO,     ///< First In, First Out
     TTL,      ///< Time To Live (expiry-aware)
-    Adaptive  ///< Adaptive decision based on usage patterns
+    Adaptive, ///< Adaptive decision based on usage patterns
+    WTinyLFU  ///< Admission-filtered segmented LRU
+};
+
+/**
+ * @brief Approximate access-frequency counter for TinyLFU admission.
+ *
+ * A count-min sketch of 4-bit counters (four rows packed into 64-bit words)
+ * with periodic aging: once the number of increments reaches ten times the
+ * configured capacity, every counter is halved so old popularity decays.
+ * Counters are atomic so hits can be recorded under a shared lock.
+ */
+class FrequencySketch {
+public:
+    FrequencySketch() = default;
+
+    /**
+     * @brief Allocate counters sized for max_entries keys (idempotent).
+     */
+    void ensureCapacity(size_t max_entries);
+    bool isInitialized() const { return table_size_ > 0; }
+
+    /**
+     * @brief Estimated access count of a hash, saturating at 15.
+     */
+    unsigned frequency(size_t hash) const;
+
+    /**
+     * @brief Record one access; may trigger aging.
+     */
+    void increment(size_t hash);
+
+private:
+    bool incrementAt(size_t index, unsigned nibble);
+    void age();
+
+    std::unique_ptr<std::atomic<uint64_t>[]> table_;
+    size_t table_size_ = 0;
+    size_t table_mask_ = 0;
+    size_t sample_size_ = 0;
+    std::atomic<size_t> additions_{0};
 };
 
 /**
@@ -117,10 +309,34 @@ struct CacheStatistics {
     std::atomic<size_t> cache_hits{0};     /**< Number of successful lookups. */
     std::atomic<size_t> cache_misses{0};   /**< Number of failed lookups. */
     std::atomic<size_t> evictions{0};      /**< Number of evicted entries. */
+    std::atomic<size_t> expirations{
+        0}; /**< Evictions caused by a passed TTL. */
     std::atomic<size_t> total_memory_usage{
         0}; /**< Total memory usage tracked for this cache. */
     std::atomic<size_t> max_memory_usage{
         0}; /**< Observed max memory usage for this cache. */
+    std::atomic<size_t> storage_allocations{
+        0}; /**< Heap allocations made by the slot slab and index. */
+    std::atomic<size_t> storage_bytes{
+        0}; /**< Capacity of the slot slab and index in bytes. */
+    std::atomic<size_t> slot_reuses{
+        0}; /**< Inserts served from the slab free list. */
+    std::atomic<size_t> compressed_entries{
+        0}; /**< Entries currently stored compressed. */
+    std::atomic<size_t> uncompressed_bytes{
+        0}; /**< Encoded size of compressed entries before compression. */
+    std::atomic<size_t> compressed_bytes{
+        0}; /**< Size of compressed payloads. */
+    std::atomic<size_t> decompressions{0}; /**< Cold reads that inflated. */
+    std::atomic<size_t> decompress_time_ns{
+        0}; /**< Total time spent decompressing. */
+    std::atomic<size_t> hot_tier_hits{
+        0}; /**< Reads of compressed entries served uncompressed. */
+    std::atomic<size_t> loader_calls{0}; /**< getOrCompute() loader runs. */
+    std::atomic<size_t> coalesced_loads{
+        0}; /**< Callers that waited on another caller's load. */
+    std::atomic<size_t> negative_cache_hits{
+        0}; /**< Calls answered from a cached loader failure. */
 
     /**
      * @brief Compute the hit ratio as cache_hits / total_requests.
@@ -143,10 +359,28 @@ struct CacheStatisticsSnapshot {
     size_t cache_hits{0};     /**< Number of successful lookups. */
     size_t cache_misses{0};   /**< Number of failed lookups. */
     size_t evictions{0};      /**< Number of evicted entries. */
+    size_t expirations{0};    /**< Evictions caused by a passed TTL. */
     size_t total_memory_usage{
         0}; /**< Total memory usage tracked for this cache. */
     size_t max_memory_usage{
         0}; /**< Observed max memory usage for this cache. */
+    size_t storage_allocations{
+        0}; /**< Heap allocations made by the slot slab and index. */
+    size_t storage_bytes{
+        0}; /**< Capacity of the slot slab and index in bytes. */
+    size_t slot_reuses{0}; /**< Inserts served from the slab free list. */
+    size_t compressed_entries{0}; /**< Entries currently stored compressed. */
+    size_t uncompressed_bytes{
+        0}; /**< Encoded size of compressed entries before compression. */
+    size_t compressed_bytes{0};   /**< Size of compressed payloads. */
+    size_t decompressions{0};     /**< Cold reads that inflated. */
+    size_t decompress_time_ns{0}; /**< Total time spent decompressing. */
+    size_t hot_tier_hits{
+        0}; /**< Reads of compressed entries served uncompressed. */
+    size_t loader_calls{0};    /**< getOrCompute() loader runs. */
+    size_t coalesced_loads{0}; /**< Callers that waited on another's load. */
+    size_t negative_cache_hits{
+        0}; /**< Calls answered from a cached loader failure. */
 
     /**
      * @brief Compute the hit ratio as cache_hits / total_requests.
@@ -158,6 +392,26 @@ struct CacheStatisticsSnapshot {
                    ? static_cast<double>(cache_hits) / total_requests
                    : 0.0;
     }
+
+    /**
+     * @brief Uncompressed / compressed size of compressed entries.
+     * @return Ratio >= 1.0 when compression saves memory; 1.0 when nothing is
+     * compressed.
+     */
+    double getCompressionRatio() const {
+        return compressed_bytes > 0
+                   ? static_cast<double>(uncompressed_bytes) / compressed_bytes
+                   : 1.0;
+    }
+
+    /**
+     * @brief Mean decompression latency in microseconds.
+     */
+    double getAverageDecompressMicros() const {
+        return decompressions > 0 ? static_cast<double>(decompress_time_ns) /
+                                        decompressions / 1000.0
+                                  : 0.0;
+    }
 };
 
 /**
@@ -170,11 +424,30 @@ struct CacheStatisticsSnapshot {
  * shared_ptr where appropriate.
  *
  * Features:
- * - Optional TTL per-entry.
- * - Multiple eviction policies: LRU, LFU, FIFO, TTL, Adaptive.
+ * - Optional TTL per-entry. Expiry times are kept in a per-shard hierarchical
+ *   timing wheel (4 levels of 64 buckets over a 16 ms tick), so cleanup()
+ *   only visits entries that are actually due instead of scanning the slab.
+ * - Multiple eviction policies: LRU, LFU, FIFO, TTL, Adaptive, WTinyLFU.
  * - Batch operations for efficient bulk load/store.
+ * - Entries live inline in a per-shard slot slab linked by intrusive
+ *   prev/next indices and found through one open-addressing index keyed by a
+ *   precomputed qHash. Once the slab has grown to its working size, puts
+ *   recycle freed slots and perform no heap allocations of their own.
+ * - Optional transparent compression for values with a CacheValueCodec
+ *   (QByteArray, QString, QJsonObject). Values whose encoded size reaches a
+ *   threshold are stored zlib-compressed and inflated on get(); entries read
+ *   repeatedly are promoted into a small per-shard hot tier that keeps the
+ *   inflated value alongside the payload.
  * - Thread-safe reads with shared locking; writes use exclusive locking.
- * - Memory accounting via calculateMemorySize() to enforce memory limits.
+ * - Optional sharded mode: the keyspace is split into N independently locked
+ *   shards, each with its own recency list and limits (max_size / N). Hits in
+ *   sharded mode set a CLOCK reference bit under a shared lock instead of
+ *   moving list nodes, so concurrent readers do not serialize; eviction runs a
+ *   second-chance sweep over the shard's recency list.
+ * - Memory accounting: each entry is charged the heap bytes of its key and
+ *   value as measured by CacheSizeEstimator, at insertion and on eviction,
+ *   and the slab and index capacity are tracked as they grow. Limits apply
+ *   to the entry charges; memoryUsage() reports both.
  * - Statistics collection accessible from external monitors.
  */
 template <typename Key, typename Value>
@@ -184,14 +457,30 @@ public:
     using KeyType = Key;
     using ValueType = Value;
 
+    /**
+     * @brief Compression configuration, see enableCompression().
+     */
+    struct CompressionSettings {
+        bool enabled = false;
+        size_t threshold_bytes = 4096; /**< Minimum encoded size to compress. */
+        size_t hot_entries = 64; /**< Hot tier capacity across all shards. */
+    };
+
     /**
      * @brief Construct a cache instance.
      * @param max_size Maximum number of entries allowed before eviction is
      * triggered.
      * @param max_memory_mb Soft memory limit in megabytes (converted internally
      * to bytes).
+     * @param shard_count Number of independently locked shards. 1 (default)
+     * keeps exact LRU ordering; larger values enable sharded mode and are
+     * rounded up to a power of two. Each shard evicts against its share of
+     * the memory limit; an entry larger than that share, up to the whole
+     * limit, empties its shard and is kept there alone, so the shards
+     * together may briefly run over the limit by less than that entry.
      */
-    explicit LRUCache(size_t max_size = 1000, size_t max_memory_mb = 100);
+    explicit LRUCache(size_t max_size = 1000, size_t max_memory_mb = 100,
+                      size_t shard_count = 1);
     ~LRUCache() = default;
 
     /**
@@ -204,15 +493,22 @@ public:
      * @param key Cache key.
      * @param value Value to store.
      * @param expires_at Optional explicit expiry time; pass default-constructed
-     * QDateTime for none.
-     * @return True if the item was inserted or updated successfully.
+     * QDateTime to apply the default TTL (see setTTL()), if any.
+     * @return True if the item was inserted or updated successfully; false
+     * if it alone is larger than the memory limit.
      *
      * Notes:
      * - This method updates internal access order and statistics.
+     * - The wall-clock expiry is converted to a steady_clock deadline once.
      */
     bool put(const Key& key, const Value& value,
              const QDateTime& expires_at = QDateTime());
 
+    /**
+     * @brief Insert or update an entry that expires after ttl.
+     */
+    bool put(const Key& key, const Value& value, std::chrono::milliseconds ttl);
+
     /**
      * @brief Retrieve a value from the cache.
      * @param key Lookup key.
@@ -223,11 +519,35 @@ public:
      */
     std::optional<Value> get(const Key& key);
 
+    /**
+     * @brief Return the cached value, computing and inserting it on a miss.
+     * @param key Lookup key.
+     * @param loader Produces the value; runs outside any cache lock.
+     * @return The cached or freshly computed value.
+     * @throws Whatever loader throws, rethrown to every caller waiting on that
+     * load (and, with a negative cache TTL, to callers within the TTL).
+     *
+     * Concurrent misses on the same key are coalesced: only one caller runs
+     * loader while the others block on a shared future for its result.
+     *
+     * @param hit Optional; set to true when the value came from the cache.
+     */
+    Value getOrCompute(const Key& key, const std::function<Value()>& loader,
+                       bool* hit = nullptr);
+
     /**
      * @brief Returns true if key is present and not expired.
      */
     bool contains(const Key& key) const;
 
+    /**
+     * @brief Expiry deadline of a live entry without counting an access.
+     * @return time_point::max() if the entry never expires, nullopt if it is
+     * absent or expired.
+     */
+    std::optional<std::chrono::steady_clock::time_point> expiryOf(
+        const Key& key) const;
+
     /**
      * @brief Remove an entry by key.
      * @return True if an entry was removed.
@@ -255,11 +575,39 @@ public:
      * @param ttl Duration in milliseconds.
      */
     void setTTL(std::chrono::milliseconds ttl);
+    std::chrono::milliseconds defaultTTL() const {
+        return std::chrono::milliseconds(default_ttl_ms_.load());
+    }
 
     /**
      * @brief Enable or disable background automatic cleanup (when implemented).
      */
     void enableAutoCleanup(bool enabled);
+
+    /**
+     * @brief Store large values compressed.
+     * @param enabled Toggle for new insertions; existing entries keep their
+     * current representation.
+     * @param threshold_bytes Encoded values smaller than this stay
+     * uncompressed.
+     * @param hot_entries Number of decompressed values kept resident for
+     * frequently read compressed entries.
+     * @return False if Value has no CacheValueCodec.
+     */
+    bool enableCompression(bool enabled, size_t threshold_bytes = 4096,
+                           size_t hot_entries = 64);
+    CompressionSettings compressionSettings() const;
+
+    /**
+     * @brief Remember getOrCompute() loader failures for a while.
+     * @param ttl How long a failed load is replayed to later callers instead
+     * of running the loader again; zero (default) disables negative caching.
+     * Inserting or removing the key forgets the failure early.
+     */
+    void setNegativeCacheTTL(std::chrono::milliseconds ttl);
+    std::chrono::milliseconds negativeCacheTTL() const {
+        return std::chrono::milliseconds(negative_ttl_ms_.load());
+    }
     /** @} */
 
     /**
@@ -290,10 +638,22 @@ public:
     CacheStatisticsSnapshot getStatistics()
         const;           /**< Return a snapshot of current cache statistics. */
     size_t size() const; /**< Return current number of entries. */
-    size_t memoryUsage()
-        const; /**< Return current tracked memory usage in bytes. */
+    size_t memoryUsage() const; /**< Entry charges plus slab and index
+                                   storage, in bytes. */
     double getHitRatio()
         const; /**< Convenience call to statistics.getHitRatio(). */
+    size_t shardCount() const {
+        return shards_.size();
+    } /**< Number of shards (1 when not sharded). */
+    size_t maxSize() const {
+        return max_size_;
+    } /**< Configured entry limit across all shards. */
+    size_t maxMemoryBytes() const {
+        return max_memory_bytes_;
+    } /**< Configured memory limit across all shards. */
+    EvictionPolicy evictionPolicy() const {
+        return eviction_policy_.load();
+    } /**< Currently selected eviction strategy. */
     /** @} */
 
     /**
@@ -312,6 +672,17 @@ public:
      */
     void optimize();
 
+    /**
+     * @brief Evict until memoryUsage() fits in target_bytes.
+     *
+     * Expired entries go first, then victims chosen by the eviction policy.
+     * Slot and index storage is not freed by eviction, so the entries are
+     * trimmed to what the target leaves beside it, each shard to its share;
+     * a target below the storage alone evicts every entry.
+     * @return Number of entries evicted.
+     */
+    size_t trimMemory(size_t target_bytes);
+
     /**
      * @brief Preload the cache using a user-provided loader function.
      * @param loader Function that returns a map of key->value to preload.
@@ -323,53 +694,317 @@ public:
     /** @} */
 
 private:
-    mutable std::shared_mutex mutex_; /**< Protects cache_ and metadata. */
-    std::unordered_map<Key, std::shared_ptr<CacheEntryType>>
-        cache_;                   /**< Main storage of entries. */
-    std::list<Key> access_order_; /**< Recency list for LRU/FIFO. */
-    std::unordered_map<Key, typename std::list<Key>::iterator>
-        access_iterators_; /**< Index into access_order_. */
+    static constexpr uint32_t kNil =
+        std::numeric_limits<uint32_t>::max(); /**< Null slot index. */
+
+    /**
+     * @brief Timing wheel geometry. Level L buckets span 64^L ticks; deadlines
+     * beyond the last level wait in an overflow bucket.
+     */
+    static constexpr unsigned kWheelBits = 6;
+    static constexpr uint32_t kWheelSlots = 1u << kWheelBits;
+    static constexpr unsigned kWheelLevels = 4;
+    static constexpr uint16_t kOverflowBucket = kWheelLevels * kWheelSlots;
+    static constexpr uint16_t kNoTimer = std::numeric_limits<uint16_t>::max();
+    static constexpr std::chrono::milliseconds kWheelTick{16};
+
+    /**
+     * @brief Recency list a slot belongs to. Policies other than WTinyLFU
+     * keep every entry in kMain; WTinyLFU uses kMain as its probation segment.
+     */
+    enum Segment : uint8_t { kMain = 0, kWindow = 1, kProtected = 2 };
+
+    /**
+     * @brief Intrusive doubly linked list over slab indices.
+     */
+    struct RecencyList {
+        uint32_t head = kNil; /**< Most recently used slot. */
+        uint32_t tail = kNil; /**< Least recently used slot. */
+        size_t size = 0;      /**< Number of linked slots. */
+    };
+
+    /**
+     * @brief Slab slot holding one entry inline.
+     *
+     * Live slots are chained MRU -> LRU through prev/next; free slots are
+     * chained through next only.
+     */
+    struct Slot {
+        Key key;               /**< Owned copy of the key. */
+        CacheEntryType entry;  /**< Value and metadata. */
+        size_t hash = 0;       /**< Precomputed qHash of key. */
+        uint32_t prev = kNil;  /**< Towards the MRU end. */
+        uint32_t next = kNil;  /**< Towards the LRU end / next free slot. */
+        uint32_t hot_pos = kNil; /**< Position in the hot ring, if hot. */
+        uint32_t version = 0;    /**< Bumped whenever the payload changes. */
+        uint8_t segment = kMain; /**< Recency list holding the slot. */
+        bool occupied = false;   /**< False while on the free list. */
+        bool compressed = false; /**< Payload lives in packed. */
+        size_t raw_size = 0;     /**< Encoded size before compression. */
+        QByteArray packed;       /**< Compressed payload. */
+        uint32_t timer_prev = kNil; /**< Neighbours in the timer bucket. */
+        uint32_t timer_next = kNil;
+        uint16_t timer_bucket = kNoTimer; /**< Wheel bucket, if scheduled. */
+    };
+
+    /**
+     * @brief Compressed form of a value, prepared outside the shard lock.
+     */
+    struct PackedValue {
+        QByteArray bytes;
+        size_t raw_size = 0;
+    };
+
+    /**
+     * @brief Open-addressing index cell (linear probing, backward-shift
+     * deletion so no tombstones accumulate under churn).
+     */
+    struct IndexCell {
+        size_t hash = 0;      /**< Slot hash copy; skips key compares. */
+        uint32_t slot = kNil; /**< kNil marks an empty cell. */
+    };
+
+    /**
+     * @brief Cached loader failure, see setNegativeCacheTTL().
+     */
+    struct NegativeEntry {
+        std::exception_ptr error;
+        std::chrono::steady_clock::time_point expires_at;
+    };
+
+    /**
+     * @brief Hierarchical timing wheel holding entries that have an expiry.
+     *
+     * Buckets are intrusive lists through Slot::timer_prev/timer_next. Ticks
+     * count kWheelTick steps since the cache's wheel origin; every bucket at
+     * or before current_tick has already been processed.
+     */
+    struct TimerWheel {
+        std::array<uint32_t, kOverflowBucket + 1> buckets;
+        uint64_t current_tick = 0;
+        size_t scheduled = 0; /**< Entries linked into any bucket. */
+
+        TimerWheel() { buckets.fill(kNil); }
+    };
+
+    /**
+     * @brief Independently locked slice of the keyspace.
+     *
+     * Each shard owns its slab, index, limits and counters so that operations
+     * on different shards never touch the same lock or cache line.
+     */
+    struct Shard {
+        mutable std::shared_mutex mutex; /**< Protects the members below. */
+        std::vector<Slot> slab;          /**< Contiguous entry slab. */
+        std::vector<IndexCell> index;    /**< Power-of-two sized hash index. */
+        size_t live = 0;                 /**< Number of occupied slots. */
+        uint32_t free_head = kNil;       /**< First recycled slot. */
+        std::array<RecencyList, 3> lists; /**< Indexed by Segment. */
+        size_t max_size = 0;             /**< Per-shard share of max_size_. */
+        size_t window_capacity = 0;      /**< WTinyLFU window size. */
+        size_t protected_capacity = 0;   /**< WTinyLFU protected size. */
+        uint32_t admission_candidate = kNil; /**< Latest window emigrant. */
+        FrequencySketch sketch; /**< WTinyLFU frequencies, lazily sized. */
+        size_t max_memory_bytes = 0;     /**< Per-shard share of the memory
+                                            limit. */
+        std::vector<uint32_t> hot_ring;  /**< Slots holding inflated copies. */
+        std::mutex flight_mutex; /**< Guards in_flight and negative. */
+        std::unordered_map<Key, std::shared_future<Value>>
+            in_flight; /**< getOrCompute() loads in progress. */
+        std::unordered_map<Key, NegativeEntry>
+            negative; /**< Recent loader failures. */
+        size_t hot_cursor = 0; /**< Next hot ring position to reuse. */
+        TimerWheel wheel;      /**< Expiry schedule of this shard. */
+        CacheStatistics statistics;      /**< Per-shard monitoring counters. */
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_; /**< Fixed at construction. */
+    size_t shard_shift_ = 64; /**< Hash shift selecting the shard index. */
 
     size_t max_size_; /**< Max number of items before eviction triggers. */
     size_t
         max_memory_bytes_; /**< Max memory in bytes before eviction triggers. */
-    EvictionPolicy eviction_policy_ =
-        EvictionPolicy::LRU; /**< Currently selected eviction strategy. */
-    std::chrono::milliseconds default_ttl_{
+    std::atomic<EvictionPolicy> eviction_policy_{
+        EvictionPolicy::LRU}; /**< Currently selected eviction strategy. */
+    std::atomic<std::chrono::milliseconds::rep> default_ttl_ms_{
         0}; /**< Default TTL for entries inserted without expires_at. */
-    bool auto_cleanup_enabled_ =
-        true; /**< When true, background cleanup may run. */
+    std::atomic<bool> auto_cleanup_enabled_{
+        true}; /**< When true, background cleanup may run. */
+    std::atomic<bool> compression_enabled_{
+        false}; /**< Compress new values above the threshold. */
+    std::atomic<size_t> compression_threshold_{
+        4096}; /**< Minimum encoded size to compress. */
+    std::atomic<size_t> hot_entries_{64}; /**< Hot tier capacity. */
+    std::atomic<int64_t> negative_ttl_ms_{
+        0}; /**< Negative caching TTL; 0 disables it. */
+    const std::chrono::steady_clock::time_point wheel_origin_ =
+        std::chrono::steady_clock::now(); /**< Tick zero of every wheel. */
+
+    /**
+     * @brief Hash a key once; the result selects the shard and index bucket.
+     */
+    static size_t hashKey(const Key& key);
+
+    /**
+     * @brief Select the shard responsible for a hash.
+     *
+     * Uses the high bits of a multiplicatively mixed hash so the shard index
+     * stays independent of the low bits used by the shard's own index.
+     */
+    size_t shardIndex(size_t hash) const;
+    Shard& shardFor(size_t hash) const;
+
+    /**
+     * @brief True when hits are recorded with CLOCK reference bits.
+     */
+    bool usesClockRecency() const { return shards_.size() > 1; }
+
+    /**
+     * @brief Slab and index primitives. All require the shard's exclusive lock
+     * except findSlot, which only reads.
+     */
+    uint32_t findSlot(const Shard& shard, const Key& key, size_t hash) const;
+    uint32_t acquireSlot(Shard& shard);
+    void indexInsert(Shard& shard, size_t hash, uint32_t slot);
+    void indexErase(Shard& shard, size_t hash, uint32_t slot);
+    void linkFront(Shard& shard, uint32_t slot);
+    void unlink(Shard& shard, uint32_t slot);
+    void moveToSegment(Shard& shard, uint32_t slot, Segment segment);
+
+    /**
+     * @brief put() with a steady_clock deadline; count_request is false when
+     * getOrCompute() publishes a load whose lookup was already counted.
+     */
+    bool store(const Key& key, const Value& value,
+               std::chrono::steady_clock::time_point expires_at,
+               bool count_request);
+
+    /**
+     * @brief Look a key up without counting a request, feeding the
+     * frequency sketch or touching recency.
+     */
+    std::optional<Value> peek(const Key& key);
+
+    /**
+     * @brief Drop a cached loader failure for key, if any.
+     */
+    void forgetNegative(Shard& shard, const Key& key);
+
+    /**
+     * @brief Insert or overwrite an entry; returns false if it can never fit.
+     * @param packed Compressed payload from packValue(), or nullopt to store
+     * the value as is.
+     */
+    bool insertLocked(Shard& shard, const Key& key, size_t hash,
+                      const Value& value, std::optional<PackedValue> packed,
+                      size_t charge,
+                      std::chrono::steady_clock::time_point expires_at);
+
+    /**
+     * @brief Bytes charged for an entry: key plus value, or key plus the
+     * compressed payload. Computed before taking the shard lock.
+     */
+    size_t entryCharge(const Key& key, const Value& value,
+                       const std::optional<PackedValue>& packed) const;
+
+    /**
+     * @brief Expiry deadline for an insertion: the explicit wall-clock time if
+     * valid, else now + the default TTL, else no expiry.
+     */
+    std::chrono::steady_clock::time_point expiryFor(
+        const QDateTime& expires_at) const;
+
+    /**
+     * @brief Timing wheel primitives (exclusive lock).
+     * - scheduleExpiry: link a slot with an expiry into its bucket.
+     * - cancelExpiry: unlink a slot from its bucket, if scheduled.
+     * - advanceWheel: move the wheel to now, cascading higher levels into
+     *   lower ones and erasing entries in level-0 buckets that became due.
+     *   Returns the number of entries erased.
+     */
+    void scheduleExpiry(Shard& shard, uint32_t slot);
+    void cancelExpiry(Shard& shard, uint32_t slot);
+    size_t advanceWheel(Shard& shard,
+                        std::chrono::steady_clock::time_point now);
 
-    mutable CacheStatistics statistics_; /**< Per-cache monitoring counters. */
+    /**
+     * @brief Compression helpers.
+     * - packValue: compress outside any lock when enabled and above threshold.
+     * - unpackValue: inflate a payload, recording timing statistics.
+     * - releasePayload: drop compressed/hot state and gauges of a slot.
+     * - promoteHot / demoteHot: move a slot into or out of the hot ring.
+     */
+    std::optional<PackedValue> packValue(const Value& value) const;
+    Value unpackValue(Shard& shard, const QByteArray& packed) const;
+    void releasePayload(Shard& shard, uint32_t slot);
+    void promoteHot(Shard& shard, uint32_t slot, const Value& value);
+    void demoteHot(Shard& shard, uint32_t slot);
 
     /**
-     * @brief Evict entries until the cache respects size/memory limits.
+     * @brief Evict entries until the shard respects its size/memory limits.
      *
      * Called internally after mutations which may increase resource usage.
+     * The caller must hold the shard's exclusive lock.
      */
-    void evictIfNeeded();
+    void evictIfNeeded(Shard& shard);
+
+    /**
+     * @brief Evict one victim chosen by the current policy, falling back to
+     * recency order when the policy finds nothing (exclusive lock).
+     */
+    void evictOne(Shard& shard);
 
     /**
      * @brief Eviction implementations for each policy.
      * - evictLRU: remove least recently used entries.
+     * - evictClock: second-chance sweep used in sharded mode.
      * - evictLFU: remove entries with lowest access_count.
-     * - evictExpired: remove entries whose expires_at has passed.
+     * - evictExpired: remove entries whose expires_at has passed, driven by
+     *   the timing wheel so only due entries are visited.
+     * - evictTinyLFU: admission duel between window and probation victims.
+     */
+    void evictLRU(Shard& shard);
+    void evictClock(Shard& shard);
+    void evictLFU(Shard& shard);
+    void evictExpired(Shard& shard);
+    void evictTinyLFU(Shard& shard);
+
+    /**
+     * @brief WTinyLFU helpers.
+     * - recordTinyLfuHit: segment movement for a hit under the exclusive lock.
+     * - promoteToProtected: move a probation slot to protected, demoting the
+     *   protected overflow back to probation.
+     * - mergeSegments: fold all segments into kMain when switching policy.
+     */
+    void recordTinyLfuHit(Shard& shard, uint32_t slot);
+    void promoteToProtected(Shard& shard, uint32_t slot);
+    void mergeSegments(Shard& shard);
+
+    /**
+     * @brief Remove a slot from the index and recency list and recycle it.
+     */
+    void eraseSlot(Shard& shard, uint32_t slot);
+
+    /**
+     * @brief Move an accessed slot to the MRU end of its list.
      */
-    void evictLRU();
-    void evictLFU();
-    void evictExpired();
+    void updateAccessOrder(Shard& shard, uint32_t slot);
 
     /**
-     * @brief Update internal access order when an entry is accessed.
-     * @param key The accessed key.
+     * @brief Apply the current policy's reordering for a hit (exclusive lock).
      */
-    void updateAccessOrder(const Key& key);
+    void recordHitLocked(Shard& shard, uint32_t slot);
 
     /**
-     * @brief Estimate memory size of a value. Override/extend as necessary for
-     * custom value types.
+     * @brief Count an access in the WTinyLFU sketch (shared lock suffices).
+     */
+    void recordFrequency(Shard& shard, size_t hash);
+
+    /**
+     * @brief Heap bytes owned by a value, see CacheSizeEstimator. Specialize
+     * the estimator for custom value types.
      * @param value Candidate value.
-     * @return Best-effort size in bytes.
+     * @return Size in bytes.
      */
     size_t calculateMemorySize(const Value& value) const;
 };
@@ -386,6 +1021,8 @@ using PropertyCache = LRUCache<QString, QVariant>;
 using FileContentCache = LRUCache<QString, QByteArray>;
 using JSONCache = LRUCache<QString, QJsonObject>;
 
+class ParallelProcessor;
+
 /**
  * @brief Application-level manager that owns multiple cache instances and
  * provides centralized control.
@@ -440,6 +1077,95 @@ public:
     void cacheJSON(const QString& key, const QJsonObject& json);
     QJsonObject getCachedJSON(const QString& key);
 
+    /**
+     * @name Parsed UI file caching
+     *
+     * Entries are keyed by canonical file path and remember the file's
+     * modification time and size, so a lookup after the file changed misses.
+     * When the persistent tier is enabled they are also written through to
+     * disk and survive process restarts.
+     */
+    void cacheJSONFile(const QString& file_path, const QByteArray& content,
+                       const QJsonObject& json);
+    std::optional<QJsonObject> getCachedJSONFile(const QString& file_path);
+
+    /**
+     * @brief Back the JSON cache with an on-disk PersistentCacheStore.
+     *
+     * Opens (or creates) the store and warms the JSON cache from every record
+     * whose file still has the recorded modification time and size; with
+     * verify_content the file is also hashed, which costs a read but no parse.
+     * Stale records are discarded.
+     *
+     * @param store_path Store file location, e.g. under
+     * QStandardPaths::CacheLocation.
+     * @param max_size_mb Size cap of the store file.
+     * @param verify_content Compare content hashes while warming.
+     * @return False if the store cannot be opened.
+     */
+    bool enablePersistentJSONCache(const QString& store_path,
+                                   size_t max_size_mb = 64,
+                                   bool verify_content = true);
+    void disablePersistentJSONCache();
+
+    /**
+     * @name Refresh-ahead for file-backed entries
+     *
+     * With refresh-ahead enabled, the file content and JSON caches use ttl as
+     * their default TTL. A hit on a file content or parsed UI file entry that
+     * lands in the last refresh_fraction of its TTL, or finds that the file's
+     * modification time or size changed, reloads the file on a
+     * ParallelProcessor pool. getOrComputeFileContent() and
+     * getOrComputeJSON() hits are refreshed the same way, by re-reading the
+     * file their key names (a JSON key must be a canonical file path), never
+     * by calling their loader: every getOrCompute*() loader only runs on the
+     * calling thread, within the call. Readers keep getting
+     * the cached value until the reload replaces it, and at most one refresh
+     * per key is in flight. UI files are reloaded with plain
+     * QJsonDocument::fromJson; if a reload fails the entry is dropped so the
+     * next reader loads it the regular way.
+     */
+    void enableRefreshAhead(bool enabled,
+                            std::chrono::milliseconds ttl =
+                                std::chrono::minutes(5),
+                            double refresh_fraction = 0.2);
+    bool isRefreshAheadEnabled() const {
+        return refresh_ahead_enabled_.load();
+    }
+
+    /**
+     * @brief Block until every scheduled refresh has finished.
+     */
+    void waitForRefreshes();
+    bool isPersistentJSONCacheEnabled() const;
+    bool compactPersistentJSONCache();
+
+    /**
+     * @name Compute-on-miss APIs
+     *
+     * Return the cached value or run loader once per key, however many
+     * threads miss concurrently (see LRUCache::getOrCompute()). Loader
+     * exceptions propagate to every waiting caller. When the cache is
+     * disabled loader is simply called.
+     */
+    std::shared_ptr<QWidget> getOrComputeWidget(
+        const QString& key,
+        const std::function<std::shared_ptr<QWidget>()>& loader);
+    QString getOrComputeStylesheet(const QString& key,
+                                   const std::function<QString()>& loader);
+    QVariant getOrComputeProperty(const QString& key,
+                                  const std::function<QVariant()>& loader);
+    QByteArray getOrComputeFileContent(
+        const QString& file_path, const std::function<QByteArray()>& loader);
+    QJsonObject getOrComputeJSON(const QString& key,
+                                 const std::function<QJsonObject()>& loader);
+
+    /**
+     * @brief Replay loader failures of a cache for ttl instead of retrying.
+     */
+    void setNegativeCacheTTL(const QString& cache_name,
+                             std::chrono::milliseconds ttl);
+
     /** @name Invalidation APIs */
     void invalidateCache(const QString& cache_name);
     void invalidateKey(const QString& cache_name, const QString& key);
@@ -458,11 +1184,33 @@ public:
     double getOverallHitRatio() const;
     size_t getTotalMemoryUsage() const;
 
+    /**
+     * @brief Memory accounting validation.
+     *
+     * beginMemoryValidation() snapshots the tracked cache total and the
+     * allocator's bytes in use. memoryValidationReport() returns both deltas
+     * since then and their ratio, so a workload run in between shows how far
+     * the estimators drift from what was really allocated. Allocator figures
+     * come from mallinfo2() and are only available with glibc; elsewhere the
+     * report has "supported" set to false.
+     */
+    void beginMemoryValidation();
+    QJsonObject memoryValidationReport() const;
+
     /** @name Global configuration */
     void setGlobalMemoryLimit(size_t limit_mb);
     void setCleanupInterval(int seconds);
     void enableCompressionForCache(const QString& cache_name, bool enabled);
 
+    /**
+     * @brief Rebuild a cache in sharded mode with the given shard count.
+     *
+     * Limits and eviction policy are preserved; cached entries are dropped.
+     * Intended for start-up configuration before the cache is shared across
+     * threads.
+     */
+    void setCacheShardCount(const QString& cache_name, size_t shard_count);
+
 signals:
     /**
      * @brief Emitted when a cache lookup results in a hit.
@@ -509,11 +1257,11 @@ private slots:
     void onMemoryPressure();
 
 private:
-    std::unique_ptr<WidgetCache> widget_cache_;
-    std::unique_ptr<StylesheetCache> stylesheet_cache_;
-    std::unique_ptr<PropertyCache> property_cache_;
-    std::unique_ptr<FileContentCache> file_content_cache_;
-    std::unique_ptr<JSONCache> json_cache_;
+    std::shared_ptr<WidgetCache> widget_cache_;
+    std::shared_ptr<StylesheetCache> stylesheet_cache_;
+    std::shared_ptr<PropertyCache> property_cache_;
+    std::shared_ptr<FileContentCache> file_content_cache_;
+    std::shared_ptr<JSONCache> json_cache_;
 
     std::unordered_map<QString, std::unique_ptr<QObject>>
         custom_caches_; /**< Generic custom cache registry. */
@@ -533,12 +1281,75 @@ private:
     mutable std::shared_mutex
         global_mutex_; /**< Protects global registries and memory accounting. */
 
+    std::unique_ptr<PersistentCacheStore>
+        json_store_; /**< Optional on-disk tier behind json_cache_. */
+    std::unordered_map<QString, PersistentCacheStamp>
+        json_file_stamps_; /**< File identity of entries cached by path. */
+    size_t warmed_json_entries_ = 0; /**< Entries loaded by the last warm-up. */
+    size_t json_disk_hits_ = 0; /**< Lookups served from json_store_. */
+
+    bool memory_validation_active_ = false; /**< Guarded by global_mutex_. */
+    size_t validation_tracked_baseline_ = 0;
+    std::optional<size_t> validation_allocator_baseline_;
+
+    std::unique_ptr<ParallelProcessor>
+        refresh_processor_; /**< Runs refresh-ahead reloads. */
+    std::atomic<bool> refresh_ahead_enabled_{false};
+    std::atomic<int64_t> refresh_window_ms_{
+        0}; /**< Hits this close to expiry trigger a refresh. */
+    std::unordered_set<QString>
+        refreshes_pending_; /**< "cache:key" of refreshes in flight. */
+    size_t refreshes_in_flight_ = 0;
+    std::unordered_map<QString, PersistentCacheStamp>
+        file_content_stamps_; /**< File identity of cached file contents. */
+    mutable std::mutex refresh_mutex_; /**< Guards the three members above
+                                          and refresh_processor_. */
+    std::condition_variable refresh_done_;
+    std::atomic<size_t> refreshes_scheduled_{0};
+    std::atomic<size_t> refreshed_in_time_{
+        0}; /**< Finished before the old entry expired. */
+    std::atomic<size_t> refreshed_late_{
+        0}; /**< Finished after it expired; readers missed meanwhile. */
+    std::atomic<size_t> refreshes_served_stale_{
+        0}; /**< Triggered by a file change, so readers got old content. */
+    std::atomic<size_t> stale_reads_{
+        0}; /**< Hits answered with content of a since-changed file. */
+    std::atomic<size_t> refresh_failures_{0};
+    mutable std::mutex
+        json_store_mutex_; /**< Guards json_store_ and json_file_stamps_. */
+
     /** Initialization helpers and internal maintenance routines. */
     void initializeDefaultCaches();
     void checkMemoryPressure();
     void performGlobalCleanup();
     size_t calculateTotalMemoryUsage() const;
     void evictFromLargestCache();
+    size_t warmJSONCacheFromStore(bool verify_content);
+
+    /**
+     * @brief Refresh-ahead helpers.
+     * - inRefreshWindow: whether a hit on an entry with this deadline should
+     *   trigger a refresh.
+     * - scheduleRefresh: run reload on the pool unless one is pending for the
+     *   same cache and key; stale marks refreshes triggered by a file change.
+     * - refreshFileContentIfNeeded: stat check and window check for a file
+     *   content hit.
+     * - reloadFileContent / reloadJSONFile: re-read a file into its cache;
+     *   return false (and drop the entry) when that fails.
+     */
+    bool inRefreshWindow(std::chrono::steady_clock::time_point expiry) const;
+    void scheduleRefresh(const QString& cache_name, const QString& key,
+                         std::chrono::steady_clock::time_point expiry,
+                         bool stale, std::function<bool()> reload);
+    void refreshFileContentIfNeeded(const QString& file_path);
+    bool reloadFileContent(const QString& file_path);
+    bool reloadJSONFile(const QString& file_path);
+
+    template <typename CacheType>
+    typename CacheType::ValueType getOrComputeIn(
+        const QString& cache_name, const std::shared_ptr<CacheType>& cache,
+        const QString& key,
+        const std::function<typename CacheType::ValueType()>& loader);
 };
 
 }  // namespace DeclarativeUI::Core
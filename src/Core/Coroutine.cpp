@@ -0,0 +1,63 @@
+#include "Coroutine.hpp"
+
+#include <QCoreApplication>
+#include <QMetaObject>
+#include <QThread>
+
+namespace DeclarativeUI::Core {
+
+// **OperationCancelled implementation**
+const char* OperationCancelled::what() const noexcept {
+    return "Operation cancelled";
+}
+
+// **CancellationToken implementation**
+CancellationToken::CancellationToken() : state_(std::make_shared<State>()) {}
+
+void CancellationToken::cancel() const {
+    state_->cancelled.store(true, std::memory_order_release);
+}
+
+bool CancellationToken::isCancelled() const {
+    for (const State* state = state_.get(); state;
+         state = state->parent.get()) {
+        if (state->cancelled.load(std::memory_order_acquire)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CancellationToken::throwIfCancelled() const {
+    if (isCancelled()) {
+        throw OperationCancelled();
+    }
+}
+
+void CancellationToken::linkTo(const CancellationToken& parent) const {
+    state_->parent = parent.state_;
+}
+
+// **ResumeOnPool implementation**
+void ResumeOnPool::await_suspend(std::coroutine_handle<> handle) const {
+    // Throws if the pool is stopped; the coroutine then sees the exception
+    pool_->post(priority_, [handle] { handle.resume(); });
+}
+
+// **ResumeOnMainThread implementation**
+bool ResumeOnMainThread::await_ready() const {
+    QObject* context = context_ ? context_ : QCoreApplication::instance();
+    return context && context->thread() == QThread::currentThread();
+}
+
+void ResumeOnMainThread::await_suspend(std::coroutine_handle<> handle) const {
+    QObject* context = context_ ? context_ : QCoreApplication::instance();
+    if (!context) {
+        throw std::runtime_error(
+            "resumeOnMainThread() needs a QCoreApplication");
+    }
+    QMetaObject::invokeMethod(
+        context, [handle] { handle.resume(); }, Qt::QueuedConnection);
+}
+
+}  // namespace DeclarativeUI::Core
@@ -0,0 +1,513 @@
+#pragma once
+
+#include <QFuture>
+#include <QFutureInterface>
+#include <QObject>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "ParallelProcessor.hpp"
+
+namespace DeclarativeUI::Core {
+
+/**
+ * @file Coroutine.hpp
+ * @brief C++20 coroutine tasks that move between the thread pool and the
+ * main (GUI) thread.
+ *
+ * A multi-stage job (read on a worker, parse on a worker, build widgets on
+ * the main thread) written with QFutureInterface and signals needs a new
+ * future, a pool task and a queued callback for every stage. With CoTask the
+ * same job is one straight-line function:
+ *
+ * @code
+ * CoTask<QJsonObject> loadUi(ParallelProcessor& processor, QString path) {
+ *     co_await resumeOn(processor);
+ *     QJsonObject json = co_await parseFile(path);  // Child task, no hop
+ *     co_await resumeOnMainThread();
+ *     buildWidgets(json);
+ *     co_return json;
+ * }
+ *
+ * QFuture<QJsonObject> future = loadUi(processor, path).start();
+ * @endcode
+ *
+ * - CoTask<T> is lazy: the body runs once the task is awaited by another
+ *   CoTask or handed to start(), which returns a QFuture for non-coroutine
+ *   callers.
+ * - Awaiting a child task, or a hop to the thread the coroutine is already
+ *   on, does not touch any queue: the child runs inline, and when it
+ *   finishes without suspending the caller continues on the same stack
+ *   frame, so long loops over child tasks do not grow the stack.
+ * - resumeOn() continues on a pool worker, resumeOnMainThread() through the
+ *   event loop of a QObject's thread, and co_await on a QFuture continues on
+ *   the thread that finished the future.
+ * - Cancellation is structured: every task has a CancellationToken, and a
+ *   child's token is linked to its parent's when it is awaited, so
+ *   cancelling a task cancels everything it is waiting on. Cancellation is
+ *   observed at the next co_await, which throws OperationCancelled.
+ *
+ * A coroutine suspended on a hop that never runs (the pool was shut down,
+ * the context object was deleted, the awaited future never finishes) stays
+ * suspended and its frame is not reclaimed.
+ */
+
+/**
+ * @brief Thrown at a co_await of a cancelled task, and when an awaited
+ * QFuture was canceled.
+ */
+class OperationCancelled : public std::exception {
+public:
+    const char* what() const noexcept override;
+};
+
+/**
+ * @brief Shared cancellation flag of a CoTask.
+ *
+ * Copies share the flag. A token also reports cancellation when the token
+ * of the task awaiting its task is cancelled.
+ */
+class CancellationToken {
+public:
+    CancellationToken();
+
+    void cancel() const;
+    bool isCancelled() const;
+
+    /**
+     * @brief Throw OperationCancelled if cancellation was requested; for
+     * long loops without a co_await.
+     */
+    void throwIfCancelled() const;
+
+private:
+    template <typename T>
+    friend class CoTask;
+
+    // Called before the child task starts and never again
+    void linkTo(const CancellationToken& parent) const;
+
+    struct State {
+        std::atomic<bool> cancelled{false};
+        std::shared_ptr<const State> parent;
+    };
+    std::shared_ptr<State> state_;
+};
+
+template <typename T = void>
+class CoTask;
+
+/**
+ * @brief Tag for co_await currentCancellationToken(): yields the token of
+ * the running task without suspending.
+ */
+struct CurrentCancellationToken {};
+
+inline CurrentCancellationToken currentCancellationToken() { return {}; }
+
+/**
+ * @brief Awaiter returned by resumeOn(). Resumes the coroutine on a worker
+ * of the pool; a no-op when already on one.
+ */
+class ResumeOnPool {
+public:
+    ResumeOnPool(ThreadPool& pool, TaskPriority priority)
+        : pool_(&pool), priority_(priority) {}
+
+    bool await_ready() const { return pool_->is_worker_thread(); }
+    void await_suspend(std::coroutine_handle<> handle) const;
+    void await_resume() const noexcept {}
+
+private:
+    ThreadPool* pool_;
+    TaskPriority priority_;
+};
+
+/**
+ * @brief Awaiter returned by resumeOnMainThread(). Resumes the coroutine
+ * through the event loop of the context object's thread; a no-op when
+ * already on that thread.
+ */
+class ResumeOnMainThread {
+public:
+    explicit ResumeOnMainThread(QObject* context) : context_(context) {}
+
+    bool await_ready() const;
+
+    /**
+     * @throws std::runtime_error if no context was given and there is no
+     * QCoreApplication.
+     */
+    void await_suspend(std::coroutine_handle<> handle) const;
+    void await_resume() const noexcept {}
+
+private:
+    QObject* context_;
+};
+
+inline ResumeOnPool resumeOn(ThreadPool& pool,
+                             TaskPriority priority = TaskPriority::Normal) {
+    return ResumeOnPool(pool, priority);
+}
+
+inline ResumeOnPool resumeOn(ParallelProcessor& processor,
+                             TaskPriority priority = TaskPriority::Normal) {
+    return ResumeOnPool(processor.threadPool(), priority);
+}
+
+/**
+ * @brief Continue on the thread of context, or on the application's main
+ * thread when context is null. The context object must outlive the hop.
+ */
+inline ResumeOnMainThread resumeOnMainThread(QObject* context = nullptr) {
+    return ResumeOnMainThread(context);
+}
+
+namespace detail {
+
+template <typename T>
+struct IsQFuture : std::false_type {};
+
+template <typename R>
+struct IsQFuture<QFuture<R>> : std::true_type {
+    using ResultType = R;
+};
+
+/**
+ * @brief Awaits a QFuture without blocking: the coroutine continues on the
+ * thread that finishes the future, or inline if it already has.
+ */
+template <typename R>
+class QFutureAwaiter {
+public:
+    explicit QFutureAwaiter(QFuture<R> future) : future_(std::move(future)) {}
+
+    bool await_ready() const { return future_.isFinished(); }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        // The continuation may run (and destroy this awaiter) before then()
+        // returns, so work on a copy
+        QFuture<R> future = future_;
+        future
+            .then(QtFuture::Launch::Sync,
+                  [handle](const QFuture<R>&) { handle.resume(); })
+            .onCanceled([handle] { handle.resume(); });
+    }
+
+    R await_resume() {
+        // Qt marks futures holding an exception as canceled too, so let
+        // waitForFinished() rethrow before treating it as a cancellation
+        if (future_.isCanceled() && !future_.isFinished()) {
+            throw OperationCancelled();
+        }
+        future_.waitForFinished();
+        if (future_.isCanceled()) {
+            throw OperationCancelled();
+        }
+        if constexpr (!std::is_void_v<R>) {
+            if (future_.resultCount() == 0) {
+                throw std::runtime_error("Awaited QFuture has no result");
+            }
+            return future_.result();
+        }
+    }
+
+private:
+    QFuture<R> future_;
+};
+
+/**
+ * @brief Wraps every awaiter in a CoTask body so cancellation is checked
+ * before suspending and after resuming.
+ */
+template <typename Awaiter>
+class CancellableAwaiter {
+public:
+    CancellableAwaiter(Awaiter&& inner, const CancellationToken& token)
+        : inner_(std::forward<Awaiter>(inner)), token_(token) {}
+
+    bool await_ready() {
+        return token_.isCancelled() || inner_.await_ready();
+    }
+
+    template <typename Promise>
+    decltype(auto) await_suspend(std::coroutine_handle<Promise> handle) {
+        return inner_.await_suspend(handle);
+    }
+
+    decltype(auto) await_resume() {
+        token_.throwIfCancelled();
+        return inner_.await_resume();
+    }
+
+private:
+    Awaiter inner_;  // Value for temporaries, reference for lvalues
+    const CancellationToken& token_;
+};
+
+struct TokenAwaiter {
+    CancellationToken token;
+
+    bool await_ready() const noexcept { return true; }
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+    CancellationToken await_resume() const { return token; }
+};
+
+class CoPromiseBase {
+public:
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        void await_suspend(
+            std::coroutine_handle<Promise> handle) const noexcept {
+            auto& promise = handle.promise();
+            // Second to arrive resumes the awaiting coroutine; if the
+            // awaiter is still in await_suspend it carries on by itself
+            if (promise.handoff_.exchange(true, std::memory_order_acq_rel)) {
+                promise.continuation_.resume();
+            }
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    template <typename Awaitable>
+    auto await_transform(Awaitable&& awaitable) {
+        using Raw = std::remove_cvref_t<Awaitable>;
+        if constexpr (std::is_same_v<Raw, CurrentCancellationToken>) {
+            return TokenAwaiter{token_};
+        } else if constexpr (IsQFuture<Raw>::value) {
+            using Awaiter = QFutureAwaiter<typename IsQFuture<Raw>::ResultType>;
+            return CancellableAwaiter<Awaiter>(
+                Awaiter(std::forward<Awaitable>(awaitable)), token_);
+        } else if constexpr (requires {
+                                 std::forward<Awaitable>(awaitable)
+                                     .operator co_await();
+                             }) {
+            using Awaiter = decltype(std::forward<Awaitable>(awaitable)
+                                         .operator co_await());
+            return CancellableAwaiter<Awaiter>(
+                std::forward<Awaitable>(awaitable).operator co_await(),
+                token_);
+        } else {
+            return CancellableAwaiter<Awaitable>(
+                std::forward<Awaitable>(awaitable), token_);
+        }
+    }
+
+    const CancellationToken& token() const { return token_; }
+
+private:
+    template <typename T>
+    friend class ::DeclarativeUI::Core::CoTask;
+
+    std::coroutine_handle<> continuation_;
+    std::atomic<bool> handoff_{false};
+    CancellationToken token_;
+};
+
+template <typename T>
+class CoPromise : public CoPromiseBase {
+public:
+    CoTask<T> get_return_object() noexcept;
+
+    void return_value(T value) {
+        result_.template emplace<1>(std::move(value));
+    }
+
+    void unhandled_exception() noexcept {
+        result_.template emplace<2>(std::current_exception());
+    }
+
+    T result() {
+        if (result_.index() == 2) {
+            std::rethrow_exception(std::get<2>(result_));
+        }
+        return std::move(std::get<1>(result_));
+    }
+
+private:
+    std::variant<std::monostate, T, std::exception_ptr> result_;
+};
+
+template <>
+class CoPromise<void> : public CoPromiseBase {
+public:
+    CoTask<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() noexcept {
+        exception_ = std::current_exception();
+    }
+
+    void result() const {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+private:
+    std::exception_ptr exception_;
+};
+
+/**
+ * @brief Fire-and-forget coroutine behind CoTask::start(); its frame frees
+ * itself when the body returns.
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+template <typename T>
+DetachedTask runDetached(CoTask<T> task, QFutureInterface<T> interface);
+
+}  // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a T.
+ *
+ * Move-only and owning: destroying a task that has not been started
+ * destroys its frame. Await a task with co_await std::move(task) (or on a
+ * temporary); exceptions thrown in the body are rethrown to the awaiter.
+ */
+template <typename T>
+class [[nodiscard]] CoTask {
+public:
+    using promise_type = detail::CoPromise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    static_assert(!std::is_reference_v<T>, "CoTask cannot return references");
+
+    explicit CoTask(handle_type handle) noexcept : handle_(handle) {}
+
+    CoTask(CoTask&& other) noexcept
+        : handle_(std::exchange(other.handle_, {})) {}
+
+    CoTask& operator=(CoTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool isValid() const { return static_cast<bool>(handle_); }
+
+    /**
+     * @brief The task's token; stays usable after the task was started.
+     */
+    CancellationToken token() const { return handle_.promise().token(); }
+
+    void cancel() const { handle_.promise().token().cancel(); }
+
+    /**
+     * @brief Run the task without a coroutine caller.
+     *
+     * The body runs on the calling thread up to its first hop. The returned
+     * future reports the result, the exception thrown by the body, or
+     * cancellation. Cancel through token(), not through the future.
+     */
+    QFuture<T> start() && {
+        QFutureInterface<T> interface;
+        interface.reportStarted();
+        QFuture<T> future = interface.future();
+        if (handle_.promise().token().isCancelled()) {
+            interface.reportCanceled();
+            interface.reportFinished();
+        } else {
+            detail::runDetached(std::move(*this), std::move(interface));
+        }
+        return future;
+    }
+
+    class Awaiter {
+    public:
+        explicit Awaiter(handle_type handle) noexcept : handle_(handle) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> awaiting) noexcept {
+            auto& promise = handle_.promise();
+            promise.continuation_ = awaiting;
+            if constexpr (std::is_base_of_v<detail::CoPromiseBase, Promise>) {
+                promise.token_.linkTo(awaiting.promise().token());
+            }
+            handle_.resume();
+            // Stay suspended only if the child is still running
+            return !promise.handoff_.exchange(true, std::memory_order_acq_rel);
+        }
+
+        T await_resume() { return handle_.promise().result(); }
+
+    private:
+        handle_type handle_;
+    };
+
+    Awaiter operator co_await() && noexcept { return Awaiter(handle_); }
+
+private:
+    handle_type handle_;
+};
+
+namespace detail {
+
+template <typename T>
+CoTask<T> CoPromise<T>::get_return_object() noexcept {
+    return CoTask<T>(std::coroutine_handle<CoPromise<T>>::from_promise(*this));
+}
+
+inline CoTask<void> CoPromise<void>::get_return_object() noexcept {
+    return CoTask<void>(
+        std::coroutine_handle<CoPromise<void>>::from_promise(*this));
+}
+
+template <typename T>
+DetachedTask runDetached(CoTask<T> task, QFutureInterface<T> interface) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+        } else {
+            interface.reportResult(co_await std::move(task));
+        }
+    } catch (const OperationCancelled&) {
+        interface.reportCanceled();
+    } catch (...) {
+        interface.reportException(std::current_exception());
+    }
+    interface.reportFinished();
+}
+
+}  // namespace detail
+
+}  // namespace DeclarativeUI::Core
@@ -0,0 +1,174 @@
+#include "FileView.hpp"
+
+#include <QFile>
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DeclarativeUI::Core {
+
+struct FileView::Storage {
+    QString path;
+    QString error;
+    bool valid = false;
+    bool mapped = false;
+    const char* data = nullptr;
+    qsizetype size = 0;
+    QByteArray buffer;
+#ifndef Q_OS_UNIX
+    std::unique_ptr<QFile> file;  // Owns the mapping
+#endif
+
+    Storage() = default;
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    ~Storage() {
+#ifdef Q_OS_UNIX
+        if (mapped) {
+            ::munmap(const_cast<char*>(data), static_cast<size_t>(size));
+        }
+#endif
+    }
+
+    void useBuffer() {
+        data = buffer.constData();
+        size = buffer.size();
+        valid = true;
+    }
+};
+
+namespace {
+
+#ifdef Q_OS_UNIX
+QString errnoString() { return QString::fromLocal8Bit(std::strerror(errno)); }
+
+// Read up to size bytes; a file that shrank meanwhile yields fewer
+bool readAll(int fd, QByteArray& buffer, qsizetype size) {
+    buffer.resize(size);
+    qsizetype total = 0;
+    while (total < size) {
+        const ssize_t n = ::read(fd, buffer.data() + total,
+                                 static_cast<size_t>(size - total));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+        total += n;
+    }
+    buffer.truncate(total);
+    return true;
+}
+#endif
+
+}  // namespace
+
+// **FileView implementation**
+FileView FileView::open(const QString& path, qsizetype map_threshold) {
+    auto storage = std::make_shared<Storage>();
+    storage->path = path;
+
+#ifdef Q_OS_UNIX
+    const int fd = ::open(QFile::encodeName(path).constData(),
+                          O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        storage->error = errnoString();
+    } else {
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            storage->error = errnoString();
+        } else if (!S_ISREG(info.st_mode)) {
+            storage->error = QStringLiteral("Not a regular file");
+        } else {
+            const auto size = static_cast<qsizetype>(info.st_size);
+            if (size > 0 && size >= map_threshold) {
+                void* address = ::mmap(nullptr, static_cast<size_t>(size),
+                                       PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address != MAP_FAILED) {
+                    ::madvise(address, static_cast<size_t>(size),
+                              MADV_SEQUENTIAL);
+                    storage->data = static_cast<const char*>(address);
+                    storage->size = size;
+                    storage->mapped = true;
+                    storage->valid = true;
+                }
+            }
+            if (!storage->mapped) {
+                if (readAll(fd, storage->buffer, size)) {
+                    storage->useBuffer();
+                } else {
+                    storage->error = errnoString();
+                }
+            }
+        }
+        ::close(fd);  // A mapping stays valid without the descriptor
+    }
+#else
+    auto file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        storage->error = file->errorString();
+    } else {
+        const qint64 size = file->size();
+        if (size > 0 && size >= map_threshold) {
+            if (uchar* address = file->map(0, size)) {
+                storage->data = reinterpret_cast<const char*>(address);
+                storage->size = static_cast<qsizetype>(size);
+                storage->mapped = true;
+                storage->valid = true;
+                storage->file = std::move(file);
+            }
+        }
+        if (!storage->mapped) {
+            storage->buffer = file->readAll();
+            storage->useBuffer();
+        }
+    }
+#endif
+
+    FileView view;
+    view.storage_ = std::move(storage);
+    return view;
+}
+
+bool FileView::isValid() const { return storage_ && storage_->valid; }
+
+bool FileView::isMapped() const { return storage_ && storage_->mapped; }
+
+const char* FileView::data() const {
+    return storage_ ? storage_->data : nullptr;
+}
+
+qsizetype FileView::size() const { return storage_ ? storage_->size : 0; }
+
+QUtf8StringView FileView::utf8() const {
+    QByteArrayView view = bytes();
+    if (view.startsWith("\xEF\xBB\xBF")) {
+        view = view.sliced(3);
+    }
+    return QUtf8StringView(view.data(), view.size());
+}
+
+QString FileView::toString() const {
+    const QUtf8StringView text = utf8();
+    return QString::fromUtf8(text.data(), text.size());
+}
+
+QString FileView::path() const { return storage_ ? storage_->path : QString(); }
+
+QString FileView::errorString() const {
+    return storage_ ? storage_->error : QString();
+}
+
+}  // namespace DeclarativeUI::Core
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QUtf8StringView>
+
+#include <memory>
+
+namespace DeclarativeUI::Core {
+
+/**
+ * @file FileView.hpp
+ * @brief Read-only, zero-copy access to the bytes of a file.
+ *
+ * UI definitions, stylesheets and JSON are UTF-8 on disk. Decoding them into
+ * a QString doubles their size and costs a pass over every byte before a
+ * parser even starts, and most parsers (QJsonDocument::fromJson among them)
+ * take UTF-8 bytes anyway. FileView hands out those bytes directly:
+ *
+ * - Files of at least the map threshold are memory-mapped, so the view
+ *   costs no copy and pages are read in on demand. On Unix this is mmap();
+ *   elsewhere QFile::map().
+ * - Smaller files are read into one buffer with a single allocation, which
+ *   is cheaper than setting up and tearing down a mapping.
+ *
+ * Views are cheap to copy and share their storage; the mapping is released
+ * with the last copy. A mapped file must not be truncated while a view of it
+ * is alive.
+ */
+class FileView {
+public:
+    static constexpr qsizetype kDefaultMapThreshold = 64 * 1024;
+
+    /**
+     * @brief A null view: not valid, no path.
+     */
+    FileView() = default;
+
+    /**
+     * @brief Open path and map or read it.
+     *
+     * Never throws; on failure the view is invalid and errorString() says
+     * why.
+     */
+    static FileView open(const QString& path,
+                         qsizetype map_threshold = kDefaultMapThreshold);
+
+    /**
+     * @brief Whether the file was read; an empty file gives a valid view.
+     */
+    bool isValid() const;
+    bool isMapped() const;
+
+    const char* data() const;
+    qsizetype size() const;
+    bool isEmpty() const { return size() == 0; }
+
+    QByteArrayView bytes() const { return QByteArrayView(data(), size()); }
+
+    /**
+     * @brief The contents as UTF-8 text, without a leading byte order mark.
+     */
+    QUtf8StringView utf8() const;
+
+    /**
+     * @brief Decode utf8() into a QString (copies).
+     */
+    QString toString() const;
+
+    QString path() const;
+    QString errorString() const;
+
+private:
+    struct Storage;
+    std::shared_ptr<const Storage> storage_;
+};
+
+}  // namespace DeclarativeUI::Core
@@ -1,14 +1,31 @@
 #include "MemoryManager.hpp"
 
 #include <QDebug>
+#include <QFile>
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
+#include <limits>
 #include <mutex>
+#include <string_view>
+
+#include "MemoryResource.hpp"
+#include "SlabAllocator.hpp"
 #ifdef _WIN32
 #include <malloc.h>
 #endif
+#ifdef __GLIBC__
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#define DECLARATIVEUI_HAS_BACKTRACE 1
+#endif
 
 namespace DeclarativeUI::Core {
 
@@ -59,14 +76,637 @@ void MemoryArena::reset() {
     std::memset(memory_, 0, total_bytes_);
 }
 
+// **ChunkedArena implementation**
+ChunkedArena::ChunkedArena(size_t initial_chunk_size, size_t max_chunk_size)
+    : next_chunk_size_(std::max<size_t>(initial_chunk_size, 256)),
+      max_chunk_size_(std::max(max_chunk_size, next_chunk_size_)) {
+    head_ = allocate_chunk(next_chunk_size_);
+    current_.store(head_);
+}
+
+ChunkedArena::~ChunkedArena() {
+    run_destructors(nullptr);
+    while (head_) {
+        Chunk* next = head_->next;
+        free_chunk(head_);
+        head_ = next;
+    }
+}
+
+ChunkedArena::Chunk* ChunkedArena::allocate_chunk(size_t capacity) {
+    void* memory = ::operator new(sizeof(Chunk) + capacity,
+                                  std::align_val_t(alignof(Chunk)));
+    auto* chunk = new (memory) Chunk();
+    chunk->capacity = capacity;
+    return chunk;
+}
+
+void ChunkedArena::free_chunk(Chunk* chunk) {
+    chunk->~Chunk();
+    ::operator delete(chunk, std::align_val_t(alignof(Chunk)));
+}
+
+void* ChunkedArena::allocate(size_t size, size_t alignment) {
+    for (;;) {
+        Chunk* chunk = current_.load(std::memory_order_acquire);
+        const auto base = reinterpret_cast<uintptr_t>(chunk->data());
+        size_t offset = chunk->used.load(std::memory_order_relaxed);
+
+        for (;;) {
+            const size_t aligned =
+                ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+            if (aligned + size > chunk->capacity) {
+                break;
+            }
+            if (chunk->used.compare_exchange_weak(offset, aligned + size,
+                                                  std::memory_order_relaxed)) {
+                return chunk->data() + aligned;
+            }
+        }
+
+        grow(chunk, size, alignment);
+    }
+}
+
+void ChunkedArena::grow(Chunk* exhausted, size_t size, size_t alignment) {
+    std::lock_guard<std::mutex> lock(growth_mutex_);
+    if (current_.load(std::memory_order_relaxed) != exhausted) {
+        return;  // Another thread already moved on
+    }
+
+    const size_t needed = size + alignment;
+    Chunk* next = exhausted->next;
+    if (!next || next->capacity < needed) {
+        // Spare chunks after a rollback are reused when large enough;
+        // otherwise a fresh chunk is spliced in front of them.
+        const size_t capacity = std::max(next_chunk_size_, needed);
+        next_chunk_size_ = std::min(next_chunk_size_ * 2, max_chunk_size_);
+        Chunk* fresh = allocate_chunk(capacity);
+        fresh->next = exhausted->next;
+        exhausted->next = fresh;
+        next = fresh;
+    }
+
+    next->used.store(0, std::memory_order_relaxed);
+    current_.store(next, std::memory_order_release);
+}
+
+void ChunkedArena::register_destructor(void* object, void (*destroy)(void*)) {
+    auto* record = static_cast<DestructorRecord*>(
+        allocate(sizeof(DestructorRecord), alignof(DestructorRecord)));
+    record->destroy = destroy;
+    record->object = object;
+
+    DestructorRecord* head = destructors_.load(std::memory_order_relaxed);
+    do {
+        record->next = head;
+    } while (!destructors_.compare_exchange_weak(head, record,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+}
+
+void ChunkedArena::run_destructors(DestructorRecord* until) {
+    DestructorRecord* record = destructors_.load(std::memory_order_acquire);
+    while (record && record != until) {
+        record->destroy(record->object);
+        record = record->next;
+    }
+    destructors_.store(until, std::memory_order_relaxed);
+}
+
+ChunkedArena::Marker ChunkedArena::mark() const {
+    Marker marker;
+    marker.chunk = current_.load(std::memory_order_acquire);
+    marker.offset = marker.chunk->used.load(std::memory_order_relaxed);
+    marker.destructors = destructors_.load(std::memory_order_acquire);
+    return marker;
+}
+
+void ChunkedArena::rollback(const Marker& marker) {
+    if (!marker.chunk) {
+        return;
+    }
+
+    // Destructors registered after the marker sit in front of it in the list
+    run_destructors(marker.destructors);
+
+    std::lock_guard<std::mutex> lock(growth_mutex_);
+    marker.chunk->used.store(marker.offset, std::memory_order_relaxed);
+    current_.store(marker.chunk, std::memory_order_release);
+}
+
+void ChunkedArena::reset() {
+    Marker start;
+    start.chunk = head_;
+    rollback(start);
+}
+
+size_t ChunkedArena::release_unused_chunks() {
+    std::lock_guard<std::mutex> lock(growth_mutex_);
+    Chunk* current = current_.load(std::memory_order_relaxed);
+
+    size_t released = 0;
+    Chunk* spare = current->next;
+    current->next = nullptr;
+    while (spare) {
+        Chunk* next = spare->next;
+        released += sizeof(Chunk) + spare->capacity;
+        free_chunk(spare);
+        spare = next;
+    }
+    return released;
+}
+
+size_t ChunkedArena::used_bytes() const {
+    std::lock_guard<std::mutex> lock(growth_mutex_);
+    const Chunk* current = current_.load(std::memory_order_relaxed);
+
+    size_t used = 0;
+    for (const Chunk* chunk = head_; chunk; chunk = chunk->next) {
+        used += chunk->used.load(std::memory_order_relaxed);
+        if (chunk == current) {
+            break;
+        }
+    }
+    return used;
+}
+
+size_t ChunkedArena::total_bytes() const {
+    std::lock_guard<std::mutex> lock(growth_mutex_);
+    size_t total = 0;
+    for (const Chunk* chunk = head_; chunk; chunk = chunk->next) {
+        total += chunk->capacity;
+    }
+    return total;
+}
+
+size_t ChunkedArena::chunk_count() const {
+    std::lock_guard<std::mutex> lock(growth_mutex_);
+    size_t count = 0;
+    for (const Chunk* chunk = head_; chunk; chunk = chunk->next) {
+        ++count;
+    }
+    return count;
+}
+
+double ChunkedArena::usage_percentage() const {
+    const size_t total = total_bytes();
+    return total > 0 ? static_cast<double>(used_bytes()) / total * 100.0 : 0.0;
+}
+
+// **HandleArena implementation**
+HandleArena::Pin::Pin(HandleArena& arena, Handle handle)
+    : arena_(arena), handle_(handle), ptr_(arena.pin(handle)) {}
+
+HandleArena::Pin::~Pin() {
+    if (ptr_) {
+        arena_.unpin(handle_);
+    }
+}
+
+HandleArena::HandleArena(size_t chunk_size)
+    : chunk_size_(std::max<size_t>(chunk_size, 256)) {}
+
+HandleArena::~HandleArena() {
+    for (Slot& slot : slots_) {
+        if (slot.chunk && slot.destroy) {
+            slot.destroy(slot.chunk->data + slot.offset);
+        }
+    }
+    for (auto& chunk : chunks_) {
+        ::operator delete(chunk->data,
+                          std::align_val_t(alignof(std::max_align_t)));
+    }
+}
+
+HandleArena::Chunk* HandleArena::new_chunk(size_t min_size, bool survivor) {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->capacity = std::max(chunk_size_, min_size);
+    chunk->data = static_cast<char*>(::operator new(
+        chunk->capacity, std::align_val_t(alignof(std::max_align_t))));
+    chunk->survivor = survivor;
+    chunks_.push_back(std::move(chunk));
+    return chunks_.back().get();
+}
+
+void HandleArena::release_chunk(Chunk* chunk) {
+    if (chunk == nursery_) {
+        nursery_ = nullptr;
+    }
+    if (chunk == survivor_) {
+        survivor_ = nullptr;
+    }
+    if (chunk == compaction_source_) {
+        compaction_source_ = nullptr;
+        compaction_cursor_ = 0;
+    }
+    ::operator delete(chunk->data,
+                      std::align_val_t(alignof(std::max_align_t)));
+    auto it = std::find_if(chunks_.begin(), chunks_.end(),
+                           [chunk](const auto& c) { return c.get() == chunk; });
+    chunks_.erase(it);
+}
+
+void* HandleArena::bump(Chunk*& target, bool survivor, size_t size,
+                        size_t alignment, size_t& offset) {
+    auto try_bump = [&](Chunk* chunk) -> void* {
+        const auto base = reinterpret_cast<uintptr_t>(chunk->data);
+        const size_t aligned =
+            ((base + chunk->used + alignment - 1) & ~(alignment - 1)) - base;
+        if (aligned + size > chunk->capacity) {
+            return nullptr;
+        }
+        chunk->used = aligned + size;
+        offset = aligned;
+        return chunk->data + aligned;
+    };
+
+    Chunk* exhausted = target;
+    if (exhausted) {
+        if (void* memory = try_bump(exhausted)) {
+            return memory;
+        }
+    }
+    target = new_chunk(size + alignment, survivor);
+    if (exhausted && exhausted->live_count == 0 &&
+        exhausted != compaction_source_) {
+        release_chunk(exhausted);
+    }
+    return try_bump(target);
+}
+
+HandleArena::Handle HandleArena::allocate(size_t size, size_t alignment,
+                                          RelocateFn relocate,
+                                          DestroyFn destroy) {
+    return allocate_block(size, alignment, relocate, destroy, nullptr);
+}
+
+HandleArena::Handle HandleArena::allocate_block(size_t size, size_t alignment,
+                                                RelocateFn relocate,
+                                                DestroyFn destroy,
+                                                void** pinned) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    uint32_t index;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    Slot& slot = slots_[index];
+    bump(nursery_, false, std::max<size_t>(size, 1), alignment, slot.offset);
+    slot.chunk = nursery_;
+    slot.size = size;
+    slot.alignment = alignment;
+    slot.pins = 0;
+    slot.relocate = relocate;
+    slot.destroy = destroy;
+
+    const Handle handle{index, slot.generation};
+    nursery_->live_bytes += size;
+    ++nursery_->live_count;
+    nursery_->blocks.push_back(handle);
+    if (pinned) {
+        slot.pins = 1;
+        ++nursery_->pinned_count;
+        *pinned = nursery_->data + slot.offset;
+    }
+    return handle;
+}
+
+void HandleArena::finish_create(Handle handle, DestroyFn destroy) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (find_slot(handle)) {
+        Slot& slot = slots_[handle.index];
+        slot.destroy = destroy;
+        if (--slot.pins == 0) {
+            --slot.chunk->pinned_count;
+        }
+    }
+}
+
+const HandleArena::Slot* HandleArena::find_slot(Handle handle) const {
+    if (!handle || handle.index >= slots_.size()) {
+        return nullptr;
+    }
+    const Slot& slot = slots_[handle.index];
+    return slot.generation == handle.generation && slot.chunk ? &slot
+                                                              : nullptr;
+}
+
+void HandleArena::free(Handle handle) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!find_slot(handle)) {
+        return;
+    }
+
+    Slot& slot = slots_[handle.index];
+    Chunk* chunk = slot.chunk;
+    if (slot.destroy) {
+        slot.destroy(chunk->data + slot.offset);
+    }
+    chunk->live_bytes -= slot.size;
+    --chunk->live_count;
+    if (slot.pins > 0) {
+        --chunk->pinned_count;  // Outstanding Pins now see a stale handle
+    }
+
+    slot.chunk = nullptr;
+    slot.pins = 0;
+    slot.relocate = nullptr;
+    slot.destroy = nullptr;
+    if (++slot.generation == 0) {
+        slot.generation = 1;  // 0 is reserved for the null handle
+    }
+    free_slots_.push_back(handle.index);
+
+    // Chunks emptied by frees go back right away, except the bump targets
+    if (chunk->live_count == 0 && chunk != nursery_ && chunk != survivor_) {
+        release_chunk(chunk);
+    }
+}
+
+void* HandleArena::resolve(Handle handle) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const Slot* slot = find_slot(handle);
+    return slot ? slot->chunk->data + slot->offset : nullptr;
+}
+
+void* HandleArena::pin(Handle handle) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!find_slot(handle)) {
+        return nullptr;
+    }
+    Slot& slot = slots_[handle.index];
+    if (slot.pins++ == 0) {
+        ++slot.chunk->pinned_count;
+    }
+    return slot.chunk->data + slot.offset;
+}
+
+void HandleArena::unpin(Handle handle) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (find_slot(handle)) {
+        Slot& slot = slots_[handle.index];
+        if (--slot.pins == 0) {
+            --slot.chunk->pinned_count;
+        }
+    }
+}
+
+HandleArena::Chunk* HandleArena::pick_compaction_source() const {
+    Chunk* sparsest = nullptr;
+    double lowest = kCompactionOccupancy;
+    for (const auto& chunk : chunks_) {
+        if (chunk.get() == nursery_ || chunk.get() == survivor_ ||
+            chunk->used == 0) {
+            continue;
+        }
+        if (chunk->live_count > 0 && chunk->live_count == chunk->pinned_count) {
+            continue;  // Nothing movable
+        }
+        const double occupancy =
+            static_cast<double>(chunk->live_bytes) / chunk->used;
+        if (occupancy < lowest) {
+            lowest = occupancy;
+            sparsest = chunk.get();
+        }
+    }
+    return sparsest;
+}
+
+bool HandleArena::needs_compaction() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return compaction_source_ || pick_compaction_source();
+}
+
+size_t HandleArena::compact_step(size_t max_bytes) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    if (!compaction_source_) {
+        compaction_source_ = pick_compaction_source();
+        compaction_cursor_ = 0;
+        if (!compaction_source_) {
+            return 0;
+        }
+    }
+
+    Chunk* source = compaction_source_;
+    size_t moved = 0;
+    while (compaction_cursor_ < source->blocks.size() && moved < max_bytes) {
+        const Handle handle = source->blocks[compaction_cursor_++];
+        const Slot* live = find_slot(handle);
+        if (!live || live->chunk != source || live->pins > 0) {
+            continue;  // Freed, already moved, or pinned in place
+        }
+
+        Slot& slot = slots_[handle.index];
+        size_t offset = 0;
+        void* to = bump(survivor_, true, std::max<size_t>(slot.size, 1),
+                        slot.alignment, offset);
+        void* from = source->data + slot.offset;
+        if (slot.relocate) {
+            slot.relocate(to, from);
+        } else {
+            std::memcpy(to, from, slot.size);
+        }
+
+        source->live_bytes -= slot.size;
+        --source->live_count;
+        survivor_->live_bytes += slot.size;
+        ++survivor_->live_count;
+        survivor_->blocks.push_back(handle);
+        slot.chunk = survivor_;
+        slot.offset = offset;
+        moved += slot.size;
+    }
+    compacted_bytes_ += moved;
+
+    if (compaction_cursor_ >= source->blocks.size()) {
+        compaction_source_ = nullptr;
+        compaction_cursor_ = 0;
+        if (source->live_count == 0) {
+            release_chunk(source);
+        } else {
+            // Pinned blocks stayed behind; drop the stale entries
+            std::erase_if(source->blocks, [&](const Handle& h) {
+                const Slot* slot = find_slot(h);
+                return !slot || slot->chunk != source;
+            });
+        }
+    }
+    return moved;
+}
+
+size_t HandleArena::compact() {
+    // An unbounded step empties its source of everything but pinned blocks,
+    // after which the source is no longer a candidate
+    size_t moved = 0;
+    while (needs_compaction()) {
+        moved += compact_step(std::numeric_limits<size_t>::max());
+    }
+    return moved;
+}
+
+double HandleArena::fragmentation() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    size_t used = 0;
+    size_t live = 0;
+    for (const auto& chunk : chunks_) {
+        used += chunk->used;
+        live += chunk->live_bytes;
+    }
+    return used > 0 ? 1.0 - static_cast<double>(live) / used : 0.0;
+}
+
+size_t HandleArena::live_bytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    size_t live = 0;
+    for (const auto& chunk : chunks_) {
+        live += chunk->live_bytes;
+    }
+    return live;
+}
+
+size_t HandleArena::used_bytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    size_t used = 0;
+    for (const auto& chunk : chunks_) {
+        used += chunk->used;
+    }
+    return used;
+}
+
+size_t HandleArena::total_bytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    size_t total = 0;
+    for (const auto& chunk : chunks_) {
+        total += chunk->capacity;
+    }
+    return total;
+}
+
+size_t HandleArena::chunk_count() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return chunks_.size();
+}
+
+size_t HandleArena::live_count() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return slots_.size() - free_slots_.size();
+}
+
+size_t HandleArena::compacted_bytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return compacted_bytes_;
+}
+
 // **MemoryLeakDetector implementation**
 MemoryLeakDetector& MemoryLeakDetector::instance() {
     static MemoryLeakDetector instance;
     return instance;
 }
 
+namespace {
+
+// Per-thread state of the sampling countdown
+struct SamplingState {
+    int64_t bytes_until_sample = 0;
+    uint64_t epoch = 0;  // Detector epoch the countdown was drawn for
+    uint64_t rng = 0;
+    bool in_detector = false;  // Re-entrancy guard for hooked allocators
+};
+
+thread_local SamplingState sampling_state;
+
+uint64_t next_random(SamplingState& state) {
+    if (state.rng == 0) {
+        state.rng = reinterpret_cast<uintptr_t>(&state) ^
+                    static_cast<uint64_t>(std::chrono::steady_clock::now()
+                                              .time_since_epoch()
+                                              .count()) ^
+                    0x9E3779B97F4A7C15ULL;
+    }
+    // xorshift64*
+    state.rng ^= state.rng >> 12;
+    state.rng ^= state.rng << 25;
+    state.rng ^= state.rng >> 27;
+    return state.rng * 0x2545F4914F6CDD1DULL;
+}
+
+// Exponentially distributed gap with the given mean
+int64_t next_sample_gap(SamplingState& state, size_t mean) {
+    const double uniform =
+        (static_cast<double>(next_random(state) >> 11) + 1.0) /
+        9007199254740993.0;  // (0, 1]
+    return static_cast<int64_t>(-std::log(uniform) *
+                                static_cast<double>(mean)) +
+           1;
+}
+
+uint64_t mix_hash(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// capture_stack(), record_sample() and track_allocation() frames
+constexpr int kSkippedFrames = 3;
+
+[[gnu::noinline]] std::vector<void*> capture_stack() {
+#ifdef DECLARATIVEUI_HAS_BACKTRACE
+    void* frames[MemoryLeakDetector::kMaxStackDepth + kSkippedFrames];
+    const int depth = ::backtrace(frames, static_cast<int>(std::size(frames)));
+    if (depth > kSkippedFrames) {
+        return std::vector<void*>(frames + kSkippedFrames, frames + depth);
+    }
+#endif
+    return {};
+}
+
+QString symbolize(void* address) {
+#ifdef DECLARATIVEUI_HAS_BACKTRACE
+    Dl_info info;
+    if (!::dladdr(address, &info)) {
+        return QString();
+    }
+    if (info.dli_sname) {
+        int status = 0;
+        char* demangled =
+            abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        QString name =
+            QString::fromUtf8(status == 0 ? demangled : info.dli_sname);
+        std::free(demangled);
+        return name;
+    }
+    if (info.dli_fname) {
+        return QString::fromUtf8(info.dli_fname);
+    }
+#else
+    (void)address;
+#endif
+    return QString();
+}
+
+QString format_address(const void* address) {
+    return "0x" + QString::number(reinterpret_cast<uintptr_t>(address), 16);
+}
+
+}  // namespace
+
+// **MemoryLeakDetector implementation**
 void MemoryLeakDetector::track_allocation(void* ptr, size_t size,
                                           const char* file, int line) {
+    if (const size_t interval =
+            sampling_interval_.load(std::memory_order_relaxed)) {
+        if (ptr && should_sample(size, interval)) {
+            record_sample(ptr, size, interval, file, line);
+        }
+        return;
+    }
+
     std::unique_lock<std::shared_mutex> lock(mutex_);
 
     AllocationInfo info;
@@ -81,6 +721,11 @@ void MemoryLeakDetector::track_allocation(void* ptr, size_t size,
 }
 
 void MemoryLeakDetector::track_deallocation(void* ptr) {
+    if (sampling_interval_.load(std::memory_order_relaxed)) {
+        release_sample(ptr);
+        return;
+    }
+
     std::unique_lock<std::shared_mutex> lock(mutex_);
 
     auto it = allocations_.find(ptr);
@@ -90,15 +735,171 @@ void MemoryLeakDetector::track_deallocation(void* ptr) {
     }
 }
 
+void MemoryLeakDetector::set_sampling_interval(size_t interval_bytes) {
+    if (sampling_interval_.exchange(interval_bytes) != interval_bytes) {
+        sampling_epoch_.fetch_add(1);
+        clear_tracking();
+    }
+}
+
+bool MemoryLeakDetector::should_sample(size_t size, size_t interval) {
+    SamplingState& state = sampling_state;
+    if (state.in_detector) {
+        return false;
+    }
+
+    const uint64_t epoch = sampling_epoch_.load(std::memory_order_relaxed);
+    if (state.epoch != epoch) {
+        state.epoch = epoch;
+        state.bytes_until_sample = next_sample_gap(state, interval);
+    }
+
+    state.bytes_until_sample -= static_cast<int64_t>(size);
+    if (state.bytes_until_sample > 0) {
+        return false;
+    }
+    state.bytes_until_sample = next_sample_gap(state, interval);
+    return true;
+}
+
+// Out of line so the frames skipped by capture_stack() stay fixed
+[[gnu::noinline]] void MemoryLeakDetector::record_sample(
+    void* ptr, size_t size, size_t interval, const char* file, int line) {
+    SamplingState& state = sampling_state;
+    state.in_detector = true;
+
+    // Probability that an allocation of this size contains a sample point
+    const double probability =
+        1.0 - std::exp(-static_cast<double>(size) / interval);
+    const double weight = probability > 0.0 ? 1.0 / probability : 1.0;
+
+    auto stack = capture_stack();
+    uint64_t site = mix_hash(std::hash<std::string_view>{}(
+                                 file ? std::string_view(file) : ""),
+                             static_cast<uint64_t>(line));
+    for (void* frame : stack) {
+        site = mix_hash(site, reinterpret_cast<uintptr_t>(frame));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sites_mutex_);
+        auto& profile = call_sites_[site];
+        if (profile.sampled_count == 0) {
+            profile.stack = std::move(stack);
+            profile.file = file ? file : "unknown";
+            profile.line = line;
+        }
+        profile.sampled_count += 1;
+        profile.sampled_bytes += size;
+        profile.live_sampled_count += 1;
+        profile.live_sampled_bytes += size;
+        profile.estimated_count += weight;
+        profile.estimated_bytes += weight * size;
+        profile.live_estimated_count += weight;
+        profile.live_estimated_bytes += weight * size;
+    }
+
+    const SampledAllocation sample{site, size, weight,
+                                   std::chrono::steady_clock::now()};
+    bool inserted = false;
+    {
+        auto& shard = sample_shards_[shard_index(ptr)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        inserted = shard.samples.insert_or_assign(ptr, sample).second;
+    }
+    if (inserted) {
+        for (size_t slot : filter_slots(ptr)) {
+            live_filter_[slot].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    total_allocated_.fetch_add(static_cast<size_t>(weight * size));
+    allocation_count_.fetch_add(1);
+    state.in_detector = false;
+}
+
+bool MemoryLeakDetector::release_sample(void* ptr) {
+    // Most frees were never sampled; the filter rejects them without locking
+    for (size_t slot : filter_slots(ptr)) {
+        if (live_filter_[slot].load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+    }
+
+    SampledAllocation sample;
+    {
+        auto& shard = sample_shards_[shard_index(ptr)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.samples.find(ptr);
+        if (it == shard.samples.end()) {
+            return false;
+        }
+        sample = it->second;
+        shard.samples.erase(it);
+    }
+    for (size_t slot : filter_slots(ptr)) {
+        live_filter_[slot].fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sites_mutex_);
+        auto it = call_sites_.find(sample.site);
+        if (it != call_sites_.end()) {
+            auto& profile = it->second;
+            profile.live_sampled_count -= 1;
+            profile.live_sampled_bytes -= sample.size;
+            profile.live_estimated_count -= sample.weight;
+            profile.live_estimated_bytes -= sample.weight * sample.size;
+        }
+    }
+    total_allocated_.fetch_sub(
+        static_cast<size_t>(sample.weight * sample.size));
+    return true;
+}
+
+size_t MemoryLeakDetector::shard_index(const void* ptr) {
+    // Drop alignment bits so neighbouring blocks spread across shards
+    return (reinterpret_cast<uintptr_t>(ptr) >> 4) % kShardCount;
+}
+
+std::array<size_t, 2> MemoryLeakDetector::filter_slots(const void* ptr) {
+    const uint64_t hash =
+        static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) *
+        0x9E3779B97F4A7C15ULL;
+    return {static_cast<size_t>(hash >> 49) % kFilterSize,
+            static_cast<size_t>(hash >> 17) % kFilterSize};
+}
+
 std::vector<MemoryLeakDetector::AllocationInfo> MemoryLeakDetector::get_leaks()
     const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-
     std::vector<AllocationInfo> leaks;
-    leaks.reserve(allocations_.size());
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        leaks.reserve(allocations_.size());
 
-    for (const auto& [ptr, info] : allocations_) {
-        leaks.push_back(info);
+        for (const auto& [ptr, info] : allocations_) {
+            leaks.push_back(info);
+        }
+    }
+
+    // Live samples, attributed to their call site
+    std::lock_guard<std::mutex> sites_lock(sites_mutex_);
+    for (const auto& shard : sample_shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& [ptr, sample] : shard.samples) {
+            AllocationInfo info;
+            info.size = sample.size;
+            info.line = 0;
+            info.timestamp = sample.timestamp;
+            info.weight = sample.weight;
+            auto it = call_sites_.find(sample.site);
+            if (it != call_sites_.end()) {
+                info.file = it->second.file;
+                info.line = it->second.line;
+                info.stack = it->second.stack;
+            }
+            leaks.push_back(std::move(info));
+        }
     }
 
     return leaks;
@@ -115,17 +916,149 @@ size_t MemoryLeakDetector::get_allocation_count() const {
 void MemoryLeakDetector::clear_tracking() {
     std::unique_lock<std::shared_mutex> lock(mutex_);
     allocations_.clear();
+
+    std::lock_guard<std::mutex> sites_lock(sites_mutex_);
+    call_sites_.clear();
+    for (auto& shard : sample_shards_) {
+        std::lock_guard<std::mutex> shard_lock(shard.mutex);
+        for (const auto& [ptr, sample] : shard.samples) {
+            for (size_t slot : filter_slots(ptr)) {
+                live_filter_[slot].fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+        shard.samples.clear();
+    }
+
     total_allocated_.store(0);
     allocation_count_.store(0);
 }
 
+std::vector<MemoryLeakDetector::CallSiteProfile>
+MemoryLeakDetector::get_heap_profile() const {
+    std::vector<CallSiteProfile> profile;
+    {
+        std::lock_guard<std::mutex> lock(sites_mutex_);
+        profile.reserve(call_sites_.size());
+        for (const auto& [site, entry] : call_sites_) {
+            profile.push_back(entry);
+        }
+    }
+    std::sort(profile.begin(), profile.end(),
+              [](const CallSiteProfile& a, const CallSiteProfile& b) {
+                  return a.live_estimated_bytes > b.live_estimated_bytes;
+              });
+    return profile;
+}
+
+std::string MemoryLeakDetector::export_pprof() const {
+    const auto profile = get_heap_profile();
+
+    size_t live_count = 0, live_bytes = 0, total_count = 0, total_bytes = 0;
+    for (const auto& entry : profile) {
+        live_count += entry.live_sampled_count;
+        live_bytes += entry.live_sampled_bytes;
+        total_count += entry.sampled_count;
+        total_bytes += entry.sampled_bytes;
+    }
+
+    std::string out;
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "heap profile: %6zu: %8zu [%6zu: %8zu] @ heap_v2/%zu\n",
+                  live_count, live_bytes, total_count, total_bytes,
+                  std::max<size_t>(sampling_interval(), 1));
+    out += line;
+
+    for (const auto& entry : profile) {
+        if (entry.stack.empty()) {
+            continue;  // pprof needs addresses to attribute a sample
+        }
+        std::snprintf(line, sizeof(line), "%6zu: %8zu [%6zu: %8zu] @",
+                      entry.live_sampled_count, entry.live_sampled_bytes,
+                      entry.sampled_count, entry.sampled_bytes);
+        out += line;
+        for (void* frame : entry.stack) {
+            std::snprintf(line, sizeof(line), " 0x%" PRIxPTR,
+                          reinterpret_cast<uintptr_t>(frame));
+            out += line;
+        }
+        out += '\n';
+    }
+
+    // Mappings let pprof symbolize the addresses offline
+    out += "\nMAPPED_LIBRARIES:\n";
+#ifdef __linux__
+    if (std::FILE* maps = std::fopen("/proc/self/maps", "r")) {
+        char buffer[4096];
+        size_t read = 0;
+        while ((read = std::fread(buffer, 1, sizeof(buffer), maps)) > 0) {
+            out.append(buffer, read);
+        }
+        std::fclose(maps);
+    }
+#endif
+    return out;
+}
+
+QJsonObject MemoryLeakDetector::export_json() const {
+    const auto profile = get_heap_profile();
+
+    QJsonObject json;
+    json["sampling_interval_bytes"] =
+        static_cast<qint64>(sampling_interval());
+    json["estimated_live_bytes"] = static_cast<qint64>(get_total_allocated());
+
+    QJsonArray sites;
+    for (const auto& entry : profile) {
+        QJsonObject site;
+        site["file"] = QString::fromStdString(entry.file);
+        site["line"] = entry.line;
+        site["sampled_count"] = static_cast<qint64>(entry.sampled_count);
+        site["sampled_bytes"] = static_cast<qint64>(entry.sampled_bytes);
+        site["live_sampled_count"] =
+            static_cast<qint64>(entry.live_sampled_count);
+        site["live_sampled_bytes"] =
+            static_cast<qint64>(entry.live_sampled_bytes);
+        site["estimated_count"] = entry.estimated_count;
+        site["estimated_bytes"] = entry.estimated_bytes;
+        site["live_estimated_count"] = entry.live_estimated_count;
+        site["live_estimated_bytes"] = entry.live_estimated_bytes;
+
+        QJsonArray frames;
+        for (void* frame : entry.stack) {
+            QJsonObject frame_info;
+            frame_info["address"] = format_address(frame);
+            const QString symbol = symbolize(frame);
+            if (!symbol.isEmpty()) {
+                frame_info["symbol"] = symbol;
+            }
+            frames.append(frame_info);
+        }
+        site["frames"] = frames;
+        sites.append(site);
+    }
+    json["call_sites"] = sites;
+    return json;
+}
+
 // **MemoryManager implementation**
 MemoryManager& MemoryManager::instance() {
     static MemoryManager instance;
     return instance;
 }
 
-MemoryManager::MemoryManager(QObject* parent) : QObject(parent) {
+namespace {
+std::atomic<uint64_t> next_manager_id{1};
+
+// Free heap the allocator may keep before GC asks it to trim
+constexpr size_t kHeapTrimThresholdBytes = 16 * 1024 * 1024;
+
+// Live bytes moved per handle arena in one idle-time compaction step
+constexpr size_t kCompactionStepBytes = 256 * 1024;
+}  // namespace
+
+MemoryManager::MemoryManager(QObject* parent)
+    : QObject(parent), instance_id_(next_manager_id.fetch_add(1)) {
     // Setup memory monitoring timer
     memory_check_timer_ = std::make_unique<QTimer>(this);
     memory_check_timer_->setInterval(5000);  // Check every 5 seconds
@@ -144,6 +1077,14 @@ MemoryManager::MemoryManager(QObject* parent) : QObject(parent) {
     connect(optimization_timer_.get(), &QTimer::timeout, this,
             &MemoryManager::on_optimization_timer);
 
+    // Incremental compaction steps; a zero interval runs them once pending
+    // events have been processed
+    compaction_timer_ = std::make_unique<QTimer>(this);
+    compaction_timer_->setInterval(0);
+    compaction_timer_->setSingleShot(true);
+    connect(compaction_timer_.get(), &QTimer::timeout, this,
+            &MemoryManager::on_compaction_timer);
+
     // Start monitoring
     if (memory_pressure_monitoring_enabled_.load()) {
         memory_check_timer_->start();
@@ -167,7 +1108,10 @@ MemoryManager::~MemoryManager() {
 
     {
         std::unique_lock<std::shared_mutex> lock(arenas_mutex_);
+        arena_resources_.clear();
         memory_arenas_.clear();
+        chunked_arenas_.clear();
+        handle_arenas_.clear();
     }
 
     qDebug() << "🔥 Memory Manager destroyed";
@@ -180,6 +1124,7 @@ MemoryArena* MemoryManager::create_arena(const QString& name,
     auto arena = std::make_unique<MemoryArena>(size_bytes);
     MemoryArena* arena_ptr = arena.get();
 
+    arena_resources_.erase(name);  // Adapter of a replaced arena
     memory_arenas_[name] = std::move(arena);
 
     qDebug() << "🔥 Created memory arena:" << name << "size:" << size_bytes
@@ -196,12 +1141,88 @@ MemoryArena* MemoryManager::get_arena(const QString& name) {
 
 void MemoryManager::destroy_arena(const QString& name) {
     std::unique_lock<std::shared_mutex> lock(arenas_mutex_);
+    arena_resources_.erase(name);
 
     auto it = memory_arenas_.find(name);
     if (it != memory_arenas_.end()) {
         memory_arenas_.erase(it);
         qDebug() << "🔥 Destroyed memory arena:" << name;
     }
+
+    auto chunked_it = chunked_arenas_.find(name);
+    if (chunked_it != chunked_arenas_.end()) {
+        chunked_arenas_.erase(chunked_it);
+        qDebug() << "🔥 Destroyed chunked arena:" << name;
+    }
+
+    auto handle_it = handle_arenas_.find(name);
+    if (handle_it != handle_arenas_.end()) {
+        handle_arenas_.erase(handle_it);
+        qDebug() << "🔥 Destroyed handle arena:" << name;
+    }
+}
+
+ChunkedArena* MemoryManager::create_chunked_arena(const QString& name,
+                                                  size_t initial_chunk_size) {
+    std::unique_lock<std::shared_mutex> lock(arenas_mutex_);
+
+    auto& arena = chunked_arenas_[name];
+    if (!arena) {
+        arena = std::make_unique<ChunkedArena>(initial_chunk_size);
+        qDebug() << "🔥 Created chunked arena:" << name
+                 << "initial chunk:" << initial_chunk_size << "bytes";
+    }
+    return arena.get();
+}
+
+ChunkedArena* MemoryManager::get_chunked_arena(const QString& name) {
+    std::shared_lock<std::shared_mutex> lock(arenas_mutex_);
+
+    auto it = chunked_arenas_.find(name);
+    return (it != chunked_arenas_.end()) ? it->second.get() : nullptr;
+}
+
+HandleArena* MemoryManager::create_handle_arena(const QString& name,
+                                                size_t chunk_size) {
+    std::unique_lock<std::shared_mutex> lock(arenas_mutex_);
+
+    auto& arena = handle_arenas_[name];
+    if (!arena) {
+        arena = std::make_unique<HandleArena>(chunk_size);
+        qDebug() << "🔥 Created handle arena:" << name
+                 << "chunk:" << chunk_size << "bytes";
+    }
+    return arena.get();
+}
+
+HandleArena* MemoryManager::get_handle_arena(const QString& name) {
+    std::shared_lock<std::shared_mutex> lock(arenas_mutex_);
+
+    auto it = handle_arenas_.find(name);
+    return (it != handle_arenas_.end()) ? it->second.get() : nullptr;
+}
+
+std::pmr::memory_resource* MemoryManager::get_arena_resource(
+    const QString& name) {
+    std::unique_lock<std::shared_mutex> lock(arenas_mutex_);
+
+    auto& resource = arena_resources_[name];
+    if (!resource) {
+        if (auto it = chunked_arenas_.find(name); it != chunked_arenas_.end()) {
+            resource = std::make_unique<ChunkedArenaResource>(*it->second);
+        } else if (auto fixed = memory_arenas_.find(name);
+                   fixed != memory_arenas_.end()) {
+            resource = std::make_unique<ArenaMemoryResource>(*fixed->second);
+        } else {
+            arena_resources_.erase(name);
+            return nullptr;
+        }
+    }
+    return resource.get();
+}
+
+std::pmr::memory_resource* MemoryManager::get_pool_resource() const {
+    return shared_pool_resource();
 }
 
 void MemoryManager::set_gc_strategy(GCStrategy strategy) {
@@ -249,6 +1270,7 @@ MemoryStatistics MemoryManager::get_statistics() const {
 }
 
 QJsonObject MemoryManager::get_memory_report() const {
+    const auto sample = sample_process_memory();
     auto stats = get_statistics();
 
     QJsonObject report;
@@ -266,6 +1288,36 @@ QJsonObject MemoryManager::get_memory_report() const {
     report["fragmentation_ratio"] = stats.fragmentation_ratio;
     report["gc_count"] = static_cast<qint64>(stats.gc_count);
 
+    // Add process memory information
+    QJsonObject process;
+    process["sampled"] = sample.valid;
+    if (sample.valid) {
+        process["rss_bytes"] = static_cast<qint64>(sample.rss_bytes);
+        process["peak_rss_bytes"] = static_cast<qint64>(sample.peak_rss_bytes);
+        process["virtual_bytes"] = static_cast<qint64>(sample.virtual_bytes);
+        process["footprint_bytes"] =
+            static_cast<qint64>(sample.footprint_bytes());
+    }
+    if (sample.has_rollup) {
+        process["pss_bytes"] = static_cast<qint64>(sample.pss_bytes);
+        process["anonymous_bytes"] =
+            static_cast<qint64>(sample.anonymous_bytes);
+        process["swap_bytes"] = static_cast<qint64>(sample.swap_bytes);
+    }
+    if (sample.has_heap_info) {
+        process["heap_in_use_bytes"] =
+            static_cast<qint64>(sample.heap_in_use_bytes);
+        process["heap_free_bytes"] =
+            static_cast<qint64>(sample.heap_free_bytes);
+        process["heap_mapped_bytes"] =
+            static_cast<qint64>(sample.heap_mapped_bytes);
+    }
+    report["process"] = process;
+    report["memory_limit_bytes"] =
+        static_cast<qint64>(memory_limit_bytes_.load());
+    report["warning_threshold_bytes"] =
+        static_cast<qint64>(warning_threshold_bytes_.load());
+
     // Add arena information
     QJsonArray arenas;
     {
@@ -279,15 +1331,80 @@ QJsonObject MemoryManager::get_memory_report() const {
             arena_info["usage_percentage"] = arena->usage_percentage();
             arenas.append(arena_info);
         }
+        for (const auto& [name, arena] : chunked_arenas_) {
+            QJsonObject arena_info;
+            arena_info["name"] = name;
+            arena_info["chunked"] = true;
+            arena_info["total_bytes"] =
+                static_cast<qint64>(arena->total_bytes());
+            arena_info["used_bytes"] = static_cast<qint64>(arena->used_bytes());
+            arena_info["usage_percentage"] = arena->usage_percentage();
+            arena_info["chunk_count"] =
+                static_cast<qint64>(arena->chunk_count());
+            arenas.append(arena_info);
+        }
+        for (const auto& [name, arena] : handle_arenas_) {
+            QJsonObject arena_info;
+            arena_info["name"] = name;
+            arena_info["handle_based"] = true;
+            arena_info["total_bytes"] =
+                static_cast<qint64>(arena->total_bytes());
+            arena_info["used_bytes"] = static_cast<qint64>(arena->used_bytes());
+            arena_info["live_bytes"] = static_cast<qint64>(arena->live_bytes());
+            arena_info["live_count"] = static_cast<qint64>(arena->live_count());
+            arena_info["chunk_count"] =
+                static_cast<qint64>(arena->chunk_count());
+            arena_info["fragmentation"] = arena->fragmentation();
+            arena_info["compacted_bytes"] =
+                static_cast<qint64>(arena->compacted_bytes());
+            arenas.append(arena_info);
+        }
     }
     report["arenas"] = arenas;
 
+    const auto slab_stats = SlabAllocator::statistics();
+    QJsonObject slab;
+    slab["enabled"] = SlabAllocator::is_enabled();
+    slab["slab_count"] = static_cast<qint64>(slab_stats.slab_count);
+    slab["reserved_bytes"] = static_cast<qint64>(slab_stats.reserved_bytes);
+    slab["depot_free_bytes"] =
+        static_cast<qint64>(slab_stats.depot_free_bytes);
+    slab["upstream_allocations"] =
+        static_cast<qint64>(slab_stats.upstream_allocations);
+    slab["fallback_allocations"] =
+        static_cast<qint64>(slab_stats.fallback_allocations);
+    slab["refills"] = static_cast<qint64>(slab_stats.refills);
+    report["slab_allocator"] = slab;
+
     // Add leak detection information
     if (leak_detection_enabled_.load()) {
         auto leaks = get_memory_leaks();
         report["memory_leaks_count"] = static_cast<qint64>(leaks.size());
         report["total_leaked_bytes"] = static_cast<qint64>(
             MemoryLeakDetector::instance().get_total_allocated());
+
+        const auto& detector = MemoryLeakDetector::instance();
+        if (detector.sampling_interval() > 0) {
+            QJsonObject sampling;
+            sampling["interval_bytes"] =
+                static_cast<qint64>(detector.sampling_interval());
+            sampling["samples"] =
+                static_cast<qint64>(detector.get_allocation_count());
+            QJsonArray top_sites;
+            for (const auto& site : detector.get_heap_profile()) {
+                if (top_sites.size() == 10) {
+                    break;
+                }
+                QJsonObject entry;
+                entry["file"] = QString::fromStdString(site.file);
+                entry["line"] = site.line;
+                entry["live_estimated_bytes"] = site.live_estimated_bytes;
+                entry["live_estimated_count"] = site.live_estimated_count;
+                top_sites.append(entry);
+            }
+            sampling["top_call_sites"] = top_sites;
+            report["allocation_sampling"] = sampling;
+        }
     }
 
     return report;
@@ -297,10 +1414,40 @@ void MemoryManager::enable_leak_detection(bool enabled) {
     leak_detection_enabled_.store(enabled);
 
     if (!enabled) {
+        MemoryLeakDetector::instance().set_sampling_interval(0);
         MemoryLeakDetector::instance().clear_tracking();
     }
 }
 
+void MemoryManager::enable_allocation_sampling(bool enabled,
+                                               size_t interval_bytes) {
+    auto& detector = MemoryLeakDetector::instance();
+    if (enabled) {
+        detector.set_sampling_interval(std::max<size_t>(interval_bytes, 1));
+        leak_detection_enabled_.store(true);
+        qDebug() << "🔥 Allocation sampling enabled, one sample per"
+                 << detector.sampling_interval() << "bytes";
+    } else {
+        detector.set_sampling_interval(0);
+    }
+}
+
+bool MemoryManager::write_heap_profile(const QString& file_path,
+                                       HeapProfileFormat format) const {
+    const auto& detector = MemoryLeakDetector::instance();
+    const QByteArray data =
+        format == HeapProfileFormat::Pprof
+            ? QByteArray::fromStdString(detector.export_pprof())
+            : QJsonDocument(detector.export_json()).toJson();
+
+    QFile file(file_path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "🔥 Cannot write heap profile:" << file_path;
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
 std::vector<MemoryLeakDetector::AllocationInfo>
 MemoryManager::get_memory_leaks() const {
     if (leak_detection_enabled_.load()) {
@@ -356,14 +1503,53 @@ void MemoryManager::defragment_arenas() {
             qDebug() << "🔥 Reset low-usage arena:" << name;
         }
     }
+
+    // Chunked arenas may hold live objects; only drop their spare chunks
+    for (const auto& [name, arena] : chunked_arenas_) {
+        const size_t released = arena->release_unused_chunks();
+        if (released > 0) {
+            qDebug() << "🔥 Released" << released
+                     << "bytes of spare chunks from arena:" << name;
+        }
+    }
+
+    // Handle arenas can move their blocks: start (or continue) an
+    // incremental compaction pass and finish it in idle time
+    lock.unlock();
+    if (step_handle_compaction(kCompactionStepBytes)) {
+        compaction_timer_->start();
+    }
+}
+
+bool MemoryManager::step_handle_compaction(size_t max_bytes) {
+    std::shared_lock<std::shared_mutex> lock(arenas_mutex_);
+
+    bool pending = false;
+    for (const auto& [name, arena] : handle_arenas_) {
+        if (!arena->needs_compaction()) {
+            continue;
+        }
+        arena->compact_step(max_bytes);
+        pending = pending || arena->needs_compaction();
+    }
+    return pending;
 }
 
 void MemoryManager::compact_memory() {
     // Trigger garbage collection
     perform_garbage_collection();
 
-    // In a real implementation, we would compact heap memory
-    qDebug() << "🔥 Memory compaction completed";
+    // Finish compaction of handle arenas in one go
+    size_t moved = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(arenas_mutex_);
+        for (const auto& [name, arena] : handle_arenas_) {
+            moved += arena->compact();
+        }
+    }
+    compaction_timer_->stop();
+
+    qDebug() << "🔥 Memory compaction completed, moved" << moved << "bytes";
 }
 
 void MemoryManager::set_memory_limit(size_t limit_bytes) {
@@ -388,13 +1574,21 @@ void MemoryManager::enable_memory_pressure_monitoring(bool enabled) {
 void MemoryManager::on_memory_check_timer() { check_memory_pressure(); }
 
 void MemoryManager::on_gc_timer() {
-    if (auto_gc_enabled_.load()) {
+    // Periodic collection only once the process footprint warrants it
+    if (auto_gc_enabled_.load() &&
+        calculate_current_memory_usage() >= gc_threshold_bytes_.load()) {
         perform_garbage_collection();
     }
 }
 
 void MemoryManager::on_optimization_timer() { optimize_memory_usage(); }
 
+void MemoryManager::on_compaction_timer() {
+    if (step_handle_compaction(kCompactionStepBytes)) {
+        compaction_timer_->start();
+    }
+}
+
 void MemoryManager::check_memory_pressure() {
     size_t current_usage = calculate_current_memory_usage();
 
@@ -421,7 +1615,14 @@ void MemoryManager::check_memory_pressure() {
 
 void MemoryManager::perform_garbage_collection() {
     auto start_time = std::chrono::steady_clock::now();
-    size_t initial_usage = calculate_current_memory_usage();
+
+    // Measure with RSS: the PSS reading is refreshed at most once a second
+    const auto resident_usage = [this]() {
+        const auto sample = sample_process_memory();
+        return sample.valid ? sample.rss_bytes
+                            : calculate_managed_memory_usage();
+    };
+    size_t initial_usage = resident_usage();
 
     qDebug() << "🔥 Starting garbage collection";
 
@@ -431,7 +1632,13 @@ void MemoryManager::perform_garbage_collection() {
     // Clear unused pools
     clear_unused_pools();
 
-    size_t final_usage = calculate_current_memory_usage();
+    // Hand free heap pages retained by malloc back to the system
+    if (process_sampler_.last_sample().heap_free_bytes >=
+        kHeapTrimThresholdBytes) {
+        ProcessMemorySampler::trim_heap();
+    }
+
+    size_t final_usage = resident_usage();
     size_t freed_bytes =
         (initial_usage > final_usage) ? (initial_usage - final_usage) : 0;
 
@@ -452,20 +1659,62 @@ void MemoryManager::perform_garbage_collection() {
 }
 
 void MemoryManager::update_statistics() {
+    const auto sample = sample_process_memory();
+    const size_t managed_usage = calculate_managed_memory_usage();
+
     std::unique_lock<std::shared_mutex> lock(statistics_mutex_);
 
-    statistics_.current_allocated_bytes = calculate_current_memory_usage();
+    statistics_.current_allocated_bytes = managed_usage;
 
     if (statistics_.current_allocated_bytes >
         statistics_.peak_allocated_bytes) {
         statistics_.peak_allocated_bytes = statistics_.current_allocated_bytes;
     }
 
-    // Calculate fragmentation ratio (simplified)
-    statistics_.fragmentation_ratio = 0.1;  // Placeholder
+    // Aggregate pool counters
+    {
+        std::shared_lock<std::shared_mutex> pools_lock(pools_mutex_);
+        statistics_.pool_hits = 0;
+        statistics_.pool_misses = 0;
+        for (const auto& [name, entry] : object_pools_) {
+            statistics_.pool_hits += entry.hits(entry.pool.get());
+            statistics_.pool_misses += entry.misses(entry.pool.get());
+        }
+    }
+
+    // Free-but-retained share of the malloc heap
+    statistics_.fragmentation_ratio =
+        sample.has_heap_info ? sample.heap_fragmentation() : 0.1;
+}
+
+ProcessMemorySample MemoryManager::sample_process_memory() const {
+    const auto sample = process_sampler_.sample();
+    if (!sample.valid && !sample.has_heap_info) {
+        return sample;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(statistics_mutex_);
+    statistics_.process_rss_bytes = sample.rss_bytes;
+    statistics_.process_peak_rss_bytes = sample.peak_rss_bytes;
+    statistics_.process_pss_bytes = sample.pss_bytes;
+    statistics_.process_anonymous_bytes = sample.anonymous_bytes;
+    statistics_.process_swap_bytes = sample.swap_bytes;
+    statistics_.process_footprint_bytes = sample.footprint_bytes();
+    statistics_.heap_in_use_bytes = sample.heap_in_use_bytes;
+    statistics_.heap_free_bytes = sample.heap_free_bytes;
+    statistics_.heap_mapped_bytes = sample.heap_mapped_bytes;
+    statistics_.last_process_sample_time = sample.time;
+    return sample;
 }
 
 size_t MemoryManager::calculate_current_memory_usage() const {
+    // Real footprint where it can be sampled, own bookkeeping otherwise
+    const auto sample = sample_process_memory();
+    return sample.valid ? sample.footprint_bytes()
+                        : calculate_managed_memory_usage();
+}
+
+size_t MemoryManager::calculate_managed_memory_usage() const {
     size_t total_usage = 0;
 
     // Add arena usage
@@ -474,6 +1723,12 @@ size_t MemoryManager::calculate_current_memory_usage() const {
         for (const auto& [name, arena] : memory_arenas_) {
             total_usage += arena->used_bytes();
         }
+        for (const auto& [name, arena] : chunked_arenas_) {
+            total_usage += arena->total_bytes();
+        }
+        for (const auto& [name, arena] : handle_arenas_) {
+            total_usage += arena->total_bytes();
+        }
     }
 
     // Add tracked allocations
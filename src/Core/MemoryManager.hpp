@@ -7,15 +7,25 @@
 #include <QString>
 #include <QTimer>
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
 #include <queue>
 #include <shared_mutex>
+#include <string>
 #include <type_traits>
+#include <typeinfo>
 #include <unordered_map>
 #include <vector>
 
+#include "ProcessMemory.hpp"
+
 /**
  * @file MemoryManager.hpp
  * @brief Memory management utilities: pools, arenas, leak detection and
@@ -25,14 +35,24 @@
  * allocation overhead and assist debugging of memory usage in DeclarativeUI:
  *  - ObjectPool<T> : a simple, thread-safe fixed-size pool for frequently
  *    allocated objects of type T.
+ *  - ConcurrentObjectPool<T>: a lazily populated pool with per-thread
+ *    magazines over a lock-free depot, for pools shared by worker threads.
  *  - MemoryArena    : a contiguous arena allocator for short-lived or tightly
  *    packed allocations.
- *  - PooledPtr<T>   : RAII wrapper that returns objects to an ObjectPool on
+ *  - ChunkedArena   : a growable arena with lock-free bump allocation, scoped
+ *    rollback markers and optional destructor registration.
+ *  - HandleArena    : an arena addressed through generational handles, so
+ *    live blocks can be moved and fragmented chunks compacted incrementally.
+ *  - PooledPtr<T>   : RAII wrapper that returns objects to their pool on
  *    destruction.
+ *  - std::pmr adapters over arenas and size-class pools live in
+ *    MemoryResource.hpp; get_arena_resource() hands them out per arena.
  *  - MemoryLeakDetector: lightweight tracking of allocations/deallocations to
  *    assist in leak discovery during development and testing.
  *  - MemoryStatistics, GCStrategy and MemoryManager: a higher-level manager
  *    exposing pools, arenas, GC controls, monitoring and reporting interfaces.
+ *    Pressure and GC decisions use the process footprint sampled by
+ *    ProcessMemorySampler (ProcessMemory.hpp) where the platform supports it.
  *
  * Design notes:
  *  - Pool and arena implementations are intentionally conservative and simple;
@@ -127,6 +147,7 @@ public:
             }
 
             allocated_count_.fetch_add(1);
+            pool_hits_.fetch_add(1);
             return obj;
         }
 
@@ -178,11 +199,438 @@ public:
      */
     size_t pool_misses() const { return pool_misses_.load(); }
 
+    /**
+     * @brief Number of acquisitions served from pooled objects.
+     */
+    size_t pool_hits() const { return pool_hits_.load(); }
+
 private:
     mutable std::mutex mutex_;
     std::queue<std::unique_ptr<T>> available_objects_;
     std::atomic<size_t> allocated_count_{0};
     std::atomic<size_t> pool_misses_{0};
+    std::atomic<size_t> pool_hits_{0};
+};
+
+// -----------------------------------------------------------------------------
+// ConcurrentObjectPool
+// -----------------------------------------------------------------------------
+/**
+ * @brief Object pool with per-thread magazines and a lock-free global depot.
+ *
+ * Template parameters:
+ *  - T : type of pooled objects.
+ *  - PoolSize : maximum number of idle objects kept in the shared depot.
+ *  - MagazineSize : objects cached per magazine (each thread holds two).
+ *
+ * Characteristics:
+ *  - Nothing is constructed up front; objects are created on first demand and
+ *    recycled afterwards (constructed_count() reports how many exist).
+ *  - Each thread keeps a loaded and a previous magazine (Bonwick-style).
+ *    acquire() and release() only touch the calling thread's magazines until
+ *    one runs empty or full; then a whole magazine is exchanged with the
+ *    depot, so shared state is touched once per MagazineSize operations.
+ *  - The depot is a pair of Treiber stacks (full and empty magazines) whose
+ *    heads pack a 32-bit magazine index with a 32-bit ABA tag. Magazines live
+ *    in segments that are never freed while the depot exists.
+ *  - Objects released beyond the depot's PoolSize budget are destroyed.
+ *
+ * Lifetime:
+ *  - Thread caches hold a shared reference to the depot and return their
+ *    magazines when the thread exits, so a pool may be destroyed while other
+ *    threads still cache its objects; the last reference frees everything.
+ *
+ * Counters are published from the thread caches whenever a magazine is
+ * exchanged, so allocated_count(), pool_hits() and pool_misses() lag by at
+ * most two magazines per thread. flush_thread_cache() publishes them exactly
+ * for the calling thread.
+ */
+template <typename T, size_t PoolSize = 1000, size_t MagazineSize = 32>
+class ConcurrentObjectPool {
+    static_assert(MagazineSize > 0, "MagazineSize must be positive");
+
+public:
+    ConcurrentObjectPool() : depot_(std::make_shared<Depot>()) {}
+
+    ~ConcurrentObjectPool() {
+        depot_->closed.store(true, std::memory_order_release);
+        flush_thread_cache();
+    }
+
+    ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+    ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+
+    /**
+     * @brief Acquire a pooled object or construct a new one.
+     *
+     * Recycled objects are reinitialized by assignment when T is
+     * constructible from args, matching ObjectPool::acquire().
+     */
+    template <typename... Args>
+    std::unique_ptr<T> acquire(Args&&... args) {
+        ThreadMagazines& local = localMagazines();
+        ++local.acquired;
+
+        T* obj = popLocal(local);
+        if (obj) {
+            ++local.hits;
+            if constexpr (std::is_constructible_v<T, Args...>) {
+                *obj = T(std::forward<Args>(args)...);
+            }
+            return std::unique_ptr<T>(obj);
+        }
+
+        ++local.misses;
+        depot_->constructed.fetch_add(1, std::memory_order_relaxed);
+        return std::make_unique<T>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Return an object to the calling thread's magazines.
+     */
+    void release(std::unique_ptr<T> obj) {
+        if (!obj)
+            return;
+
+        ThreadMagazines& local = localMagazines();
+        ++local.released;
+        if (!pushLocal(local, obj.get())) {
+            depot_->constructed.fetch_sub(1, std::memory_order_relaxed);
+            return;  // Depot over budget: obj is destroyed here
+        }
+        obj.release();
+    }
+
+    /**
+     * @brief Return the calling thread's cached objects to the depot and
+     * publish its counters.
+     */
+    void flush_thread_cache() {
+        auto& entries = threadCache().entries;
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->depot == depot_) {
+                drain(*it);
+                entries.erase(it);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Idle objects in the depot plus the calling thread's magazines.
+     */
+    size_t available_count() const {
+        size_t count = depot_->cached.load(std::memory_order_relaxed);
+        for (const auto& local : threadCache().entries) {
+            if (local.depot == depot_) {
+                count += magazineCount(local.loaded) +
+                         magazineCount(local.previous);
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Objects handed out and not yet returned (published counts).
+     */
+    size_t allocated_count() const {
+        const int64_t outstanding =
+            depot_->outstanding.load(std::memory_order_relaxed);
+        return outstanding > 0 ? static_cast<size_t>(outstanding) : 0;
+    }
+
+    /**
+     * @brief Number of acquisitions that had to construct a new object.
+     */
+    size_t pool_misses() const {
+        return depot_->misses.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of acquisitions served from pooled objects.
+     */
+    size_t pool_hits() const {
+        return depot_->hits.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Objects of this pool currently alive, pooled or handed out.
+     */
+    size_t constructed_count() const {
+        return depot_->constructed.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t kNoMagazine = 0xFFFFFFFFu;
+    static constexpr size_t kSegmentBits = 6;
+    static constexpr size_t kSegmentSize = size_t{1} << kSegmentBits;
+    static constexpr size_t kMaxSegments = 1024;
+
+    struct Magazine {
+        std::array<T*, MagazineSize> rounds{};
+        size_t count = 0;
+        uint32_t index = kNoMagazine;
+        std::atomic<uint32_t> next{kNoMagazine};
+    };
+
+    /**
+     * @brief Shared state: magazine storage, the two stacks and counters.
+     */
+    struct Depot {
+        std::array<std::atomic<Magazine*>, kMaxSegments> segments{};
+        std::atomic<uint32_t> magazines_created{0};
+        std::atomic<uint64_t> full_head{pack(kNoMagazine, 0)};
+        std::atomic<uint64_t> empty_head{pack(kNoMagazine, 0)};
+        std::atomic<size_t> cached{0};
+        std::atomic<size_t> constructed{0};
+        std::atomic<int64_t> outstanding{0};
+        std::atomic<size_t> hits{0};
+        std::atomic<size_t> misses{0};
+        std::atomic<bool> closed{false};
+
+        ~Depot() {
+            // Thread caches drained before dropping their reference, so only
+            // the full stack still owns objects.
+            while (Magazine* magazine = pop(full_head)) {
+                for (size_t i = 0; i < magazine->count; ++i) {
+                    delete magazine->rounds[i];
+                }
+            }
+            for (auto& segment : segments) {
+                delete[] segment.load(std::memory_order_relaxed);
+            }
+        }
+
+        static constexpr uint64_t pack(uint32_t index, uint32_t tag) {
+            return (static_cast<uint64_t>(tag) << 32) | index;
+        }
+
+        Magazine* at(uint32_t index) const {
+            Magazine* segment =
+                segments[index >> kSegmentBits].load(std::memory_order_acquire);
+            return segment + (index & (kSegmentSize - 1));
+        }
+
+        void push(std::atomic<uint64_t>& head, Magazine* magazine) {
+            uint64_t old_head = head.load(std::memory_order_relaxed);
+            uint64_t new_head;
+            do {
+                magazine->next.store(static_cast<uint32_t>(old_head),
+                                     std::memory_order_relaxed);
+                new_head = pack(magazine->index,
+                                static_cast<uint32_t>(old_head >> 32) + 1);
+            } while (!head.compare_exchange_weak(old_head, new_head,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        }
+
+        Magazine* pop(std::atomic<uint64_t>& head) {
+            uint64_t old_head = head.load(std::memory_order_acquire);
+            while (static_cast<uint32_t>(old_head) != kNoMagazine) {
+                // Magazines are never freed, so reading next is safe even if
+                // another thread pops this one first; the tag rejects the
+                // stale head.
+                Magazine* magazine = at(static_cast<uint32_t>(old_head));
+                const uint32_t next =
+                    magazine->next.load(std::memory_order_relaxed);
+                const uint64_t new_head =
+                    pack(next, static_cast<uint32_t>(old_head >> 32) + 1);
+                if (head.compare_exchange_weak(old_head, new_head,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+                    return magazine;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Pop an empty magazine or carve a new one.
+         * @return nullptr once kMaxSegments are exhausted.
+         */
+        Magazine* emptyMagazine() {
+            if (Magazine* magazine = pop(empty_head)) {
+                return magazine;
+            }
+            const uint32_t index =
+                magazines_created.fetch_add(1, std::memory_order_relaxed);
+            const size_t segment_index = index >> kSegmentBits;
+            if (segment_index >= kMaxSegments) {
+                magazines_created.fetch_sub(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            auto& slot = segments[segment_index];
+            Magazine* segment = slot.load(std::memory_order_acquire);
+            if (!segment) {
+                auto* fresh = new Magazine[kSegmentSize];
+                for (size_t i = 0; i < kSegmentSize; ++i) {
+                    fresh[i].index = static_cast<uint32_t>(
+                        (segment_index << kSegmentBits) + i);
+                }
+                if (slot.compare_exchange_strong(segment, fresh,
+                                                 std::memory_order_acq_rel)) {
+                    segment = fresh;
+                } else {
+                    delete[] fresh;
+                }
+            }
+            return segment + (index & (kSegmentSize - 1));
+        }
+
+        /**
+         * @brief Hand a (possibly partial) magazine to the full stack, or
+         * destroy its objects when the depot budget is exhausted.
+         */
+        void depositFull(Magazine* magazine) {
+            const size_t count = magazine->count;
+            if (count == 0 ||
+                cached.fetch_add(count, std::memory_order_relaxed) + count >
+                    PoolSize) {
+                if (count > 0) {
+                    cached.fetch_sub(count, std::memory_order_relaxed);
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    delete magazine->rounds[i];
+                }
+                constructed.fetch_sub(count, std::memory_order_relaxed);
+                magazine->count = 0;
+                push(empty_head, magazine);
+                return;
+            }
+            push(full_head, magazine);
+        }
+
+        Magazine* takeFull() {
+            Magazine* magazine = pop(full_head);
+            if (magazine) {
+                cached.fetch_sub(magazine->count, std::memory_order_relaxed);
+            }
+            return magazine;
+        }
+    };
+
+    /**
+     * @brief One thread's view of one pool.
+     */
+    struct ThreadMagazines {
+        std::shared_ptr<Depot> depot;
+        Magazine* loaded = nullptr;
+        Magazine* previous = nullptr;
+        size_t acquired = 0;
+        size_t released = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+
+    struct ThreadCache {
+        std::vector<ThreadMagazines> entries;
+
+        ~ThreadCache() {
+            for (auto& entry : entries) {
+                drain(entry);
+            }
+        }
+    };
+
+    static ThreadCache& threadCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    static size_t magazineCount(const Magazine* magazine) {
+        return magazine ? magazine->count : 0;
+    }
+
+    static void publish(ThreadMagazines& local) {
+        Depot& depot = *local.depot;
+        depot.outstanding.fetch_add(static_cast<int64_t>(local.acquired) -
+                                        static_cast<int64_t>(local.released),
+                                    std::memory_order_relaxed);
+        depot.hits.fetch_add(local.hits, std::memory_order_relaxed);
+        depot.misses.fetch_add(local.misses, std::memory_order_relaxed);
+        local.acquired = local.released = local.hits = local.misses = 0;
+    }
+
+    static void drain(ThreadMagazines& local) {
+        for (Magazine* magazine : {local.loaded, local.previous}) {
+            if (magazine) {
+                local.depot->depositFull(magazine);
+            }
+        }
+        local.loaded = local.previous = nullptr;
+        publish(local);
+    }
+
+    ThreadMagazines& localMagazines() {
+        auto& entries = threadCache().entries;
+        for (auto& entry : entries) {
+            if (entry.depot == depot_) {
+                return entry;
+            }
+        }
+
+        // First use from this thread: drop entries of destroyed pools
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->depot->closed.load(std::memory_order_acquire)) {
+                drain(*it);
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        entries.push_back(ThreadMagazines{depot_});
+        return entries.back();
+    }
+
+    T* popLocal(ThreadMagazines& local) {
+        if (local.loaded && local.loaded->count > 0) {
+            return local.loaded->rounds[--local.loaded->count];
+        }
+        if (local.previous && local.previous->count > 0) {
+            std::swap(local.loaded, local.previous);
+            return local.loaded->rounds[--local.loaded->count];
+        }
+
+        Magazine* full = depot_->takeFull();
+        publish(local);
+        if (!full) {
+            return nullptr;
+        }
+        if (local.previous) {
+            depot_->push(depot_->empty_head, local.previous);
+        }
+        local.previous = local.loaded;
+        local.loaded = full;
+        return local.loaded->rounds[--local.loaded->count];
+    }
+
+    bool pushLocal(ThreadMagazines& local, T* obj) {
+        if (local.loaded && local.loaded->count < MagazineSize) {
+            local.loaded->rounds[local.loaded->count++] = obj;
+            return true;
+        }
+        if (local.previous && local.previous->count < MagazineSize) {
+            std::swap(local.loaded, local.previous);
+            local.loaded->rounds[local.loaded->count++] = obj;
+            return true;
+        }
+
+        Magazine* empty = depot_->emptyMagazine();
+        publish(local);
+        if (!empty) {
+            return false;
+        }
+        if (local.previous) {
+            depot_->depositFull(local.previous);
+        }
+        local.previous = local.loaded;
+        local.loaded = empty;
+        local.loaded->rounds[local.loaded->count++] = obj;
+        return true;
+    }
+
+    std::shared_ptr<Depot> depot_;
 };
 
 // -----------------------------------------------------------------------------
@@ -234,6 +682,14 @@ public:
 
     size_t used_bytes() const { return used_bytes_.load(); }
     size_t total_bytes() const { return total_bytes_; }
+
+    /**
+     * @brief Whether ptr points into the arena's block.
+     */
+    bool owns(const void* ptr) const {
+        const auto* byte = static_cast<const char*>(ptr);
+        return byte >= memory_ && byte < memory_ + total_bytes_;
+    }
     double usage_percentage() const {
         return static_cast<double>(used_bytes_.load()) / total_bytes_ * 100.0;
     }
@@ -245,15 +701,393 @@ private:
     std::mutex allocation_mutex_;
 };
 
+// -----------------------------------------------------------------------------
+// ChunkedArena
+// -----------------------------------------------------------------------------
+/**
+ * @brief Growable arena for per-reload and per-frame temporaries.
+ *
+ * Memory comes from a list of chunks. Each chunk carries an atomic bump
+ * offset, so concurrent allocate() calls only race on a compare-exchange;
+ * the growth mutex is taken only when the current chunk is exhausted, and a
+ * new chunk is then linked in (chunk sizes double up to max_chunk_size).
+ *
+ * Scopes:
+ *  - mark() captures the current position; rollback() returns to it, running
+ *    the destructors registered since then in reverse order. Chunks past the
+ *    marker are kept and reused by later allocations.
+ *  - ArenaScope does mark/rollback with RAII and nests naturally.
+ *  - reset() rolls back to the empty arena; release_unused_chunks() returns
+ *    spare chunks to the system.
+ *
+ * Objects:
+ *  - create<T>(args...) placement-constructs a T. Non-trivially destructible
+ *    types get a destructor record (stored in the arena itself) so rollback()
+ *    and reset() destroy them.
+ *
+ * Thread-safety: allocate() and create() may be called concurrently.
+ * mark(), rollback() and reset() must not overlap with allocations from
+ * other threads; they are meant to be called by the owner of the scope
+ * between frames or reloads. release_unused_chunks() may overlap with any
+ * of these: it only frees chunks past the current one, under the growth
+ * mutex, and no allocation or open scope's Marker points past the current
+ * chunk. MemoryManager calls it from its cleanup timer for registered
+ * arenas.
+ */
+class ChunkedArena {
+    struct Chunk;
+    struct DestructorRecord;
+
+public:
+    /**
+     * @brief Position in the arena captured by mark().
+     */
+    struct Marker {
+        Chunk* chunk = nullptr;
+        size_t offset = 0;
+        DestructorRecord* destructors = nullptr;
+    };
+
+    /**
+     * @param initial_chunk_size size of the first chunk in bytes.
+     * @param max_chunk_size upper bound for geometric chunk growth; larger
+     * single requests still get a dedicated chunk.
+     */
+    explicit ChunkedArena(size_t initial_chunk_size = 64 * 1024,
+                          size_t max_chunk_size = 4 * 1024 * 1024);
+    ~ChunkedArena();
+
+    ChunkedArena(const ChunkedArena&) = delete;
+    ChunkedArena& operator=(const ChunkedArena&) = delete;
+
+    /**
+     * @brief Allocate size bytes aligned to alignment (a power of two).
+     * @return Never nullptr; throws std::bad_alloc if a chunk cannot be
+     * obtained.
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Construct a T in the arena; its destructor runs on rollback.
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T));
+        T* object = new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            register_destructor(
+                object, [](void* ptr) { static_cast<T*>(ptr)->~T(); });
+        }
+        return object;
+    }
+
+    /**
+     * @brief Register a cleanup callback for memory the caller placed in
+     * the arena (e.g. through allocate()).
+     */
+    void register_destructor(void* object, void (*destroy)(void*));
+
+    Marker mark() const;
+    void rollback(const Marker& marker);
+    void reset();
+
+    /**
+     * @brief Free chunks beyond the current one; safe to call while other
+     * threads allocate.
+     * @return Number of bytes returned to the system.
+     */
+    size_t release_unused_chunks();
+
+    size_t used_bytes() const;
+    size_t total_bytes() const;
+    size_t chunk_count() const;
+    double usage_percentage() const;
+
+private:
+    struct alignas(std::max_align_t) Chunk {
+        size_t capacity = 0;
+        std::atomic<size_t> used{0};
+        Chunk* next = nullptr;
+
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    struct DestructorRecord {
+        void (*destroy)(void*) = nullptr;
+        void* object = nullptr;
+        DestructorRecord* next = nullptr;
+    };
+
+    static Chunk* allocate_chunk(size_t capacity);
+    static void free_chunk(Chunk* chunk);
+    void grow(Chunk* exhausted, size_t size, size_t alignment);
+    void run_destructors(DestructorRecord* until);
+
+    Chunk* head_ = nullptr;
+    std::atomic<Chunk*> current_{nullptr};
+    std::atomic<DestructorRecord*> destructors_{nullptr};
+    size_t next_chunk_size_;
+    const size_t max_chunk_size_;
+    mutable std::mutex growth_mutex_;  // Guards the chunk list links
+};
+
+/**
+ * @brief RAII scope that rolls a ChunkedArena back on exit.
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(ChunkedArena& arena)
+        : arena_(arena), marker_(arena.mark()) {}
+    ~ArenaScope() { arena_.rollback(marker_); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    ChunkedArena& arena() const { return arena_; }
+
+private:
+    ChunkedArena& arena_;
+    ChunkedArena::Marker marker_;
+};
+
+// -----------------------------------------------------------------------------
+// HandleArena
+// -----------------------------------------------------------------------------
+/**
+ * @brief Arena whose clients hold handles instead of pointers, so the arena
+ * can move live blocks and give fragmented chunks back.
+ *
+ * Long-running sessions with frequent hot reloads leave arenas full of holes.
+ * Because every block is reached through a Handle (slot index + generation),
+ * compaction can copy the survivors of a sparse chunk into a dense one and
+ * free the source chunk.
+ *
+ * Generations:
+ *  - New blocks are bump-allocated in the nursery chunk.
+ *  - Blocks that survive a compaction move to survivor chunks, which hold
+ *    only long-lived data and rarely need compacting again.
+ *  - A slot's generation is bumped on free(), so stale handles resolve to
+ *    nullptr instead of aliasing a new block.
+ *
+ * Compaction is incremental: compact_step() moves at most a byte budget per
+ * call and resumes where it stopped, so it can run in idle time without a
+ * visible pause. MemoryManager drives it from its optimization timer.
+ *
+ * Pointers returned by resolve()/get() stay valid until the next
+ * compact_step() or free() of that handle. Code that must keep a pointer
+ * across event loop turns (or on another thread) holds a Pin, which keeps
+ * the block in place.
+ *
+ * Thread-safety: all operations are internally synchronized; resolve()
+ * takes a shared lock and may run concurrently with other resolves.
+ */
+class HandleArena {
+    struct Chunk;
+
+public:
+    struct Handle {
+        uint32_t index = 0;
+        uint32_t generation = 0;  // 0 = null handle
+
+        explicit operator bool() const { return generation != 0; }
+        bool operator==(const Handle&) const = default;
+    };
+
+    /**
+     * @brief Moves an object from src to dst (uninitialized) and ends the
+     * lifetime of src. nullptr means the block is trivially relocatable.
+     */
+    using RelocateFn = void (*)(void* dst, void* src);
+    using DestroyFn = void (*)(void*);
+
+    /**
+     * @brief Keeps a block from being moved while it is alive.
+     */
+    class Pin {
+    public:
+        Pin(HandleArena& arena, Handle handle);
+        ~Pin();
+
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+
+        void* get() const { return ptr_; }
+
+    private:
+        HandleArena& arena_;
+        Handle handle_;
+        void* ptr_;
+    };
+
+    /**
+     * @param chunk_size size of nursery and survivor chunks; larger blocks
+     * get a dedicated chunk.
+     */
+    explicit HandleArena(size_t chunk_size = 64 * 1024);
+    ~HandleArena();
+
+    HandleArena(const HandleArena&) = delete;
+    HandleArena& operator=(const HandleArena&) = delete;
+
+    /**
+     * @brief Allocate size bytes. Without a relocate function the block is
+     * moved with memcpy during compaction.
+     */
+    Handle allocate(size_t size, size_t alignment = alignof(std::max_align_t),
+                    RelocateFn relocate = nullptr, DestroyFn destroy = nullptr);
+
+    /**
+     * @brief Construct a T in the arena. T must be move constructible; its
+     * destructor runs on free() or when the arena is destroyed.
+     */
+    template <typename T, typename... Args>
+    Handle create(Args&&... args) {
+        static_assert(std::is_move_constructible_v<T>,
+                      "HandleArena objects must be move constructible");
+        RelocateFn relocate = nullptr;
+        if constexpr (!std::is_trivially_copyable_v<T>) {
+            relocate = [](void* dst, void* src) {
+                T* from = static_cast<T*>(src);
+                new (dst) T(std::move(*from));
+                from->~T();
+            };
+        }
+        DestroyFn destroy = nullptr;
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destroy = [](void* ptr) { static_cast<T*>(ptr)->~T(); };
+        }
+
+        // Pinned until constructed, so compaction never relocates raw memory
+        void* memory = nullptr;
+        Handle handle = allocate_block(sizeof(T), alignof(T), relocate,
+                                       nullptr, &memory);
+        try {
+            new (memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            unpin(handle);
+            free(handle);
+            throw;
+        }
+        finish_create(handle, destroy);
+        return handle;
+    }
+
+    /**
+     * @brief Run the block's destructor (if any) and release it.
+     * Stale and null handles are ignored.
+     */
+    void free(Handle handle);
+
+    /**
+     * @brief Current address of the block, or nullptr for a stale handle.
+     */
+    void* resolve(Handle handle) const;
+
+    template <typename T>
+    T* get(Handle handle) const {
+        return static_cast<T*>(resolve(handle));
+    }
+
+    bool is_valid(Handle handle) const { return resolve(handle) != nullptr; }
+
+    /**
+     * @brief Share of allocated chunk space taken by freed blocks.
+     */
+    double fragmentation() const;
+
+    /**
+     * @brief Whether compaction is in progress or a chunk is sparse enough
+     * to be worth compacting.
+     */
+    bool needs_compaction() const;
+
+    /**
+     * @brief Move up to max_bytes of live data out of the sparsest chunk,
+     * continuing the pass left off by the previous call. Once a source
+     * chunk holds no live blocks it is freed.
+     * @return Bytes moved; needs_compaction() tells whether work remains.
+     */
+    size_t compact_step(size_t max_bytes);
+
+    /**
+     * @brief Compact until no sparse chunk remains.
+     */
+    size_t compact();
+
+    size_t live_bytes() const;
+    size_t used_bytes() const;
+    size_t total_bytes() const;
+    size_t chunk_count() const;
+    size_t live_count() const;
+    size_t compacted_bytes() const;
+
+    /**
+     * @brief Chunks whose live bytes fall below this share of their used
+     * bytes are compacted.
+     */
+    static constexpr double kCompactionOccupancy = 0.5;
+
+private:
+    struct Chunk {
+        char* data = nullptr;
+        size_t capacity = 0;
+        size_t used = 0;
+        size_t live_bytes = 0;
+        size_t live_count = 0;
+        size_t pinned_count = 0;  // Live blocks with at least one Pin
+        bool survivor = false;
+        // Blocks in allocation order; entries of freed blocks go stale
+        std::vector<Handle> blocks;
+    };
+
+    struct Slot {
+        Chunk* chunk = nullptr;
+        size_t offset = 0;
+        size_t size = 0;
+        size_t alignment = 0;
+        uint32_t generation = 1;
+        uint32_t pins = 0;
+        RelocateFn relocate = nullptr;
+        DestroyFn destroy = nullptr;
+    };
+
+    Chunk* new_chunk(size_t min_size, bool survivor);
+    void release_chunk(Chunk* chunk);
+    void* bump(Chunk*& target, bool survivor, size_t size, size_t alignment,
+               size_t& offset);
+    const Slot* find_slot(Handle handle) const;
+    Chunk* pick_compaction_source() const;
+    Handle allocate_block(size_t size, size_t alignment, RelocateFn relocate,
+                          DestroyFn destroy, void** pinned);
+    void finish_create(Handle handle, DestroyFn destroy);
+    void* pin(Handle handle);
+    void unpin(Handle handle);
+
+    const size_t chunk_size_;
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+    Chunk* nursery_ = nullptr;
+    Chunk* survivor_ = nullptr;
+
+    // Incremental compaction state
+    Chunk* compaction_source_ = nullptr;
+    size_t compaction_cursor_ = 0;
+    size_t compacted_bytes_ = 0;
+
+    mutable std::shared_mutex mutex_;
+};
+
 // -----------------------------------------------------------------------------
 // PooledPtr
 // -----------------------------------------------------------------------------
 /**
- * @brief RAII smart wrapper returning objects to an ObjectPool on destruction.
+ * @brief RAII smart wrapper returning objects to a pool on destruction.
  *
- * PooledPtr owns a unique_ptr<T> and a pointer to the ObjectPool<T> it should
- * be returned to. When the PooledPtr is destroyed (or moved-from) the held
- * object is released back into the pool, enabling reuse.
+ * PooledPtr owns a unique_ptr<T> and a pointer to the pool (ObjectPool<T> or
+ * ConcurrentObjectPool<T>) it should be returned to. When the PooledPtr is
+ * destroyed (or moved-from) the held object is released back into the pool,
+ * enabling reuse.
  *
  * Semantics:
  *  - Move-only: copy operations are disabled to prevent double-return.
@@ -261,10 +1095,10 @@ private:
  *    object is returned via pool->release().
  *  - Use PooledPtr when you want automatic return-to-pool behavior.
  */
-template <typename T>
+template <typename T, typename Pool = ConcurrentObjectPool<T>>
 class PooledPtr {
 public:
-    PooledPtr(std::unique_ptr<T> ptr, ObjectPool<T>* pool)
+    PooledPtr(std::unique_ptr<T> ptr, Pool* pool)
         : ptr_(std::move(ptr)), pool_(pool) {}
 
     ~PooledPtr() {
@@ -302,7 +1136,7 @@ public:
 
 private:
     std::unique_ptr<T> ptr_;
-    ObjectPool<T>* pool_;
+    Pool* pool_;
 };
 
 // -----------------------------------------------------------------------------
@@ -316,15 +1150,34 @@ private:
  * query leaks. It is intended for diagnostic builds and may be enabled via
  * runtime configuration.
  *
+ * Two modes:
+ *  - Exact (sampling interval 0, the default): every tracked allocation is
+ *    recorded with its file/line under a lock. Precise but too expensive to
+ *    leave on outside development.
+ *  - Sampling: on average one allocation per sampling interval bytes is
+ *    recorded, together with a captured stack. The sample points follow a
+ *    Poisson process over allocated bytes (exponentially distributed gaps
+ *    drawn per thread), so each sample can be weighted to an unbiased
+ *    estimate of the allocations it stands for. Unsampled allocations cost a
+ *    thread-local countdown; unsampled frees cost two relaxed loads from a
+ *    counting Bloom filter of live sampled pointers. Samples are aggregated
+ *    per call site into a heap profile exportable as a legacy pprof heap
+ *    profile (export_pprof(), readable by `pprof`) or JSON (export_json()).
+ *
  * Notes:
  *  - The detector does not integrate with global new/delete by default; users
  *    must instrument allocations they wish to track. Integration macros are
  *    provided in this file to simplify instrumentation.
- *  - Thread-safety: uses a shared_mutex to allow concurrent queries while
- *    serializing modifications.
+ *  - Thread-safety: exact mode uses a shared_mutex to allow concurrent
+ *    queries while serializing modifications; sampling mode shards live
+ *    samples by pointer and only locks when an allocation is sampled or a
+ *    free hits the Bloom filter.
  */
 class MemoryLeakDetector {
 public:
+    static constexpr size_t kDefaultSamplingInterval = 512 * 1024;
+    static constexpr size_t kMaxStackDepth = 32;
+
     static MemoryLeakDetector& instance();
 
     /**
@@ -346,8 +1199,39 @@ public:
         std::string file;
         int line;
         std::chrono::steady_clock::time_point timestamp;
+        std::vector<void*> stack;  // Sampling mode only, innermost first
+        double weight = 1.0;       // Allocations this record stands for
     };
 
+    /**
+     * @brief Heap profile entry aggregating samples from one call site.
+     *
+     * sampled_* fields are raw sample counts and bytes; estimated_* fields
+     * are scaled by the sampling probability of each sample.
+     */
+    struct CallSiteProfile {
+        std::vector<void*> stack;
+        std::string file;
+        int line = 0;
+        size_t sampled_count = 0;
+        size_t sampled_bytes = 0;
+        size_t live_sampled_count = 0;
+        size_t live_sampled_bytes = 0;
+        double estimated_count = 0.0;
+        double estimated_bytes = 0.0;
+        double live_estimated_count = 0.0;
+        double live_estimated_bytes = 0.0;
+    };
+
+    /**
+     * @brief Switch between exact tracking (0) and sampling one allocation
+     * per interval_bytes on average. Changing the mode clears tracking.
+     */
+    void set_sampling_interval(size_t interval_bytes);
+    size_t sampling_interval() const {
+        return sampling_interval_.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Return a list of currently outstanding allocations (potential
      * leaks).
@@ -355,15 +1239,66 @@ public:
      * freed.
      */
     std::vector<AllocationInfo> get_leaks() const;
+    /**
+     * @brief Outstanding tracked bytes (an estimate in sampling mode).
+     */
     size_t get_total_allocated() const;
     size_t get_allocation_count() const;
     void clear_tracking();
 
+    /**
+     * @brief Call sites seen while sampling, largest live bytes first.
+     */
+    std::vector<CallSiteProfile> get_heap_profile() const;
+
+    /**
+     * @brief Heap profile in the legacy gperftools text format
+     * ("heap_v2/<interval>", raw sample counts, followed by the process
+     * mappings), which `pprof` reads and unsamples itself.
+     */
+    std::string export_pprof() const;
+
+    /**
+     * @brief Heap profile as JSON with symbolized frames and both raw and
+     * estimated counters.
+     */
+    QJsonObject export_json() const;
+
 private:
+    struct SampledAllocation {
+        uint64_t site;
+        size_t size;
+        double weight;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    struct SampleShard {
+        mutable std::mutex mutex;
+        std::unordered_map<void*, SampledAllocation> samples;
+    };
+
+    static constexpr size_t kShardCount = 16;
+    static constexpr size_t kFilterSize = size_t(1) << 15;
+
+    bool should_sample(size_t size, size_t interval);
+    void record_sample(void* ptr, size_t size, size_t interval,
+                       const char* file, int line);
+    bool release_sample(void* ptr);
+    static size_t shard_index(const void* ptr);
+    static std::array<size_t, 2> filter_slots(const void* ptr);
+
     mutable std::shared_mutex mutex_;
     std::unordered_map<void*, AllocationInfo> allocations_;
     std::atomic<size_t> total_allocated_{0};
     std::atomic<size_t> allocation_count_{0};
+
+    // **Sampling mode**
+    std::atomic<size_t> sampling_interval_{0};
+    std::atomic<uint64_t> sampling_epoch_{0};  // Bumped on mode changes
+    std::array<SampleShard, kShardCount> sample_shards_;
+    std::array<std::atomic<uint16_t>, kFilterSize> live_filter_{};
+    mutable std::mutex sites_mutex_;
+    std::unordered_map<uint64_t, CallSiteProfile> call_sites_;
 };
 
 // -----------------------------------------------------------------------------
@@ -375,6 +1310,10 @@ private:
  * Collects counters and metrics useful for telemetry and diagnostics. Fields
  * are updated by MemoryManager::update_statistics() and exposed via
  * get_statistics().
+ *
+ * The *_allocated_bytes fields cover memory the manager itself hands out
+ * (arenas, tracked allocations). The process_* and heap_* fields are the
+ * last ProcessMemorySample and stay zero where sampling is unsupported.
  */
 struct MemoryStatistics {
     size_t total_allocated_bytes = 0;
@@ -387,6 +1326,18 @@ struct MemoryStatistics {
     double fragmentation_ratio = 0.0;
     std::chrono::steady_clock::time_point last_gc_time;
     size_t gc_count = 0;
+
+    // Process memory as reported by the operating system and malloc
+    size_t process_rss_bytes = 0;
+    size_t process_peak_rss_bytes = 0;
+    size_t process_pss_bytes = 0;
+    size_t process_anonymous_bytes = 0;
+    size_t process_swap_bytes = 0;
+    size_t process_footprint_bytes = 0;  // PSS if known, RSS otherwise
+    size_t heap_in_use_bytes = 0;
+    size_t heap_free_bytes = 0;
+    size_t heap_mapped_bytes = 0;
+    std::chrono::steady_clock::time_point last_process_sample_time;
 };
 
 // -----------------------------------------------------------------------------
@@ -466,11 +1417,23 @@ public:
     template <typename T>
     ObjectPool<T>& get_pool();
 
+    /**
+     * @brief Get or create the ConcurrentObjectPool<T> backing
+     * create_pooled<T>().
+     *
+     * Same lifetime guarantees as get_pool(); prefer it for pools shared by
+     * worker threads.
+     */
+    template <typename T>
+    ConcurrentObjectPool<T>& get_concurrent_pool();
+
     /**
      * @brief Convenience: create a pooled RAII handle (PooledPtr<T>).
      *
-     * Allocates (or reuses) a T instance from the pool and returns a PooledPtr
-     * that will return the object to the pool when it goes out of scope.
+     * Allocates (or reuses) a T instance from the concurrent pool and returns
+     * a PooledPtr that will return the object to the pool when it goes out of
+     * scope. The pool is looked up once per thread, so steady-state calls
+     * touch no shared locks.
      *
      * @tparam T pooled type.
      * @tparam Args constructor arg types forwarded to T.
@@ -491,8 +1454,49 @@ public:
      */
     MemoryArena* create_arena(const QString& name, size_t size_bytes);
     MemoryArena* get_arena(const QString& name);
+    /**
+     * @brief Destroy the fixed or chunked arena registered under name.
+     */
     void destroy_arena(const QString& name);
 
+    /**
+     * @brief Create (or return the existing) named ChunkedArena.
+     *
+     * Chunked arenas are reported alongside fixed arenas and count towards
+     * memory usage. Optimization passes only release their spare chunks;
+     * unlike fixed arenas they are never reset behind the owner's back.
+     */
+    ChunkedArena* create_chunked_arena(const QString& name,
+                                       size_t initial_chunk_size = 64 * 1024);
+    ChunkedArena* get_chunked_arena(const QString& name);
+
+    /**
+     * @brief Create (or return the existing) named HandleArena.
+     *
+     * Handle arenas are compacted incrementally: each optimization tick
+     * starts a pass over fragmented arenas and further steps run from a
+     * zero-interval timer, i.e. when the event loop is otherwise idle.
+     */
+    HandleArena* create_handle_arena(const QString& name,
+                                     size_t chunk_size = 64 * 1024);
+    HandleArena* get_handle_arena(const QString& name);
+
+    /**
+     * @brief std::pmr adapter over the named fixed or chunked arena.
+     *
+     * The adapter is created on first request and destroyed together with
+     * the arena. Fixed arenas fall back to the default resource when full.
+     *
+     * @return nullptr if no arena with that name exists.
+     */
+    std::pmr::memory_resource* get_arena_resource(const QString& name);
+
+    /**
+     * @brief Shared synchronized size-class pool resource for pmr
+     * containers (see shared_pool_resource()).
+     */
+    std::pmr::memory_resource* get_pool_resource() const;
+
     // ---------------------------
     // Garbage collection control
     // ---------------------------
@@ -506,9 +1510,35 @@ public:
     // ---------------------------
     MemoryStatistics get_statistics() const;
     QJsonObject get_memory_report() const;
+
+    /**
+     * @brief Sample process memory now and record it in the statistics.
+     *
+     * Called on every memory check tick; cheap enough to call on demand.
+     */
+    ProcessMemorySample sample_process_memory() const;
     void enable_leak_detection(bool enabled);
     std::vector<MemoryLeakDetector::AllocationInfo> get_memory_leaks() const;
 
+    /**
+     * @brief Turn on leak detection in sampling mode, recording about one
+     * allocation per interval_bytes with its stack. Cheap enough to stay on
+     * in long-running soak builds; get_memory_leaks() then returns the live
+     * samples, each weighted by the allocations it represents.
+     */
+    void enable_allocation_sampling(
+        bool enabled,
+        size_t interval_bytes = MemoryLeakDetector::kDefaultSamplingInterval);
+
+    enum class HeapProfileFormat { Pprof, Json };
+
+    /**
+     * @brief Write the sampled heap profile to file_path.
+     * @return False if the file cannot be written.
+     */
+    bool write_heap_profile(const QString& file_path,
+                            HeapProfileFormat format) const;
+
     // ---------------------------
     // Optimization helpers
     // ---------------------------
@@ -553,14 +1583,25 @@ private slots:
     void on_memory_check_timer();
     void on_gc_timer();
     void on_optimization_timer();
+    void on_compaction_timer();
 
 private:
     // **Object pools for different types**
-    std::unordered_map<std::string, void*> object_pools_;
+    struct PoolEntry {
+        std::shared_ptr<void> pool;
+        size_t (*hits)(const void*) = nullptr;
+        size_t (*misses)(const void*) = nullptr;
+    };
+    std::unordered_map<std::string, PoolEntry> object_pools_;
     mutable std::shared_mutex pools_mutex_;
+    const uint64_t instance_id_;  // Keys per-thread pool lookups
 
     // **Memory arenas**
     std::unordered_map<QString, std::unique_ptr<MemoryArena>> memory_arenas_;
+    std::unordered_map<QString, std::unique_ptr<ChunkedArena>> chunked_arenas_;
+    std::unordered_map<QString, std::unique_ptr<HandleArena>> handle_arenas_;
+    std::unordered_map<QString, std::unique_ptr<std::pmr::memory_resource>>
+        arena_resources_;
     mutable std::shared_mutex arenas_mutex_;
 
     // **Configuration**
@@ -575,23 +1616,86 @@ private:
     // **Statistics**
     mutable MemoryStatistics statistics_;
     mutable std::shared_mutex statistics_mutex_;
+    mutable ProcessMemorySampler process_sampler_;
 
     // **Timers**
     std::unique_ptr<QTimer> memory_check_timer_;
     std::unique_ptr<QTimer> gc_timer_;
     std::unique_ptr<QTimer> optimization_timer_;
+    std::unique_ptr<QTimer> compaction_timer_;
 
     // **Internal methods**
     void check_memory_pressure();
     void perform_garbage_collection();
     void update_statistics();
     size_t calculate_current_memory_usage() const;
+    size_t calculate_managed_memory_usage() const;
     void cleanup_expired_objects();
+    // One budgeted compaction step per handle arena; true if work remains
+    bool step_handle_compaction(size_t max_bytes);
+
+    template <typename Pool>
+    Pool& find_or_create_pool(const std::string& key);
 
     template <typename T>
     std::string get_type_name() const;
 };
 
+// **MemoryManager template implementation**
+template <typename Pool>
+Pool& MemoryManager::find_or_create_pool(const std::string& key) {
+    {
+        std::shared_lock<std::shared_mutex> lock(pools_mutex_);
+        auto it = object_pools_.find(key);
+        if (it != object_pools_.end()) {
+            return *static_cast<Pool*>(it->second.pool.get());
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(pools_mutex_);
+    auto& entry = object_pools_[key];
+    if (!entry.pool) {
+        entry.pool = std::make_shared<Pool>();
+        entry.hits = [](const void* pool) {
+            return static_cast<const Pool*>(pool)->pool_hits();
+        };
+        entry.misses = [](const void* pool) {
+            return static_cast<const Pool*>(pool)->pool_misses();
+        };
+    }
+    return *static_cast<Pool*>(entry.pool.get());
+}
+
+template <typename T>
+ObjectPool<T>& MemoryManager::get_pool() {
+    return find_or_create_pool<ObjectPool<T>>(get_type_name<T>());
+}
+
+template <typename T>
+ConcurrentObjectPool<T>& MemoryManager::get_concurrent_pool() {
+    return find_or_create_pool<ConcurrentObjectPool<T>>(get_type_name<T>() +
+                                                        "#concurrent");
+}
+
+template <typename T, typename... Args>
+PooledPtr<T> MemoryManager::create_pooled(Args&&... args) {
+    // Pools live as long as the manager, so each thread resolves its pool
+    // once; the instance id guards against a new manager at the same address.
+    thread_local uint64_t cached_owner = 0;
+    thread_local ConcurrentObjectPool<T>* cached_pool = nullptr;
+    if (cached_owner != instance_id_) {
+        cached_pool = &get_concurrent_pool<T>();
+        cached_owner = instance_id_;
+    }
+    return PooledPtr<T>(cached_pool->acquire(std::forward<Args>(args)...),
+                        cached_pool);
+}
+
+template <typename T>
+std::string MemoryManager::get_type_name() const {
+    return typeid(T).name();
+}
+
 // -----------------------------------------------------------------------------
 // Allocation macros
 // -----------------------------------------------------------------------------
@@ -604,9 +1708,18 @@ private:
  * - TRACKED_DELETE is a no-op for pooled objects (PooledPtr destructor handles
  *   returning to pool). For non-pooled usage TRACKED_DELETE resets the pointer.
  *
+ * - TRACK_ALLOCATION / TRACK_DEALLOCATION report raw allocations made
+ *   outside the pools to MemoryLeakDetector.
+ *
  * These macros are easy to grep for and can be selectively enabled in debug
  * builds to assist tracking without widespread code changes.
  */
+#define TRACK_ALLOCATION(ptr, size)                                       \
+    DeclarativeUI::Core::MemoryLeakDetector::instance().track_allocation( \
+        (ptr), (size), __FILE__, __LINE__)
+#define TRACK_DEALLOCATION(ptr) \
+    DeclarativeUI::Core::MemoryLeakDetector::instance().track_deallocation(ptr)
+
 #ifdef ENABLE_MEMORY_TRACKING
 #define TRACKED_NEW(type, ...)                                          \
     DeclarativeUI::Core::MemoryManager::instance().create_pooled<type>( \
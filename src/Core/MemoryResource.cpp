@@ -0,0 +1,160 @@
+#include "MemoryResource.hpp"
+
+#include <algorithm>
+
+#include "MemoryManager.hpp"
+
+namespace DeclarativeUI::Core {
+
+// **ArenaMemoryResource implementation**
+ArenaMemoryResource::ArenaMemoryResource(MemoryArena& arena,
+                                         std::pmr::memory_resource* upstream)
+    : arena_(arena), upstream_(upstream) {}
+
+void* ArenaMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    if (void* ptr = arena_.allocate(bytes, alignment)) {
+        return ptr;
+    }
+    void* ptr = upstream_->allocate(bytes, alignment);
+    fallback_bytes_.fetch_add(bytes);
+    return ptr;
+}
+
+void ArenaMemoryResource::do_deallocate(void* ptr, size_t bytes,
+                                        size_t alignment) {
+    // Arena memory is reclaimed by MemoryArena::reset()
+    if (!arena_.owns(ptr)) {
+        upstream_->deallocate(ptr, bytes, alignment);
+        fallback_bytes_.fetch_sub(bytes);
+    }
+}
+
+bool ArenaMemoryResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+// **ChunkedArenaResource implementation**
+void* ChunkedArenaResource::do_allocate(size_t bytes, size_t alignment) {
+    return arena_.allocate(bytes, alignment);
+}
+
+void ChunkedArenaResource::do_deallocate(void*, size_t, size_t) {
+    // Reclaimed by ChunkedArena::rollback()/reset()
+}
+
+bool ChunkedArenaResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+// **SizeClassPoolResource implementation**
+SizeClassPoolResource::SizeClassPoolResource(
+    bool synchronized, std::pmr::memory_resource* upstream, size_t chunk_bytes)
+    : synchronized_(synchronized),
+      upstream_(upstream),
+      chunk_bytes_(std::max(chunk_bytes, kMaxPooledSize * 4)) {}
+
+SizeClassPoolResource::~SizeClassPoolResource() { release(); }
+
+size_t SizeClassPoolResource::class_index(size_t bytes) {
+    return static_cast<size_t>(
+        std::lower_bound(kClassSizes.begin(), kClassSizes.end(), bytes) -
+        kClassSizes.begin());
+}
+
+void* SizeClassPoolResource::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes > kMaxPooledSize || alignment > kBlockAlignment) {
+        large_bytes_.fetch_add(bytes);
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    const size_t index = class_index(std::max<size_t>(bytes, 1));
+    if (synchronized_) {
+        std::lock_guard<std::mutex> lock(classes_[index].mutex);
+        return allocate_block(index);
+    }
+    return allocate_block(index);
+}
+
+void SizeClassPoolResource::do_deallocate(void* ptr, size_t bytes,
+                                          size_t alignment) {
+    if (bytes > kMaxPooledSize || alignment > kBlockAlignment) {
+        upstream_->deallocate(ptr, bytes, alignment);
+        large_bytes_.fetch_sub(bytes);
+        return;
+    }
+
+    const size_t index = class_index(std::max<size_t>(bytes, 1));
+    if (synchronized_) {
+        std::lock_guard<std::mutex> lock(classes_[index].mutex);
+        free_block(index, ptr);
+        return;
+    }
+    free_block(index, ptr);
+}
+
+bool SizeClassPoolResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void* SizeClassPoolResource::allocate_block(size_t index) {
+    SizeClass& size_class = classes_[index];
+    const size_t block_size = kClassSizes[index];
+    in_use_bytes_.fetch_add(block_size, std::memory_order_relaxed);
+
+    if (FreeBlock* block = size_class.free_list) {
+        size_class.free_list = block->next;
+        return block;
+    }
+
+    if (!size_class.bump ||
+        size_class.bump + block_size > size_class.bump_end) {
+        void* chunk = upstream_->allocate(chunk_bytes_, kBlockAlignment);
+        {
+            std::lock_guard<std::mutex> lock(chunks_mutex_);
+            chunks_.push_back(chunk);
+        }
+        pooled_bytes_.fetch_add(chunk_bytes_, std::memory_order_relaxed);
+        size_class.bump = static_cast<char*>(chunk);
+        size_class.bump_end = size_class.bump + chunk_bytes_;
+    }
+
+    void* block = size_class.bump;
+    size_class.bump += block_size;
+    return block;
+}
+
+void SizeClassPoolResource::free_block(size_t index, void* ptr) {
+    SizeClass& size_class = classes_[index];
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = size_class.free_list;
+    size_class.free_list = block;
+    in_use_bytes_.fetch_sub(kClassSizes[index], std::memory_order_relaxed);
+}
+
+void SizeClassPoolResource::release() {
+    std::vector<void*> chunks;
+    {
+        std::lock_guard<std::mutex> lock(chunks_mutex_);
+        chunks.swap(chunks_);
+    }
+    for (auto& size_class : classes_) {
+        std::lock_guard<std::mutex> lock(size_class.mutex);
+        size_class.free_list = nullptr;
+        size_class.bump = size_class.bump_end = nullptr;
+    }
+    for (void* chunk : chunks) {
+        upstream_->deallocate(chunk, chunk_bytes_, kBlockAlignment);
+    }
+    pooled_bytes_.store(0);
+    in_use_bytes_.store(0);
+}
+
+std::pmr::memory_resource* shared_pool_resource() {
+    static SizeClassPoolResource resource(true);
+    return &resource;
+}
+
+}  // namespace DeclarativeUI::Core
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace DeclarativeUI::Core {
+
+class MemoryArena;
+class ChunkedArena;
+
+/**
+ * @file MemoryResource.hpp
+ * @brief std::pmr::memory_resource adapters over MemoryManager's arenas and
+ * a size-class pool.
+ *
+ * The adapters let standard pmr containers (std::pmr::vector,
+ * std::pmr::unordered_map, ...) draw from DeclarativeUI allocators:
+ *  - ArenaMemoryResource: bump allocation from a fixed MemoryArena, falling
+ *    back to an upstream resource once the arena is full.
+ *  - ChunkedArenaResource: bump allocation from a growable ChunkedArena.
+ *    Combined with ArenaScope a whole parse/validate/dispatch cycle can be
+ *    released in O(1).
+ *  - SizeClassPoolResource: segregated free lists for small blocks, for
+ *    long-lived node-based containers that insert and erase continuously.
+ *
+ * Arena-backed resources ignore deallocate(); memory comes back when the
+ * arena is reset or rolled back, so containers using them must be destroyed
+ * before that happens.
+ */
+
+/**
+ * @brief memory_resource over a fixed-size MemoryArena.
+ *
+ * Requests the arena cannot satisfy go to the upstream resource and are
+ * returned there on deallocate(). Thread-safety follows MemoryArena.
+ */
+class ArenaMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit ArenaMemoryResource(
+        MemoryArena& arena,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    MemoryArena& arena() const { return arena_; }
+
+    /**
+     * @brief Bytes currently served by the upstream resource.
+     */
+    size_t fallback_bytes() const { return fallback_bytes_.load(); }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override;
+
+    MemoryArena& arena_;
+    std::pmr::memory_resource* upstream_;
+    std::atomic<size_t> fallback_bytes_{0};
+};
+
+/**
+ * @brief memory_resource over a ChunkedArena.
+ *
+ * Allocation never fails short of the system running out of memory; use
+ * ArenaScope (or ChunkedArena::mark/rollback) around the containers'
+ * lifetime to free everything at once.
+ */
+class ChunkedArenaResource : public std::pmr::memory_resource {
+public:
+    explicit ChunkedArenaResource(ChunkedArena& arena) : arena_(arena) {}
+
+    ChunkedArena& arena() const { return arena_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override;
+
+    ChunkedArena& arena_;
+};
+
+/**
+ * @brief Size-class pool resource for small, frequently recycled blocks.
+ *
+ * Requests up to kMaxPooledSize bytes (alignment up to kBlockAlignment) are
+ * rounded to one of a dozen size classes. Each class keeps an intrusive free
+ * list and carves new blocks from chunks obtained upstream; freed blocks go
+ * back on the list. Larger or over-aligned requests pass straight through to
+ * upstream. Chunks are returned only by release() or destruction.
+ *
+ * Thread-safety: with synchronized = true each size class has its own mutex,
+ * so unrelated sizes never contend. Unsynchronized pools are for owners that
+ * already serialize access.
+ */
+class SizeClassPoolResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kBlockAlignment = 16;
+    static constexpr size_t kMaxPooledSize = 1024;
+
+    explicit SizeClassPoolResource(
+        bool synchronized = true,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource(),
+        size_t chunk_bytes = 64 * 1024);
+    ~SizeClassPoolResource() override;
+
+    SizeClassPoolResource(const SizeClassPoolResource&) = delete;
+    SizeClassPoolResource& operator=(const SizeClassPoolResource&) = delete;
+
+    /**
+     * @brief Return every chunk upstream. Outstanding blocks become invalid.
+     */
+    void release();
+
+    /** @return Bytes of chunks obtained from upstream for pooled classes. */
+    size_t pooled_bytes() const { return pooled_bytes_.load(); }
+    /** @return Bytes handed out from pooled classes and not yet freed. */
+    size_t in_use_bytes() const { return in_use_bytes_.load(); }
+    /** @return Bytes of pass-through (large) allocations outstanding. */
+    size_t large_bytes() const { return large_bytes_.load(); }
+
+private:
+    static constexpr size_t kClassCount = 12;
+    static constexpr std::array<size_t, kClassCount> kClassSizes = {
+        16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024};
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SizeClass {
+        FreeBlock* free_list = nullptr;
+        char* bump = nullptr;
+        char* bump_end = nullptr;
+        std::mutex mutex;
+    };
+
+    static size_t class_index(size_t bytes);
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override;
+
+    void* allocate_block(size_t index);
+    void free_block(size_t index, void* ptr);
+
+    const bool synchronized_;
+    std::pmr::memory_resource* upstream_;
+    const size_t chunk_bytes_;
+
+    std::array<SizeClass, kClassCount> classes_;
+    std::mutex chunks_mutex_;
+    std::vector<void*> chunks_;  // Guarded by chunks_mutex_
+
+    std::atomic<size_t> pooled_bytes_{0};
+    std::atomic<size_t> in_use_bytes_{0};
+    std::atomic<size_t> large_bytes_{0};
+};
+
+/**
+ * @brief Process-wide synchronized SizeClassPoolResource.
+ *
+ * Used by long-lived internals (state maps, command handler tables) that
+ * churn small nodes. Created on first use and destroyed after every static
+ * object that touched it during its own construction.
+ */
+std::pmr::memory_resource* shared_pool_resource();
+
+}  // namespace DeclarativeUI::Core
@@ -10,21 +10,237 @@
 #include <QFutureInterface>
 #include <QJsonArray>
 #include <QMetaObject>
+#include <QSaveFile>
 #include <QStandardPaths>
 #include <QTextStream>
 #include <QUuid>
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <mutex>
+
+#include "../JSON/JSONParser.hpp"
+#include "../JSON/JSONUILoader.hpp"
+
 namespace DeclarativeUI::Core {
 
+namespace {
+
+// **Chase-Lev work-stealing deque**
+// The owner pushes and pops at the bottom; any thread steals from the top.
+// Follows Lê et al., "Correct and Efficient Work-Stealing for Weak Memory
+// Models" (PPoPP 2013), using seq_cst operations where the paper uses
+// standalone fences. Arrays replaced by growth are retired, not freed, until
+// the deque is destroyed, since a thief may still be reading them.
+template <typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256)
+        : array_(new Array(capacity)) {}
+
+    ~WorkStealingDeque() { delete array_.load(); }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only
+    void push(T item) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        Array* array = array_.load(std::memory_order_relaxed);
+        if (bottom - top > array->capacity - 1) {
+            array = grow(array, bottom, top);
+        }
+        array->put(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release);
+    }
+
+    // Owner only; LIFO
+    T pop() {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* array = array_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_seq_cst);
+
+        T item = nullptr;
+        if (top <= bottom) {
+            item = array->get(bottom);
+            if (top == bottom) {
+                // Last element: race against thieves for it
+                if (!top_.compare_exchange_strong(top, top + 1,
+                                                  std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+        } else {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread; FIFO. nullptr when empty or when another thread won.
+    T steal() {
+        int64_t top = top_.load(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+        if (top >= bottom) {
+            return nullptr;
+        }
+        Array* array = array_.load(std::memory_order_acquire);
+        T item = array->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+private:
+    struct Array {
+        explicit Array(int64_t size)
+            : capacity(size),
+              mask(size - 1),
+              cells(new std::atomic<T>[size]) {}
+
+        T get(int64_t index) const {
+            return cells[index & mask].load(std::memory_order_relaxed);
+        }
+        void put(int64_t index, T item) {
+            cells[index & mask].store(item, std::memory_order_relaxed);
+        }
+
+        const int64_t capacity;
+        const int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> cells;
+    };
+
+    Array* grow(Array* array, int64_t bottom, int64_t top) {
+        auto* bigger = new Array(array->capacity * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            bigger->put(i, array->get(i));
+        }
+        retired_.emplace_back(array);
+        array_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Array*> array_;
+    std::vector<std::unique_ptr<Array>> retired_;  // Owner only
+};
+
+using PoolTask = std::function<void()>;
+
+// Worker identity of the current thread
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+constexpr size_t kNoWorker = static_cast<size_t>(-1);
+constexpr int kSpinIterations = 128;
+
+size_t lane_of(TaskPriority priority) {
+    return std::min(static_cast<size_t>(priority), size_t(3));
+}
+
+void spin_pause(int iteration) {
+    if (iteration < kSpinIterations / 2) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+// **Data-parallel chunking**
+// Chunks should run long enough that claiming one is negligible
+constexpr auto kMinChunkTime = std::chrono::microseconds(25);
+// Planning times a prefix until it has run this long
+constexpr auto kProbeTime = std::chrono::microseconds(10);
+// Target chunks per participant, for load balance
+constexpr size_t kChunksPerParticipant = 8;
+// Smallest run parallelSort() sorts on its own
+constexpr size_t kMinSortRun = 8192;
+
+// Shared by the caller and the helper tasks of one runChunks() call.
+// Helpers may start after the call returned; they then find no chunk
+// left and never touch body.
+struct ChunkRun {
+    const std::function<void(size_t, size_t, size_t)>* body = nullptr;
+    size_t offset = 0;
+    size_t grain = 0;
+    size_t count = 0;
+    size_t chunks = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    void work() {
+        for (size_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+             chunk < chunks;
+             chunk = next.fetch_add(1, std::memory_order_relaxed)) {
+            if (!failed.load(std::memory_order_relaxed)) {
+                const size_t begin = offset + chunk * grain;
+                try {
+                    (*body)(chunk, begin, std::min(begin + grain, count));
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                done.notify_all();
+            }
+        }
+    }
+};
+
+}  // namespace
+
+struct ThreadPool::WorkerQueues {
+    std::array<WorkStealingDeque<PoolTask*>, kLaneCount> lanes;
+};
+
+struct ThreadPool::InjectionLane {
+    std::mutex mutex;
+    std::deque<PoolTask*> tasks;
+    std::atomic<size_t> size{0};
+};
+
 // **ThreadPool implementation**
-ThreadPool::ThreadPool(size_t thread_count) {
-    workers_.reserve(thread_count);
+ThreadPool::ThreadPool(size_t thread_count, SchedulingMode mode)
+    : mode_(mode), thread_count_(std::max<size_t>(thread_count, 1)) {
+    workers_.reserve(thread_count_);
 
-    for (size_t i = 0; i < thread_count; ++i) {
-        workers_.emplace_back(&ThreadPool::worker_thread, this);
+    if (mode_ == SchedulingMode::WorkStealing) {
+        for (size_t i = 0; i < thread_count_; ++i) {
+            worker_queues_.push_back(std::make_unique<WorkerQueues>());
+        }
+        for (size_t lane = 0; lane < kLaneCount; ++lane) {
+            injection_lanes_.push_back(std::make_unique<InjectionLane>());
+        }
+        for (size_t i = 0; i < thread_count_; ++i) {
+            workers_.emplace_back(&ThreadPool::stealing_worker_thread, this,
+                                  i);
+        }
+    } else {
+        for (size_t i = 0; i < thread_count_; ++i) {
+            workers_.emplace_back(&ThreadPool::worker_thread, this);
+        }
     }
 
-    qDebug() << "🔥 ThreadPool initialized with" << thread_count << "threads";
+    qDebug() << "🔥 ThreadPool initialized with" << thread_count_ << "threads"
+             << (mode_ == SchedulingMode::WorkStealing ? "(work stealing)"
+                                                       : "(shared queue)");
 }
 
 ThreadPool::~ThreadPool() { shutdown(); }
@@ -33,6 +249,7 @@ void ThreadPool::shutdown() {
     {
         std::unique_lock<std::mutex> lock(queue_mutex_);
         running_.store(false);
+        wake_epoch_.fetch_add(1);
     }
 
     condition_.notify_all();
@@ -43,6 +260,26 @@ void ThreadPool::shutdown() {
         }
     }
 
+    // Tasks still queued are dropped; their futures report broken promises
+    for (auto& queues : worker_queues_) {
+        for (auto& lane : queues->lanes) {
+            while (PoolTask* task = lane.pop()) {
+                delete task;
+            }
+        }
+    }
+    for (auto& lane : injection_lanes_) {
+        std::lock_guard<std::mutex> lock(lane->mutex);
+        for (PoolTask* task : lane->tasks) {
+            delete task;
+        }
+        lane->tasks.clear();
+        lane->size.store(0);
+    }
+    for (auto& pending : lane_pending_) {
+        pending.store(0);
+    }
+
     workers_.clear();
     qDebug() << "🔥 ThreadPool shutdown completed";
 }
@@ -54,16 +291,41 @@ void ThreadPool::pause() {
 
 void ThreadPool::resume() {
     paused_.store(false);
-    condition_.notify_all();
+    wake_workers(true);
     qDebug() << "🔥 ThreadPool resumed";
 }
 
 size_t ThreadPool::queued_tasks() const {
+    if (mode_ == SchedulingMode::WorkStealing) {
+        int64_t queued = 0;
+        for (const auto& pending : lane_pending_) {
+            queued += pending.load(std::memory_order_relaxed);
+        }
+        return queued > 0 ? static_cast<size_t>(queued) : 0;
+    }
     std::unique_lock<std::mutex> lock(queue_mutex_);
     return task_queue_.size();
 }
 
+bool ThreadPool::is_worker_thread() const { return current_pool == this; }
+
+void ThreadPool::run_task(std::function<void()>& task) {
+    active_threads_.fetch_add(1);
+
+    try {
+        task();
+    } catch (const std::exception& e) {
+        qWarning() << "🔥 Task execution failed:" << e.what();
+    } catch (...) {
+        qWarning() << "🔥 Task execution failed with unknown error";
+    }
+
+    active_threads_.fetch_sub(1);
+}
+
 void ThreadPool::worker_thread() {
+    current_pool = this;
+
     while (true) {
         TaskWrapper task;
 
@@ -87,23 +349,563 @@ void ThreadPool::worker_thread() {
             task_queue_.pop();
         }
 
-        active_threads_.fetch_add(1);
+        run_task(task.task);
+    }
+}
+
+void ThreadPool::submit(TaskPriority priority, std::function<void()> task) {
+    if (mode_ == SchedulingMode::SharedQueue) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            if (!running_.load()) {
+                throw std::runtime_error("ThreadPool is not running");
+            }
+
+            TaskWrapper wrapper;
+            wrapper.task = std::move(task);
+            wrapper.priority = priority;
+            wrapper.enqueue_time = std::chrono::steady_clock::now();
+            task_queue_.push(std::move(wrapper));
+        }
+        condition_.notify_one();
+        return;
+    }
+
+    if (!running_.load()) {
+        throw std::runtime_error("ThreadPool is not running");
+    }
+
+    const size_t lane = lane_of(priority);
+    auto* node = new PoolTask(std::move(task));
+    if (current_pool == this) {
+        worker_queues_[current_worker]->lanes[lane].push(node);
+    } else {
+        InjectionLane& injection = *injection_lanes_[lane];
+        std::lock_guard<std::mutex> lock(injection.mutex);
+        injection.tasks.push_back(node);
+        injection.size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Pairs with the seq_cst sleeper registration in park_worker()
+    lane_pending_[lane].fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping_workers_.load(std::memory_order_seq_cst) > 0) {
+        wake_workers(false);
+    }
+}
+
+bool ThreadPool::has_pending_tasks() const {
+    for (const auto& pending : lane_pending_) {
+        if (pending.load(std::memory_order_seq_cst) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
 
+std::function<void()>* ThreadPool::find_stealing_task(size_t self) {
+    const size_t worker_count = worker_queues_.size();
+
+    for (size_t lane = kLaneCount; lane-- > 0;) {
+        if (lane_pending_[lane].load(std::memory_order_relaxed) <= 0) {
+            continue;
+        }
+
+        PoolTask* task = nullptr;
+        if (self != kNoWorker) {
+            task = worker_queues_[self]->lanes[lane].pop();
+        }
+
+        if (!task) {
+            InjectionLane& injection = *injection_lanes_[lane];
+            if (injection.size.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(injection.mutex);
+                if (!injection.tasks.empty()) {
+                    task = injection.tasks.front();
+                    injection.tasks.pop_front();
+                    injection.size.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        if (!task) {
+            // Start at a different victim per thief to spread contention
+            const size_t start =
+                self != kNoWorker ? self + 1
+                                  : static_cast<size_t>(
+                                        std::hash<std::thread::id>()(
+                                            std::this_thread::get_id()));
+            for (size_t i = 0; i < worker_count && !task; ++i) {
+                const size_t victim = (start + i) % worker_count;
+                if (victim != self) {
+                    task = worker_queues_[victim]->lanes[lane].steal();
+                }
+            }
+            if (task) {
+                steal_count_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (task) {
+            lane_pending_[lane].fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+bool ThreadPool::try_run_one() {
+    if (mode_ == SchedulingMode::SharedQueue) {
+        TaskWrapper task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            if (task_queue_.empty() || paused_.load()) {
+                return false;
+            }
+            task = task_queue_.top();
+            task_queue_.pop();
+        }
+        run_task(task.task);
+        return true;
+    }
+
+    if (paused_.load() || !running_.load()) {
+        return false;
+    }
+    PoolTask* task =
+        find_stealing_task(current_pool == this ? current_worker : kNoWorker);
+    if (!task) {
+        return false;
+    }
+    run_task(*task);
+    delete task;
+    return true;
+}
+
+void ThreadPool::stealing_worker_thread(size_t index) {
+    current_pool = this;
+    current_worker = index;
+
+    while (running_.load(std::memory_order_relaxed)) {
+        if (paused_.load(std::memory_order_relaxed)) {
+            park_worker();
+            continue;
+        }
+
+        if (PoolTask* task = find_stealing_task(index)) {
+            run_task(*task);
+            delete task;
+            continue;
+        }
+
+        // Spin briefly: fine-grained work usually arrives within microseconds
+        bool found = false;
+        for (int spin = 0; spin < kSpinIterations; ++spin) {
+            if (has_pending_tasks() || !running_.load()) {
+                found = true;
+                break;
+            }
+            spin_pause(spin);
+        }
+        if (!found) {
+            park_worker();
+        }
+    }
+}
+
+void ThreadPool::park_worker() {
+    const uint64_t epoch = wake_epoch_.load(std::memory_order_seq_cst);
+    sleeping_workers_.fetch_add(1, std::memory_order_seq_cst);
+
+    // Re-check after registering: a submitter either sees us sleeping or we
+    // see its task
+    if (!running_.load() || (!paused_.load() && has_pending_tasks())) {
+        sleeping_workers_.fetch_sub(1, std::memory_order_seq_cst);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        condition_.wait(lock, [&] {
+            return wake_epoch_.load() != epoch || !running_.load();
+        });
+    }
+    sleeping_workers_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void ThreadPool::wake_workers(bool all) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        wake_epoch_.fetch_add(1);
+    }
+    if (all) {
+        condition_.notify_all();
+    } else {
+        condition_.notify_one();
+    }
+}
+
+// **TaskGraph implementation**
+struct TaskGraph::Node {
+    QString name;
+    NodeFunction function;
+    TaskPriority priority = TaskPriority::Normal;
+    std::vector<NodeId> predecessors;
+    std::vector<NodeId> successors;
+
+    bool dirty = true;
+    bool scheduled = false;  // Part of the current run
+    std::atomic<NodeState> state{NodeState::Pending};
+    std::atomic<size_t> pending_predecessors{0};
+    std::atomic<size_t> execution_count{0};
+    QVariant result;
+    QString error;
+    std::chrono::microseconds duration{0};
+};
+
+struct TaskGraph::RunState {
+    QFutureInterface<TaskGraphResult> interface;
+    std::function<void(const TaskGraphResult&)> on_finished;
+    std::vector<NodeId> order;  // Scheduled nodes, topologically sorted
+    std::atomic<size_t> remaining{0};
+    std::atomic<bool> cancelled{false};
+    std::chrono::steady_clock::time_point start_time;
+};
+
+TaskGraph::TaskGraph(const QString& name) : name_(name) {}
+
+TaskGraph::~TaskGraph() = default;
+
+TaskGraph::NodeId TaskGraph::addNodeFunction(const QString& name,
+                                             NodeFunction function,
+                                             TaskPriority priority) {
+    requireIdle();
+    auto node = std::make_unique<Node>();
+    node->name = name;
+    node->function = std::move(function);
+    node->priority = priority;
+    nodes_.push_back(std::move(node));
+    return nodes_.size() - 1;
+}
+
+void TaskGraph::addEdge(NodeId from, NodeId to) {
+    requireIdle();
+    node(from);
+    node(to);
+
+    auto& successors = nodes_[from]->successors;
+    if (std::find(successors.begin(), successors.end(), to) !=
+        successors.end()) {
+        return;
+    }
+
+    // The edge closes a cycle if from is reachable from to
+    std::vector<NodeId> stack{to};
+    std::vector<bool> visited(nodes_.size(), false);
+    while (!stack.empty()) {
+        const NodeId current = stack.back();
+        stack.pop_back();
+        if (current == from) {
+            throw std::invalid_argument(
+                QString("Edge %1 -> %2 would create a cycle in task graph %3")
+                    .arg(nodes_[from]->name, nodes_[to]->name, name_)
+                    .toStdString());
+        }
+        if (visited[current]) {
+            continue;
+        }
+        visited[current] = true;
+        for (NodeId next : nodes_[current]->successors) {
+            stack.push_back(next);
+        }
+    }
+
+    successors.push_back(to);
+    nodes_[to]->predecessors.push_back(from);
+    invalidate(to);
+}
+
+void TaskGraph::invalidate(NodeId id) {
+    requireIdle();
+    node(id);
+
+    std::vector<NodeId> stack{id};
+    while (!stack.empty()) {
+        Node& current = *nodes_[stack.back()];
+        stack.pop_back();
+        if (current.dirty && &current != nodes_[id].get()) {
+            continue;  // Already dirty downstream as well
+        }
+        current.dirty = true;
+        for (NodeId next : current.successors) {
+            stack.push_back(next);
+        }
+    }
+}
+
+void TaskGraph::invalidateAll() {
+    requireIdle();
+    for (auto& node : nodes_) {
+        node->dirty = true;
+    }
+}
+
+void TaskGraph::cancel() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (current_run_) {
+        current_run_->cancelled.store(true);
+    }
+}
+
+const TaskGraph::Node& TaskGraph::node(NodeId id) const {
+    if (id >= nodes_.size()) {
+        throw std::out_of_range("Unknown task graph node");
+    }
+    return *nodes_[id];
+}
+
+void TaskGraph::requireIdle() const {
+    if (running_.load()) {
+        throw std::runtime_error("TaskGraph cannot change while running");
+    }
+}
+
+bool TaskGraph::isDirty(NodeId id) const { return node(id).dirty; }
+
+TaskGraph::NodeState TaskGraph::state(NodeId id) const {
+    return node(id).state.load();
+}
+
+QVariant TaskGraph::result(NodeId id) const { return node(id).result; }
+
+QString TaskGraph::error(NodeId id) const { return node(id).error; }
+
+QString TaskGraph::nodeName(NodeId id) const { return node(id).name; }
+
+std::chrono::microseconds TaskGraph::executionTime(NodeId id) const {
+    return node(id).duration;
+}
+
+size_t TaskGraph::executionCount(NodeId id) const {
+    return node(id).execution_count.load();
+}
+
+TaskGraphResult TaskGraph::lastResult() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return last_result_;
+}
+
+QFuture<TaskGraphResult> TaskGraph::start(
+    ThreadPool& pool, std::function<void(const TaskGraphResult&)> on_finished) {
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true)) {
+        throw std::runtime_error("TaskGraph is already running");
+    }
+
+    auto run = std::make_shared<RunState>();
+    run->on_finished = std::move(on_finished);
+    run->start_time = std::chrono::steady_clock::now();
+    run->interface.reportStarted();
+    QFuture<TaskGraphResult> future = run->interface.future();
+
+    // Readiness counters only count predecessors that run as well; clean
+    // predecessors already hold their results
+    std::vector<NodeId> ready;
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+        Node& node = *nodes_[id];
+        node.scheduled = node.dirty;
+        if (node.scheduled) {
+            node.state.store(NodeState::Pending);
+            node.error.clear();
+        }
+    }
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+        Node& node = *nodes_[id];
+        if (!node.scheduled) {
+            continue;
+        }
+        size_t pending = 0;
+        for (NodeId pred : node.predecessors) {
+            pending += nodes_[pred]->scheduled ? 1 : 0;
+        }
+        node.pending_predecessors.store(pending);
+        if (pending == 0) {
+            ready.push_back(id);
+        }
+    }
+
+    // Topological order of the scheduled nodes, for the critical path
+    std::vector<size_t> in_degree(nodes_.size());
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+        in_degree[id] = nodes_[id]->pending_predecessors.load();
+    }
+    run->order = ready;
+    for (size_t i = 0; i < run->order.size(); ++i) {
+        for (NodeId next : nodes_[run->order[i]]->successors) {
+            if (nodes_[next]->scheduled && --in_degree[next] == 0) {
+                run->order.push_back(next);
+            }
+        }
+    }
+    run->remaining.store(run->order.size());
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        current_run_ = run;
+    }
+
+    if (run->order.empty()) {
+        finishRun(run);
+        return future;
+    }
+    for (NodeId id : ready) {
+        scheduleNode(pool, id, run);
+    }
+    return future;
+}
+
+void TaskGraph::scheduleNode(ThreadPool& pool, NodeId id,
+                             const std::shared_ptr<RunState>& run) {
+    try {
+        pool.post(nodes_[id]->priority,
+                  [this, &pool, id, run]() { executeNode(pool, id, run); });
+    } catch (const std::runtime_error&) {
+        // Pool shut down: settle the rest of the graph as cancelled
+        run->cancelled.store(true);
+        executeNode(pool, id, run);
+    }
+}
+
+void TaskGraph::executeNode(ThreadPool& pool, NodeId id,
+                            const std::shared_ptr<RunState>& run) {
+    Node& node = *nodes_[id];
+
+    QVariantList inputs;
+    QString upstream_error;
+    for (NodeId pred : node.predecessors) {
+        const Node& input = *nodes_[pred];
+        const NodeState input_state = input.state.load();
+        if (input_state == NodeState::Failed) {
+            upstream_error = QString("Upstream node '%1' failed: %2")
+                                 .arg(input.name, input.error);
+            break;
+        }
+        if (input_state != NodeState::Completed) {
+            upstream_error = input.error;  // Already names the root cause
+            break;
+        }
+        inputs.append(input.result);
+    }
+
+    if (run->cancelled.load()) {
+        node.error = "Task graph cancelled";
+        node.state.store(NodeState::Cancelled);
+    } else if (!upstream_error.isEmpty()) {
+        node.error = upstream_error;
+        node.state.store(NodeState::Cancelled);
+    } else {
+        node.state.store(NodeState::Running);
+        const auto start_time = std::chrono::steady_clock::now();
+        NodeState final_state = NodeState::Completed;
         try {
-            task.task();
+            node.result = node.function(inputs);
+            node.dirty = false;
         } catch (const std::exception& e) {
-            qWarning() << "🔥 Task execution failed:" << e.what();
+            node.error = QString::fromStdString(e.what());
+            final_state = NodeState::Failed;
         } catch (...) {
-            qWarning() << "🔥 Task execution failed with unknown error";
+            node.error = "Unknown error";
+            final_state = NodeState::Failed;
+        }
+        node.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        node.execution_count.fetch_add(1);
+        node.state.store(final_state);
+    }
+
+    for (NodeId next : node.successors) {
+        Node& successor = *nodes_[next];
+        if (successor.scheduled &&
+            successor.pending_predecessors.fetch_sub(
+                1, std::memory_order_acq_rel) == 1) {
+            scheduleNode(pool, next, run);
+        }
+    }
+
+    if (run->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        finishRun(run);
+    }
+}
+
+void TaskGraph::finishRun(const std::shared_ptr<RunState>& run) {
+    TaskGraphResult result;
+    result.cancelled = run->cancelled.load();
+    result.wall_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - run->start_time);
+
+    // Longest chain of executed nodes, by execution time
+    std::vector<std::chrono::microseconds> path_time(nodes_.size());
+    std::vector<NodeId> path_prev(nodes_.size(), nodes_.size());
+    NodeId path_end = nodes_.size();
+    for (NodeId id : run->order) {
+        const Node& node = *nodes_[id];
+        const NodeState state = node.state.load();
+        const bool executed =
+            state == NodeState::Completed || state == NodeState::Failed;
+        if (executed) {
+            ++result.executed_nodes;
+            result.total_work_time += node.duration;
+        }
+        if (state == NodeState::Failed) {
+            ++result.failed_nodes;
+            result.errors.append(QString("%1: %2").arg(node.name, node.error));
+        } else if (state == NodeState::Cancelled) {
+            ++result.cancelled_nodes;
         }
 
-        active_threads_.fetch_sub(1);
+        for (NodeId pred : node.predecessors) {
+            if (nodes_[pred]->scheduled && path_time[pred] > path_time[id]) {
+                path_time[id] = path_time[pred];
+                path_prev[id] = pred;
+            }
+        }
+        if (executed) {
+            path_time[id] += node.duration;
+        }
+        if (path_end == nodes_.size() || path_time[id] > path_time[path_end]) {
+            path_end = id;
+        }
+    }
+    if (path_end != nodes_.size()) {
+        result.critical_path_time = path_time[path_end];
+        for (NodeId id = path_end; id != nodes_.size(); id = path_prev[id]) {
+            result.critical_path.prepend(nodes_[id]->name);
+        }
     }
+    result.success = result.failed_nodes == 0 && result.cancelled_nodes == 0;
+
+    auto on_finished = std::move(run->on_finished);
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        last_result_ = result;
+        current_run_.reset();
+    }
+    running_.store(false);
+
+    // Before the future finishes, so its waiters see the owner's
+    // bookkeeping. May drop the last reference to this graph; only run and
+    // result are used after it.
+    if (on_finished) {
+        on_finished(result);
+    }
+
+    run->interface.reportResult(result);
+    run->interface.reportFinished();
 }
 
 // **ParallelProcessor implementation**
 ParallelProcessor::ParallelProcessor(QObject* parent) : QObject(parent) {
-    thread_pool_ = std::make_unique<ThreadPool>();
+    thread_pool_ = std::make_unique<ThreadPool>(
+        std::thread::hardware_concurrency(), scheduling_mode_);
 
     // Setup timeout timer
     timeout_timer_ = std::make_unique<QTimer>(this);
@@ -129,6 +931,138 @@ ParallelProcessor::~ParallelProcessor() {
     qDebug() << "🔥 ParallelProcessor destroyed";
 }
 
+QFuture<TaskGraphResult> ParallelProcessor::runTaskGraph(
+    std::shared_ptr<TaskGraph> graph) {
+    if (!graph) {
+        throw std::invalid_argument("Cannot run a null task graph");
+    }
+
+    // Counted until on_finished, which runs before the future finishes
+    running_graphs_.fetch_add(1);
+    try {
+        return graph->start(
+            *thread_pool_, [this, graph](const TaskGraphResult& result) {
+                running_graphs_.fetch_sub(1);
+                task_graphs_executed_.fetch_add(1);
+                {
+                    std::lock_guard<std::mutex> lock(graph_metrics_mutex_);
+                    last_graph_result_ = result;
+                }
+
+                const QString name = graph->name();
+                const bool success = result.success;
+                QMetaObject::invokeMethod(
+                    this,
+                    [this, name, success]() {
+                        emit taskGraphCompleted(name, success);
+                    },
+                    Qt::QueuedConnection);
+            });
+    } catch (...) {
+        running_graphs_.fetch_sub(1);
+        throw;
+    }
+}
+
+ParallelProcessor::ChunkPlan ParallelProcessor::planChunks(
+    size_t count, size_t grain, const RangeFunction& probe) const {
+    ChunkPlan plan;
+    const size_t participants = thread_pool_->thread_count() + 1;
+
+    if (grain == 0) {
+        // Run a doubling prefix here until it took long enough to estimate
+        // the cost per element. The prefix is part of the result, and is
+        // capped so it cannot eat into the parallel share of the range.
+        const size_t probe_limit =
+            std::max<size_t>(1, count / (kChunksPerParticipant * participants));
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration::zero();
+        for (size_t step = 1; plan.probed < probe_limit; step *= 2) {
+            const size_t end = std::min(probe_limit, plan.probed + step);
+            probe(plan.probed, end);
+            plan.probed = end;
+            elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed >= kProbeTime) {
+                break;
+            }
+        }
+
+        const size_t remaining = count - plan.probed;
+        if (remaining == 0) {
+            return plan;
+        }
+        const double element_ns =
+            std::chrono::duration<double, std::nano>(elapsed).count() /
+            static_cast<double>(plan.probed);
+        const double min_chunk_ns =
+            std::chrono::duration<double, std::nano>(kMinChunkTime).count();
+
+        // Too little left to be worth a handoff: finish on this thread
+        if (element_ns * static_cast<double>(remaining) < 2 * min_chunk_ns) {
+            plan.grain = remaining;
+            plan.chunks = 1;
+            return plan;
+        }
+
+        const auto by_time = static_cast<size_t>(
+            std::ceil(min_chunk_ns / std::max(element_ns, 0.1)));
+        const size_t by_balance =
+            (remaining + kChunksPerParticipant * participants - 1) /
+            (kChunksPerParticipant * participants);
+        grain = std::max(by_time, by_balance);
+    }
+
+    plan.grain = grain;
+    plan.chunks = (count - plan.probed + grain - 1) / grain;
+    return plan;
+}
+
+void ParallelProcessor::runChunks(const ChunkPlan& plan, size_t count,
+                                  const ChunkFunction& body) {
+    if (plan.chunks == 0) {
+        return;
+    }
+
+    auto run = std::make_shared<ChunkRun>();
+    run->body = &body;
+    run->offset = plan.probed;
+    run->grain = plan.grain;
+    run->count = count;
+    run->chunks = plan.chunks;
+
+    const size_t helpers =
+        std::min(plan.chunks - 1, thread_pool_->thread_count());
+    for (size_t i = 0; i < helpers; ++i) {
+        try {
+            thread_pool_->post(TaskPriority::Normal, [run]() { run->work(); });
+        } catch (const std::runtime_error&) {
+            break;  // Pool stopped: the caller runs every chunk
+        }
+    }
+
+    // Only chunks another thread has claimed can be outstanding once this
+    // returns, and those are running, so blocking cannot deadlock
+    run->work();
+    for (size_t done = run->done.load(std::memory_order_acquire);
+         done < plan.chunks; done = run->done.load(std::memory_order_acquire)) {
+        run->done.wait(done, std::memory_order_acquire);
+    }
+
+    if (run->error) {
+        std::rethrow_exception(run->error);
+    }
+}
+
+size_t ParallelProcessor::sortRunCount(size_t count) const {
+    const size_t limit = std::min(2 * thread_pool_->thread_count(),
+                                  count / kMinSortRun);
+    size_t runs = 1;
+    while (runs * 2 <= limit) {
+        runs *= 2;
+    }
+    return runs;
+}
+
 void ParallelProcessor::cancelTask(const QString& task_id) {
     std::unique_lock<std::shared_mutex> lock(tasks_mutex_);
 
@@ -195,12 +1129,38 @@ bool ParallelProcessor::isTaskCompleted(const QString& task_id) const {
     return active_tasks_.find(task_id) == active_tasks_.end();
 }
 
-void ParallelProcessor::setThreadPoolSize(size_t size) {
-    if (thread_pool_) {
-        thread_pool_->shutdown();
+bool ParallelProcessor::setThreadPoolSize(size_t size) {
+    if (!replaceThreadPool(size, scheduling_mode_)) {
+        return false;
     }
-    thread_pool_ = std::make_unique<ThreadPool>(size);
     qDebug() << "🔥 Thread pool resized to" << size << "threads";
+    return true;
+}
+
+bool ParallelProcessor::setSchedulingMode(ThreadPool::SchedulingMode mode) {
+    if (mode == scheduling_mode_) {
+        return true;
+    }
+    return replaceThreadPool(thread_pool_->thread_count(), mode);
+}
+
+bool ParallelProcessor::replaceThreadPool(size_t size,
+                                          ThreadPool::SchedulingMode mode) {
+    // Running graphs hold the pool and post their next nodes to it, and
+    // queued tasks would be dropped by shutdown()
+    if (running_graphs_.load() > 0 || thread_pool_->queued_tasks() > 0) {
+        qWarning() << "🔥 Cannot replace the thread pool while tasks are "
+                      "in flight";
+        return false;
+    }
+
+    // Joins the workers, so tasks still running finish first. The old pool
+    // stays alive for references taken through threadPool().
+    thread_pool_->shutdown();
+    retired_pools_.push_back(std::move(thread_pool_));
+    thread_pool_ = std::make_unique<ThreadPool>(size, mode);
+    scheduling_mode_ = mode;
+    return true;
 }
 
 void ParallelProcessor::pauseProcessing() {
@@ -235,6 +1195,15 @@ QJsonObject ParallelProcessor::getPerformanceMetrics() const {
         metrics["active_threads"] =
             static_cast<qint64>(thread_pool_->active_threads());
         metrics["thread_pool_running"] = thread_pool_->is_running();
+        metrics["thread_count"] =
+            static_cast<qint64>(thread_pool_->thread_count());
+        metrics["scheduling_mode"] =
+            thread_pool_->scheduling_mode() ==
+                    ThreadPool::SchedulingMode::WorkStealing
+                ? "work_stealing"
+                : "shared_queue";
+        metrics["steal_count"] =
+            static_cast<qint64>(thread_pool_->steal_count());
     }
 
     double success_rate =
@@ -245,6 +1214,25 @@ QJsonObject ParallelProcessor::getPerformanceMetrics() const {
             : 100.0;
     metrics["success_rate"] = success_rate;
 
+    metrics["task_graphs_executed"] =
+        static_cast<qint64>(task_graphs_executed_.load());
+    if (task_graphs_executed_.load() > 0) {
+        std::lock_guard<std::mutex> lock(graph_metrics_mutex_);
+        const auto& graph = last_graph_result_;
+        const double critical_path_ms =
+            graph.critical_path_time.count() / 1000.0;
+        const double work_ms = graph.total_work_time.count() / 1000.0;
+        metrics["last_graph_wall_time_ms"] = graph.wall_time.count() / 1000.0;
+        metrics["last_graph_work_ms"] = work_ms;
+        metrics["last_graph_critical_path_ms"] = critical_path_ms;
+        metrics["last_graph_critical_path"] =
+            QJsonArray::fromStringList(graph.critical_path);
+        // Upper bound on the speedup extra threads could give this graph
+        metrics["last_graph_parallelism"] =
+            critical_path_ms > 0.0 ? work_ms / critical_path_ms : 1.0;
+        metrics["last_graph_success"] = graph.success;
+    }
+
     return metrics;
 }
 
@@ -375,70 +1363,174 @@ ParallelFileProcessor::ParallelFileProcessor(QObject* parent)
     qDebug() << "🔥 ParallelFileProcessor created";
 }
 
-QFuture<QStringList> ParallelFileProcessor::readFilesAsync(
-    const QStringList& file_paths) {
-    QFutureInterface<QStringList> interface;
-    QFuture<QStringList> future = interface.future();
-    interface.reportStarted();
+namespace {
+
+// Shared by the reader tasks of one readConcurrently() batch
+struct ReadBatch {
+    QStringList paths;
+    qsizetype map_threshold = 0;
+    std::function<bool(int, const FileView&)> on_file;
+    std::function<void(bool)> on_done;
+    std::atomic<int> next{0};
+    std::atomic<int> completed{0};
+    std::atomic<int> pending{0};  // Readers plus the submitter
+    std::atomic<bool> failed{false};
+
+    void release(int count) {
+        if (pending.fetch_sub(count, std::memory_order_acq_rel) == count) {
+            on_done(failed.load(std::memory_order_acquire));
+        }
+    }
+};
+
+// Text-mode reads drop carriage returns; keep that for decoded contents
+QString decodeText(const FileView& view) {
+    QString text = view.toString();
+    text.remove(QLatin1Char('\r'));
+    return text;
+}
 
-    // Submit batch task to read all files
-    auto task_func = [this, file_paths, interface]() mutable {
+void finishStrings(QFutureInterface<QStringList>& interface,
+                   std::vector<QString>& strings, bool failed) {
+    if (failed) {
+        interface.reportCanceled();
+    } else {
         QStringList results;
-        results.reserve(file_paths.size());
+        results.reserve(static_cast<qsizetype>(strings.size()));
+        for (QString& string : strings) {
+            results.append(std::move(string));
+        }
+        interface.reportResult(results);
+    }
+    interface.reportFinished();
+}
 
-        int completed = 0;
-        int total = file_paths.size();
+}  // namespace
 
-        try {
-            for (const QString& file_path : file_paths) {
-                QFile file(file_path);
-                QString content;
+void ParallelFileProcessor::setMaxConcurrentReads(int max_reads) {
+    max_concurrent_reads_ = std::max(1, max_reads);
+}
 
-                if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                    QTextStream stream(&file);
-                    content = stream.readAll();
-                    file.close();
+void ParallelFileProcessor::readConcurrently(
+    const QStringList& file_paths, FileHandler on_file,
+    std::function<void(bool)> on_done) {
+    const int total = file_paths.size();
+    if (total == 0) {
+        on_done(false);
+        return;
+    }
 
-                    QMetaObject::invokeMethod(
-                        this,
-                        [this, file_path]() {
-                            emit fileProcessed(file_path, true);
-                        },
-                        Qt::QueuedConnection);
-                } else {
-                    qWarning() << "🔥 Failed to read file:" << file_path;
-                    QMetaObject::invokeMethod(
-                        this,
-                        [this, file_path]() {
-                            emit fileProcessed(file_path, false);
-                        },
-                        Qt::QueuedConnection);
+    auto batch = std::make_shared<ReadBatch>();
+    batch->paths = file_paths;
+    batch->map_threshold = map_threshold_;
+    batch->on_file = std::move(on_file);
+    batch->on_done = std::move(on_done);
+
+    ThreadPool& pool = processor_->threadPool();
+    const int readers = std::min(
+        {max_concurrent_reads_, total,
+         static_cast<int>(std::max<size_t>(1, pool.thread_count()))});
+    batch->pending.store(readers + 1, std::memory_order_relaxed);
+
+    auto read = [this, batch, total]() {
+        for (int i = batch->next.fetch_add(1, std::memory_order_relaxed);
+             i < total;
+             i = batch->next.fetch_add(1, std::memory_order_relaxed)) {
+            const QString file_path = batch->paths[i];
+            bool success = false;
+            if (!batch->failed.load(std::memory_order_relaxed)) {
+                try {
+                    success = batch->on_file(
+                        i, FileView::open(file_path, batch->map_threshold));
+                } catch (const std::exception& e) {
+                    qWarning() << "🔥 File batch failed at" << file_path
+                               << ":" << e.what();
+                    batch->failed.store(true, std::memory_order_release);
                 }
-
-                results.append(content);
-                completed++;
-
-                // Report progress
-                QMetaObject::invokeMethod(
-                    this,
-                    [this, completed, total]() {
-                        emit batchProgress(completed, total);
-                    },
-                    Qt::QueuedConnection);
             }
 
-            interface.reportResult(results);
-            interface.reportFinished();
+            QMetaObject::invokeMethod(
+                this,
+                [this, file_path, success]() {
+                    emit fileProcessed(file_path, success);
+                },
+                Qt::QueuedConnection);
 
-        } catch (const std::exception& e) {
-            qWarning() << "🔥 File reading failed:" << e.what();
-            interface.reportCanceled();
-            interface.reportFinished();
+            const int completed =
+                batch->completed.fetch_add(1, std::memory_order_relaxed) + 1;
+            QMetaObject::invokeMethod(
+                this,
+                [this, completed, total]() {
+                    emit batchProgress(completed, total);
+                },
+                Qt::QueuedConnection);
         }
+        batch->release(1);
     };
 
-    processor_->submitTask("read_files_batch", TaskPriority::Normal,
-                           ExecutionContext::ThreadPool, task_func);
+    int posted = 0;
+    try {
+        for (; posted < readers; ++posted) {
+            pool.post(TaskPriority::Normal, read);
+        }
+    } catch (const std::runtime_error&) {
+        // Pool is stopping; the readers already posted finish the batch
+    }
+
+    if (posted == 0) {
+        batch->pending.fetch_add(1, std::memory_order_relaxed);
+        read();
+    }
+    batch->release(readers - posted + 1);
+}
+
+QFuture<QStringList> ParallelFileProcessor::readFilesAsync(
+    const QStringList& file_paths) {
+    QFutureInterface<QStringList> interface;
+    QFuture<QStringList> future = interface.future();
+    interface.reportStarted();
+
+    auto contents = std::make_shared<std::vector<QString>>(file_paths.size());
+    readConcurrently(
+        file_paths,
+        [contents](int index, const FileView& view) {
+            if (!view.isValid()) {
+                qWarning() << "🔥 Failed to read file:" << view.path()
+                           << view.errorString();
+                return false;
+            }
+            (*contents)[index] = decodeText(view);
+            return true;
+        },
+        [contents, interface](bool failed) mutable {
+            finishStrings(interface, *contents, failed);
+        });
+
+    return future;
+}
+
+QFuture<QList<FileView>> ParallelFileProcessor::readFileViewsAsync(
+    const QStringList& file_paths) {
+    QFutureInterface<QList<FileView>> interface;
+    QFuture<QList<FileView>> future = interface.future();
+    interface.reportStarted();
+
+    auto views = std::make_shared<std::vector<FileView>>(file_paths.size());
+    readConcurrently(
+        file_paths,
+        [views](int index, const FileView& view) {
+            if (!view.isValid()) {
+                qWarning() << "🔥 Failed to read file:" << view.path()
+                           << view.errorString();
+            }
+            (*views)[index] = view;
+            return view.isValid();
+        },
+        [views, interface](bool) mutable {
+            interface.reportResult(QList<FileView>(views->begin(),
+                                                   views->end()));
+            interface.reportFinished();
+        });
 
     return future;
 }
@@ -522,65 +1614,21 @@ QFuture<QStringList> ParallelFileProcessor::processFilesAsync(
     QFuture<QStringList> future = interface.future();
     interface.reportStarted();
 
-    auto task_func = [this, file_paths, processor, interface]() mutable {
-        QStringList results;
-        results.reserve(file_paths.size());
-
-        int completed = 0;
-        int total = file_paths.size();
-
-        try {
-            for (const QString& file_path : file_paths) {
-                QFile file(file_path);
-                QString processed_content;
-
-                if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                    QTextStream stream(&file);
-                    QString content = stream.readAll();
-                    file.close();
-
-                    // Apply processor function
-                    processed_content = processor(content);
-
-                    QMetaObject::invokeMethod(
-                        this,
-                        [this, file_path]() {
-                            emit fileProcessed(file_path, true);
-                        },
-                        Qt::QueuedConnection);
-                } else {
-                    qWarning() << "🔥 Failed to process file:" << file_path;
-                    QMetaObject::invokeMethod(
-                        this,
-                        [this, file_path]() {
-                            emit fileProcessed(file_path, false);
-                        },
-                        Qt::QueuedConnection);
-                }
-
-                results.append(processed_content);
-                completed++;
-
-                QMetaObject::invokeMethod(
-                    this,
-                    [this, completed, total]() {
-                        emit batchProgress(completed, total);
-                    },
-                    Qt::QueuedConnection);
+    auto processed = std::make_shared<std::vector<QString>>(file_paths.size());
+    readConcurrently(
+        file_paths,
+        [processed, processor](int index, const FileView& view) {
+            if (!view.isValid()) {
+                qWarning() << "🔥 Failed to process file:" << view.path()
+                           << view.errorString();
+                return false;
             }
-
-            interface.reportResult(results);
-            interface.reportFinished();
-
-        } catch (const std::exception& e) {
-            qWarning() << "🔥 File processing failed:" << e.what();
-            interface.reportCanceled();
-            interface.reportFinished();
-        }
-    };
-
-    processor_->submitTask("process_files_batch", TaskPriority::Normal,
-                           ExecutionContext::ThreadPool, task_func);
+            (*processed)[index] = processor(decodeText(view));
+            return true;
+        },
+        [processed, interface](bool failed) mutable {
+            finishStrings(interface, *processed, failed);
+        });
 
     return future;
 }
@@ -821,6 +1869,125 @@ QFuture<QStringList> ParallelUICompiler::compileUIBatchAsync(
     return future;
 }
 
+namespace {
+
+// Parse, compile and write one image; failures are logged
+bool writeUIImage(const JSON::JSONUILoader* loader, const QString& ui_file_path,
+                  const QString& image_path) {
+    try {
+        JSON::JSONParser parser;
+        const QJsonObject root = parser.parseFile(ui_file_path);
+        const QByteArray image = loader
+                                     ? loader->compileImage(root)
+                                     : JSON::JSONUILoader().compileImage(root);
+
+        QSaveFile file(image_path);
+        if (!file.open(QIODevice::WriteOnly) ||
+            file.write(image) != image.size() || !file.commit()) {
+            qWarning() << "🔥 Failed to write UI image:" << image_path
+                       << file.errorString();
+            return false;
+        }
+        return true;
+
+    } catch (const std::exception& e) {
+        qWarning() << "🔥 UI image compilation failed:" << ui_file_path
+                   << e.what();
+        return false;
+    }
+}
+
+}  // namespace
+
+QString ParallelUICompiler::imagePathFor(const QString& ui_file_path,
+                                         const QString& output_dir) {
+    const QFileInfo info(ui_file_path);
+    const QDir dir(output_dir.isEmpty() ? info.absolutePath() : output_dir);
+    return dir.filePath(info.completeBaseName() +
+                        JSON::CompiledUIImage::kFileSuffix);
+}
+
+void ParallelUICompiler::setUILoader(
+    std::shared_ptr<const JSON::JSONUILoader> loader) {
+    ui_loader_ = std::move(loader);
+}
+
+QFuture<bool> ParallelUICompiler::compileImageAsync(
+    const QString& ui_file_path, const QString& image_path) {
+    QFutureInterface<bool> interface;
+    QFuture<bool> future = interface.future();
+    interface.reportStarted();
+
+    auto task_func = [this, loader = ui_loader_, ui_file_path, image_path,
+                      interface]() mutable {
+        const bool success =
+            writeUIImage(loader.get(), ui_file_path, image_path);
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, ui_file_path, success]() {
+                emit compilationCompleted(ui_file_path, success);
+            },
+            Qt::QueuedConnection);
+
+        interface.reportResult(success);
+        interface.reportFinished();
+    };
+
+    processor_->submitTask("image_" + ui_file_path, TaskPriority::Normal,
+                           ExecutionContext::ThreadPool, task_func);
+
+    return future;
+}
+
+QFuture<QStringList> ParallelUICompiler::compileImageBatchAsync(
+    const QStringList& ui_file_paths, const QString& output_dir) {
+    QFutureInterface<QStringList> interface;
+    QFuture<QStringList> future = interface.future();
+    interface.reportStarted();
+
+    auto task_func = [this, loader = ui_loader_, ui_file_paths, output_dir,
+                      interface]() mutable {
+        if (!output_dir.isEmpty()) {
+            QDir().mkpath(output_dir);
+        }
+        std::vector<char> written(ui_file_paths.size(), 0);
+
+        // One file per chunk: each is parsed, compiled and written alone
+        processor_->parallelFor(
+            qsizetype{0}, ui_file_paths.size(),
+            [&](qsizetype i) {
+                const QString& file_path = ui_file_paths[i];
+                const bool success =
+                    writeUIImage(loader.get(), file_path,
+                                 imagePathFor(file_path, output_dir));
+                written[i] = success;
+
+                QMetaObject::invokeMethod(
+                    this,
+                    [this, file_path, success]() {
+                        emit compilationCompleted(file_path, success);
+                    },
+                    Qt::QueuedConnection);
+            },
+            1);
+
+        QStringList images;
+        for (qsizetype i = 0; i < ui_file_paths.size(); ++i) {
+            if (written[i]) {
+                images.append(imagePathFor(ui_file_paths[i], output_dir));
+            }
+        }
+        interface.reportResult(images);
+        interface.reportFinished();
+    };
+
+    processor_->submitTask("image_batch", TaskPriority::Normal,
+                           ExecutionContext::ThreadPool, task_func);
+
+    return future;
+}
+
 QFuture<bool> ParallelUICompiler::validateUIAsync(const QString& ui_file_path) {
     QFutureInterface<bool> interface;
     QFuture<bool> future = interface.future();
@@ -990,14 +2157,19 @@ QFuture<bool> ParallelPropertyBinder::updateBindingsAsync(
     interface.reportStarted();
 
     auto task_func = [this, binding_ids, interface]() mutable {
-        bool all_success = true;
+        std::atomic<bool> all_success{true};
 
         try {
+            // Held by this task while the pool evaluates the providers
             std::shared_lock<std::shared_mutex> lock(bindings_mutex_);
 
-            for (const QString& binding_id : binding_ids) {
-                auto it = bindings_.find(binding_id);
-                if (it != bindings_.end() && it->second.is_active) {
+            processor_->parallelFor(
+                qsizetype(0), binding_ids.size(), [&](qsizetype index) {
+                    const QString& binding_id = binding_ids[index];
+                    auto it = bindings_.find(binding_id);
+                    if (it == bindings_.end() || !it->second.is_active) {
+                        return;
+                    }
                     try {
                         QVariant new_value = it->second.value_provider();
 
@@ -1021,10 +2193,9 @@ QFuture<bool> ParallelPropertyBinder::updateBindingsAsync(
                                    << binding_id << ":" << e.what();
                         all_success = false;
                     }
-                }
-            }
+                });
 
-            interface.reportResult(all_success);
+            interface.reportResult(all_success.load());
             interface.reportFinished();
 
         } catch (const std::exception& e) {
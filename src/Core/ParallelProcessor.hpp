@@ -8,23 +8,35 @@
 #include <QReadWriteLock>
 #include <QString>
 #include <QThread>
+#include <QStringList>
 #include <QTimer>
+#include <QVariant>
 #include <QWaitCondition>
 // #include <QtConcurrent>  // Commented out - may not be available in this Qt
 // installation
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <future>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <shared_mutex>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "FileView.hpp"
+
+namespace DeclarativeUI::JSON {
+class JSONUILoader;
+}  // namespace DeclarativeUI::JSON
+
 namespace DeclarativeUI::Core {
 
 /**
@@ -40,6 +52,8 @@ namespace DeclarativeUI::Core {
  * - ITask interface and templated Task<ResultType> concrete task for invoking
  * functions with completion callbacks.
  * - ThreadPool: a priority-aware thread pool implementation.
+ * - TaskGraph: a DAG of tasks run on the pool with readiness tracking, error
+ * and cancellation propagation and incremental re-runs.
  * - ParallelProcessor: a Qt QObject that provides higher-level task submission,
  * batching, monitoring and integration with the application's event loop
  * (signals for completion/failure).
@@ -271,15 +285,28 @@ private:
 
 /**
  * @class ThreadPool
- * @brief Simple priority-aware thread pool.
+ * @brief Priority-aware thread pool with an optional work-stealing scheduler.
  *
- * The ThreadPool accepts enqueued tasks with an associated TaskPriority. Tasks
- * are placed into a priority queue (higher TaskPriority runs first). Each
- * worker thread repeatedly pops the next TaskWrapper and executes it.
+ * The ThreadPool accepts enqueued tasks with an associated TaskPriority
+ * (higher TaskPriority runs first). Two scheduling modes are available:
+ *
+ * - SharedQueue: all tasks go into one priority queue guarded by a mutex.
+ * Simple and strictly ordered, but under fine-grained load the workers
+ * mostly contend for that lock.
+ * - WorkStealing: each worker owns one Chase-Lev deque per priority lane.
+ * Tasks submitted from a worker go to its own deque and are popped LIFO
+ * (cache-warm, depth-first for fork-join); idle workers steal FIFO from the
+ * other end. Tasks submitted from other threads go to a per-lane injection
+ * queue. Workers always look at higher lanes first, so priorities hold
+ * across the pool, though only approximately in time. Idle workers spin
+ * briefly before parking on a condition variable.
  *
  * Public methods:
  * - enqueue(): schedule a callable for execution and get a std::future for its
  * result.
+ * - post(): schedule a callable without a future (fire and forget).
+ * - wait_for(): wait for a future while running queued tasks, so tasks that
+ * wait for their own subtasks (fork-join) cannot starve the pool.
  * - shutdown(): stop accepting tasks and join worker threads.
  * - pause()/resume(): temporarily pause worker threads from dequeuing new
  * tasks.
@@ -290,8 +317,11 @@ private:
  */
 class ThreadPool {
 public:
+    enum class SchedulingMode { SharedQueue, WorkStealing };
+
     explicit ThreadPool(
-        size_t thread_count = std::thread::hardware_concurrency());
+        size_t thread_count = std::thread::hardware_concurrency(),
+        SchedulingMode mode = SchedulingMode::SharedQueue);
     ~ThreadPool();
 
     /**
@@ -314,6 +344,41 @@ public:
     auto enqueue(TaskPriority priority, F&& f, Args&&... args)
         -> std::future<typename std::result_of<F(Args...)>::type>;
 
+    /**
+     * @brief Schedule a callable without creating a future.
+     *
+     * Cheaper than enqueue() for fine-grained work whose completion is
+     * tracked by the caller (counters, latches). Exceptions are logged and
+     * swallowed like those of enqueued tasks.
+     *
+     * @throws std::runtime_error if the thread pool is not running.
+     */
+    template <typename F>
+    void post(TaskPriority priority, F&& f) {
+        submit(priority, std::function<void()>(std::forward<F>(f)));
+    }
+
+    /**
+     * @brief Run one queued task on the calling thread, if there is one.
+     *
+     * Workers prefer their own deque; other threads take injected tasks or
+     * steal. Returns false when no task was available.
+     */
+    bool try_run_one();
+
+    /**
+     * @brief Block until future is ready, running queued tasks meanwhile.
+     */
+    template <typename T>
+    void wait_for(const std::future<T>& future) {
+        while (future.wait_for(std::chrono::seconds(0)) !=
+               std::future_status::ready) {
+            if (!try_run_one()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
     void shutdown();
     void pause();
     void resume();
@@ -333,6 +398,19 @@ public:
      */
     bool is_running() const { return running_.load(); }
 
+    SchedulingMode scheduling_mode() const { return mode_; }
+    size_t thread_count() const { return thread_count_; }
+
+    /**
+     * @brief Number of tasks taken from another worker's deque.
+     */
+    size_t steal_count() const { return steal_count_.load(); }
+
+    /**
+     * @brief Whether the calling thread is one of this pool's workers.
+     */
+    bool is_worker_thread() const;
+
 private:
     struct TaskWrapper {
         std::function<void()> task;
@@ -354,6 +432,14 @@ private:
         }
     };
 
+    static constexpr size_t kLaneCount = 4;  // One per TaskPriority
+
+    // Work-stealing state, defined in ParallelProcessor.cpp
+    struct WorkerQueues;
+    struct InjectionLane;
+
+    const SchedulingMode mode_;
+    const size_t thread_count_;
     std::vector<std::thread> workers_;
     std::priority_queue<TaskWrapper> task_queue_;
     mutable std::mutex queue_mutex_;
@@ -362,6 +448,13 @@ private:
     std::atomic<bool> paused_{false};
     std::atomic<size_t> active_threads_{0};
 
+    std::vector<std::unique_ptr<WorkerQueues>> worker_queues_;
+    std::vector<std::unique_ptr<InjectionLane>> injection_lanes_;
+    std::array<std::atomic<int64_t>, kLaneCount> lane_pending_{};
+    std::atomic<size_t> sleeping_workers_{0};
+    std::atomic<uint64_t> wake_epoch_{0};
+    std::atomic<size_t> steal_count_{0};
+
     /**
      * @brief Entry point function for each worker thread.
      *
@@ -370,6 +463,167 @@ private:
      * pause/resume semantics and update active_threads_ counters.
      */
     void worker_thread();
+
+    /**
+     * @brief Worker loop of the work-stealing mode: own deque, injection
+     * queue, then steal, lane by lane from the highest priority; spin, then
+     * park when everything is empty.
+     */
+    void stealing_worker_thread(size_t index);
+
+    void submit(TaskPriority priority, std::function<void()> task);
+    std::function<void()>* find_stealing_task(size_t self);
+    bool has_pending_tasks() const;
+    void park_worker();
+    void wake_workers(bool all);
+    void run_task(std::function<void()>& task);
+};
+
+/**
+ * @struct TaskGraphResult
+ * @brief Outcome of one TaskGraph run.
+ *
+ * The critical path is the chain of dependent nodes executed in this run
+ * whose summed execution time is largest; it bounds how fast the run could
+ * have finished with unlimited threads.
+ */
+struct TaskGraphResult {
+    bool success = false;    /**< Every scheduled node completed. */
+    bool cancelled = false;  /**< cancel() was called during the run. */
+    size_t executed_nodes = 0;
+    size_t failed_nodes = 0;
+    size_t cancelled_nodes = 0; /**< Not run: cancelled or upstream failed. */
+    std::chrono::microseconds wall_time{0};
+    std::chrono::microseconds total_work_time{0}; /**< Sum over nodes. */
+    std::chrono::microseconds critical_path_time{0};
+    QStringList critical_path; /**< Node names, first to last. */
+    QStringList errors;
+};
+
+/**
+ * @class TaskGraph
+ * @brief Directed acyclic graph of tasks with automatic readiness tracking.
+ *
+ * Nodes are callables; an edge from A to B makes B wait for A and receive A's
+ * result. Each node may take the results of its predecessors (in the order
+ * the edges were added) as a QVariantList and may return a value:
+ *
+ *   TaskGraph graph("reload");
+ *   auto read = graph.addNode("read", [] { return readFile(); });
+ *   auto parse = graph.addNode("parse", [](const QVariantList& in) {
+ *       return parse(in[0].toByteArray());
+ *   });
+ *   graph.addEdge(read, parse);
+ *
+ * Running (through ParallelProcessor::runTaskGraph()):
+ * - Every node counts its unfinished predecessors; a node is posted to the
+ * pool when the count drops to zero, with the node's priority.
+ * - A node that throws fails; nodes downstream of it are not run and are
+ * reported as cancelled with the upstream error. Independent branches keep
+ * running.
+ * - cancel() stops nodes that have not started yet.
+ *
+ * Incremental re-runs: nodes that completed stay clean and keep their
+ * result. invalidate() marks a node and everything downstream dirty, and the
+ * next run executes only dirty nodes (failed and cancelled nodes stay dirty).
+ *
+ * Thread-safety: the structure (nodes, edges, invalidate()) must not change
+ * while a run is in progress; such calls throw std::runtime_error. A graph
+ * runs at most once at a time.
+ */
+class TaskGraph {
+public:
+    using NodeId = size_t;
+    using NodeFunction = std::function<QVariant(const QVariantList&)>;
+
+    enum class NodeState { Pending, Running, Completed, Failed, Cancelled };
+
+    explicit TaskGraph(const QString& name = QString());
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /**
+     * @brief Add a node. function may take const QVariantList& (predecessor
+     * results) or nothing, and may return void or a value stored as QVariant.
+     */
+    template <typename F>
+    NodeId addNode(const QString& name, F&& function,
+                   TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * @brief Make to depend on from.
+     * @throws std::out_of_range for unknown nodes, std::invalid_argument if
+     * the edge would create a cycle.
+     */
+    void addEdge(NodeId from, NodeId to);
+
+    /**
+     * @brief Mark node and all nodes downstream of it for re-execution.
+     */
+    void invalidate(NodeId node);
+    void invalidateAll();
+
+    /**
+     * @brief Stop nodes of the current run that have not started yet.
+     */
+    void cancel();
+
+    QString name() const { return name_; }
+    size_t nodeCount() const { return nodes_.size(); }
+    bool isRunning() const { return running_.load(); }
+    bool isDirty(NodeId node) const;
+    NodeState state(NodeId node) const;
+
+    /**
+     * @brief Result and error of the node's latest execution; read them once
+     * the node has finished (or after the run).
+     */
+    QVariant result(NodeId node) const;
+    QString error(NodeId node) const;
+    QString nodeName(NodeId node) const;
+    std::chrono::microseconds executionTime(NodeId node) const;
+
+    /**
+     * @brief Number of times node has been executed across all runs.
+     */
+    size_t executionCount(NodeId node) const;
+
+    /**
+     * @brief Result of the most recent finished run.
+     */
+    TaskGraphResult lastResult() const;
+
+private:
+    friend class ParallelProcessor;
+    struct Node;
+    struct RunState;
+
+    NodeId addNodeFunction(const QString& name, NodeFunction function,
+                           TaskPriority priority);
+    const Node& node(NodeId id) const;
+    void requireIdle() const;
+
+    /**
+     * @brief Start a run on pool; on_finished is called on the thread that
+     * completes the last node (or immediately if nothing is dirty).
+     */
+    QFuture<TaskGraphResult> start(
+        ThreadPool& pool,
+        std::function<void(const TaskGraphResult&)> on_finished);
+    void executeNode(ThreadPool& pool, NodeId id,
+                     const std::shared_ptr<RunState>& run);
+    void scheduleNode(ThreadPool& pool, NodeId id,
+                      const std::shared_ptr<RunState>& run);
+    void finishRun(const std::shared_ptr<RunState>& run);
+
+    QString name_;
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::atomic<bool> running_{false};
+    std::shared_ptr<RunState> current_run_;
+    TaskGraphResult last_result_;
+    mutable std::mutex state_mutex_;  // Guards current_run_ and last_result_
 };
 
 /**
@@ -448,6 +702,62 @@ public:
     std::vector<QString> submitBatchTasks(const QString& batch_id,
                                           const Container& items, F&& func);
 
+    /**
+     * @brief Run the dirty nodes of graph on the thread pool.
+     *
+     * The graph is kept alive until the run finishes. Completion is reported
+     * through the returned future and the taskGraphCompleted signal, and the
+     * run's wall time and critical path appear in getPerformanceMetrics().
+     *
+     * @throws std::runtime_error if the graph is already running.
+     */
+    QFuture<TaskGraphResult> runTaskGraph(std::shared_ptr<TaskGraph> graph);
+
+    // **Data-parallel algorithms**
+    /**
+     * @brief Call body(i) for every i in [begin, end), spread over the pool
+     * and the calling thread.
+     *
+     * The range is cut into chunks that the caller and up to one helper task
+     * per pool thread claim until none are left. With grain = 0 the chunk
+     * size is adaptive: the caller runs a short, growing prefix of the range
+     * and times it. A loop that would finish in a few tens of microseconds
+     * then completes on the calling thread; longer ones get chunks of at
+     * least ~25 us and about eight per participant.
+     *
+     * The caller only ever waits for chunks another thread is already
+     * running, never for queued tasks, so these algorithms can be called
+     * from pool tasks and nested inside each other.
+     *
+     * The first exception thrown by body skips the chunks not yet started
+     * and is rethrown here.
+     */
+    template <typename Index, typename F>
+    void parallelFor(Index begin, Index end, F&& body, size_t grain = 0);
+
+    /**
+     * @brief Parallel std::transform_reduce over a random-access range.
+     *
+     * reduce must be associative. Partial results are combined in range
+     * order, so it does not need to be commutative. Chunking follows
+     * parallelFor().
+     */
+    template <typename Iterator, typename T, typename Reduce,
+              typename Transform>
+    T parallelTransformReduce(Iterator first, Iterator last, T init,
+                              Reduce reduce, Transform transform,
+                              size_t grain = 0);
+
+    /**
+     * @brief Sort a random-access range; not stable.
+     *
+     * Runs of at least 8192 elements, up to two per pool thread, are sorted
+     * in parallel and then merged pairwise, one parallel level at a time.
+     * Shorter ranges are sorted on the calling thread.
+     */
+    template <typename Iterator, typename Compare = std::less<>>
+    void parallelSort(Iterator first, Iterator last, Compare comp = Compare());
+
     // **Task management**
     void cancelTask(const QString& task_id);
     void cancelBatch(const QString& batch_id);
@@ -455,7 +765,38 @@ public:
     bool isTaskCompleted(const QString& task_id) const;
 
     // **Thread pool management**
-    void setThreadPoolSize(size_t size);
+
+    /**
+     * @brief Replace the pool with one of size threads.
+     *
+     * Refused, with a warning, while a task graph runs or tasks are queued.
+     * Tasks already running finish on the old pool before this returns.
+     * Call it from the thread that owns the processor while nothing else
+     * submits work.
+     *
+     * @return Whether the pool was replaced.
+     */
+    bool setThreadPoolSize(size_t size);
+
+    /**
+     * @brief Switch the pool's scheduler (the shared queue by default).
+     *
+     * Recreates the pool with the same thread count, under the same rules
+     * as setThreadPoolSize().
+     *
+     * @return Whether the pool was replaced.
+     */
+    bool setSchedulingMode(ThreadPool::SchedulingMode mode);
+
+    /**
+     * @brief The pool tasks run on, e.g. for resumeOn() in coroutines.
+     *
+     * Replaced by setThreadPoolSize() and setSchedulingMode(). A replaced
+     * pool stays alive, shut down, until the processor is destroyed, so
+     * references kept past a replacement throw std::runtime_error on
+     * submission instead of dangling.
+     */
+    ThreadPool& threadPool() { return *thread_pool_; }
     void pauseProcessing();
     void resumeProcessing();
     void setMaxQueueSize(size_t max_size);
@@ -510,6 +851,13 @@ signals:
      */
     void performanceAlert(const QString& metric, double value);
 
+    /**
+     * @brief Emitted when a task graph run finishes.
+     * @param graph_name Name of the graph.
+     * @param success True when every scheduled node completed.
+     */
+    void taskGraphCompleted(const QString& graph_name, bool success);
+
 private slots:
     /**
      * @brief Slot invoked when a periodic timeout check triggers.
@@ -530,6 +878,10 @@ private slots:
 private:
     // **Core infrastructure**
     std::unique_ptr<ThreadPool> thread_pool_;
+    std::vector<std::unique_ptr<ThreadPool>> retired_pools_;
+    ThreadPool::SchedulingMode scheduling_mode_ =
+        ThreadPool::SchedulingMode::SharedQueue;
+    std::atomic<size_t> running_graphs_{0};
     std::unordered_map<QString, std::shared_ptr<ITask>> active_tasks_;
     std::unordered_map<QString, std::vector<QString>> batch_tasks_;
     mutable std::shared_mutex tasks_mutex_;
@@ -545,12 +897,51 @@ private:
     std::atomic<size_t> total_tasks_failed_{0};
     std::atomic<double> total_execution_time_{0.0};
     std::atomic<size_t> peak_queue_size_{0};
+    std::atomic<size_t> task_graphs_executed_{0};
+    TaskGraphResult last_graph_result_;
+    mutable std::mutex graph_metrics_mutex_;
 
     // **Timers**
     std::unique_ptr<QTimer> timeout_timer_;
     std::unique_ptr<QTimer> performance_timer_;
 
+    // **Data-parallel engine**
+    struct ChunkPlan {
+        size_t probed = 0;  // Leading elements already run while planning
+        size_t grain = 0;
+        size_t chunks = 0;
+    };
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+    using ChunkFunction =
+        std::function<void(size_t chunk, size_t begin, size_t end)>;
+
+    /**
+     * @brief Split count elements into chunks of grain elements; with
+     * grain = 0, size them by running a timed prefix through probe.
+     */
+    ChunkPlan planChunks(size_t count, size_t grain,
+                         const RangeFunction& probe) const;
+
+    /**
+     * @brief Run the chunks of plan that follow the probed prefix on the
+     * calling thread and helper tasks, and rethrow the first exception.
+     */
+    void runChunks(const ChunkPlan& plan, size_t count,
+                   const ChunkFunction& body);
+
+    /**
+     * @brief Number of sorted runs parallelSort() uses: a power of two, 1
+     * for a serial sort.
+     */
+    size_t sortRunCount(size_t count) const;
+
     // **Internal methods**
+    /**
+     * @brief Shut the current pool down, retire it and start a new one;
+     * see setThreadPoolSize().
+     */
+    bool replaceThreadPool(size_t size, ThreadPool::SchedulingMode mode);
+
     /**
      * @brief Generate a unique task identifier.
      * @return QString unique id.
@@ -598,21 +989,38 @@ private:
  * The methods return QFuture so callers can integrate with QtConcurrent-like
  * patterns or QFutureWatcher. The class emits fileProcessed signals for
  * per-file reporting and batchProgress for progress updates.
+ *
+ * Reads fan out across the pool: up to maxConcurrentReads() reader tasks
+ * each claim the next unread file until the batch is done, so results keep
+ * the order of file_paths while a slow file holds up only one reader. Files
+ * are opened through FileView, which maps large files instead of copying
+ * them.
  */
 class ParallelFileProcessor : public QObject {
     Q_OBJECT
 
 public:
+    static constexpr int kDefaultMaxConcurrentReads = 8;
+
     explicit ParallelFileProcessor(QObject* parent = nullptr);
 
     /**
      * @brief Read multiple files asynchronously.
      * @param file_paths List of file paths to read.
      * @return QFuture<QStringList> containing file contents in the same order
-     * as file_paths.
+     * as file_paths. Files are decoded as UTF-8 with carriage returns removed,
+     * as a text-mode read would; unreadable files give an empty string.
      */
     QFuture<QStringList> readFilesAsync(const QStringList& file_paths);
 
+    /**
+     * @brief Read multiple files asynchronously without decoding them.
+     * @param file_paths List of file paths to read.
+     * @return QFuture<QList<FileView>> with one view per path, in order. A
+     * file that could not be read gives an invalid view carrying its error.
+     */
+    QFuture<QList<FileView>> readFileViewsAsync(const QStringList& file_paths);
+
     /**
      * @brief Write multiple files asynchronously.
      * @param file_paths Target file paths.
@@ -627,6 +1035,7 @@ public:
      * parallel.
      * @param file_paths List of files to process.
      * @param processor Callable that maps file content to a processed QString.
+     * It runs on the reader tasks and so must be safe to call concurrently.
      * @return QFuture<QStringList> processed results.
      */
     QFuture<QStringList> processFilesAsync(
@@ -646,12 +1055,41 @@ public:
     QFuture<bool> copyDirectoryAsync(const QString& source,
                                      const QString& destination);
 
+    /**
+     * @brief Bound the number of files read at once.
+     *
+     * Reads never use more tasks than the pool has threads; a lower bound
+     * leaves threads free for other work while a batch of slow reads runs.
+     */
+    void setMaxConcurrentReads(int max_reads);
+    int maxConcurrentReads() const { return max_concurrent_reads_; }
+
+    /**
+     * @brief Files of at least this many bytes are memory-mapped.
+     */
+    void setMapThreshold(qsizetype bytes) { map_threshold_ = bytes; }
+    qsizetype mapThreshold() const { return map_threshold_; }
+
 signals:
     void fileProcessed(const QString& file_path, bool success);
     void batchProgress(int completed, int total);
 
 private:
+    using FileHandler = std::function<bool(int, const FileView&)>;
+
     std::unique_ptr<ParallelProcessor> processor_;
+    int max_concurrent_reads_ = kDefaultMaxConcurrentReads;
+    qsizetype map_threshold_ = FileView::kDefaultMapThreshold;
+
+    /**
+     * @brief Read file_paths on bounded reader tasks.
+     *
+     * on_file receives each file's index and view on a reader thread and
+     * returns whether the file counts as processed. on_done runs once, on
+     * whichever thread finishes last, with true if on_file threw.
+     */
+    void readConcurrently(const QStringList& file_paths, FileHandler on_file,
+                          std::function<void(bool)> on_done);
 
     /**
      * @brief Helper method for recursive directory copying.
@@ -684,6 +1122,48 @@ public:
      */
     QFuture<QStringList> compileUIBatchAsync(const QStringList& ui_file_paths);
 
+    /**
+     * @brief Compile a JSON UI file into a binary UI image.
+     *
+     * The file is parsed with JSONParser, which resolves references and
+     * includes, then compiled by the loader set with setUILoader() and
+     * written atomically to image_path. Component types must be registered
+     * with ComponentRegistry beforehand. Emits compilationCompleted().
+     *
+     * @return true if the image was written.
+     */
+    QFuture<bool> compileImageAsync(const QString& ui_file_path,
+                                    const QString& image_path);
+
+    /**
+     * @brief Compile several JSON UI files into binary UI images in
+     * parallel, one image per file at imagePathFor().
+     *
+     * @return Paths of the images written, in input order; files that
+     * failed are left out.
+     */
+    QFuture<QStringList> compileImageBatchAsync(
+        const QStringList& ui_file_paths, const QString& output_dir = {});
+
+    /**
+     * @brief Where compileImageBatchAsync() writes the image of a file: its
+     * base name with CompiledUIImage::kFileSuffix, in output_dir, or next to
+     * the file when output_dir is empty.
+     */
+    static QString imagePathFor(const QString& ui_file_path,
+                                const QString& output_dir = {});
+
+    /**
+     * @brief Loader whose property converters compile the images.
+     *
+     * Images must be compiled with the converters of the loader that will
+     * load them, or custom property types are stored unconverted. Each
+     * compilation keeps the loader it started with; the loader is used from
+     * pool threads, so register its converters before setting it. Without
+     * one, a default JSONUILoader is used. Call from the owning thread.
+     */
+    void setUILoader(std::shared_ptr<const JSON::JSONUILoader> loader);
+
     /**
      * @brief Validate a UI file asynchronously; returns true if valid.
      */
@@ -709,6 +1189,7 @@ signals:
 
 private:
     std::unique_ptr<ParallelProcessor> processor_;
+    std::shared_ptr<const JSON::JSONUILoader> ui_loader_;
     std::unordered_map<QString, QStringList> dependency_cache_;
     mutable std::shared_mutex cache_mutex_;
 };
@@ -778,6 +1259,42 @@ private:
     mutable std::shared_mutex bindings_mutex_;
 };
 
+/**
+ * @brief Template implementation of TaskGraph::addNode.
+ *
+ * Adapts callables with or without a QVariantList parameter, returning void
+ * or a value, to the uniform NodeFunction signature.
+ */
+template <typename F>
+TaskGraph::NodeId TaskGraph::addNode(const QString& name, F&& function,
+                                     TaskPriority priority) {
+    NodeFunction wrapped;
+    if constexpr (std::is_invocable_v<F&, const QVariantList&>) {
+        using R = std::invoke_result_t<F&, const QVariantList&>;
+        wrapped = [f = std::forward<F>(function)](
+                      const QVariantList& inputs) mutable -> QVariant {
+            if constexpr (std::is_void_v<R>) {
+                f(inputs);
+                return QVariant();
+            } else {
+                return QVariant::fromValue(f(inputs));
+            }
+        };
+    } else {
+        using R = std::invoke_result_t<F&>;
+        wrapped = [f = std::forward<F>(function)](
+                      const QVariantList&) mutable -> QVariant {
+            if constexpr (std::is_void_v<R>) {
+                f();
+                return QVariant();
+            } else {
+                return QVariant::fromValue(f());
+            }
+        };
+    }
+    return addNodeFunction(name, std::move(wrapped), priority);
+}
+
 /**
  * @brief Template implementation of ThreadPool::enqueue.
  *
@@ -798,6 +1315,11 @@ auto ThreadPool::enqueue(TaskPriority priority, F&& f, Args&&... args)
 
     std::future<return_type> result = task->get_future();
 
+    if (mode_ == SchedulingMode::WorkStealing) {
+        submit(priority, [task]() { (*task)(); });
+        return result;
+    }
+
     {
         std::unique_lock<std::mutex> lock(queue_mutex_);
 
@@ -972,6 +1494,117 @@ std::vector<QString> ParallelProcessor::submitBatchTasks(
     return task_ids;
 }
 
+template <typename Index, typename F>
+void ParallelProcessor::parallelFor(Index begin, Index end, F&& body,
+                                    size_t grain) {
+    static_assert(std::is_integral_v<Index>,
+                  "parallelFor() needs an integral index");
+    if (!(begin < end)) {
+        return;
+    }
+    const auto count = static_cast<size_t>(end - begin);
+    auto run_range = [&body, begin](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            body(static_cast<Index>(begin + static_cast<Index>(i)));
+        }
+    };
+    const ChunkPlan plan = planChunks(count, grain, run_range);
+    runChunks(plan, count, [&run_range](size_t, size_t from, size_t to) {
+        run_range(from, to);
+    });
+}
+
+template <typename Iterator, typename T, typename Reduce, typename Transform>
+T ParallelProcessor::parallelTransformReduce(Iterator first, Iterator last,
+                                             T init, Reduce reduce,
+                                             Transform transform,
+                                             size_t grain) {
+    using Difference = typename std::iterator_traits<Iterator>::difference_type;
+    static_assert(
+        std::is_base_of_v<
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<Iterator>::iterator_category>,
+        "parallelTransformReduce() needs random-access iterators");
+    if (!(first < last)) {
+        return init;
+    }
+    const auto count = static_cast<size_t>(last - first);
+
+    // Ranges are never empty, so no identity element is needed
+    auto reduce_range = [&](size_t from, size_t to) {
+        Iterator it = first + static_cast<Difference>(from);
+        T partial = transform(*it);
+        for (size_t i = from + 1; i < to; ++i) {
+            partial = reduce(std::move(partial), transform(*++it));
+        }
+        return partial;
+    };
+
+    std::optional<T> prefix;
+    const ChunkPlan plan =
+        planChunks(count, grain, [&](size_t from, size_t to) {
+            T partial = reduce_range(from, to);
+            if (prefix) {
+                prefix = reduce(std::move(*prefix), std::move(partial));
+            } else {
+                prefix = std::move(partial);
+            }
+        });
+
+    std::vector<std::optional<T>> partials(plan.chunks);
+    runChunks(plan, count, [&](size_t chunk, size_t from, size_t to) {
+        partials[chunk] = reduce_range(from, to);
+    });
+
+    T result = std::move(init);
+    if (prefix) {
+        result = reduce(std::move(result), std::move(*prefix));
+    }
+    for (auto& partial : partials) {
+        result = reduce(std::move(result), std::move(*partial));
+    }
+    return result;
+}
+
+template <typename Iterator, typename Compare>
+void ParallelProcessor::parallelSort(Iterator first, Iterator last,
+                                     Compare comp) {
+    using Difference = typename std::iterator_traits<Iterator>::difference_type;
+    static_assert(
+        std::is_base_of_v<
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<Iterator>::iterator_category>,
+        "parallelSort() needs random-access iterators");
+    const size_t count =
+        first < last ? static_cast<size_t>(last - first) : size_t(0);
+    const size_t runs = sortRunCount(count);
+    if (runs <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    auto boundary = [&](size_t run) {
+        return first + static_cast<Difference>(count * run / runs);
+    };
+
+    // One chunk per run, then one chunk per pair of runs and level
+    ChunkPlan plan;
+    plan.grain = 1;
+    plan.chunks = runs;
+    runChunks(plan, runs, [&](size_t run, size_t, size_t) {
+        std::sort(boundary(run), boundary(run + 1), comp);
+    });
+
+    for (size_t width = 1; width < runs; width *= 2) {
+        plan.chunks = runs / (2 * width);
+        runChunks(plan, plan.chunks, [&](size_t pair, size_t, size_t) {
+            const size_t low = pair * 2 * width;
+            std::inplace_merge(boundary(low), boundary(low + width),
+                               boundary(low + 2 * width), comp);
+        });
+    }
+}
+
 /**
  * @brief Template implementation for ParallelPropertyBinder::bindPropertyAsync.
  *
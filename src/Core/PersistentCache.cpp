@@ -0,0 +1,490 @@
+#include "PersistentCache.hpp"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace DeclarativeUI::Core {
+
+namespace {
+
+constexpr char kFileMagic[8] = {'D', 'U', 'I', 'C', 'A', 'C', 'H', 'E'};
+constexpr quint32 kFormatVersion = 1;
+constexpr qint64 kFileHeaderSize = 16;
+
+constexpr quint32 kRecordMagic = 0x44524543;  // "CERD" little-endian
+constexpr quint32 kTombstoneFlag = 0x1;
+
+/**
+ * @brief On-disk record header, followed by key bytes, payload and padding
+ * to an 8-byte boundary. Native byte order; a store written on a machine of
+ * the other endianness fails the magic check and is recreated.
+ */
+struct RecordHeader {
+    quint32 magic;
+    quint32 flags;
+    quint32 key_size;
+    quint32 payload_size;
+    qint64 modified_ms;
+    quint64 file_size;
+    quint64 content_hash;
+    quint64 checksum; /**< Over the header (checksum zeroed), key, payload. */
+};
+static_assert(sizeof(RecordHeader) == 48);
+
+constexpr quint64 kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr quint64 kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr quint64 kPrime3 = 0x165667B19E3779F9ULL;
+
+inline quint64 rotl(quint64 x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline size_t alignedRecordSize(size_t key_size, size_t payload_size) {
+    const size_t raw = sizeof(RecordHeader) + key_size + payload_size;
+    return (raw + 7) & ~size_t(7);
+}
+
+/**
+ * @brief Seeded variant of hashContent() used to chain record checksums.
+ */
+quint64 hashBytes(const char* data, size_t size, quint64 seed) {
+    quint64 h = seed + kPrime1 + static_cast<quint64>(size);
+    const char* end = data + size;
+
+    while (end - data >= 8) {
+        quint64 block;
+        std::memcpy(&block, data, sizeof(block));
+        h ^= rotl(block * kPrime2, 31) * kPrime1;
+        h = rotl(h, 27) * kPrime1 + kPrime3;
+        data += 8;
+    }
+    while (data < end) {
+        h ^= static_cast<quint64>(static_cast<uchar>(*data++)) * kPrime3;
+        h = rotl(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+quint64 recordChecksum(RecordHeader header, const char* body,
+                       size_t body_size) {
+    header.checksum = 0;
+    const quint64 seed = hashBytes(reinterpret_cast<const char*>(&header),
+                                   sizeof(header), 0);
+    return hashBytes(body, body_size, seed);
+}
+
+QByteArray fileHeader() {
+    QByteArray header(kFileHeaderSize, '\0');
+    std::memcpy(header.data(), kFileMagic, sizeof(kFileMagic));
+    std::memcpy(header.data() + sizeof(kFileMagic), &kFormatVersion,
+                sizeof(kFormatVersion));
+    return header;
+}
+
+}  // namespace
+
+// **PersistentCacheStore implementation**
+PersistentCacheStore::PersistentCacheStore(const QString& file_path,
+                                           size_t max_bytes)
+    : file_path_(file_path), max_bytes_(max_bytes) {}
+
+PersistentCacheStore::~PersistentCacheStore() { close(); }
+
+quint64 PersistentCacheStore::hashContent(const char* data, size_t size) {
+    return hashBytes(data, size, 0);
+}
+
+bool PersistentCacheStore::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closeLocked();
+    statistics_ = PersistentCacheStatistics{};
+    return openLocked();
+}
+
+void PersistentCacheStore::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closeLocked();
+}
+
+bool PersistentCacheStore::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_ != nullptr;
+}
+
+size_t PersistentCacheStore::maxBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_bytes_;
+}
+
+void PersistentCacheStore::setMaxBytes(size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_bytes_ = max_bytes;
+    if (file_ && static_cast<size_t>(file_size_) > max_bytes_) {
+        compactLocked(max_bytes_ / 4 * 3);
+    }
+}
+
+bool PersistentCacheStore::openLocked() {
+    QDir().mkpath(QFileInfo(file_path_).absolutePath());
+
+    auto file = std::make_unique<QFile>(file_path_);
+    if (!file->open(QIODevice::ReadWrite)) {
+        qWarning() << "🔥 Cannot open persistent cache" << file_path_ << ":"
+                   << file->errorString();
+        return false;
+    }
+
+    const qint64 size = file->size();
+    if (size >= kFileHeaderSize) {
+        const QByteArray header = file->read(kFileHeaderSize);
+        if (header != fileHeader()) {
+            qWarning() << "🔥 Persistent cache" << file_path_
+                       << "has an incompatible header, recreating it";
+            file->resize(0);
+        }
+    } else if (size > 0) {
+        // Torn while writing the header: nothing worth keeping
+        file->resize(0);
+    }
+
+    if (file->size() == 0) {
+        if (file->write(fileHeader()) != kFileHeaderSize || !file->flush()) {
+            qWarning() << "🔥 Cannot initialize persistent cache" << file_path_;
+            return false;
+        }
+    }
+
+    file_ = std::move(file);
+    file_size_ = file_->size();
+    index_.clear();
+    live_bytes_ = 0;
+
+    if (!remapLocked() || !scanLocked()) {
+        closeLocked();
+        return false;
+    }
+    return true;
+}
+
+void PersistentCacheStore::closeLocked() {
+    if (file_) {
+        if (mapped_) {
+            file_->unmap(mapped_);
+        }
+        file_->close();
+    }
+    mapped_ = nullptr;
+    mapped_size_ = 0;
+    file_.reset();
+    file_size_ = 0;
+    index_.clear();
+    live_bytes_ = 0;
+}
+
+bool PersistentCacheStore::remapLocked() const {
+    if (mapped_) {
+        file_->unmap(mapped_);
+        mapped_ = nullptr;
+        mapped_size_ = 0;
+    }
+    mapped_ = file_->map(0, file_size_);
+    if (!mapped_) {
+        qWarning() << "🔥 Cannot map persistent cache" << file_path_ << ":"
+                   << file_->errorString();
+        return false;
+    }
+    mapped_size_ = file_size_;
+    return true;
+}
+
+bool PersistentCacheStore::scanLocked() {
+    qint64 offset = kFileHeaderSize;
+
+    while (offset + static_cast<qint64>(sizeof(RecordHeader)) <= file_size_) {
+        RecordHeader header;
+        std::memcpy(&header, mapped_ + offset, sizeof(header));
+        if (header.magic != kRecordMagic) {
+            break;
+        }
+
+        const size_t record_size =
+            alignedRecordSize(header.key_size, header.payload_size);
+        if (offset + static_cast<qint64>(record_size) > file_size_) {
+            break;
+        }
+
+        const char* body = reinterpret_cast<const char*>(mapped_ + offset +
+                                                         sizeof(RecordHeader));
+        if (recordChecksum(header, body,
+                           header.key_size + header.payload_size) !=
+            header.checksum) {
+            break;
+        }
+
+        const QString key = QString::fromUtf8(body, header.key_size);
+        auto existing = index_.find(key);
+        if (existing != index_.end()) {
+            live_bytes_ -= existing->second.record_size;
+            index_.erase(existing);
+        }
+
+        if (!(header.flags & kTombstoneFlag)) {
+            IndexEntry entry;
+            entry.offset = offset;
+            entry.stamp = {header.modified_ms, header.file_size,
+                           header.content_hash};
+            entry.payload_offset =
+                offset + sizeof(RecordHeader) + header.key_size;
+            entry.payload_size = header.payload_size;
+            entry.record_size = static_cast<quint32>(record_size);
+            index_.emplace(key, entry);
+            live_bytes_ += record_size;
+        }
+
+        offset += record_size;
+    }
+
+    if (offset < file_size_) {
+        // Torn or corrupt tail from an interrupted append: drop it
+        statistics_.recovered_bytes += file_size_ - offset;
+        qWarning() << "🔥 Persistent cache" << file_path_ << "truncated"
+                   << (file_size_ - offset) << "bytes of incomplete records";
+        file_->unmap(mapped_);
+        mapped_ = nullptr;
+        mapped_size_ = 0;
+        if (!file_->resize(offset)) {
+            return false;
+        }
+        file_size_ = offset;
+        return remapLocked();
+    }
+    return true;
+}
+
+bool PersistentCacheStore::put(const QString& key,
+                               const PersistentCacheStamp& stamp,
+                               const QByteArray& payload) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+        return false;
+    }
+    return appendLocked(key, stamp, payload, false);
+}
+
+bool PersistentCacheStore::remove(const QString& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_ || index_.find(key) == index_.end()) {
+        return false;
+    }
+    return appendLocked(key, PersistentCacheStamp{}, QByteArray(), true);
+}
+
+bool PersistentCacheStore::appendLocked(const QString& key,
+                                        const PersistentCacheStamp& stamp,
+                                        const QByteArray& payload,
+                                        bool tombstone) {
+    const QByteArray key_bytes = key.toUtf8();
+    const size_t record_size =
+        alignedRecordSize(key_bytes.size(), payload.size());
+
+    // A record that would be dropped by the next compaction is not worth
+    // writing
+    if (!tombstone &&
+        record_size + kFileHeaderSize > max_bytes_ / 4 * 3) {
+        return false;
+    }
+
+    QByteArray record(static_cast<qsizetype>(record_size), '\0');
+    char* body = record.data() + sizeof(RecordHeader);
+    std::memcpy(body, key_bytes.constData(), key_bytes.size());
+    std::memcpy(body + key_bytes.size(), payload.constData(), payload.size());
+
+    RecordHeader header{};
+    header.magic = kRecordMagic;
+    header.flags = tombstone ? kTombstoneFlag : 0;
+    header.key_size = static_cast<quint32>(key_bytes.size());
+    header.payload_size = static_cast<quint32>(payload.size());
+    header.modified_ms = stamp.modified_ms;
+    header.file_size = stamp.file_size;
+    header.content_hash = stamp.content_hash;
+    header.checksum =
+        recordChecksum(header, body, key_bytes.size() + payload.size());
+    std::memcpy(record.data(), &header, sizeof(header));
+
+    if (!file_->seek(file_size_) || file_->write(record) != record.size() ||
+        !file_->flush()) {
+        qWarning() << "🔥 Failed to append to persistent cache" << file_path_
+                   << ":" << file_->errorString();
+        // Whatever reached the disk is discarded by the next open()
+        return false;
+    }
+
+    auto existing = index_.find(key);
+    if (existing != index_.end()) {
+        live_bytes_ -= existing->second.record_size;
+        index_.erase(existing);
+    }
+    if (!tombstone) {
+        IndexEntry entry;
+        entry.offset = file_size_;
+        entry.stamp = stamp;
+        entry.payload_offset =
+            file_size_ + sizeof(RecordHeader) + key_bytes.size();
+        entry.payload_size = static_cast<quint32>(payload.size());
+        entry.record_size = static_cast<quint32>(record_size);
+        index_.emplace(key, entry);
+        live_bytes_ += record_size;
+    }
+
+    file_size_ += static_cast<qint64>(record_size);
+    ++statistics_.appends;
+
+    if (static_cast<size_t>(file_size_) > max_bytes_) {
+        compactLocked(max_bytes_ / 4 * 3);
+    }
+    return true;
+}
+
+bool PersistentCacheStore::contains(const QString& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.find(key) != index_.end();
+}
+
+std::optional<PersistentCacheStamp> PersistentCacheStore::stamp(
+    const QString& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+    return it->second.stamp;
+}
+
+const uchar* PersistentCacheStore::payloadLocked(
+    const IndexEntry& entry) const {
+    // Appends are written through the file, so the mapping may lag behind
+    if (entry.payload_offset + entry.payload_size > mapped_size_ &&
+        !remapLocked()) {
+        return nullptr;
+    }
+    return mapped_ + entry.payload_offset;
+}
+
+std::optional<QByteArray> PersistentCacheStore::payload(
+    const QString& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+    const uchar* data = payloadLocked(it->second);
+    if (!data) {
+        return std::nullopt;
+    }
+    return QByteArray(reinterpret_cast<const char*>(data),
+                      it->second.payload_size);
+}
+
+void PersistentCacheStore::forEach(
+    const std::function<void(const RecordView&)>& visitor) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_ || (mapped_size_ < file_size_ && !remapLocked())) {
+        return;
+    }
+
+    std::vector<std::pair<const QString*, const IndexEntry*>> records;
+    records.reserve(index_.size());
+    for (const auto& [key, entry] : index_) {
+        records.emplace_back(&key, &entry);
+    }
+    std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+        return a.second->offset < b.second->offset;
+    });
+
+    for (const auto& [key, entry] : records) {
+        visitor(RecordView{
+            *key, entry->stamp,
+            QByteArray::fromRawData(
+                reinterpret_cast<const char*>(mapped_ + entry->payload_offset),
+                entry->payload_size)});
+    }
+}
+
+bool PersistentCacheStore::compact(size_t target_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+        return false;
+    }
+    return compactLocked(target_bytes);
+}
+
+bool PersistentCacheStore::compactLocked(size_t target_bytes) {
+    if (mapped_size_ < file_size_ && !remapLocked()) {
+        return false;
+    }
+
+    std::vector<const IndexEntry*> live;
+    live.reserve(index_.size());
+    for (const auto& [key, entry] : index_) {
+        live.push_back(&entry);
+    }
+    std::sort(live.begin(), live.end(),
+              [](const IndexEntry* a, const IndexEntry* b) {
+                  return a->offset < b->offset;
+              });
+
+    // Oldest records go first when the live set exceeds the target
+    size_t kept_bytes = live_bytes_;
+    size_t first_kept = 0;
+    while (target_bytes > 0 && first_kept < live.size() &&
+           kept_bytes + kFileHeaderSize > target_bytes) {
+        kept_bytes -= live[first_kept]->record_size;
+        ++first_kept;
+    }
+
+    QSaveFile output(file_path_);
+    if (!output.open(QIODevice::WriteOnly)) {
+        qWarning() << "🔥 Cannot compact persistent cache" << file_path_ << ":"
+                   << output.errorString();
+        return false;
+    }
+    output.write(fileHeader());
+    for (size_t i = first_kept; i < live.size(); ++i) {
+        // Records are position independent, copy them verbatim
+        output.write(reinterpret_cast<const char*>(mapped_ + live[i]->offset),
+                     live[i]->record_size);
+    }
+
+    // The old file must be unmapped and closed before it can be replaced
+    closeLocked();
+    const bool committed = output.commit();
+    if (!committed) {
+        qWarning() << "🔥 Persistent cache compaction failed for" << file_path_
+                   << ":" << output.errorString();
+    } else {
+        ++statistics_.compactions;
+        statistics_.dropped_records += first_kept;
+    }
+
+    return openLocked() && committed;
+}
+
+PersistentCacheStatistics PersistentCacheStore::statistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PersistentCacheStatistics result = statistics_;
+    result.file_size = static_cast<size_t>(file_size_);
+    result.live_bytes = live_bytes_;
+    result.live_records = index_.size();
+    return result;
+}
+
+}  // namespace DeclarativeUI::Core
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace DeclarativeUI::Core {
+
+/**
+ * @file PersistentCache.hpp
+ * @brief Append-only, memory-mapped on-disk cache used as a second tier
+ * behind CacheManager's in-memory caches.
+ *
+ * The store holds one record per source file, keyed by the file's path and
+ * stamped with its modification time, size and a 64-bit content hash, so a
+ * later process can decide whether the cached payload still matches the file
+ * without re-running the parser.
+ *
+ * File layout:
+ * - 16-byte header: magic "DUICACHE", format version, reserved word.
+ * - A sequence of 8-byte aligned records, each a fixed header (stamp, key
+ *   and payload lengths, checksum) followed by the UTF-8 key and the payload.
+ *   Removals append a tombstone record; later records supersede earlier ones.
+ *
+ * Crash safety:
+ * - Records carry a checksum over key and payload. open() stops at the first
+ *   torn or corrupt record and truncates the file there, so an interrupted
+ *   append loses at most that record.
+ * - compact() writes live records into a QSaveFile and atomically renames it
+ *   over the store; a crash mid-compaction leaves the previous file intact.
+ *
+ * Thread-safety: all public methods are serialized by an internal mutex.
+ */
+
+/**
+ * @brief Identity of a cached source file.
+ */
+struct PersistentCacheStamp {
+    qint64 modified_ms = 0;    /**< Last modification time (ms since epoch). */
+    quint64 file_size = 0;     /**< Size in bytes. */
+    quint64 content_hash = 0;  /**< PersistentCacheStore::hashContent(). */
+
+    bool operator==(const PersistentCacheStamp&) const = default;
+};
+
+/**
+ * @brief Counters describing the on-disk tier.
+ */
+struct PersistentCacheStatistics {
+    size_t file_size = 0;      /**< Current size of the store file. */
+    size_t live_bytes = 0;     /**< Bytes occupied by live records. */
+    size_t live_records = 0;   /**< Records that are not superseded. */
+    size_t appends = 0;        /**< Records written since open(). */
+    size_t compactions = 0;    /**< Successful compactions since open(). */
+    size_t dropped_records = 0; /**< Records dropped to honour the size cap. */
+    size_t recovered_bytes = 0; /**< Torn tail bytes truncated by open(). */
+};
+
+class PersistentCacheStore {
+public:
+    /**
+     * @brief Payload view handed to forEach(); valid only during the call.
+     */
+    struct RecordView {
+        const QString& key;
+        const PersistentCacheStamp& stamp;
+        QByteArray payload; /**< Wraps mapped memory, no copy. */
+    };
+
+    /**
+     * @param file_path Location of the store file; created on open().
+     * @param max_bytes Size cap. Appends that push the file beyond it trigger
+     * a compaction that drops the oldest records until live data fits in
+     * three quarters of the cap.
+     */
+    explicit PersistentCacheStore(const QString& file_path,
+                                  size_t max_bytes = 64 * 1024 * 1024);
+    ~PersistentCacheStore();
+
+    PersistentCacheStore(const PersistentCacheStore&) = delete;
+    PersistentCacheStore& operator=(const PersistentCacheStore&) = delete;
+
+    /**
+     * @brief Open or create the store, map it and rebuild the key index.
+     * @return False if the file cannot be opened or has a foreign header.
+     */
+    bool open();
+    void close();
+    bool isOpen() const;
+
+    QString filePath() const { return file_path_; }
+    size_t maxBytes() const;
+    void setMaxBytes(size_t max_bytes);
+
+    /**
+     * @brief Append a record for key, superseding any previous one.
+     */
+    bool put(const QString& key, const PersistentCacheStamp& stamp,
+             const QByteArray& payload);
+
+    /**
+     * @brief Append a tombstone for key if it has a live record.
+     */
+    bool remove(const QString& key);
+
+    bool contains(const QString& key) const;
+    std::optional<PersistentCacheStamp> stamp(const QString& key) const;
+
+    /**
+     * @brief Copy the payload of a live record.
+     */
+    std::optional<QByteArray> payload(const QString& key) const;
+
+    /**
+     * @brief Visit every live record in file order without copying payloads.
+     */
+    void forEach(const std::function<void(const RecordView&)>& visitor) const;
+
+    /**
+     * @brief Rewrite the store with live records only (crash safe).
+     * @param target_bytes If non-zero, drop the oldest records until live data
+     * fits.
+     */
+    bool compact(size_t target_bytes = 0);
+
+    PersistentCacheStatistics statistics() const;
+
+    /**
+     * @brief Stable 64-bit hash of file contents (independent of qHash seeds
+     * and Qt versions, so it can be persisted).
+     */
+    static quint64 hashContent(const char* data, size_t size);
+    static quint64 hashContent(const QByteArray& data) {
+        return hashContent(data.constData(), static_cast<size_t>(data.size()));
+    }
+
+private:
+    struct IndexEntry {
+        qint64 offset = 0;         /**< Record start in the file. */
+        PersistentCacheStamp stamp;
+        qint64 payload_offset = 0; /**< Payload start in the file. */
+        quint32 payload_size = 0;
+        quint32 record_size = 0;   /**< Header + key + payload + padding. */
+    };
+
+    bool openLocked();
+    void closeLocked();
+    bool remapLocked() const;
+    bool scanLocked();
+    bool appendLocked(const QString& key, const PersistentCacheStamp& stamp,
+                      const QByteArray& payload, bool tombstone);
+    bool compactLocked(size_t target_bytes);
+    const uchar* payloadLocked(const IndexEntry& entry) const;
+
+    QString file_path_;
+    size_t max_bytes_;
+
+    mutable std::mutex mutex_;
+    std::unique_ptr<QFile> file_;
+    mutable uchar* mapped_ = nullptr; /**< Mapping of [0, mapped_size_). */
+    mutable qint64 mapped_size_ = 0;
+    qint64 file_size_ = 0;       /**< Logical end of valid records. */
+    std::unordered_map<QString, IndexEntry> index_;
+    size_t live_bytes_ = 0;
+
+    PersistentCacheStatistics statistics_;
+};
+
+}  // namespace DeclarativeUI::Core
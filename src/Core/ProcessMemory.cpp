@@ -0,0 +1,217 @@
+#include "ProcessMemory.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#if __GLIBC_PREREQ(2, 33)
+#define DECLARATIVEUI_HAS_MALLINFO2 1
+#endif
+#endif
+
+namespace DeclarativeUI::Core {
+
+namespace {
+
+#ifdef __linux__
+// Read a whole procfs file from offset 0; procfs regenerates the contents on
+// every read starting at the beginning.
+size_t read_proc_file(int fd, char* buffer, size_t capacity) {
+    size_t length = 0;
+    while (length + 1 < capacity) {
+        const ssize_t n =
+            ::pread(fd, buffer + length, capacity - 1 - length, length);
+        if (n <= 0) {
+            break;
+        }
+        length += static_cast<size_t>(n);
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+// Value of a "Key:   123 kB" line, in bytes
+bool parse_kb_field(const char* text, const char* key, size_t& bytes) {
+    const size_t key_length = std::strlen(key);
+    for (const char* line = text; line && *line;) {
+        if (std::strncmp(line, key, key_length) == 0 &&
+            line[key_length] == ':') {
+            bytes = static_cast<size_t>(
+                        std::strtoull(line + key_length + 1, nullptr, 10)) *
+                    1024;
+            return true;
+        }
+        line = std::strchr(line, '\n');
+        if (line) {
+            ++line;
+        }
+    }
+    return false;
+}
+#endif
+
+}  // namespace
+
+// **ProcessMemorySample implementation**
+double ProcessMemorySample::heap_fragmentation() const {
+    const size_t heap = heap_in_use_bytes + heap_free_bytes;
+    return heap > 0 ? static_cast<double>(heap_free_bytes) / heap : 0.0;
+}
+
+// **ProcessMemorySampler implementation**
+ProcessMemorySampler::ProcessMemorySampler(
+    std::chrono::milliseconds rollup_interval)
+    : rollup_interval_(rollup_interval) {
+#ifdef __linux__
+    statm_fd_ = ::open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    rollup_fd_ = ::open("/proc/self/smaps_rollup", O_RDONLY | O_CLOEXEC);
+    rollup_unavailable_ = rollup_fd_ < 0;  // Linux < 4.14
+    const long page_size = ::sysconf(_SC_PAGESIZE);
+    if (page_size > 0) {
+        page_size_ = static_cast<size_t>(page_size);
+    }
+#else
+    rollup_unavailable_ = true;
+#endif
+}
+
+ProcessMemorySampler::~ProcessMemorySampler() {
+#ifdef __linux__
+    if (statm_fd_ >= 0) {
+        ::close(statm_fd_);
+    }
+    if (rollup_fd_ >= 0) {
+        ::close(rollup_fd_);
+    }
+#endif
+}
+
+bool ProcessMemorySampler::is_supported() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+ProcessMemorySample ProcessMemorySampler::sample(bool refresh_rollup) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ProcessMemorySample sample;
+    sample.time = std::chrono::steady_clock::now();
+    sample.valid = read_statm(sample);
+
+    // smaps_rollup walks every mapping; reuse the last reading in between
+    if (sample.valid && !rollup_unavailable_) {
+        if (refresh_rollup || !last_sample_.has_rollup ||
+            sample.time - last_rollup_time_ >= rollup_interval_) {
+            if (read_rollup(sample)) {
+                last_rollup_time_ = sample.time;
+            }
+        } else {
+            sample.has_rollup = true;
+            sample.pss_bytes = last_sample_.pss_bytes;
+            sample.anonymous_bytes = last_sample_.anonymous_bytes;
+            sample.swap_bytes = last_sample_.swap_bytes;
+        }
+    }
+
+    read_heap_info(sample);
+    last_sample_ = sample;
+    return sample;
+}
+
+ProcessMemorySample ProcessMemorySampler::last_sample() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_sample_;
+}
+
+void ProcessMemorySampler::set_rollup_interval(
+    std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rollup_interval_ = interval;
+}
+
+bool ProcessMemorySampler::trim_heap() {
+#ifdef __GLIBC__
+    return ::malloc_trim(0) != 0;
+#else
+    return false;
+#endif
+}
+
+bool ProcessMemorySampler::read_statm(ProcessMemorySample& sample) {
+#ifdef __linux__
+    if (statm_fd_ < 0) {
+        return false;
+    }
+
+    // size resident shared text lib data dt, in pages
+    char buffer[128];
+    if (read_proc_file(statm_fd_, buffer, sizeof(buffer)) == 0) {
+        return false;
+    }
+    char* cursor = buffer;
+    const size_t pages_virtual = std::strtoull(cursor, &cursor, 10);
+    const size_t pages_resident = std::strtoull(cursor, &cursor, 10);
+    const size_t pages_shared = std::strtoull(cursor, &cursor, 10);
+
+    sample.virtual_bytes = pages_virtual * page_size_;
+    sample.rss_bytes = pages_resident * page_size_;
+    sample.shared_bytes = pages_shared * page_size_;
+
+    struct rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+        sample.peak_rss_bytes = static_cast<size_t>(usage.ru_maxrss) * 1024;
+    }
+    return true;
+#else
+    (void)sample;
+    return false;
+#endif
+}
+
+bool ProcessMemorySampler::read_rollup(ProcessMemorySample& sample) {
+#ifdef __linux__
+    char buffer[4096];
+    if (read_proc_file(rollup_fd_, buffer, sizeof(buffer)) == 0) {
+        rollup_unavailable_ = true;
+        return false;
+    }
+    sample.has_rollup = parse_kb_field(buffer, "Pss", sample.pss_bytes);
+    parse_kb_field(buffer, "Anonymous", sample.anonymous_bytes);
+    parse_kb_field(buffer, "Swap", sample.swap_bytes);
+    return sample.has_rollup;
+#else
+    (void)sample;
+    return false;
+#endif
+}
+
+void ProcessMemorySampler::read_heap_info(ProcessMemorySample& sample) {
+#if defined(DECLARATIVEUI_HAS_MALLINFO2)
+    const struct mallinfo2 info = ::mallinfo2();
+    sample.heap_in_use_bytes = info.uordblks + info.hblkhd;
+    sample.heap_free_bytes = info.fordblks;
+    sample.heap_mapped_bytes = info.hblkhd;
+    sample.has_heap_info = true;
+#elif defined(__GLIBC__)
+    // Fields are int and wrap past 2 GB
+    const struct mallinfo info = ::mallinfo();
+    sample.heap_in_use_bytes = static_cast<unsigned>(info.uordblks) +
+                               static_cast<unsigned>(info.hblkhd);
+    sample.heap_free_bytes = static_cast<unsigned>(info.fordblks);
+    sample.heap_mapped_bytes = static_cast<unsigned>(info.hblkhd);
+    sample.has_heap_info = true;
+#else
+    (void)sample;
+#endif
+}
+
+}  // namespace DeclarativeUI::Core
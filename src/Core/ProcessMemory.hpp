@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace DeclarativeUI::Core {
+
+/**
+ * @file ProcessMemory.hpp
+ * @brief Sampling of the real memory footprint of the current process.
+ *
+ * MemoryManager's own counters only see arenas, pools and tracked
+ * allocations. ProcessMemorySampler reads what the operating system and the
+ * C allocator report, so pressure and GC decisions can be based on the
+ * memory the process actually holds.
+ *
+ * Linux backend:
+ *  - /proc/self/statm: virtual size, RSS and file-backed resident pages.
+ *    A single pread() on a descriptor kept open across samples.
+ *  - /proc/self/smaps_rollup: PSS, anonymous and swapped memory. The kernel
+ *    walks every mapping to produce it, so it is refreshed at most once per
+ *    rollup interval and carried forward in between.
+ *  - getrusage(): peak RSS as tracked by the kernel.
+ *  - mallinfo2() (mallinfo() before glibc 2.33): heap bytes in use, free
+ *    bytes retained by malloc and bytes in mmapped chunks.
+ *
+ * On other platforms samples are returned with valid = false and callers
+ * keep using their own estimates.
+ */
+
+/**
+ * @brief One reading of process memory. All values are in bytes.
+ */
+struct ProcessMemorySample {
+    bool valid = false;         /**< statm could be read. */
+    bool has_rollup = false;    /**< PSS/anonymous/swap values are present. */
+    bool has_heap_info = false; /**< Heap values are present. */
+
+    size_t virtual_bytes = 0;
+    size_t rss_bytes = 0;
+    size_t peak_rss_bytes = 0;
+    size_t shared_bytes = 0;    /**< File-backed resident pages. */
+    size_t pss_bytes = 0;       /**< Proportional set size. */
+    size_t anonymous_bytes = 0;
+    size_t swap_bytes = 0;
+
+    size_t heap_in_use_bytes = 0; /**< Allocated through malloc. */
+    size_t heap_free_bytes = 0;   /**< Held by malloc but unused. */
+    size_t heap_mapped_bytes = 0; /**< In chunks served by mmap. */
+
+    std::chrono::steady_clock::time_point time;
+
+    /**
+     * @brief Memory attributable to this process: PSS when known, RSS
+     * otherwise.
+     */
+    size_t footprint_bytes() const {
+        return has_rollup ? pss_bytes : rss_bytes;
+    }
+
+    /**
+     * @brief Share of the malloc heap that is free but still retained.
+     */
+    double heap_fragmentation() const;
+};
+
+/**
+ * @brief Cheap, thread-safe sampler of process memory.
+ *
+ * sample() costs two small procfs reads and a mallinfo call in the common
+ * case, so it is suitable for every monitoring timer tick.
+ */
+class ProcessMemorySampler {
+public:
+    explicit ProcessMemorySampler(
+        std::chrono::milliseconds rollup_interval = std::chrono::seconds(1));
+    ~ProcessMemorySampler();
+
+    ProcessMemorySampler(const ProcessMemorySampler&) = delete;
+    ProcessMemorySampler& operator=(const ProcessMemorySampler&) = delete;
+
+    /**
+     * @brief Whether this platform has a sampling backend.
+     */
+    static bool is_supported();
+
+    /**
+     * @brief Take a sample.
+     * @param refresh_rollup Re-read smaps_rollup even if the rollup interval
+     * has not elapsed.
+     */
+    ProcessMemorySample sample(bool refresh_rollup = false);
+
+    /**
+     * @brief The most recent sample, without touching the system.
+     */
+    ProcessMemorySample last_sample() const;
+
+    void set_rollup_interval(std::chrono::milliseconds interval);
+
+    /**
+     * @brief Return free heap memory held by malloc to the system.
+     * @return True if memory was released (always false where unsupported).
+     */
+    static bool trim_heap();
+
+private:
+    bool read_statm(ProcessMemorySample& sample);
+    bool read_rollup(ProcessMemorySample& sample);
+    static void read_heap_info(ProcessMemorySample& sample);
+
+    mutable std::mutex mutex_;
+    int statm_fd_ = -1;
+    int rollup_fd_ = -1;
+    bool rollup_unavailable_ = false;
+    size_t page_size_ = 4096;
+    std::chrono::milliseconds rollup_interval_;
+    std::chrono::steady_clock::time_point last_rollup_time_;
+    ProcessMemorySample last_sample_;
+};
+
+}  // namespace DeclarativeUI::Core
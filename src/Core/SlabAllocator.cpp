@@ -0,0 +1,331 @@
+#include "SlabAllocator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace DeclarativeUI::Core {
+
+namespace {
+
+// **Size classes**
+constexpr size_t kClassCount = 16 + 12 + 8;
+constexpr size_t kSlabShift = 16;
+static_assert(size_t(1) << kSlabShift == SlabAllocator::kSlabSize);
+
+constexpr size_t class_size(size_t index) {
+    if (index < 16) {
+        return (index + 1) * 16;  // 16 .. 256
+    }
+    if (index < 28) {
+        return 256 + (index - 15) * 64;  // 320 .. 1024
+    }
+    return 1024 + (index - 27) * 128;  // 1152 .. 2048
+}
+static_assert(class_size(kClassCount - 1) == SlabAllocator::kMaxBlockSize);
+
+constexpr size_t class_index(size_t size) {
+    if (size <= 256) {
+        return size == 0 ? 0 : (size - 1) / 16;
+    }
+    if (size <= 1024) {
+        return 16 + (size - 257) / 64;
+    }
+    return 28 + (size - 1025) / 128;
+}
+
+// Blocks moved between a thread cache and the depot at once
+constexpr uint32_t batch_size(size_t index) {
+    return static_cast<uint32_t>(
+        std::clamp<size_t>(8192 / class_size(index), 4, 32));
+}
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+// **Page map: 64 KiB region -> size class + 1 (0 = not a slab)**
+// Covers 48-bit addresses with 65536 lazily allocated 64 KiB leaves.
+constexpr size_t kLeafBits = 16;
+constexpr size_t kRootSize = size_t(1) << 16;
+
+using PageMapLeaf = std::array<std::atomic<uint8_t>, size_t(1) << kLeafBits>;
+std::atomic<PageMapLeaf*> page_map[kRootSize];
+std::mutex page_map_mutex;
+
+bool page_map_set(void* slab, uint8_t value) {
+    const uintptr_t key = reinterpret_cast<uintptr_t>(slab) >> kSlabShift;
+    const uintptr_t root = key >> kLeafBits;
+    if (root >= kRootSize) {
+        return false;
+    }
+    PageMapLeaf* leaf = page_map[root].load(std::memory_order_acquire);
+    if (!leaf) {
+        std::lock_guard<std::mutex> lock(page_map_mutex);
+        leaf = page_map[root].load(std::memory_order_relaxed);
+        if (!leaf) {
+            leaf = new PageMapLeaf();  // Never freed
+            page_map[root].store(leaf, std::memory_order_release);
+        }
+    }
+    (*leaf)[key & ((uintptr_t(1) << kLeafBits) - 1)].store(
+        value, std::memory_order_release);
+    return true;
+}
+
+// Size class index of the slab holding ptr, or -1
+int page_map_class(const void* ptr) {
+    const uintptr_t key = reinterpret_cast<uintptr_t>(ptr) >> kSlabShift;
+    const uintptr_t root = key >> kLeafBits;
+    if (root >= kRootSize) {
+        return -1;
+    }
+    const PageMapLeaf* leaf = page_map[root].load(std::memory_order_acquire);
+    if (!leaf) {
+        return -1;
+    }
+    return static_cast<int>((*leaf)[key & ((uintptr_t(1) << kLeafBits) - 1)]
+                                .load(std::memory_order_acquire)) -
+           1;
+}
+
+void* allocate_slab() {
+#ifdef _WIN32
+    return _aligned_malloc(SlabAllocator::kSlabSize, SlabAllocator::kSlabSize);
+#else
+    return std::aligned_alloc(SlabAllocator::kSlabSize,
+                              SlabAllocator::kSlabSize);
+#endif
+}
+
+void free_slab(void* slab) {
+#ifdef _WIN32
+    _aligned_free(slab);
+#else
+    std::free(slab);
+#endif
+}
+
+// **Depot: shared per-class free lists and slab carving**
+struct Depot {
+    std::mutex mutex;
+    FreeBlock* free_list = nullptr;
+    size_t free_count = 0;
+    char* bump = nullptr;
+    char* bump_end = nullptr;
+};
+
+struct SlabState {
+    std::array<Depot, kClassCount> depots;
+    std::atomic<bool> enabled{true};
+    std::atomic<size_t> slab_count{0};
+    std::atomic<size_t> fallback_allocations{0};
+    std::atomic<size_t> refills{0};
+};
+
+// Leaked so objects freed during static destruction still find it
+SlabState& state() {
+    static SlabState* instance = new SlabState();
+    return *instance;
+}
+
+// Take up to count blocks from the depot as a linked chain
+FreeBlock* depot_take(size_t index, uint32_t count, uint32_t& taken) {
+    Depot& depot = state().depots[index];
+    const size_t block_size = class_size(index);
+    std::lock_guard<std::mutex> lock(depot.mutex);
+
+    FreeBlock* head = nullptr;
+    taken = 0;
+    while (taken < count && depot.free_list) {
+        FreeBlock* block = depot.free_list;
+        depot.free_list = block->next;
+        block->next = head;
+        head = block;
+        ++taken;
+    }
+    depot.free_count -= taken;
+
+    while (taken < count) {
+        if (!depot.bump || depot.bump + block_size > depot.bump_end) {
+            void* slab = allocate_slab();
+            if (!slab) {
+                break;
+            }
+            if (!page_map_set(slab, static_cast<uint8_t>(index + 1))) {
+                free_slab(slab);  // Outside the mapped address range
+                break;
+            }
+            state().slab_count.fetch_add(1, std::memory_order_relaxed);
+            depot.bump = static_cast<char*>(slab);
+            depot.bump_end = depot.bump + SlabAllocator::kSlabSize;
+        }
+        auto* block = reinterpret_cast<FreeBlock*>(depot.bump);
+        depot.bump += block_size;
+        block->next = head;
+        head = block;
+        ++taken;
+    }
+    return head;
+}
+
+void depot_put(size_t index, FreeBlock* head, FreeBlock* tail,
+               uint32_t count) {
+    Depot& depot = state().depots[index];
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    tail->next = depot.free_list;
+    depot.free_list = head;
+    depot.free_count += count;
+}
+
+// **Thread cache**
+struct ThreadCache {
+    struct List {
+        FreeBlock* head = nullptr;
+        uint32_t count = 0;
+    };
+    std::array<List, kClassCount> lists;
+
+    ~ThreadCache();
+    void flush();
+    void release(size_t index, uint32_t count);
+};
+
+thread_local ThreadCache thread_cache;
+// Trivially destructible, so still readable after thread_cache is destroyed
+thread_local bool thread_cache_destroyed = false;
+
+ThreadCache::~ThreadCache() {
+    flush();
+    thread_cache_destroyed = true;
+}
+
+void ThreadCache::flush() {
+    for (size_t index = 0; index < kClassCount; ++index) {
+        release(index, lists[index].count);
+    }
+}
+
+// Return the first count cached blocks of a class to its depot
+void ThreadCache::release(size_t index, uint32_t count) {
+    List& list = lists[index];
+    if (count == 0 || !list.head) {
+        return;
+    }
+    FreeBlock* head = list.head;
+    FreeBlock* tail = head;
+    for (uint32_t i = 1; i < count; ++i) {
+        tail = tail->next;
+    }
+    list.head = tail->next;
+    list.count -= count;
+    depot_put(index, head, tail, count);
+}
+
+void* fallback_allocate(size_t size) {
+    state().fallback_allocations.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(size);
+}
+
+}  // namespace
+
+// **SlabAllocator implementation**
+void* SlabAllocator::allocate(size_t size) {
+    if (size > kMaxBlockSize ||
+        !state().enabled.load(std::memory_order_relaxed)) {
+        return fallback_allocate(size);
+    }
+
+    const size_t index = class_index(size);
+    if (thread_cache_destroyed) {
+        uint32_t taken = 0;
+        if (FreeBlock* block = depot_take(index, 1, taken)) {
+            return block;
+        }
+        return fallback_allocate(size);
+    }
+
+    auto& list = thread_cache.lists[index];
+    if (!list.head) {
+        uint32_t taken = 0;
+        list.head = depot_take(index, batch_size(index), taken);
+        list.count = taken;
+        state().refills.fetch_add(1, std::memory_order_relaxed);
+        if (!list.head) {
+            return fallback_allocate(size);
+        }
+    }
+
+    FreeBlock* block = list.head;
+    list.head = block->next;
+    --list.count;
+    return block;
+}
+
+void SlabAllocator::deallocate(void* ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    const int index = page_map_class(ptr);
+    if (index < 0) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto* block = static_cast<FreeBlock*>(ptr);
+    if (thread_cache_destroyed) {
+        block->next = nullptr;
+        depot_put(static_cast<size_t>(index), block, block, 1);
+        return;
+    }
+
+    auto& list = thread_cache.lists[index];
+    block->next = list.head;
+    list.head = block;
+    ++list.count;
+
+    // Keep at most two batches per class cached on this thread
+    const uint32_t batch = batch_size(static_cast<size_t>(index));
+    if (list.count > 2 * batch) {
+        thread_cache.release(static_cast<size_t>(index), batch);
+    }
+}
+
+void SlabAllocator::set_enabled(bool enabled) {
+    state().enabled.store(enabled);
+}
+
+bool SlabAllocator::is_enabled() { return state().enabled.load(); }
+
+bool SlabAllocator::owns(const void* ptr) {
+    return ptr && page_map_class(ptr) >= 0;
+}
+
+void SlabAllocator::flush_thread_cache() {
+    if (!thread_cache_destroyed) {
+        thread_cache.flush();
+    }
+}
+
+SlabAllocator::Statistics SlabAllocator::statistics() {
+    Statistics stats;
+    stats.slab_count = state().slab_count.load();
+    stats.reserved_bytes = stats.slab_count * kSlabSize;
+    stats.fallback_allocations = state().fallback_allocations.load();
+    stats.upstream_allocations = stats.slab_count + stats.fallback_allocations;
+    stats.refills = state().refills.load();
+    for (size_t index = 0; index < kClassCount; ++index) {
+        Depot& depot = state().depots[index];
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        stats.depot_free_bytes += depot.free_count * class_size(index);
+    }
+    return stats;
+}
+
+}  // namespace DeclarativeUI::Core
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace DeclarativeUI::Core {
+
+/**
+ * @file SlabAllocator.hpp
+ * @brief Size-class slab allocator for small, frequently created UI objects.
+ *
+ * Declarative trees create thousands of small heap objects (UI elements,
+ * commands, command state and events, reactive properties, bindings).
+ * SlabAllocator packs them into 64 KiB slabs, one size class per slab, so
+ * objects of similar size sit next to each other and allocation avoids the
+ * general-purpose allocator.
+ *
+ * - Size classes are 16-byte steps up to 256 bytes, 64-byte steps up to
+ *   1 KiB and 128-byte steps up to 2 KiB. Larger requests go to
+ *   ::operator new.
+ * - Each thread keeps a free list per size class and moves blocks to and
+ *   from a mutex-protected depot in batches, so the common path takes no
+ *   lock. Blocks freed on another thread simply join that thread's list.
+ * - A two-level page map records which 64 KiB regions are slabs and their
+ *   size class, so deallocate() does not trust the size it is given and
+ *   copes with objects allocated while the allocator was disabled.
+ * - Slabs are kept for the lifetime of the process and reused.
+ *
+ * Classes opt in with DECLARATIVE_UI_SLAB_ALLOCATED inside their body; the
+ * operators are inherited by every subclass.
+ */
+class SlabAllocator {
+public:
+    static constexpr size_t kSlabSize = 64 * 1024;
+    static constexpr size_t kMaxBlockSize = 2048;
+
+    struct Statistics {
+        size_t slab_count = 0;           /**< Slabs obtained upstream. */
+        size_t reserved_bytes = 0;       /**< slab_count * kSlabSize. */
+        size_t depot_free_bytes = 0;     /**< Free blocks in the depots. */
+        size_t upstream_allocations = 0; /**< Slabs plus fallbacks. */
+        size_t fallback_allocations = 0; /**< Served by ::operator new. */
+        size_t refills = 0;              /**< Thread cache refills. */
+    };
+
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr) noexcept;
+
+    /**
+     * @brief Route new allocations through the slabs (default) or straight
+     * to ::operator new. Existing objects are freed correctly either way.
+     */
+    static void set_enabled(bool enabled);
+    static bool is_enabled();
+
+    /**
+     * @brief Whether ptr lies in a slab.
+     */
+    static bool owns(const void* ptr);
+
+    /**
+     * @brief Hand the calling thread's cached blocks back to the depots.
+     */
+    static void flush_thread_cache();
+
+    static Statistics statistics();
+};
+
+}  // namespace DeclarativeUI::Core
+
+/**
+ * @brief Give a class (and its subclasses) slab-backed operator new/delete.
+ *
+ * Place in a public section of the class body. Placement new
+ * stays available for in-place construction (e.g. by QMetaType).
+ */
+#define DECLARATIVE_UI_SLAB_ALLOCATED                                \
+    static void* operator new(std::size_t size) {                    \
+        return ::DeclarativeUI::Core::SlabAllocator::allocate(size); \
+    }                                                                \
+    static void* operator new(std::size_t, void* place) noexcept {   \
+        return place;                                                \
+    }                                                                \
+    static void operator delete(void* ptr) noexcept {                \
+        ::DeclarativeUI::Core::SlabAllocator::deallocate(ptr);       \
+    }                                                                \
+    static void operator delete(void*, void*) noexcept {}
@@ -31,6 +31,7 @@
 
 #include "../Animation/AnimationEngine.hpp"
 #include "../Exceptions/UIExceptions.hpp"
+#include "SlabAllocator.hpp"
 
 Q_DECLARE_METATYPE(std::function<void()>)
 
@@ -179,6 +180,8 @@ class UIElement : public QObject {
     Q_OBJECT
 
 public:
+    DECLARATIVE_UI_SLAB_ALLOCATED
+
     explicit UIElement(QObject *parent = nullptr);
     virtual ~UIElement() = default;
 
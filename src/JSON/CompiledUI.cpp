@@ -0,0 +1,511 @@
+#include "CompiledUI.hpp"
+
+#include <QDataStream>
+#include <QHash>
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "../Exceptions/UIExceptions.hpp"
+
+namespace DeclarativeUI::JSON {
+
+namespace {
+
+// Fixed so that an image does not depend on QDataStream's default
+constexpr int kStreamVersion = QDataStream::Qt_6_0;
+
+static_assert(sizeof(CompiledUIImage::Header) == 64);
+static_assert(sizeof(CompiledUIImage::Node) == 88);
+static_assert(sizeof(CompiledUIImage::Property) == 16);
+static_assert(sizeof(CompiledUIImage::Pair) == 8);
+static_assert(std::is_trivially_copyable_v<CompiledUIImage::Node>);
+
+template <typename T>
+T readRecord(const char *data) {
+    T record;
+    std::memcpy(&record, data, sizeof(T));
+    return record;
+}
+
+qsizetype align8(qsizetype offset) { return (offset + 7) & ~qsizetype(7); }
+
+QVariant readVariant(const char *data, quint32 size) {
+    const QByteArray blob = QByteArray::fromRawData(data, size);
+    QDataStream stream(blob);
+    stream.setVersion(kStreamVersion);
+    QVariant value;
+    stream >> value;
+    return value;
+}
+
+// Lays out the tables while the tree is walked, then packs them
+class ImageBuilder {
+public:
+    void addNode(const CompiledUIWriter::Node &node, int depth);
+    QByteArray finish() const;
+
+private:
+    QHash<QString, quint32> string_ids_;
+    std::vector<quint32> string_offsets_;
+    QByteArray string_data_;
+    std::vector<CompiledUIImage::Node> nodes_;
+    std::vector<CompiledUIImage::Property> properties_;
+    std::vector<CompiledUIImage::Pair> pairs_;
+    QByteArray value_data_;
+
+    quint32 intern(const QString &text);
+    CompiledUIImage::Property encode(const CompiledUIWriter::Property &prop);
+    void appendPairs(const QList<QPair<QString, QString>> &pairs);
+    QPair<quint32, quint32> appendVariant(const QVariant &value,
+                                          const QString &what);
+};
+
+quint32 ImageBuilder::intern(const QString &text) {
+    const auto it = string_ids_.constFind(text);
+    if (it != string_ids_.constEnd()) {
+        return it.value();
+    }
+    const auto id = static_cast<quint32>(string_offsets_.size());
+    string_offsets_.push_back(static_cast<quint32>(string_data_.size()));
+    string_data_.append(text.toUtf8());
+    string_data_.append('\0');
+    string_ids_.insert(text, id);
+    return id;
+}
+
+QPair<quint32, quint32> ImageBuilder::appendVariant(const QVariant &value,
+                                                    const QString &what) {
+    QByteArray blob;
+    QDataStream stream(&blob, QIODevice::WriteOnly);
+    stream.setVersion(kStreamVersion);
+    stream << value;
+    if (stream.status() != QDataStream::Ok) {
+        throw Exceptions::JSONValidationException(
+            QString("Cannot store %1 value of %2 in a UI image")
+                .arg(QString::fromLatin1(value.typeName()), what)
+                .toStdString());
+    }
+    const auto offset = static_cast<quint32>(value_data_.size());
+    value_data_.append(blob);
+    return {offset, static_cast<quint32>(blob.size())};
+}
+
+CompiledUIImage::Property ImageBuilder::encode(
+    const CompiledUIWriter::Property &prop) {
+    using Kind = CompiledUIImage::ValueKind;
+    CompiledUIImage::Property record{intern(prop.name), Kind::Invalid, 0, 0};
+    const QVariant &value = prop.value;
+
+    switch (value.typeId()) {
+        case QMetaType::UnknownType:
+            break;
+        case QMetaType::Bool:
+            record.kind = Kind::Bool;
+            record.a = value.toBool() ? 1 : 0;
+            break;
+        case QMetaType::Int:
+            record.kind = Kind::Int;
+            record.a = static_cast<quint32>(value.toInt());
+            break;
+        case QMetaType::Double: {
+            const double number = value.toDouble();
+            quint64 bits = 0;
+            std::memcpy(&bits, &number, sizeof(bits));
+            record.kind = Kind::Double;
+            record.a = static_cast<quint32>(bits);
+            record.b = static_cast<quint32>(bits >> 32);
+            break;
+        }
+        case QMetaType::QString:
+            record.kind = Kind::String;
+            record.a = intern(value.toString());
+            break;
+        default: {
+            const auto [offset, size] =
+                appendVariant(value, "property " + prop.name);
+            record.kind = Kind::Variant;
+            record.a = offset;
+            record.b = size;
+            break;
+        }
+    }
+    return record;
+}
+
+void ImageBuilder::appendPairs(const QList<QPair<QString, QString>> &pairs) {
+    for (const auto &[key, value] : pairs) {
+        pairs_.push_back({intern(key), intern(value)});
+    }
+}
+
+void ImageBuilder::addNode(const CompiledUIWriter::Node &node, int depth) {
+    if (depth > CompiledUIImage::kMaxDepth) {
+        throw Exceptions::JSONValidationException(
+            "UI tree is nested too deeply for a UI image");
+    }
+
+    // Children are appended behind this node, so fill a copy first
+    const std::size_t index = nodes_.size();
+    nodes_.emplace_back();
+    CompiledUIImage::Node record{};
+    record.type = intern(node.type);
+
+    record.first_property = static_cast<quint32>(properties_.size());
+    record.property_count = static_cast<quint32>(node.properties.size());
+    for (const auto &prop : node.properties) {
+        properties_.push_back(encode(prop));
+    }
+
+    record.first_event = static_cast<quint32>(pairs_.size());
+    record.event_count = static_cast<quint32>(node.events.size());
+    appendPairs(node.events);
+    record.first_binding = static_cast<quint32>(pairs_.size());
+    record.binding_count = static_cast<quint32>(node.bindings.size());
+    appendPairs(node.bindings);
+
+    if (!node.factory_config.isEmpty()) {
+        const auto [offset, size] =
+            appendVariant(QVariant(node.factory_config),
+                          "the factory config of " + node.type);
+        record.config_offset = offset;
+        record.config_size = size;
+    }
+
+    record.layout_type = node.layout_type ? intern(*node.layout_type)
+                                          : CompiledUIImage::kNoString;
+    if (node.layout_spacing) {
+        record.flags |= CompiledUIImage::kHasLayoutSpacing;
+        record.layout_spacing = *node.layout_spacing;
+    }
+    if (node.layout_margins) {
+        const QMargins &margins = *node.layout_margins;
+        record.flags |= CompiledUIImage::kHasLayoutMargins;
+        record.layout_margins[0] = margins.left();
+        record.layout_margins[1] = margins.top();
+        record.layout_margins[2] = margins.right();
+        record.layout_margins[3] = margins.bottom();
+    }
+    record.grid[0] = node.row;
+    record.grid[1] = node.column;
+    record.grid[2] = node.row_span;
+    record.grid[3] = node.column_span;
+
+    record.child_count = static_cast<quint32>(node.children.size());
+    for (const auto &child : node.children) {
+        addNode(child, depth + 1);
+    }
+    record.subtree_size = static_cast<quint32>(nodes_.size() - index);
+    nodes_[index] = record;
+}
+
+QByteArray ImageBuilder::finish() const {
+    CompiledUIImage::Header header{};
+    header.magic = CompiledUIImage::kMagic;
+    header.byte_order = CompiledUIImage::kByteOrderMark;
+    header.version = CompiledUIImage::kVersion;
+
+    qsizetype offset = sizeof(header);
+    const auto place = [&offset](qsizetype bytes) {
+        const qsizetype at = offset;
+        offset = align8(offset + bytes);
+        return static_cast<quint32>(at);
+    };
+
+    header.string_count = static_cast<quint32>(string_offsets_.size());
+    header.string_index_offset =
+        place(string_offsets_.size() * sizeof(quint32));
+    header.string_data_offset = place(string_data_.size());
+    header.string_data_size = static_cast<quint32>(string_data_.size());
+    header.node_count = static_cast<quint32>(nodes_.size());
+    header.nodes_offset =
+        place(nodes_.size() * sizeof(CompiledUIImage::Node));
+    header.property_count = static_cast<quint32>(properties_.size());
+    header.properties_offset =
+        place(properties_.size() * sizeof(CompiledUIImage::Property));
+    header.pair_count = static_cast<quint32>(pairs_.size());
+    header.pairs_offset =
+        place(pairs_.size() * sizeof(CompiledUIImage::Pair));
+    header.value_data_offset = place(value_data_.size());
+    header.value_data_size = static_cast<quint32>(value_data_.size());
+
+    if (offset > std::numeric_limits<quint32>::max()) {
+        throw Exceptions::JSONValidationException(
+            "UI image would exceed 4 GiB");
+    }
+    header.total_size = static_cast<quint32>(offset);
+
+    QByteArray image(offset, '\0');
+    char *out = image.data();
+    // Empty tables may have no storage at all
+    const auto copy = [out](quint32 at, const void *table, std::size_t bytes) {
+        if (bytes > 0) {
+            std::memcpy(out + at, table, bytes);
+        }
+    };
+    copy(0, &header, sizeof(header));
+    copy(header.string_index_offset, string_offsets_.data(),
+         string_offsets_.size() * sizeof(quint32));
+    copy(header.string_data_offset, string_data_.constData(),
+         string_data_.size());
+    copy(header.nodes_offset, nodes_.data(),
+         nodes_.size() * sizeof(CompiledUIImage::Node));
+    copy(header.properties_offset, properties_.data(),
+         properties_.size() * sizeof(CompiledUIImage::Property));
+    copy(header.pairs_offset, pairs_.data(),
+         pairs_.size() * sizeof(CompiledUIImage::Pair));
+    copy(header.value_data_offset, value_data_.constData(),
+         value_data_.size());
+    return image;
+}
+
+}  // namespace
+
+// **CompiledUIWriter implementation**
+
+QByteArray CompiledUIWriter::write(const Node &root) {
+    ImageBuilder builder;
+    builder.addNode(root, 1);
+    return builder.finish();
+}
+
+// **CompiledUIImage implementation**
+
+CompiledUIImage CompiledUIImage::open(const QString &path) {
+    CompiledUIImage image;
+    // Map even small images: they are read in place, never copied
+    image.file_ = Core::FileView::open(path, 0);
+    if (!image.file_.isValid()) {
+        image.fail(image.file_.errorString());
+    } else {
+        image.attach(image.file_.data(), image.file_.size());
+    }
+    return image;
+}
+
+CompiledUIImage CompiledUIImage::fromData(const QByteArray &data) {
+    CompiledUIImage image;
+    image.buffer_ = data;
+    image.attach(image.buffer_.constData(), image.buffer_.size());
+    return image;
+}
+
+bool CompiledUIImage::attach(const char *data, qsizetype size) {
+    data_ = data;
+    size_ = size;
+    return validate() && validateTree();
+}
+
+bool CompiledUIImage::fail(const QString &error) {
+    data_ = nullptr;
+    error_ = error;
+    return false;
+}
+
+bool CompiledUIImage::validate() {
+    if (size_ < static_cast<qsizetype>(sizeof(Header))) {
+        return fail("UI image is truncated");
+    }
+    header_ = readRecord<Header>(data_);
+    if (header_.magic != kMagic) {
+        return fail("Not a UI image");
+    }
+    if (header_.byte_order != kByteOrderMark) {
+        return fail("UI image was compiled for a different byte order");
+    }
+    if (header_.version != kVersion) {
+        return fail(
+            QString("Unsupported UI image version %1").arg(header_.version));
+    }
+    if (header_.total_size != static_cast<quint64>(size_)) {
+        return fail("UI image is truncated");
+    }
+
+    const auto fits = [this](quint64 offset, quint64 count, quint64 size) {
+        return offset + count * size <= static_cast<quint64>(size_);
+    };
+    if (!fits(header_.string_index_offset, header_.string_count,
+              sizeof(quint32)) ||
+        !fits(header_.string_data_offset, header_.string_data_size, 1) ||
+        !fits(header_.nodes_offset, header_.node_count, sizeof(Node)) ||
+        !fits(header_.properties_offset, header_.property_count,
+              sizeof(Property)) ||
+        !fits(header_.pairs_offset, header_.pair_count, sizeof(Pair)) ||
+        !fits(header_.value_data_offset, header_.value_data_size, 1)) {
+        return fail("UI image table is out of bounds");
+    }
+    if (header_.node_count == 0) {
+        return fail("UI image has no widgets");
+    }
+
+    // Each string ends where the next one starts, with a NUL
+    const char *strings = data_ + header_.string_data_offset;
+    for (quint32 i = 0; i < header_.string_count; ++i) {
+        const quint32 begin = stringOffset(i);
+        const quint32 end = i + 1 < header_.string_count
+                                ? stringOffset(i + 1)
+                                : header_.string_data_size;
+        if (begin >= end || end > header_.string_data_size ||
+            strings[end - 1] != '\0') {
+            return fail(QString("UI image string %1 is malformed").arg(i));
+        }
+    }
+
+    const auto isString = [this](quint32 index) {
+        return index < header_.string_count;
+    };
+    const auto inValues = [this](quint64 offset, quint64 size) {
+        return offset + size <= header_.value_data_size;
+    };
+
+    for (quint32 i = 0; i < header_.property_count; ++i) {
+        const Property prop = property(i);
+        bool ok = isString(prop.name) && prop.kind <= ValueKind::Variant;
+        if (prop.kind == ValueKind::String) {
+            ok = ok && isString(prop.a);
+        } else if (prop.kind == ValueKind::Variant) {
+            ok = ok && inValues(prop.a, prop.b);
+        }
+        if (!ok) {
+            return fail(QString("UI image property %1 is malformed").arg(i));
+        }
+    }
+
+    for (quint32 i = 0; i < header_.pair_count; ++i) {
+        const Pair entry = pair(i);
+        if (!isString(entry.key) || !isString(entry.value)) {
+            return fail(QString("UI image pair %1 is malformed").arg(i));
+        }
+    }
+
+    for (quint32 i = 0; i < header_.node_count; ++i) {
+        const Node entry = node(i);
+        const bool ok =
+            isString(entry.type) &&
+            (entry.layout_type == kNoString || isString(entry.layout_type)) &&
+            quint64(entry.first_property) + entry.property_count <=
+                header_.property_count &&
+            quint64(entry.first_event) + entry.event_count <=
+                header_.pair_count &&
+            quint64(entry.first_binding) + entry.binding_count <=
+                header_.pair_count &&
+            inValues(entry.config_offset, entry.config_size);
+        if (!ok) {
+            return fail(QString("UI image widget %1 is malformed").arg(i));
+        }
+    }
+    return true;
+}
+
+bool CompiledUIImage::validateTree() {
+    if (!isValid()) {
+        return false;
+    }
+
+    // Every subtree must hold exactly its children's subtrees
+    struct Frame {
+        quint64 end;
+        quint32 children_left;
+    };
+    const Node root = node(0);
+    if (root.subtree_size != header_.node_count) {
+        return fail("UI image tree does not cover all widgets");
+    }
+    std::vector<Frame> stack{{root.subtree_size, root.child_count}};
+    quint64 next = 1;
+    while (!stack.empty()) {
+        if (stack.back().children_left == 0) {
+            if (next != stack.back().end) {
+                return fail("UI image tree is malformed");
+            }
+            stack.pop_back();
+            continue;
+        }
+        --stack.back().children_left;
+        // A child count larger than the subtree would read past the table
+        if (next >= stack.back().end) {
+            return fail("UI image tree is malformed");
+        }
+        const Node child = node(static_cast<quint32>(next));
+        if (child.subtree_size == 0 ||
+            next + child.subtree_size > stack.back().end) {
+            return fail("UI image tree is malformed");
+        }
+        if (stack.size() >= static_cast<std::size_t>(kMaxDepth)) {
+            return fail("UI image tree is nested too deeply");
+        }
+        stack.push_back({next + child.subtree_size, child.child_count});
+        ++next;
+    }
+    return true;
+}
+
+quint32 CompiledUIImage::stringOffset(quint32 index) const {
+    return readRecord<quint32>(data_ + header_.string_index_offset +
+                               std::size_t(index) * sizeof(quint32));
+}
+
+CompiledUIImage::Node CompiledUIImage::node(quint32 index) const {
+    return readRecord<Node>(data_ + header_.nodes_offset +
+                            std::size_t(index) * sizeof(Node));
+}
+
+CompiledUIImage::Property CompiledUIImage::property(quint32 index) const {
+    return readRecord<Property>(data_ + header_.properties_offset +
+                                std::size_t(index) * sizeof(Property));
+}
+
+CompiledUIImage::Pair CompiledUIImage::pair(quint32 index) const {
+    return readRecord<Pair>(data_ + header_.pairs_offset +
+                            std::size_t(index) * sizeof(Pair));
+}
+
+const char *CompiledUIImage::utf8(quint32 index) const {
+    return data_ + header_.string_data_offset + stringOffset(index);
+}
+
+qsizetype CompiledUIImage::utf8Size(quint32 index) const {
+    const quint32 end = index + 1 < header_.string_count
+                            ? stringOffset(index + 1)
+                            : header_.string_data_size;
+    return end - stringOffset(index) - 1;
+}
+
+QString CompiledUIImage::string(quint32 index) const {
+    return QString::fromUtf8(utf8(index), utf8Size(index));
+}
+
+QVariant CompiledUIImage::value(const Property &property) const {
+    switch (property.kind) {
+        case ValueKind::Bool:
+            return property.a != 0;
+        case ValueKind::Int:
+            return static_cast<qint32>(property.a);
+        case ValueKind::Double: {
+            const quint64 bits = (quint64(property.b) << 32) | property.a;
+            double number = 0;
+            std::memcpy(&number, &bits, sizeof(number));
+            return number;
+        }
+        case ValueKind::String:
+            return string(property.a);
+        case ValueKind::Variant:
+            return readVariant(
+                data_ + header_.value_data_offset + property.a, property.b);
+        case ValueKind::Invalid:
+            break;
+    }
+    return QVariant{};
+}
+
+QVariantMap CompiledUIImage::factoryConfig(const Node &node) const {
+    if (node.config_size == 0) {
+        return {};
+    }
+    return readVariant(data_ + header_.value_data_offset + node.config_offset,
+                       node.config_size)
+        .toMap();
+}
+
+}  // namespace DeclarativeUI::JSON
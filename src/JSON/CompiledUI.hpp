@@ -0,0 +1,225 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QMargins>
+#include <QPair>
+#include <QString>
+#include <QVariant>
+#include <QVariantMap>
+
+#include <optional>
+#include <vector>
+
+#include "../Core/FileView.hpp"
+
+namespace DeclarativeUI::JSON {
+
+/**
+ * @file CompiledUI.hpp
+ * @brief Binary UI images: widget trees compiled ahead of time so that
+ * loading them needs no JSON parser.
+ *
+ * An image holds one UI definition after JSONParser has resolved its
+ * references and includes and JSONUILoader has validated it and converted
+ * its property values (see JSONUILoader::compileImage()):
+ *
+ * - Every string (types, property names, handler names, ...) is stored
+ *   once, as NUL-terminated UTF-8, and referred to by index.
+ * - Widgets are stored in pre-order. Each node records how many nodes its
+ *   subtree spans, so a child that fails to build is skipped in O(1).
+ * - Property values already have the type of the widget property they are
+ *   written to. Booleans, integers, doubles and strings are stored inline;
+ *   anything else is a QVariant serialized with QDataStream.
+ * - Images are memory-mapped and used in place. Every index and range is
+ *   checked once, when the image is opened.
+ *
+ * Images are build artifacts for the machine that compiled them: the
+ * QVariant encoding follows the Qt version and records are stored in the
+ * host byte order, so an image from a different byte order is rejected.
+ */
+
+/**
+ * @class CompiledUIImage
+ * @brief Read-only view of a binary UI image.
+ *
+ * Opening never throws; an image that fails its checks is invalid and
+ * errorString() says why. Accessors assume isValid() and an index below
+ * the matching count.
+ */
+class CompiledUIImage {
+public:
+    static constexpr quint32 kMagic = 0x43495544;  // "DUIC"
+    static constexpr quint32 kVersion = 1;
+    static constexpr quint32 kByteOrderMark = 0x01020304;
+    static constexpr quint32 kNoString = 0xFFFFFFFF;
+    static constexpr int kMaxDepth = 1024;
+
+    /**
+     * @brief File name suffix the compiler gives images.
+     */
+    static constexpr const char *kFileSuffix = ".uibin";
+
+    enum class ValueKind : quint32 {
+        Invalid,  // Resets the property, like a JSON null
+        Bool,     // a
+        Int,      // a, as qint32
+        Double,   // a and b hold the low and high words of the bits
+        String,   // a is a string index
+        Variant   // a and b are the offset and size of a QDataStream blob
+    };
+
+    enum NodeFlags : quint32 {
+        kHasLayoutSpacing = 0x1,
+        kHasLayoutMargins = 0x2
+    };
+
+    struct Header {
+        quint32 magic;
+        quint32 byte_order;  // kByteOrderMark as written by the compiler
+        quint32 version;
+        quint32 total_size;
+        quint32 string_count;
+        quint32 string_index_offset;  // string_count offsets into the data
+        quint32 string_data_offset;
+        quint32 string_data_size;
+        quint32 node_count;
+        quint32 nodes_offset;
+        quint32 property_count;
+        quint32 properties_offset;
+        quint32 pair_count;
+        quint32 pairs_offset;
+        quint32 value_data_offset;
+        quint32 value_data_size;
+    };
+
+    /**
+     * @brief One widget. Its descendants follow it directly.
+     */
+    struct Node {
+        quint32 type;
+        quint32 subtree_size;  // This node and all of its descendants
+        quint32 child_count;
+        quint32 first_property;
+        quint32 property_count;
+        quint32 first_event;  // Pairs of event name and handler name
+        quint32 event_count;
+        quint32 first_binding;  // Pairs of property name and state key
+        quint32 binding_count;
+        quint32 config_offset;  // QVariantMap handed to the factory
+        quint32 config_size;    // 0 when the factory needs no config
+        quint32 layout_type;    // kNoString without a "layout" member
+        quint32 flags;
+        qint32 layout_spacing;
+        qint32 layout_margins[4];  // Left, top, right, bottom
+        qint32 grid[4];            // Row, column, row span, column span
+    };
+
+    struct Property {
+        quint32 name;
+        ValueKind kind;
+        quint32 a;
+        quint32 b;
+    };
+
+    struct Pair {
+        quint32 key;
+        quint32 value;
+    };
+
+    /**
+     * @brief A null image: not valid.
+     */
+    CompiledUIImage() = default;
+
+    /**
+     * @brief Map the image at path.
+     */
+    static CompiledUIImage open(const QString &path);
+
+    /**
+     * @brief Use an image held in memory; the image keeps a reference.
+     */
+    static CompiledUIImage fromData(const QByteArray &data);
+
+    [[nodiscard]] bool isValid() const { return data_ != nullptr; }
+    [[nodiscard]] QString errorString() const { return error_; }
+    [[nodiscard]] bool isMapped() const { return file_.isMapped(); }
+    [[nodiscard]] qsizetype size() const { return size_; }
+
+    [[nodiscard]] quint32 nodeCount() const { return header_.node_count; }
+    [[nodiscard]] Node node(quint32 index) const;
+    [[nodiscard]] Property property(quint32 index) const;
+    [[nodiscard]] Pair pair(quint32 index) const;
+
+    /**
+     * @brief NUL-terminated UTF-8 of a string, pointing into the image.
+     */
+    [[nodiscard]] const char *utf8(quint32 index) const;
+    [[nodiscard]] qsizetype utf8Size(quint32 index) const;
+    [[nodiscard]] QString string(quint32 index) const;
+
+    /**
+     * @brief Decode a property value.
+     */
+    [[nodiscard]] QVariant value(const Property &property) const;
+
+    /**
+     * @brief The factory config of a node, as a map of property values.
+     */
+    [[nodiscard]] QVariantMap factoryConfig(const Node &node) const;
+
+private:
+    Core::FileView file_;
+    QByteArray buffer_;
+    const char *data_ = nullptr;
+    qsizetype size_ = 0;
+    Header header_{};
+    QString error_;
+
+    quint32 stringOffset(quint32 index) const;
+    bool attach(const char *data, qsizetype size);
+    bool validate();
+    bool validateTree();
+    bool fail(const QString &error);
+};
+
+/**
+ * @class CompiledUIWriter
+ * @brief Serializes a widget tree description into a CompiledUIImage.
+ *
+ * The writer only lays out bytes; deciding what goes into each node
+ * (validation, value conversion) is JSONUILoader::compileImage()'s job.
+ */
+class CompiledUIWriter {
+public:
+    struct Property {
+        QString name;
+        QVariant value;
+    };
+
+    struct Node {
+        QString type;
+        QList<Property> properties;
+        QVariantMap factory_config;
+        QList<QPair<QString, QString>> events;
+        QList<QPair<QString, QString>> bindings;
+        std::optional<QString> layout_type;
+        std::optional<int> layout_spacing;
+        std::optional<QMargins> layout_margins;
+        int row = 0;
+        int column = 0;
+        int row_span = 1;
+        int column_span = 1;
+        std::vector<Node> children;
+    };
+
+    /**
+     * @brief Write the image of the tree rooted at root.
+     * @throws Exceptions::JSONValidationException if a value cannot be
+     * serialized or the tree is deeper than CompiledUIImage::kMaxDepth.
+     */
+    static QByteArray write(const Node &root);
+};
+
+}  // namespace DeclarativeUI::JSON
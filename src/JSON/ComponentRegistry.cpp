@@ -55,6 +55,14 @@ bool ComponentRegistry::hasComponent(const QString& type_name) const noexcept {
     return factories_.find(type_name) != factories_.end();
 }
 
+const QMetaObject* ComponentRegistry::metaObjectFor(
+    const QString& type_name) const noexcept {
+    auto factory_it = factories_.find(type_name);
+    return factory_it != factories_.end()
+               ? factory_it->second->widgetMetaObject()
+               : nullptr;
+}
+
 QStringList ComponentRegistry::getRegisteredTypes() const {
     QStringList types;
     for (const auto& [type_name, factory] : factories_) {
@@ -92,6 +92,15 @@ public:
      * The returned string is used primarily for diagnostics and debugging.
      */
     virtual QString getTypeName() const = 0;
+
+    /**
+     * @brief Meta-object of the widgets the factory creates, if known.
+     * @return The QMetaObject, or nullptr when the factory cannot tell.
+     *
+     * Lets UI definitions be compiled ahead of time (property types are
+     * resolved without creating a widget).
+     */
+    virtual const QMetaObject* widgetMetaObject() const { return nullptr; }
 };
 
 /**
@@ -135,6 +144,10 @@ public:
         return QString::fromUtf8(typeid(WidgetType).name());
     }
 
+    const QMetaObject* widgetMetaObject() const override {
+        return &WidgetType::staticMetaObject;
+    }
+
 private:
     std::function<std::unique_ptr<WidgetType>(const QJsonObject&)> factory_;
 };
@@ -202,6 +215,14 @@ public:
      */
     [[nodiscard]] QStringList getRegisteredTypes() const;
 
+    /**
+     * @brief Meta-object of the widgets a registered type creates.
+     * @param type_name Type name to query.
+     * @return The factory's widgetMetaObject(), or nullptr for unknown types.
+     */
+    [[nodiscard]] const QMetaObject* metaObjectFor(
+        const QString& type_name) const noexcept;
+
     /**
      * @brief Clear all registered factories.
      *
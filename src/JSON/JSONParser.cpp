@@ -1,5 +1,8 @@
 #include "JSONParser.hpp"
 
+#include "../Core/CacheManager.hpp"
+#include "JSONStreamParser.hpp"
+#include "JSONStructuralIndex.hpp"
 #include "src/Exceptions/UIExceptions.hpp"
 
 #include <QDebug>
@@ -355,25 +358,40 @@ QJsonObject JSONParser::parseFile(const QString& file_path) {
                                                "File is not readable");
     }
 
+    if (cache_manager_) {
+        if (auto cached = cache_manager_->getCachedJSONFile(file_path)) {
+            return *cached;
+        }
+    }
+
     QFile file(file_path);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         throw Exceptions::JSONParsingException(
             file_path.toStdString(),
             "Cannot open file: " + file.errorString().toStdString());
     }
 
-    QString json_content = QString::fromUtf8(file.readAll());
+    QByteArray content = file.readAll();
+    // The cache hashes the bytes as read; preprocessing then works on a copy
+    const QByteArray raw_content = cache_manager_ ? content : QByteArray();
 
     // **Setup parsing context**
-    JSONParsingContext context;
+    JSONParsingContext context(memory_resource_);
     context.source_file = file_info.canonicalFilePath();
     context.strict_mode = strict_mode_;
 
-    return parseWithContext(json_content, context);
+    QJsonObject result = parseUtf8WithContext(std::move(content), context);
+
+    // Only cache clean parses so errors are reported again on the next load
+    if (cache_manager_ && context.errors.isEmpty()) {
+        cache_manager_->cacheJSONFile(file_path, raw_content, result);
+    }
+
+    return result;
 }
 
 QJsonObject JSONParser::parseString(const QString& json_string) {
-    JSONParsingContext context;
+    JSONParsingContext context(memory_resource_);
     context.source_file = "<string>";
     context.strict_mode = strict_mode_;
 
@@ -403,32 +421,47 @@ QJsonObject JSONParser::parseUrl(const QUrl& url) {
             "Network error: " + error_msg.toStdString());
     }
 
-    QString json_content = QString::fromUtf8(reply->readAll());
+    QByteArray json_content = reply->readAll();
     reply->deleteLater();
 
-    JSONParsingContext context;
+    JSONParsingContext context(memory_resource_);
     context.source_file = url.toString();
     context.strict_mode = strict_mode_;
 
-    return parseWithContext(json_content, context);
+    return parseUtf8WithContext(std::move(json_content), context);
 }
 
 QJsonObject JSONParser::parseWithContext(const QString& source,
                                          JSONParsingContext& context) {
+    return parseUtf8WithContext(source.toUtf8(), context);
+}
+
+void JSONParser::parseStream(QIODevice& device, JSONStreamHandler& handler,
+                             const QString& source) {
+    JSONStreamParser stream;
+    stream.setAllowComments(allow_comments_)
+        .setAllowTrailingCommas(allow_trailing_commas_)
+        .setMaxDepth(max_depth_);
+
+    if (!stream.parse(device, handler)) {
+        throw Exceptions::JSONParsingException(
+            source.toStdString(), QString("JSON parse error at offset %1: %2")
+                                      .arg(stream.errorOffset())
+                                      .arg(stream.errorString())
+                                      .toStdString());
+    }
+}
+
+QJsonObject JSONParser::parseUtf8WithContext(QByteArray utf8,
+                                             JSONParsingContext& context) {
     current_context_ = std::make_unique<JSONParsingContext>(std::move(context));
     reference_resolver_ =
         std::make_unique<JSONReferenceResolver>(*current_context_);
 
     try {
-        // **Preprocess JSON if needed**
-        QString processed_source = source;
-        if (allow_comments_ || allow_trailing_commas_) {
-            processed_source = preprocessJson(source);
-        }
-
-        // **Parse the JSON document**
+        // **Parse the JSON document (comments and trailing commas too)**
         QJsonDocument doc =
-            parseJsonDocument(processed_source, current_context_->source_file);
+            parseJsonDocument(utf8, current_context_->source_file);
         current_context_->document = doc;
 
         if (!doc.isObject()) {
@@ -479,6 +512,18 @@ JSONParser& JSONParser::setIncludeResolver(
     return *this;
 }
 
+JSONParser& JSONParser::setCacheManager(
+    std::shared_ptr<Core::CacheManager> cache_manager) {
+    cache_manager_ = std::move(cache_manager);
+    return *this;
+}
+
+JSONParser& JSONParser::setMemoryResource(
+    std::pmr::memory_resource* resource) {
+    memory_resource_ = resource ? resource : std::pmr::get_default_resource();
+    return *this;
+}
+
 template <JSONConvertible T>
 JSONParser& JSONParser::registerTypeParser(const QString& type_name) {
     custom_parsers_[type_name] =
@@ -547,10 +592,23 @@ bool JSONParser::setValueAtPath(QJsonObject& root, const JSONPath& path,
     return JSONUtils::setValue(root, path.toString(), value);
 }
 
-QJsonDocument JSONParser::parseJsonDocument(const QString& source,
+QJsonDocument JSONParser::parseJsonDocument(QByteArray& utf8,
                                             const QString& file_path) {
+    JSONStructuralIndex index;
+    index.build(utf8);
+
+    // Comments that are not allowed are left for fromJson to report
+    if (allow_comments_ || !index.hasComments()) {
+        QJsonDocument doc = index.parse(utf8, allow_trailing_commas_);
+        if (!doc.isNull()) {
+            return doc;
+        }
+    }
+
+    // Invalid input: QJsonDocument produces the diagnostics
+    index.strip(utf8, allow_comments_, allow_trailing_commas_);
     QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(source.toUtf8(), &error);
+    QJsonDocument doc = QJsonDocument::fromJson(utf8, &error);
 
     if (doc.isNull()) {
         throw Exceptions::JSONParsingException(
@@ -762,87 +820,20 @@ bool JSONParser::validateArrayStructure(const QJsonArray& arr,
     return true;  // Simplified for brevity
 }
 
-QString JSONParser::preprocessJson(const QString& json_string) {
-    QString result = json_string;
-
-    if (allow_comments_) {
-        result = removeComments(result);
-    }
-
-    if (allow_trailing_commas_) {
-        result = removeTrailingCommas(result);
-    }
-
-    return result;
-}
-
-QString JSONParser::removeComments(const QString& json_string) {
-    QString result;
-    result.reserve(json_string.length());
-
-    bool in_string = false;
-    bool escaped = false;
-    bool in_line_comment = false;
-    bool in_block_comment = false;
-
-    for (int i = 0; i < json_string.length(); ++i) {
-        QChar ch = json_string[i];
-        QChar next_ch =
-            (i + 1 < json_string.length()) ? json_string[i + 1] : QChar();
-
-        if (in_line_comment) {
-            if (ch == '\n' || ch == '\r') {
-                in_line_comment = false;
-                result.append(ch);
-            }
-            continue;
-        }
-
-        if (in_block_comment) {
-            if (ch == '*' && next_ch == '/') {
-                in_block_comment = false;
-                ++i;  // Skip the '/'
-            }
-            continue;
-        }
-
-        if (!in_string) {
-            if (ch == '/' && next_ch == '/') {
-                in_line_comment = true;
-                ++i;  // Skip the second '/'
-                continue;
-            } else if (ch == '/' && next_ch == '*') {
-                in_block_comment = true;
-                ++i;  // Skip the '*'
-                continue;
-            }
-        }
-
-        if (ch == '"' && !escaped) {
-            in_string = !in_string;
-        }
-
-        escaped = (ch == '\\' && !escaped);
-        result.append(ch);
+void JSONParser::preprocessJson(QByteArray& utf8, bool strip_comments,
+                                bool strip_trailing_commas) {
+    if (!strip_comments && !strip_trailing_commas) {
+        return;
     }
 
-    return result;
-}
-
-QString JSONParser::removeTrailingCommas(const QString& json_string) {
-    // **Simple regex-based trailing comma removal**
-    QString result = json_string;
-
-    // **Remove trailing commas before closing braces and brackets**
-    QRegularExpression trailing_comma_regex(R"(,(\s*[}\]]))");
-    result.replace(trailing_comma_regex, R"(\1)");
-
-    return result;
+    JSONStructuralIndex index;
+    index.build(utf8);
+    index.strip(utf8, strip_comments, strip_trailing_commas);
 }
 
 void JSONParser::setParsingContext(const QString& source,
                                    const QString& file_path) {
-    current_context_ = std::make_unique<JSONParsingContext>();
+    current_context_ = std::make_unique<JSONParsingContext>(memory_resource_);
     current_context_->source_file = file_path.isEmpty() ? source : file_path;
     current_context_->strict_mode = strict_mode_;
 }
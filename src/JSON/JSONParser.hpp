@@ -1,6 +1,7 @@
 // JSON/JSONParser.hpp
 #pragma once
 #include <QFileInfo>
+#include <QIODevice>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -12,11 +13,18 @@
 #include <concepts>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <unordered_map>
 
+namespace DeclarativeUI::Core {
+class CacheManager;
+}
+
 namespace DeclarativeUI::JSON {
 
+class JSONStreamHandler;
+
 /**
  * @file JSONParser.hpp
  * @brief JSON parsing, resolution, validation, and utility declarations used by
@@ -134,16 +142,30 @@ private:
  *  - create a context and pass it into JSONParser/JSONReferenceResolver
  *  - call throwIfErrors() at the end to convert accumulated errors into an
  * exception
+ *
+ * The reference and parser maps allocate from a std::pmr resource, so a
+ * parse can run entirely on a per-operation arena (see
+ * Core::ChunkedArenaResource).
  */
 struct JSONParsingContext {
+    JSONParsingContext() = default;
+
+    /**
+     * @brief Construct a context whose maps allocate from resource.
+     * @param resource Must outlive the context.
+     */
+    explicit JSONParsingContext(std::pmr::memory_resource *resource)
+        : resolved_references(resource), custom_parsers(resource) {}
+
     QString source_file;    ///< Source file path for diagnostic messages.
     JSONPath current_path;  ///< Current location within the JSON document.
     QJsonDocument
         document;  ///< Parsed document (kept for reference resolution).
-    std::unordered_map<QString, QJsonValue>
+    std::pmr::unordered_map<QString, QJsonValue>
         resolved_references;  ///< Cache of resolved references by reference
                               ///< string.
-    std::unordered_map<QString, std::function<QJsonValue(const QJsonValue &)>>
+    std::pmr::unordered_map<QString,
+                            std::function<QJsonValue(const QJsonValue &)>>
         custom_parsers;  ///< Type-specific custom parsers.
 
     // Error/warning accumulation
@@ -321,6 +343,20 @@ public:
     [[nodiscard]] QJsonObject parseWithContext(const QString &source,
                                                JSONParsingContext &context);
 
+    /**
+     * @brief Stream a document from device into handler event by event.
+     * @param device Open, readable device; read in chunks, never whole.
+     * @param handler Receives the events (see JSONStreamParser).
+     * @param source Name used in error messages.
+     * @throw Exceptions::JSONParsingException on a syntax error.
+     *
+     * Honors the comment, trailing-comma and depth settings. References,
+     * includes and custom type parsers need the whole document, so they
+     * are not applied: the handler sees values as written.
+     */
+    void parseStream(QIODevice &device, JSONStreamHandler &handler,
+                     const QString &source = "<stream>");
+
     /**
      * @name Configuration setters
      * Methods return *this to allow fluent configuration.
@@ -342,6 +378,29 @@ public:
     JSONParser &setIncludeResolver(
         std::function<QString(const QString &)> resolver);
 
+    /**
+     * @brief Serve parseFile() from a CacheManager's file-keyed JSON cache.
+     * @param cache_manager Cache consulted before reading a file and filled
+     * after a successful parse; nullptr disables caching.
+     *
+     * With CacheManager::enablePersistentJSONCache() this lets a restarted
+     * process skip parsing unchanged files entirely. Only the top-level
+     * file's identity is tracked, not files pulled in through includes.
+     */
+    JSONParser &setCacheManager(
+        std::shared_ptr<Core::CacheManager> cache_manager);
+
+    /**
+     * @brief Allocate parsing contexts from resource.
+     * @param resource Used by every later parse; nullptr restores the
+     * default resource.
+     *
+     * The last parse's context is kept for getWarnings()/getErrors(), so an
+     * arena behind resource must not be rolled back while the parser is
+     * alive or before another parse replaces that context.
+     */
+    JSONParser &setMemoryResource(std::pmr::memory_resource *resource);
+
     /**
      * @brief Register a parser for a custom convertible type.
      *
@@ -423,6 +482,21 @@ public:
                                              const JSONPath &path,
                                              const QJsonValue &value);
 
+    /**
+     * @brief Utility: turn JSONC (comments, trailing commas) into JSON.
+     * @param utf8 UTF-8 document, rewritten in place.
+     * @param strip_comments Blank out // and block comments.
+     * @param strip_trailing_commas Blank out commas before '}' or ']'.
+     *
+     * Works from a JSONStructuralIndex, so string literals are skipped
+     * and a "//" or ",]" inside a string is left alone. Removed bytes
+     * become spaces (newlines in block comments are kept), so the document
+     * keeps its length and QJsonParseError offsets still point into the
+     * original text.
+     */
+    static void preprocessJson(QByteArray &utf8, bool strip_comments = true,
+                               bool strip_trailing_commas = true);
+
 private:
     // Configuration
     bool strict_mode_ = false;
@@ -436,11 +510,20 @@ private:
     std::unordered_map<QString, std::function<QJsonValue(const QJsonValue &)>>
         custom_parsers_;
 
+    // Parsed file cache (optional)
+    std::shared_ptr<Core::CacheManager> cache_manager_;
+
+    // Allocation source for parsing contexts
+    std::pmr::memory_resource *memory_resource_ =
+        std::pmr::get_default_resource();
+
     // Parsing state (used internally during an active parse)
     std::unique_ptr<JSONParsingContext> current_context_;
 
     // Internal parsing pipeline methods (helpers)
-    QJsonDocument parseJsonDocument(const QString &source,
+    QJsonObject parseUtf8WithContext(QByteArray utf8,
+                                     JSONParsingContext &context);
+    QJsonDocument parseJsonDocument(QByteArray &utf8,
                                     const QString &file_path = "");
     QJsonObject processJsonObject(const QJsonObject &input,
                                   JSONParsingContext &context);
@@ -464,11 +547,6 @@ private:
     bool validateArrayStructure(const QJsonArray &arr,
                                 JSONParsingContext &context);
 
-    // Comment and trailing-comma preprocessing
-    QString preprocessJson(const QString &json_string);
-    QString removeComments(const QString &json_string);
-    QString removeTrailingCommas(const QString &json_string);
-
     // Error context utilities
     void setParsingContext(const QString &source,
                            const QString &file_path = "");
@@ -0,0 +1,570 @@
+#include "JSONStreamParser.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace DeclarativeUI::JSON {
+
+namespace {
+
+bool isNumberByte(char c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' ||
+           c == 'e' || c == 'E';
+}
+
+int hexValue(int c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?; stop is where it failed
+bool isValidNumber(const QByteArray &token, bool &integral, qsizetype &stop) {
+    const char *const begin = token.constData();
+    const char *const end = begin + token.size();
+    const char *p = begin;
+    auto digits = [&p, end]() {
+        const char *start = p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            ++p;
+        }
+        return p > start;
+    };
+    auto result = [&p, begin, &stop](bool valid) {
+        stop = p - begin;
+        return valid;
+    };
+    integral = true;
+    if (p < end && *p == '-') {
+        ++p;
+    }
+    if (p < end && *p == '0') {
+        ++p;
+    } else if (!digits()) {
+        return result(false);
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        integral = false;
+        if (!digits()) {
+            return result(false);
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        integral = false;
+        if (p < end && (*p == '+' || *p == '-')) {
+            ++p;
+        }
+        if (!digits()) {
+            return result(false);
+        }
+    }
+    return result(p == end);
+}
+
+}  // namespace
+
+/**
+ * @brief Recursive-descent reader over a window of the input.
+ *
+ * The window is either the whole in-memory document or the current chunk
+ * of the device; fill() slides it forward. Strings and numbers may span
+ * chunks, so their bytes are gathered in pending_ until they end.
+ */
+class JSONStreamParser::Reader {
+public:
+    Reader(const JSONStreamParser &options, JSONStreamHandler &handler,
+           QIODevice *device, QByteArrayView utf8)
+        : options_(options),
+          handler_(handler),
+          device_(device),
+          base_(utf8.data()),
+          cursor_(utf8.data()),
+          end_(utf8.data() + utf8.size()) {}
+
+    bool parseDocument() {
+        // A UTF-8 byte order mark is allowed, as in FileView::utf8()
+        if (peek() == 0xEF) {
+            ++cursor_;
+            if (next() != 0xBB || next() != 0xBF) {
+                return fail(QStringLiteral("Invalid byte order mark"));
+            }
+        }
+        if (!parseValue(0) || !skipSpace()) {
+            return false;
+        }
+        if (peek() != -1) {
+            return fail(QStringLiteral("Unexpected content after the "
+                                       "document"));
+        }
+        return error_.isEmpty();
+    }
+
+    QString errorString() const { return error_; }
+    qint64 errorOffset() const { return error_offset_; }
+
+private:
+    const JSONStreamParser &options_;
+    JSONStreamHandler &handler_;
+    QIODevice *device_;
+
+    QByteArray chunk_;
+    const char *base_;
+    const char *cursor_;
+    const char *end_;
+    qint64 base_offset_ = 0;  // Input offset of base_
+
+    QString error_;
+    qint64 error_offset_ = 0;
+
+    JSONPath path_;
+    QByteArray pending_;  // Raw bytes of the token being read
+    QString text_;        // Decoded part of a string with escapes
+
+    qint64 offset() const { return base_offset_ + (cursor_ - base_); }
+
+    bool failAt(qint64 offset, const QString &message) {
+        // A read error is reported instead of the truncation it causes
+        if (error_.isEmpty()) {
+            error_ = message;
+            error_offset_ = offset;
+        }
+        return false;
+    }
+
+    bool fail(const QString &message) { return failAt(offset(), message); }
+
+    // Slide the window to the next chunk; false at the end of the input
+    bool fill() {
+        base_offset_ = offset();
+        base_ = cursor_ = end_;
+        if (device_ == nullptr) {
+            return false;
+        }
+        if (chunk_.isEmpty()) {
+            chunk_.resize(options_.chunk_size_);
+        }
+        while (true) {
+            const qint64 n = device_->read(chunk_.data(), chunk_.size());
+            if (n > 0) {
+                base_ = cursor_ = chunk_.constData();
+                end_ = base_ + n;
+                return true;
+            }
+            // Sockets and processes report a closed stream as -1, files
+            // only report failures that way
+            if (n < 0 && !device_->isSequential()) {
+                fail(QStringLiteral("Read error: ") + device_->errorString());
+                device_ = nullptr;
+                return false;
+            }
+            if (n < 0 || !device_->isSequential() ||
+                !device_->waitForReadyRead(options_.read_timeout_)) {
+                device_ = nullptr;
+                return false;
+            }
+        }
+    }
+
+    int peek() {
+        if (cursor_ == end_ && !fill()) {
+            return -1;
+        }
+        return static_cast<quint8>(*cursor_);
+    }
+
+    int next() {
+        const int c = peek();
+        if (c >= 0) {
+            ++cursor_;
+        }
+        return c;
+    }
+
+    // Whitespace and, when allowed, comments
+    bool skipSpace() {
+        while (true) {
+            while (cursor_ < end_ && (*cursor_ == ' ' || *cursor_ == '\n' ||
+                                      *cursor_ == '\r' || *cursor_ == '\t')) {
+                ++cursor_;
+            }
+            const int c = peek();
+            if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                continue;
+            }
+            if (c != '/') {
+                return true;
+            }
+            if (!options_.allow_comments_) {
+                return fail(QStringLiteral("Comments are not allowed"));
+            }
+            const qint64 start = offset();
+            ++cursor_;
+            const int kind = next();
+            if (kind == '/') {
+                // Up to the end of the line, which stays as whitespace
+                while (peek() >= 0) {
+                    const void *newline =
+                        std::memchr(cursor_, '\n', end_ - cursor_);
+                    if (newline != nullptr) {
+                        cursor_ = static_cast<const char *>(newline);
+                        break;
+                    }
+                    cursor_ = end_;
+                }
+            } else if (kind == '*') {
+                bool star = false;
+                while (true) {
+                    const int byte = next();
+                    if (byte < 0) {
+                        return failAt(start,
+                                      QStringLiteral("Unterminated comment"));
+                    }
+                    if (star && byte == '/') {
+                        break;
+                    }
+                    star = byte == '*';
+                }
+            } else {
+                return failAt(start, QStringLiteral("Unexpected '/'"));
+            }
+        }
+    }
+
+    bool parseValue(int depth) {
+        if (!skipSpace()) {
+            return false;
+        }
+        const int c = peek();
+        switch (c) {
+            case '{':
+            case '[':
+                if (depth >= options_.max_depth_) {
+                    return fail(QStringLiteral("Nesting deeper than %1 levels")
+                                    .arg(options_.max_depth_));
+                }
+                return c == '{' ? parseObject(depth + 1)
+                                : parseArray(depth + 1);
+            case '"': {
+                ++cursor_;
+                QString text;
+                if (!readString(text)) {
+                    return false;
+                }
+                handler_.value(QJsonValue(text), path_);
+                return true;
+            }
+            case 't':
+                return parseLiteral("true", QJsonValue(true));
+            case 'f':
+                return parseLiteral("false", QJsonValue(false));
+            case 'n':
+                return parseLiteral("null", QJsonValue(QJsonValue::Null));
+            case -1:
+                return fail(QStringLiteral("Unexpected end of input"));
+            default:
+                if (c == '-' || (c >= '0' && c <= '9')) {
+                    return parseNumber();
+                }
+                return fail(QStringLiteral("Unexpected character"));
+        }
+    }
+
+    bool parseObject(int depth) {
+        ++cursor_;
+        handler_.startObject(path_);
+        if (!skipSpace()) {
+            return false;
+        }
+        if (peek() == '}') {
+            ++cursor_;
+            handler_.endObject(path_);
+            return true;
+        }
+        while (true) {
+            if (peek() != '"') {
+                return fail(QStringLiteral("Expected a string key"));
+            }
+            ++cursor_;
+            QString name;
+            if (!readString(name) || !skipSpace()) {
+                return false;
+            }
+            if (peek() != ':') {
+                return fail(QStringLiteral("Expected ':' after a key"));
+            }
+            ++cursor_;
+
+            // JSONPath does not record empty keys, so only pop what it took
+            const bool named = !name.isEmpty();
+            path_.append(name);
+            handler_.key(name, path_);
+            if (!parseValue(depth)) {
+                return false;
+            }
+            if (named) {
+                path_.parent();
+            }
+
+            if (!skipSpace()) {
+                return false;
+            }
+            const int separator = peek();
+            if (separator == '}') {
+                ++cursor_;
+                break;
+            }
+            if (separator != ',') {
+                return fail(QStringLiteral("Expected ',' or '}'"));
+            }
+            ++cursor_;
+            if (!skipSpace()) {
+                return false;
+            }
+            if (options_.allow_trailing_commas_ && peek() == '}') {
+                ++cursor_;
+                break;
+            }
+        }
+        handler_.endObject(path_);
+        return true;
+    }
+
+    bool parseArray(int depth) {
+        ++cursor_;
+        handler_.startArray(path_);
+        if (!skipSpace()) {
+            return false;
+        }
+        if (peek() == ']') {
+            ++cursor_;
+            handler_.endArray(path_);
+            return true;
+        }
+        for (int index = 0;; ++index) {
+            path_.append(index);
+            if (!parseValue(depth)) {
+                return false;
+            }
+            path_.parent();
+
+            if (!skipSpace()) {
+                return false;
+            }
+            const int separator = peek();
+            if (separator == ']') {
+                ++cursor_;
+                break;
+            }
+            if (separator != ',') {
+                return fail(QStringLiteral("Expected ',' or ']'"));
+            }
+            ++cursor_;
+            if (!skipSpace()) {
+                return false;
+            }
+            if (options_.allow_trailing_commas_ && peek() == ']') {
+                ++cursor_;
+                break;
+            }
+        }
+        handler_.endArray(path_);
+        return true;
+    }
+
+    // Escapes only follow complete UTF-8 sequences, so decode up to here
+    void flushPending() {
+        text_ += QString::fromUtf8(pending_);
+        pending_.clear();
+    }
+
+    // The string whose opening quote was just consumed
+    bool readString(QString &result) {
+        const qint64 start = offset() - 1;
+        pending_.clear();
+        text_.clear();
+        while (true) {
+            if (cursor_ == end_ && !fill()) {
+                return failAt(start, QStringLiteral("Unterminated string"));
+            }
+            const char *const run = cursor_;
+            while (cursor_ < end_ && *cursor_ != '"' && *cursor_ != '\\' &&
+                   static_cast<quint8>(*cursor_) >= 0x20) {
+                ++cursor_;
+            }
+            if (cursor_ == end_) {
+                pending_.append(run, cursor_ - run);
+                continue;
+            }
+
+            if (*cursor_ == '"') {
+                if (pending_.isEmpty() && text_.isEmpty()) {
+                    // The common case: no escapes, within one chunk
+                    result = QString::fromUtf8(run, cursor_ - run);
+                } else {
+                    pending_.append(run, cursor_ - run);
+                    flushPending();
+                    result = text_;
+                }
+                ++cursor_;
+                return true;
+            }
+            if (*cursor_ != '\\') {
+                return fail(QStringLiteral("Control character in string"));
+            }
+
+            pending_.append(run, cursor_ - run);
+            flushPending();
+            ++cursor_;
+            const int escape = next();
+            switch (escape) {
+                case '"':
+                case '\\':
+                case '/':
+                    text_ += QLatin1Char(static_cast<char>(escape));
+                    break;
+                case 'b':
+                    text_ += QLatin1Char('\b');
+                    break;
+                case 'f':
+                    text_ += QLatin1Char('\f');
+                    break;
+                case 'n':
+                    text_ += QLatin1Char('\n');
+                    break;
+                case 'r':
+                    text_ += QLatin1Char('\r');
+                    break;
+                case 't':
+                    text_ += QLatin1Char('\t');
+                    break;
+                case 'u': {
+                    // Surrogate pairs arrive as two escapes of one unit each
+                    char16_t unit = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        const int digit = hexValue(next());
+                        if (digit < 0) {
+                            return failAt(offset() - 1,
+                                          QStringLiteral("Invalid \\u escape"));
+                        }
+                        unit = static_cast<char16_t>(unit << 4 | digit);
+                    }
+                    text_ += QChar(unit);
+                    break;
+                }
+                case -1:
+                    return failAt(start, QStringLiteral("Unterminated string"));
+                default:
+                    return failAt(offset() - 2,
+                                  QStringLiteral("Invalid escape sequence"));
+            }
+        }
+    }
+
+    bool parseNumber() {
+        const qint64 start = offset();
+        pending_.clear();
+        while (peek() >= 0) {
+            const char *const run = cursor_;
+            while (cursor_ < end_ && isNumberByte(*cursor_)) {
+                ++cursor_;
+            }
+            pending_.append(run, cursor_ - run);
+            if (cursor_ < end_) {
+                break;
+            }
+        }
+
+        bool integral = true;
+        qsizetype stop = 0;
+        if (!isValidNumber(pending_, integral, stop)) {
+            return failAt(start + stop, QStringLiteral("Invalid number"));
+        }
+        bool ok = false;
+        if (integral) {
+            const qint64 integer = pending_.toLongLong(&ok);
+            if (ok) {
+                handler_.value(QJsonValue(integer), path_);
+                return true;
+            }
+        }
+        const double real = pending_.toDouble(&ok);
+        if (!ok || !std::isfinite(real)) {
+            return failAt(start, QStringLiteral("Number out of range"));
+        }
+        handler_.value(QJsonValue(real), path_);
+        return true;
+    }
+
+    bool parseLiteral(const char *literal, const QJsonValue &value) {
+        const qint64 start = offset();
+        for (const char *p = literal; *p != '\0'; ++p) {
+            if (next() != *p) {
+                return failAt(start, QStringLiteral("Invalid literal"));
+            }
+        }
+        handler_.value(value, path_);
+        return true;
+    }
+};
+
+// **JSONStreamParser implementation**
+JSONStreamParser &JSONStreamParser::setAllowComments(bool allow) {
+    allow_comments_ = allow;
+    return *this;
+}
+
+JSONStreamParser &JSONStreamParser::setAllowTrailingCommas(bool allow) {
+    allow_trailing_commas_ = allow;
+    return *this;
+}
+
+JSONStreamParser &JSONStreamParser::setMaxDepth(int max_depth) {
+    max_depth_ = std::max(1, max_depth);
+    return *this;
+}
+
+JSONStreamParser &JSONStreamParser::setChunkSize(qint64 chunk_size) {
+    chunk_size_ = std::max<qint64>(1, chunk_size);
+    return *this;
+}
+
+JSONStreamParser &JSONStreamParser::setReadTimeout(int msecs) {
+    read_timeout_ = msecs;
+    return *this;
+}
+
+bool JSONStreamParser::parse(QIODevice &device, JSONStreamHandler &handler) {
+    if (!device.isReadable()) {
+        error_ = QStringLiteral("Device is not open for reading");
+        error_offset_ = 0;
+        return false;
+    }
+    Reader reader(*this, handler, &device, QByteArrayView());
+    return run(reader);
+}
+
+bool JSONStreamParser::parse(QByteArrayView utf8, JSONStreamHandler &handler) {
+    Reader reader(*this, handler, nullptr, utf8);
+    return run(reader);
+}
+
+bool JSONStreamParser::run(Reader &reader) {
+    error_.clear();
+    error_offset_ = 0;
+    const bool ok = reader.parseDocument();
+    error_ = reader.errorString();
+    error_offset_ = reader.errorOffset();
+    return ok;
+}
+
+}  // namespace DeclarativeUI::JSON
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QIODevice>
+#include <QJsonValue>
+#include <QString>
+
+#include "JSONParser.hpp"
+
+namespace DeclarativeUI::JSON {
+
+/**
+ * @file JSONStreamParser.hpp
+ * @brief Event-driven (SAX-style) JSON and JSONC parsing over a QIODevice.
+ *
+ * JSONStreamParser reads a device in fixed-size chunks and reports the
+ * document as a sequence of callbacks on a JSONStreamHandler, never
+ * building a QJsonDocument. It keeps one chunk, the token being read and
+ * one frame per open object or array, so its memory is bounded by the
+ * nesting depth and the longest string rather than the document size.
+ *
+ * - Comments and trailing commas are accepted the same way JSONParser
+ *   accepts them, and can be turned off.
+ * - Every callback receives the JSONPath of the value it describes.
+ * - Handlers abort a parse by throwing; the exception propagates out of
+ *   parse() unchanged.
+ */
+
+/**
+ * @class JSONStreamHandler
+ * @brief Receives the events of a JSONStreamParser run.
+ *
+ * For an object member the parser calls key() with the path already
+ * extended by the key, then reports the member value at that same path.
+ * Array elements are reported at paths ending in their index. Scalars
+ * (strings, numbers, booleans and null) arrive through value().
+ *
+ * The default implementations ignore the event, so handlers override only
+ * what they need.
+ */
+class JSONStreamHandler {
+public:
+    virtual ~JSONStreamHandler() = default;
+
+    virtual void startObject(const JSONPath &path) { Q_UNUSED(path); }
+    virtual void endObject(const JSONPath &path) { Q_UNUSED(path); }
+    virtual void startArray(const JSONPath &path) { Q_UNUSED(path); }
+    virtual void endArray(const JSONPath &path) { Q_UNUSED(path); }
+    virtual void key(const QString &name, const JSONPath &path) {
+        Q_UNUSED(name);
+        Q_UNUSED(path);
+    }
+    virtual void value(const QJsonValue &value, const JSONPath &path) {
+        Q_UNUSED(value);
+        Q_UNUSED(path);
+    }
+};
+
+/**
+ * @class JSONStreamParser
+ * @brief Incremental JSON/JSONC reader that drives a JSONStreamHandler.
+ *
+ * Syntax errors stop the parse: parse() returns false and errorString()
+ * and errorOffset() describe the first problem. Events already delivered
+ * are not retracted, so handlers that build state should discard it when
+ * parse() fails.
+ */
+class JSONStreamParser {
+public:
+    static constexpr qint64 kDefaultChunkSize = 64 * 1024;
+    static constexpr int kDefaultMaxDepth = 1024;
+    static constexpr int kDefaultReadTimeout = 30000;
+
+    JSONStreamParser &setAllowComments(bool allow);
+    JSONStreamParser &setAllowTrailingCommas(bool allow);
+
+    /**
+     * @brief Limit how many objects and arrays may be open at once.
+     */
+    JSONStreamParser &setMaxDepth(int max_depth);
+
+    /**
+     * @brief Bytes requested from the device per read.
+     */
+    JSONStreamParser &setChunkSize(qint64 chunk_size);
+
+    /**
+     * @brief Milliseconds to wait for a sequential device to produce more
+     * data before treating it as ended.
+     */
+    JSONStreamParser &setReadTimeout(int msecs);
+
+    [[nodiscard]] bool allowComments() const { return allow_comments_; }
+    [[nodiscard]] bool allowTrailingCommas() const {
+        return allow_trailing_commas_;
+    }
+    [[nodiscard]] int maxDepth() const { return max_depth_; }
+    [[nodiscard]] qint64 chunkSize() const { return chunk_size_; }
+    [[nodiscard]] int readTimeout() const { return read_timeout_; }
+
+    /**
+     * @brief Parse one document from device, reading until it ends.
+     * @param device An open, readable device. Sequential devices are
+     * waited on for more data, up to readTimeout() per read.
+     * @return true if the device held exactly one valid document.
+     */
+    bool parse(QIODevice &device, JSONStreamHandler &handler);
+
+    /**
+     * @brief Parse an in-memory document without copying it.
+     */
+    bool parse(QByteArrayView utf8, JSONStreamHandler &handler);
+
+    /**
+     * @brief Description of the last failure, empty after a success.
+     */
+    [[nodiscard]] QString errorString() const { return error_; }
+
+    /**
+     * @brief Byte offset of the last failure from the start of the input.
+     */
+    [[nodiscard]] qint64 errorOffset() const { return error_offset_; }
+
+private:
+    class Reader;
+
+    bool allow_comments_ = true;
+    bool allow_trailing_commas_ = true;
+    int max_depth_ = kDefaultMaxDepth;
+    qint64 chunk_size_ = kDefaultChunkSize;
+    int read_timeout_ = kDefaultReadTimeout;
+
+    QString error_;
+    qint64 error_offset_ = 0;
+
+    bool run(Reader &reader);
+};
+
+}  // namespace DeclarativeUI::JSON
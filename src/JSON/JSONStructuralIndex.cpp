@@ -0,0 +1,799 @@
+#include "JSONStructuralIndex.hpp"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define DECLARATIVE_UI_JSON_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define DECLARATIVE_UI_JSON_TARGET(isa)
+#else
+#define DECLARATIVE_UI_JSON_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace DeclarativeUI::JSON {
+
+namespace {
+
+constexpr qsizetype kBlockSize = 64;
+constexpr int kMaxNesting = 1024;  // As QJsonDocument::fromJson
+
+enum ByteClass : quint8 {
+    kQuote = 1,
+    kBackslash = 2,
+    kSlash = 4,
+    kOperator = 8,
+    kWhitespace = 16,
+};
+
+constexpr std::array<quint8, 256> makeClassTable() {
+    std::array<quint8, 256> table{};
+    table['"'] = kQuote;
+    table['\\'] = kBackslash;
+    table['/'] = kSlash;
+    for (unsigned char c : {'{', '}', '[', ']', ':', ','}) {
+        table[c] = kOperator;
+    }
+    for (unsigned char c : {' ', '\t', '\n', '\r'}) {
+        table[c] = kWhitespace;
+    }
+    return table;
+}
+
+constexpr std::array<quint8, 256> kClassTable = makeClassTable();
+
+quint8 classOf(char c) { return kClassTable[static_cast<quint8>(c)]; }
+
+// Raw byte classes of one block; bit i describes byte i
+struct BlockMasks {
+    quint64 quote = 0;
+    quint64 backslash = 0;
+    quint64 slash = 0;
+    quint64 op = 0;
+    quint64 whitespace = 0;
+};
+
+using Classifier = void (*)(const char*, BlockMasks&);
+
+void classifyScalar(const char* block, BlockMasks& masks) {
+    for (int i = 0; i < kBlockSize; ++i) {
+        const quint64 cls = classOf(block[i]);
+        masks.quote |= (cls & 1) << i;
+        masks.backslash |= ((cls >> 1) & 1) << i;
+        masks.slash |= ((cls >> 2) & 1) << i;
+        masks.op |= ((cls >> 3) & 1) << i;
+        masks.whitespace |= ((cls >> 4) & 1) << i;
+    }
+}
+
+#ifdef DECLARATIVE_UI_JSON_X86
+DECLARATIVE_UI_JSON_TARGET("sse4.2")
+quint64 equalMask128(__m128i bytes, char c) {
+    return static_cast<quint16>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(c))));
+}
+
+// PCMPESTRM matches each byte against a whole character set
+DECLARATIVE_UI_JSON_TARGET("sse4.2")
+void classifySse42(const char* block, BlockMasks& masks) {
+    const __m128i operators =
+        _mm_setr_epi8('{', '}', '[', ']', ':', ',', 0, 0, 0, 0, 0, 0, 0, 0,
+                      0, 0);
+    const __m128i whitespace = _mm_setr_epi8(' ', '\t', '\n', '\r', 0, 0, 0,
+                                             0, 0, 0, 0, 0, 0, 0, 0, 0);
+    constexpr int kAnyByte =
+        _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+    for (int chunk = 0; chunk < 4; ++chunk) {
+        const __m128i bytes = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(block + 16 * chunk));
+        const int shift = 16 * chunk;
+        masks.quote |= equalMask128(bytes, '"') << shift;
+        masks.backslash |= equalMask128(bytes, '\\') << shift;
+        masks.slash |= equalMask128(bytes, '/') << shift;
+        masks.op |= static_cast<quint64>(static_cast<quint16>(
+                        _mm_cvtsi128_si32(_mm_cmpestrm(operators, 6, bytes,
+                                                       16, kAnyByte))))
+                    << shift;
+        masks.whitespace |=
+            static_cast<quint64>(static_cast<quint16>(_mm_cvtsi128_si32(
+                _mm_cmpestrm(whitespace, 4, bytes, 16, kAnyByte))))
+            << shift;
+    }
+}
+
+DECLARATIVE_UI_JSON_TARGET("avx2")
+__m256i equalBytes256(__m256i bytes, char c) {
+    return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c));
+}
+
+DECLARATIVE_UI_JSON_TARGET("avx2")
+quint64 bitMask256(__m256i matches) {
+    return static_cast<quint32>(_mm256_movemask_epi8(matches));
+}
+
+DECLARATIVE_UI_JSON_TARGET("avx2")
+void classifyAvx2(const char* block, BlockMasks& masks) {
+    for (int half = 0; half < 2; ++half) {
+        const __m256i bytes = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(block + 32 * half));
+        const int shift = 32 * half;
+        masks.quote |= bitMask256(equalBytes256(bytes, '"')) << shift;
+        masks.backslash |= bitMask256(equalBytes256(bytes, '\\')) << shift;
+        masks.slash |= bitMask256(equalBytes256(bytes, '/')) << shift;
+
+        const __m256i braces = _mm256_or_si256(equalBytes256(bytes, '{'),
+                                               equalBytes256(bytes, '}'));
+        const __m256i brackets = _mm256_or_si256(equalBytes256(bytes, '['),
+                                                 equalBytes256(bytes, ']'));
+        const __m256i separators = _mm256_or_si256(
+            equalBytes256(bytes, ':'), equalBytes256(bytes, ','));
+        masks.op |= bitMask256(_mm256_or_si256(
+                        _mm256_or_si256(braces, brackets), separators))
+                    << shift;
+
+        const __m256i blanks = _mm256_or_si256(equalBytes256(bytes, ' '),
+                                               equalBytes256(bytes, '\t'));
+        const __m256i newlines = _mm256_or_si256(equalBytes256(bytes, '\n'),
+                                                 equalBytes256(bytes, '\r'));
+        masks.whitespace |= bitMask256(_mm256_or_si256(blanks, newlines))
+                            << shift;
+    }
+}
+
+struct CpuFeatures {
+    bool sse42 = false;
+    bool avx2 = false;
+};
+
+CpuFeatures detectCpuFeatures() {
+    CpuFeatures features;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    features.sse42 = (info[2] & (1 << 20)) != 0;
+    const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 &&
+                              (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    features.avx2 = os_saves_ymm && (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    features.sse42 = __builtin_cpu_supports("sse4.2");
+    features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+    return features;
+}
+
+const CpuFeatures& cpuFeatures() {
+    static const CpuFeatures features = detectCpuFeatures();
+    return features;
+}
+#endif
+
+Classifier classifierFor(JSONStructuralIndex::Backend backend) {
+#ifdef DECLARATIVE_UI_JSON_X86
+    if (JSONStructuralIndex::isSupported(backend)) {
+        switch (backend) {
+            case JSONStructuralIndex::Backend::AVX2:
+                return classifyAvx2;
+            case JSONStructuralIndex::Backend::SSE42:
+                return classifySse42;
+            case JSONStructuralIndex::Backend::Scalar:
+                break;
+        }
+    }
+#else
+    Q_UNUSED(backend);
+#endif
+    return classifyScalar;
+}
+
+// Bits of backslash-escaped bytes (simdjson's branchless odd-run trick)
+quint64 findEscaped(quint64 backslash, quint64& prev_escaped) {
+    constexpr quint64 kEvenBits = 0x5555555555555555ULL;
+    backslash &= ~prev_escaped;
+    const quint64 follows_escape = backslash << 1 | prev_escaped;
+    const quint64 odd_sequence_starts =
+        backslash & ~kEvenBits & ~follows_escape;
+    const quint64 sequences_starting_on_even_bits =
+        odd_sequence_starts + backslash;
+    prev_escaped = sequences_starting_on_even_bits < odd_sequence_starts;
+    const quint64 invert_mask = sequences_starting_on_even_bits << 1;
+    return (kEvenBits ^ invert_mask) & follows_escape;
+}
+
+// Bit i becomes the XOR of bits 0..i
+quint64 prefixXor(quint64 bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// Per-block scanning state carried across block boundaries
+struct Scanner {
+    enum class Mode { Normal, LineComment, BlockComment };
+
+    const char* data;
+    qsizetype size;
+    quint64 prev_escaped = 0;    // Byte 0 of the next block is escaped
+    quint64 prev_in_string = 0;  // All ones while inside a string
+    quint64 prev_scalar = 0;     // The last byte belonged to a scalar
+    Mode mode = Mode::Normal;
+    qsizetype comment_start = 0;
+
+    // Strings and comments of a block with comments, byte by byte
+    void scanSlowly(qsizetype base, quint64& in_string, quint64& quote,
+                    quint64& comment) {
+        bool inside = prev_in_string != 0;
+        bool escaped = prev_escaped != 0;
+        const qsizetype end = std::min(base + kBlockSize, size);
+        for (qsizetype pos = base; pos < end; ++pos) {
+            const quint64 bit = quint64(1) << (pos - base);
+            const char c = data[pos];
+            if (mode == Mode::LineComment) {
+                if (c == '\n' || c == '\r') {
+                    mode = Mode::Normal;
+                } else {
+                    comment |= bit;
+                }
+            } else if (mode == Mode::BlockComment) {
+                comment |= bit;
+                if (c == '/' && pos >= comment_start + 3 &&
+                    data[pos - 1] == '*') {
+                    mode = Mode::Normal;
+                }
+            } else if (inside) {
+                if (escaped) {
+                    escaped = false;
+                    in_string |= bit;
+                } else if (c == '\\') {
+                    escaped = true;
+                    in_string |= bit;
+                } else if (c == '"') {
+                    inside = false;
+                    quote |= bit;
+                } else {
+                    in_string |= bit;
+                }
+            } else if (c == '"') {
+                inside = true;
+                quote |= bit;
+                in_string |= bit;
+            } else if (c == '/' && pos + 1 < size &&
+                       (data[pos + 1] == '/' || data[pos + 1] == '*')) {
+                mode = data[pos + 1] == '/' ? Mode::LineComment
+                                            : Mode::BlockComment;
+                comment_start = pos;
+                comment |= bit;
+            }
+        }
+        prev_in_string = inside ? ~quint64(0) : 0;
+        prev_escaped = escaped ? 1 : 0;
+    }
+};
+
+// **Stage 2: QJsonDocument from the structural positions**
+class DomBuilder {
+public:
+    DomBuilder(QByteArrayView utf8, const std::vector<quint32>& positions,
+               bool allow_trailing_commas)
+        : data_(utf8.data()),
+          size_(utf8.size()),
+          positions_(positions),
+          allow_trailing_commas_(allow_trailing_commas) {}
+
+    QJsonDocument build() {
+        if (positions_.empty()) {
+            return fail(0);
+        }
+        const char first = data_[positions_[0]];
+        if (first != '{' && first != '[') {
+            return fail(positions_[0]);
+        }
+        QJsonValue root;
+        if (!parseValue(root, 0)) {
+            return QJsonDocument();
+        }
+        if (next_ != positions_.size()) {
+            return fail(positions_[next_]);
+        }
+        return root.isObject() ? QJsonDocument(root.toObject())
+                               : QJsonDocument(root.toArray());
+    }
+
+    qsizetype errorOffset() const { return error_offset_; }
+
+private:
+    const char* data_;
+    qsizetype size_;
+    const std::vector<quint32>& positions_;
+    bool allow_trailing_commas_;
+    size_t next_ = 0;
+    qsizetype error_offset_ = 0;
+
+    QJsonDocument fail(qsizetype offset) {
+        error_offset_ = offset;
+        return QJsonDocument();
+    }
+
+    bool failAt(qsizetype offset) {
+        error_offset_ = offset;
+        return false;
+    }
+
+    // The character at the next structural position, or 0 at the end
+    char peek() const {
+        return next_ < positions_.size() ? data_[positions_[next_]] : '\0';
+    }
+
+    qsizetype offset() const {
+        return next_ < positions_.size() ? positions_[next_] : size_;
+    }
+
+    bool parseValue(QJsonValue& value, int depth) {
+        if (next_ >= positions_.size()) {
+            return failAt(size_);
+        }
+        const qsizetype pos = positions_[next_++];
+        switch (data_[pos]) {
+            case '{':
+                return depth < kMaxNesting ? parseObject(value, depth + 1)
+                                           : failAt(pos);
+            case '[':
+                return depth < kMaxNesting ? parseArray(value, depth + 1)
+                                           : failAt(pos);
+            case '"': {
+                QString text;
+                if (!parseString(pos, text)) {
+                    return false;
+                }
+                value = QJsonValue(text);
+                return true;
+            }
+            default:
+                return parseScalar(pos, value);
+        }
+    }
+
+    bool parseObject(QJsonValue& value, int depth) {
+        QJsonObject object;
+        if (peek() == '}') {
+            ++next_;
+            value = object;
+            return true;
+        }
+        while (true) {
+            if (peek() != '"') {
+                return failAt(offset());
+            }
+            QString key;
+            if (!parseString(positions_[next_++], key)) {
+                return false;
+            }
+            if (peek() != ':') {
+                return failAt(offset());
+            }
+            ++next_;
+            QJsonValue member;
+            if (!parseValue(member, depth)) {
+                return false;
+            }
+            object.insert(key, member);
+
+            const char separator = peek();
+            ++next_;
+            if (separator == '}') {
+                break;
+            }
+            if (separator != ',') {
+                --next_;
+                return failAt(offset());
+            }
+            if (allow_trailing_commas_ && peek() == '}') {
+                ++next_;
+                break;
+            }
+        }
+        value = object;
+        return true;
+    }
+
+    bool parseArray(QJsonValue& value, int depth) {
+        QJsonArray array;
+        if (peek() == ']') {
+            ++next_;
+            value = array;
+            return true;
+        }
+        while (true) {
+            QJsonValue element;
+            if (!parseValue(element, depth)) {
+                return false;
+            }
+            array.append(element);
+
+            const char separator = peek();
+            ++next_;
+            if (separator == ']') {
+                break;
+            }
+            if (separator != ',') {
+                --next_;
+                return failAt(offset());
+            }
+            if (allow_trailing_commas_ && peek() == ']') {
+                ++next_;
+                break;
+            }
+        }
+        value = array;
+        return true;
+    }
+
+    static int hexValue(char c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    // The literal whose opening quote is at pos
+    bool parseString(qsizetype pos, QString& text) {
+        const char* const begin = data_ + pos + 1;
+        const char* const end = data_ + size_;
+        const char* cursor = begin;
+        bool has_escapes = false;
+        while (cursor < end && *cursor != '"') {
+            if (*cursor == '\\') {
+                if (end - cursor < 2) {
+                    return failAt(pos);
+                }
+                has_escapes = true;
+                cursor += 2;
+            } else if (static_cast<quint8>(*cursor) < 0x20) {
+                return failAt(cursor - data_);
+            } else {
+                ++cursor;
+            }
+        }
+        if (cursor >= end) {
+            return failAt(pos);
+        }
+        if (!has_escapes) {
+            text = QString::fromUtf8(begin, cursor - begin);
+            return true;
+        }
+
+        text.reserve(cursor - begin);
+        const char* run = begin;
+        for (const char* p = begin; p < cursor;) {
+            if (*p != '\\') {
+                ++p;
+                continue;
+            }
+            text += QString::fromUtf8(run, p - run);
+            const char escape = p[1];
+            p += 2;
+            switch (escape) {
+                case '"':
+                case '\\':
+                case '/':
+                    text += QLatin1Char(escape);
+                    break;
+                case 'b':
+                    text += QLatin1Char('\b');
+                    break;
+                case 'f':
+                    text += QLatin1Char('\f');
+                    break;
+                case 'n':
+                    text += QLatin1Char('\n');
+                    break;
+                case 'r':
+                    text += QLatin1Char('\r');
+                    break;
+                case 't':
+                    text += QLatin1Char('\t');
+                    break;
+                case 'u': {
+                    if (cursor - p < 4) {
+                        return failAt(p - data_);
+                    }
+                    char16_t unit = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        const int digit = hexValue(p[i]);
+                        if (digit < 0) {
+                            return failAt(p + i - data_);
+                        }
+                        unit = static_cast<char16_t>(unit << 4 | digit);
+                    }
+                    text += QChar(unit);
+                    p += 4;
+                    break;
+                }
+                default:
+                    return failAt(p - 1 - data_);
+            }
+            run = p;
+        }
+        text += QString::fromUtf8(run, cursor - run);
+        return true;
+    }
+
+    // A number or literal starting at pos
+    bool parseScalar(qsizetype pos, QJsonValue& value) {
+        qsizetype end = pos;
+        while (end < size_ && classOf(data_[end]) == 0) {
+            ++end;
+        }
+        const char* const begin = data_ + pos;
+        const qsizetype length = end - pos;
+        const std::string_view token(begin, static_cast<size_t>(length));
+        if (token == "true") {
+            value = QJsonValue(true);
+            return true;
+        }
+        if (token == "false") {
+            value = QJsonValue(false);
+            return true;
+        }
+        if (token == "null") {
+            value = QJsonValue(QJsonValue::Null);
+            return true;
+        }
+
+        // -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+        const char* p = begin;
+        const char* const stop = begin + length;
+        auto digits = [&p, stop]() {
+            const char* start = p;
+            while (p < stop && *p >= '0' && *p <= '9') {
+                ++p;
+            }
+            return p > start;
+        };
+        if (p < stop && *p == '-') {
+            ++p;
+        }
+        if (p < stop && *p == '0') {
+            ++p;
+        } else if (!digits()) {
+            return failAt(pos);
+        }
+        bool integral = true;
+        if (p < stop && *p == '.') {
+            ++p;
+            integral = false;
+            if (!digits()) {
+                return failAt(p - data_);
+            }
+        }
+        if (p < stop && (*p == 'e' || *p == 'E')) {
+            ++p;
+            integral = false;
+            if (p < stop && (*p == '+' || *p == '-')) {
+                ++p;
+            }
+            if (!digits()) {
+                return failAt(p - data_);
+            }
+        }
+        if (p != stop) {
+            return failAt(p - data_);
+        }
+
+        const QByteArray number = QByteArray::fromRawData(begin, length);
+        bool ok = false;
+        if (integral) {
+            const qint64 integer = number.toLongLong(&ok);
+            if (ok) {
+                value = QJsonValue(integer);
+                return true;
+            }
+        }
+        const double real = number.toDouble(&ok);
+        if (!ok || !std::isfinite(real)) {
+            return failAt(pos);
+        }
+        value = QJsonValue(real);
+        return true;
+    }
+};
+
+}  // namespace
+
+// **JSONStructuralIndex Implementation**
+
+JSONStructuralIndex::Backend JSONStructuralIndex::bestBackend() {
+    if (isSupported(Backend::AVX2)) {
+        return Backend::AVX2;
+    }
+    if (isSupported(Backend::SSE42)) {
+        return Backend::SSE42;
+    }
+    return Backend::Scalar;
+}
+
+bool JSONStructuralIndex::isSupported(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar:
+            return true;
+#ifdef DECLARATIVE_UI_JSON_X86
+        case Backend::SSE42:
+            return cpuFeatures().sse42;
+        case Backend::AVX2:
+            return cpuFeatures().avx2;
+#else
+        default:
+            return false;
+#endif
+    }
+    return false;
+}
+
+const char* JSONStructuralIndex::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar:
+            return "scalar";
+        case Backend::SSE42:
+            return "SSE4.2";
+        case Backend::AVX2:
+            return "AVX2";
+    }
+    return "unknown";
+}
+
+bool JSONStructuralIndex::build(QByteArrayView utf8, Backend backend) {
+    positions_.clear();
+    comment_blocks_.clear();
+    complete_ = true;
+
+    const qsizetype size = utf8.size();
+    if (size > static_cast<qsizetype>(std::numeric_limits<quint32>::max())) {
+        complete_ = false;
+        return false;
+    }
+    // Typical documents have a structural every 4-10 bytes
+    positions_.resize(static_cast<size_t>(size / 8 + kBlockSize));
+    size_t count = 0;
+
+    const Classifier classify = classifierFor(backend);
+    Scanner scanner{utf8.data(), size};
+    char padded[kBlockSize];
+
+    for (qsizetype base = 0; base < size; base += kBlockSize) {
+        const char* block = utf8.data() + base;
+        if (size - base < kBlockSize) {
+            // Spaces are inert, so padding adds no structurals
+            std::memset(padded, ' ', sizeof(padded));
+            std::memcpy(padded, block, static_cast<size_t>(size - base));
+            block = padded;
+        }
+
+        BlockMasks masks;
+        classify(block, masks);
+
+        quint64 in_string = 0;
+        quint64 quote = 0;
+        quint64 comment = 0;
+        bool fast = scanner.mode == Scanner::Mode::Normal;
+        if (fast) {
+            const quint64 saved_escaped = scanner.prev_escaped;
+            const quint64 escaped =
+                findEscaped(masks.backslash, scanner.prev_escaped);
+            quote = masks.quote & ~escaped;
+            in_string = prefixXor(quote) ^ scanner.prev_in_string;
+            if (masks.slash & ~in_string) {
+                // Possibly a comment: redo the block byte by byte
+                scanner.prev_escaped = saved_escaped;
+                fast = false;
+            } else {
+                scanner.prev_in_string =
+                    static_cast<quint64>(static_cast<qint64>(in_string) >> 63);
+            }
+        }
+        if (!fast) {
+            in_string = 0;
+            quote = 0;
+            scanner.scanSlowly(base, in_string, quote, comment);
+            if (comment) {
+                comment_blocks_.emplace_back(
+                    static_cast<quint32>(base / kBlockSize), comment);
+            }
+        }
+
+        // Comments act as whitespace; whatever else is left is scalar text
+        const quint64 op = masks.op & ~in_string & ~comment;
+        const quint64 outside = ~(in_string | quote | comment);
+        const quint64 scalar = outside & ~op & ~masks.whitespace;
+        const quint64 scalar_starts =
+            scalar & ~(scalar << 1 | scanner.prev_scalar);
+        scanner.prev_scalar = scalar >> 63;
+        quint64 structurals = op | (quote & in_string) | scalar_starts;
+
+        // Grow in large steps; a block adds at most kBlockSize entries
+        constexpr size_t kBlockEntries = kBlockSize;
+        if (positions_.size() < count + kBlockEntries) {
+            positions_.resize(
+                std::max(positions_.size() * 2, count + 16 * kBlockEntries));
+        }
+        quint32* out = positions_.data() + count;
+        count += std::popcount(structurals);
+        while (structurals) {
+            *out++ = static_cast<quint32>(base + std::countr_zero(structurals));
+            structurals &= structurals - 1;
+        }
+    }
+    positions_.resize(count);
+
+    complete_ = scanner.prev_in_string == 0 &&
+                scanner.mode != Scanner::Mode::BlockComment;
+    return complete_;
+}
+
+void JSONStructuralIndex::strip(QByteArray& utf8, bool comments,
+                                bool trailing_commas) const {
+    char* const data = utf8.data();
+    if (comments) {
+        for (const auto& [block, mask] : comment_blocks_) {
+            char* const base =
+                data + static_cast<qsizetype>(block) * kBlockSize;
+            for (quint64 bits = mask; bits; bits &= bits - 1) {
+                char& c = base[std::countr_zero(bits)];
+                if (c != '\n' && c != '\r') {
+                    c = ' ';
+                }
+            }
+        }
+    }
+    if (trailing_commas) {
+        for (size_t i = 0; i + 1 < positions_.size(); ++i) {
+            const char next = data[positions_[i + 1]];
+            if (data[positions_[i]] == ',' && (next == '}' || next == ']')) {
+                data[positions_[i]] = ' ';
+            }
+        }
+    }
+}
+
+QJsonDocument JSONStructuralIndex::parse(QByteArrayView utf8,
+                                         bool allow_trailing_commas,
+                                         qsizetype* error_offset) const {
+    if (!complete_) {
+        if (error_offset) {
+            *error_offset = utf8.size();
+        }
+        return QJsonDocument();
+    }
+    DomBuilder builder(utf8, positions_, allow_trailing_commas);
+    QJsonDocument document = builder.build();
+    if (document.isNull() && error_offset) {
+        *error_offset = builder.errorOffset();
+    }
+    return document;
+}
+
+}  // namespace DeclarativeUI::JSON
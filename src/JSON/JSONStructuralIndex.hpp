@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QJsonDocument>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace DeclarativeUI::JSON {
+
+/**
+ * @file JSONStructuralIndex.hpp
+ * @brief SIMD stage-1 indexer for JSON and JSONC documents.
+ *
+ * Following simdjson, a document is scanned in 64-byte blocks and every
+ * block is reduced to bitmasks (bit i describes byte i): quotes,
+ * backslashes, slashes, structural characters and whitespace. Bit tricks
+ * then resolve escapes, string interiors and where each scalar starts,
+ * without a branch per byte. The result is the ordered list of structural
+ * positions: { } [ ] : , outside strings, opening quotes and the first byte
+ * of every number or literal.
+ *
+ * - Byte classification uses AVX2 or SSE4.2 when the CPU has them, chosen
+ *   at run time, and a table-driven scalar loop otherwise.
+ * - Comments cannot be found with the string mask alone, since a quote in a
+ *   comment does not open a string. A block with a slash outside strings,
+ *   or one that starts inside a comment, is rescanned byte by byte; UI
+ *   files have few comments, so nearly all blocks stay on the fast path.
+ *
+ * On top of the index, strip() turns JSONC into JSON in place and parse()
+ * builds a QJsonDocument by walking the structural positions, skipping
+ * comments and trailing commas without rewriting the text.
+ */
+class JSONStructuralIndex {
+public:
+    enum class Backend { Scalar, SSE42, AVX2 };
+
+    /**
+     * @brief The fastest backend this CPU supports.
+     */
+    static Backend bestBackend();
+    static bool isSupported(Backend backend);
+    static const char *backendName(Backend backend);
+
+    /**
+     * @brief Index utf8; an unsupported backend falls back to Scalar.
+     * @return isComplete().
+     *
+     * An unterminated string or block comment runs to the end of the
+     * document, matching how strip() treats it.
+     */
+    bool build(QByteArrayView utf8, Backend backend = bestBackend());
+
+    /**
+     * @brief Whether every string and block comment was closed.
+     */
+    bool isComplete() const { return complete_; }
+    bool hasComments() const { return !comment_blocks_.empty(); }
+
+    /**
+     * @brief Structural byte offsets, in document order.
+     */
+    const std::vector<quint32> &positions() const { return positions_; }
+
+    /**
+     * @brief Blank out comments and/or trailing commas in the indexed text.
+     *
+     * utf8 must hold the bytes the index was built from. Removed bytes
+     * become spaces and newlines inside block comments are kept, so
+     * offsets stay valid.
+     */
+    void strip(QByteArray &utf8, bool comments,
+               bool trailing_commas) const;
+
+    /**
+     * @brief Build a document from the indexed text.
+     * @param utf8 The bytes the index was built from.
+     * @param allow_trailing_commas Accept a comma before '}' or ']'.
+     * @param error_offset Set to the failing offset on error, if given.
+     * @return The document, or a null document if utf8 is not valid JSON
+     * with comments. Invalid UTF-8 in strings is replaced, not rejected.
+     */
+    QJsonDocument parse(QByteArrayView utf8, bool allow_trailing_commas,
+                        qsizetype *error_offset = nullptr) const;
+
+private:
+    std::vector<quint32> positions_;
+    // Comment bytes of the (rare) blocks that have any: block, mask
+    std::vector<std::pair<quint32, quint64>> comment_blocks_;
+    bool complete_ = true;
+};
+
+}  // namespace DeclarativeUI::JSON
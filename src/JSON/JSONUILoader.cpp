@@ -1,5 +1,6 @@
 #include "JSONUILoader.hpp"
 #include "ComponentRegistry.hpp"
+#include "JSONStreamParser.hpp"
 
 #include <QColor>
 #include <QFile>
@@ -9,6 +10,8 @@
 #include <QHBoxLayout>
 #include <QJsonParseError>
 #include <QLayout>
+#include <QMargins>
+#include <QMetaEnum>
 #include <QMetaObject>
 #include <QMetaProperty>
 #include <QPushButton>
@@ -20,6 +23,87 @@
 
 namespace DeclarativeUI::JSON {
 
+namespace {
+
+struct LayoutSpec {
+    QString type;
+    std::optional<int> spacing;
+    std::optional<QMargins> margins;
+};
+
+LayoutSpec layoutSpec(const QJsonObject &layout_config) {
+    LayoutSpec spec{layout_config["type"].toString(), {}, {}};
+    if (layout_config.contains("spacing")) {
+        spec.spacing = layout_config["spacing"].toInt();
+    }
+    if (layout_config.contains("margins")) {
+        QJsonArray margins = layout_config["margins"].toArray();
+        if (margins.size() == 4) {
+            spec.margins = QMargins(margins[0].toInt(), margins[1].toInt(),
+                                    margins[2].toInt(), margins[3].toInt());
+        }
+    }
+    return spec;
+}
+
+void installLayout(QWidget *parent, const LayoutSpec &spec) {
+    QLayout *layout = nullptr;
+
+    // **Create layout based on type**
+    if (spec.type == "VBoxLayout") {
+        layout = new QVBoxLayout();
+    } else if (spec.type == "HBoxLayout") {
+        layout = new QHBoxLayout();
+    } else if (spec.type == "GridLayout") {
+        layout = new QGridLayout();
+    } else if (spec.type == "FormLayout") {
+        layout = new QFormLayout();
+    } else {
+        qWarning() << "Unknown layout type:" << spec.type;
+        return;
+    }
+
+    // **Apply layout properties**
+    if (spec.spacing) {
+        layout->setSpacing(*spec.spacing);
+    }
+    if (spec.margins) {
+        layout->setContentsMargins(*spec.margins);
+    }
+
+    parent->setLayout(layout);
+}
+
+// The value QMetaProperty::write() would end up writing, so that an image
+// needs no conversion at load time. Enums are kept as int, which write()
+// accepts and QDataStream can store.
+QVariant toPropertyType(const QMetaProperty &property, QVariant value) {
+    if (!value.isValid()) {
+        return value;
+    }
+    if (property.isEnumType()) {
+        if (value.typeId() == QMetaType::QString) {
+            bool ok = false;
+            const int key_value = property.enumerator().keysToValue(
+                value.toString().toUtf8().constData(), &ok);
+            return ok ? QVariant(key_value) : value;
+        }
+        QVariant number = value;
+        return number.convert(QMetaType::fromType<int>()) ? number : value;
+    }
+
+    const QMetaType target = property.metaType();
+    if (value.metaType() == target ||
+        !target.hasRegisteredDataStreamOperators() ||
+        !QMetaType::canConvert(value.metaType(), target)) {
+        return value;
+    }
+    QVariant converted = value;
+    return converted.convert(target) ? converted : value;
+}
+
+}  // namespace
+
 JSONUILoader::JSONUILoader(QObject *parent) : QObject(parent) {
     // **Register default property converters**
     property_converters_["color"] = [](const QJsonValue &value) {
@@ -130,6 +214,224 @@ std::unique_ptr<QWidget> JSONUILoader::loadFromString(
     }
 }
 
+// **Streaming construction**
+
+/**
+ * @brief Builds the widget tree from JSONStreamParser events.
+ *
+ * A widget object is collected member by member and the widget is created
+ * when its object ends, so members may come in any order (QJsonDocument
+ * writes them sorted, "children" before "layout" and "type"). Each child is
+ * built the same way and held, already constructed, until its parent ends
+ * and can take it; only widgets and small member values such as properties
+ * and layout are kept, never the JSON of a finished subtree.
+ */
+class JSONUILoader::StreamBuilder : public JSONStreamHandler {
+public:
+    explicit StreamBuilder(JSONUILoader &loader) : loader_(loader) {}
+
+    std::unique_ptr<QWidget> takeRoot() { return std::move(root_); }
+
+    void startObject(const JSONPath &) override {
+        if (skip_depth_ > 0) {
+            ++skip_depth_;
+        } else if (!values_.empty() ||
+                   (!widgets_.empty() && !widgets_.back().in_children)) {
+            values_.emplace_back(true);
+        } else {
+            widgets_.emplace_back();
+        }
+    }
+
+    void endObject(const JSONPath &) override {
+        if (skip_depth_ > 0) {
+            --skip_depth_;
+        } else if (!values_.empty()) {
+            endValue();
+        } else {
+            endWidget();
+        }
+    }
+
+    void startArray(const JSONPath &) override {
+        if (skip_depth_ > 0) {
+            ++skip_depth_;
+            return;
+        }
+        if (!values_.empty()) {
+            values_.emplace_back(false);
+            return;
+        }
+        if (widgets_.empty()) {
+            throw Exceptions::JSONValidationException(
+                "Invalid JSON structure");
+        }
+        WidgetFrame &frame = widgets_.back();
+        if (frame.in_children) {
+            skip_depth_ = 1;  // Non-object children are ignored
+        } else if (frame.key == "children") {
+            frame.in_children = true;
+        } else {
+            values_.emplace_back(false);
+        }
+    }
+
+    void endArray(const JSONPath &) override {
+        if (skip_depth_ > 0) {
+            --skip_depth_;
+        } else if (!values_.empty()) {
+            endValue();
+        } else {
+            widgets_.back().in_children = false;
+        }
+    }
+
+    void key(const QString &name, const JSONPath &) override {
+        if (skip_depth_ > 0) {
+            return;
+        }
+        if (!values_.empty()) {
+            values_.back().key = name;
+        } else {
+            widgets_.back().key = name;
+        }
+    }
+
+    void value(const QJsonValue &value, const JSONPath &) override {
+        if (skip_depth_ > 0) {
+            return;
+        }
+        if (!values_.empty()) {
+            values_.back().add(value);
+        } else if (widgets_.empty()) {
+            throw Exceptions::JSONValidationException(
+                "Invalid JSON structure");
+        } else if (!widgets_.back().in_children) {
+            widgets_.back().members.insert(widgets_.back().key, value);
+        }
+    }
+
+private:
+    struct ValueFrame {
+        explicit ValueFrame(bool object) : is_object(object) {}
+
+        bool is_object;
+        QJsonObject object;
+        QJsonArray array;
+        QString key;
+
+        void add(const QJsonValue &value) {
+            if (is_object) {
+                object.insert(key, value);
+            } else {
+                array.append(value);
+            }
+        }
+    };
+
+    // A finished child waiting for its parent, with its grid cell
+    struct PendingChild {
+        std::unique_ptr<QWidget> widget;
+        int row;
+        int column;
+        int row_span;
+        int column_span;
+    };
+
+    struct WidgetFrame {
+        QJsonObject members;  // Everything but "children"
+        std::vector<PendingChild> children;
+        QString key;  // Member being read
+        bool in_children = false;
+    };
+
+    JSONUILoader &loader_;
+    std::vector<WidgetFrame> widgets_;
+    std::vector<ValueFrame> values_;
+    int skip_depth_ = 0;
+    std::unique_ptr<QWidget> root_;
+
+    void endValue() {
+        ValueFrame frame = std::move(values_.back());
+        values_.pop_back();
+        const QJsonValue value = frame.is_object ? QJsonValue(frame.object)
+                                                 : QJsonValue(frame.array);
+        if (!values_.empty()) {
+            values_.back().add(value);
+        } else {
+            widgets_.back().members.insert(widgets_.back().key, value);
+        }
+    }
+
+    // The root propagates failures; a child that fails is skipped with its
+    // subtree, as in addChildren()
+    void endWidget() {
+        WidgetFrame frame = std::move(widgets_.back());
+        widgets_.pop_back();
+        const bool is_root = widgets_.empty();
+
+        std::unique_ptr<QWidget> widget;
+        if (is_root) {
+            if (!loader_.validateJSON(frame.members)) {
+                throw Exceptions::JSONValidationException(
+                    "Invalid JSON structure");
+            }
+            widget = loader_.createWidgetShell(frame.members);
+        } else {
+            try {
+                widget = loader_.createWidgetShell(frame.members);
+            } catch (const std::exception &e) {
+                qWarning() << "Failed to create child widget:" << e.what();
+                return;
+            }
+        }
+
+        // The shell has its layout now, so the children land in it
+        for (PendingChild &child : frame.children) {
+            loader_.attachChild(widget.get(), std::move(child.widget),
+                                child.row, child.column, child.row_span,
+                                child.column_span);
+        }
+
+        if (is_root) {
+            root_ = std::move(widget);
+        } else {
+            const QJsonObject &members = frame.members;
+            widgets_.back().children.push_back(
+                {std::move(widget), members.value("row").toInt(0),
+                 members.value("column").toInt(0),
+                 members.value("rowSpan").toInt(1),
+                 members.value("columnSpan").toInt(1)});
+        }
+    }
+};
+
+std::unique_ptr<QWidget> JSONUILoader::loadFromDevice(QIODevice &device,
+                                                      const QString &source) {
+    emit loadingStarted(source);
+
+    try {
+        StreamBuilder builder(*this);
+        JSONStreamParser parser;
+        if (!parser.parse(device, builder)) {
+            throw Exceptions::JSONParsingException(
+                source.toStdString(),
+                QString("JSON parse error at offset %1: %2")
+                    .arg(parser.errorOffset())
+                    .arg(parser.errorString())
+                    .toStdString());
+        }
+
+        auto widget = builder.takeRoot();
+        emit loadingFinished(source);
+        return widget;
+
+    } catch (const std::exception &e) {
+        emit loadingFailed(source, QString::fromStdString(e.what()));
+        throw;
+    }
+}
+
 std::unique_ptr<QWidget> JSONUILoader::loadFromObject(
     const QJsonObject &json_object) {
     if (!validateJSON(json_object)) {
@@ -139,6 +441,214 @@ std::unique_ptr<QWidget> JSONUILoader::loadFromObject(
     return createWidgetFromObject(json_object);
 }
 
+// **Binary UI images**
+
+QByteArray JSONUILoader::compileImage(const QJsonObject &json_object) const {
+    if (!validateJSON(json_object)) {
+        throw Exceptions::JSONValidationException("Invalid JSON structure");
+    }
+
+    return CompiledUIWriter::write(compileNode(json_object));
+}
+
+CompiledUIWriter::Node JSONUILoader::compileNode(
+    const QJsonObject &widget_object) const {
+    CompiledUIWriter::Node node;
+    node.type = widget_object["type"].toString();
+    const QMetaObject *meta_object =
+        ComponentRegistry::instance().metaObjectFor(node.type);
+
+    // **Convert properties**
+    const QJsonObject properties = widget_object["properties"].toObject();
+    for (auto it = properties.begin(); it != properties.end(); ++it) {
+        const QString &property_name = it.key();
+        const int index =
+            meta_object ? meta_object->indexOfProperty(
+                              property_name.toUtf8().constData())
+                        : -1;
+        // Only the factory knows what to make of a non-property (QComboBox
+        // "items") or of an enum name the meta-enum does not resolve, such as
+        // the lowercase QSlider "orientation" the factories read
+        const bool is_enum =
+            index >= 0 && meta_object->property(index).isEnumType();
+        bool for_factory = index < 0 || is_enum;
+
+        try {
+            QVariant value = convertJSONValue(it.value(), property_name);
+            if (index >= 0) {
+                value = toPropertyType(meta_object->property(index),
+                                       std::move(value));
+            }
+            if (is_enum && value.typeId() == QMetaType::Int) {
+                for_factory = false;
+            }
+            node.properties.append({property_name, std::move(value)});
+
+        } catch (const std::exception &e) {
+            qWarning() << "Property conversion failed for" << property_name
+                       << ":" << e.what();
+        }
+
+        if (for_factory) {
+            node.factory_config.insert(property_name, it.value().toVariant());
+        }
+    }
+
+    const QJsonObject events = widget_object["events"].toObject();
+    for (auto it = events.begin(); it != events.end(); ++it) {
+        node.events.append({it.key(), it.value().toString()});
+    }
+
+    const QJsonObject bindings = widget_object["bindings"].toObject();
+    for (auto it = bindings.begin(); it != bindings.end(); ++it) {
+        node.bindings.append({it.key(), it.value().toString()});
+    }
+
+    if (widget_object.contains("layout")) {
+        LayoutSpec spec = layoutSpec(widget_object["layout"].toObject());
+        node.layout_type = std::move(spec.type);
+        node.layout_spacing = spec.spacing;
+        node.layout_margins = spec.margins;
+    }
+
+    // **Grid placement**, used when the parent has a QGridLayout
+    node.row = widget_object.value("row").toInt(0);
+    node.column = widget_object.value("column").toInt(0);
+    node.row_span = widget_object.value("rowSpan").toInt(1);
+    node.column_span = widget_object.value("columnSpan").toInt(1);
+
+    // **Compile children**
+    for (const QJsonValue &child_value : widget_object["children"].toArray()) {
+        if (!child_value.isObject())
+            continue;
+
+        const QJsonObject child_obj = child_value.toObject();
+        const QString child_type = child_obj["type"].toString();
+        if (!ComponentRegistry::instance().hasComponent(child_type)) {
+            qWarning() << "Failed to create child widget:"
+                       << "Component type not registered:" << child_type;
+            continue;
+        }
+        node.children.push_back(compileNode(child_obj));
+    }
+
+    return node;
+}
+
+std::unique_ptr<QWidget> JSONUILoader::loadFromCompiledFile(
+    const QString &file_path) {
+    emit loadingStarted(file_path);
+
+    try {
+        const CompiledUIImage image = CompiledUIImage::open(file_path);
+        if (!image.isValid()) {
+            throw Exceptions::JSONParsingException(
+                file_path.toStdString(), image.errorString().toStdString());
+        }
+
+        auto widget = createWidgetFromImage(image, 0);
+        emit loadingFinished(file_path);
+        return widget;
+
+    } catch (const std::exception &e) {
+        emit loadingFailed(file_path, QString::fromStdString(e.what()));
+        throw;
+    }
+}
+
+std::unique_ptr<QWidget> JSONUILoader::loadFromImage(
+    const CompiledUIImage &image) {
+    if (!image.isValid()) {
+        throw Exceptions::JSONParsingException(
+            "image", image.errorString().toStdString());
+    }
+
+    return createWidgetFromImage(image, 0);
+}
+
+std::unique_ptr<QWidget> JSONUILoader::createWidgetFromImage(
+    const CompiledUIImage &image, quint32 index) {
+    const CompiledUIImage::Node node = image.node(index);
+    std::unique_ptr<QWidget> widget;
+
+    try {
+        const QString type = image.string(node.type);
+        QJsonObject config;
+        if (node.config_size > 0) {
+            config.insert(
+                "properties",
+                QJsonObject::fromVariantMap(image.factoryConfig(node)));
+        }
+
+        // **Create widget using registry**
+        widget = ComponentRegistry::instance().createComponent(type, config);
+
+        if (!widget) {
+            throw Exceptions::ComponentCreationException(type.toStdString());
+        }
+
+        // **Apply properties**, already of the property's type
+        for (quint32 i = 0; i < node.property_count; ++i) {
+            const auto prop = image.property(node.first_property + i);
+            if (!widget->setProperty(image.utf8(prop.name),
+                                     image.value(prop))) {
+                qWarning() << "Failed to set property"
+                           << image.string(prop.name) << "on widget"
+                           << widget->metaObject()->className();
+            }
+        }
+
+        // **Bind events**
+        for (quint32 i = 0; i < node.event_count; ++i) {
+            const auto event = image.pair(node.first_event + i);
+            bindEvent(widget.get(), image.string(event.key),
+                      image.string(event.value));
+        }
+
+        // **Setup property bindings**
+        for (quint32 i = 0; state_manager_ && i < node.binding_count; ++i) {
+            const auto binding = image.pair(node.first_binding + i);
+            bindProperty(widget.get(), image.string(binding.key),
+                         image.string(binding.value));
+        }
+
+        // **Setup layout**
+        if (node.layout_type != CompiledUIImage::kNoString) {
+            LayoutSpec spec{image.string(node.layout_type), {}, {}};
+            if (node.flags & CompiledUIImage::kHasLayoutSpacing) {
+                spec.spacing = node.layout_spacing;
+            }
+            if (node.flags & CompiledUIImage::kHasLayoutMargins) {
+                spec.margins = QMargins(
+                    node.layout_margins[0], node.layout_margins[1],
+                    node.layout_margins[2], node.layout_margins[3]);
+            }
+            installLayout(widget.get(), spec);
+        }
+
+    } catch (const std::exception &e) {
+        throw Exceptions::ComponentCreationException(
+            "Widget creation failed: " + std::string(e.what()));
+    }
+
+    // **Add children**; a failed child is skipped with its subtree
+    quint32 child_index = index + 1;
+    for (quint32 i = 0; i < node.child_count; ++i) {
+        const CompiledUIImage::Node child = image.node(child_index);
+        try {
+            attachChild(widget.get(), createWidgetFromImage(image, child_index),
+                        child.grid[0], child.grid[1], child.grid[2],
+                        child.grid[3]);
+
+        } catch (const std::exception &e) {
+            qWarning() << "Failed to create child widget:" << e.what();
+        }
+        child_index += child.subtree_size;
+    }
+
+    return widget;
+}
+
 bool JSONUILoader::validateJSON(const QJsonObject &json_object) const {
     // **Validate required fields**
     if (!json_object.contains("type")) {
@@ -171,6 +681,18 @@ bool JSONUILoader::validateJSON(const QJsonObject &json_object) const {
 }
 
 std::unique_ptr<QWidget> JSONUILoader::createWidgetFromObject(
+    const QJsonObject &widget_object) {
+    auto widget = createWidgetShell(widget_object);
+
+    // **Add children**
+    if (widget_object.contains("children")) {
+        addChildren(widget.get(), widget_object["children"].toArray());
+    }
+
+    return widget;
+}
+
+std::unique_ptr<QWidget> JSONUILoader::createWidgetShell(
     const QJsonObject &widget_object) {
     try {
         QString type = widget_object["type"].toString();
@@ -205,11 +727,6 @@ std::unique_ptr<QWidget> JSONUILoader::createWidgetFromObject(
             setupLayout(widget.get(), widget_object["layout"].toObject());
         }
 
-        // **Add children**
-        if (widget_object.contains("children")) {
-            addChildren(widget.get(), widget_object["children"].toArray());
-        }
-
         return widget;
 
     } catch (const std::exception &e) {
@@ -251,33 +768,35 @@ void JSONUILoader::bindEvents(QWidget *widget, const QJsonObject &events) {
         return;
 
     for (auto it = events.begin(); it != events.end(); ++it) {
-        const QString &event_name = it.key();
-        const QString &handler_name = it.value().toString();
+        bindEvent(widget, it.key(), it.value().toString());
+    }
+}
 
-        // **Find event handler**
-        auto handler_it = event_handlers_.find(handler_name);
-        if (handler_it == event_handlers_.end()) {
-            qWarning() << "Event handler not found:" << handler_name;
-            continue;
-        }
+void JSONUILoader::bindEvent(QWidget *widget, const QString &event_name,
+                             const QString &handler_name) {
+    // **Find event handler**
+    auto handler_it = event_handlers_.find(handler_name);
+    if (handler_it == event_handlers_.end()) {
+        qWarning() << "Event handler not found:" << handler_name;
+        return;
+    }
 
-        // **Handle specific widget types and signals**
-        bool signal_connected = false;
+    // **Handle specific widget types and signals**
+    bool signal_connected = false;
 
-        if (event_name == "clicked") {
-            if (auto *button = qobject_cast<QPushButton *>(widget)) {
-                QObject::connect(button, &QPushButton::clicked,
-                                 [handler_it]() { handler_it->second(); });
-                signal_connected = true;
-                qDebug() << "✅ Connected signal:" << event_name
-                         << "to handler:" << handler_name;
-            }
+    if (event_name == "clicked") {
+        if (auto *button = qobject_cast<QPushButton *>(widget)) {
+            QObject::connect(button, &QPushButton::clicked,
+                             [handler_it]() { handler_it->second(); });
+            signal_connected = true;
+            qDebug() << "✅ Connected signal:" << event_name
+                     << "to handler:" << handler_name;
         }
+    }
 
-        if (!signal_connected) {
-            qWarning() << "❌ Failed to connect signal:" << event_name
-                       << "for widget" << widget->metaObject()->className();
-        }
+    if (!signal_connected) {
+        qWarning() << "❌ Failed to connect signal:" << event_name
+                   << "for widget" << widget->metaObject()->className();
     }
 }
 
@@ -286,69 +805,20 @@ void JSONUILoader::setupLayout(QWidget *parent,
     if (!parent)
         return;
 
-    QString layout_type = layout_config["type"].toString();
-    QLayout *layout = nullptr;
-
-    // **Create layout based on type**
-    if (layout_type == "VBoxLayout") {
-        layout = new QVBoxLayout();
-    } else if (layout_type == "HBoxLayout") {
-        layout = new QHBoxLayout();
-    } else if (layout_type == "GridLayout") {
-        layout = new QGridLayout();
-    } else if (layout_type == "FormLayout") {
-        layout = new QFormLayout();
-    } else {
-        qWarning() << "Unknown layout type:" << layout_type;
-        return;
-    }
-
-    // **Apply layout properties**
-    if (layout_config.contains("spacing")) {
-        layout->setSpacing(layout_config["spacing"].toInt());
-    }
-
-    if (layout_config.contains("margins")) {
-        QJsonArray margins = layout_config["margins"].toArray();
-        if (margins.size() == 4) {
-            layout->setContentsMargins(margins[0].toInt(), margins[1].toInt(),
-                                       margins[2].toInt(), margins[3].toInt());
-        }
-    }
-
-    parent->setLayout(layout);
+    installLayout(parent, layoutSpec(layout_config));
 }
 
 void JSONUILoader::addChildren(QWidget *parent, const QJsonArray &children) {
     if (!parent)
         return;
 
-    QLayout *layout = parent->layout();
-
     for (const QJsonValue &child_value : children) {
         if (!child_value.isObject())
             continue;
 
         try {
-            auto child_widget = createWidgetFromObject(child_value.toObject());
-
-            if (layout) {
-                // **Handle grid layout positioning**
-                if (auto *grid_layout = qobject_cast<QGridLayout *>(layout)) {
-                    QJsonObject child_obj = child_value.toObject();
-                    int row = child_obj.value("row").toInt(0);
-                    int col = child_obj.value("column").toInt(0);
-                    int row_span = child_obj.value("rowSpan").toInt(1);
-                    int col_span = child_obj.value("columnSpan").toInt(1);
-
-                    grid_layout->addWidget(child_widget.release(), row, col,
-                                           row_span, col_span);
-                } else {
-                    layout->addWidget(child_widget.release());
-                }
-            } else {
-                child_widget->setParent(parent);
-            }
+            const QJsonObject child_obj = child_value.toObject();
+            attachChild(parent, createWidgetFromObject(child_obj), child_obj);
 
         } catch (const std::exception &e) {
             qWarning() << "Failed to create child widget:" << e.what();
@@ -356,6 +826,32 @@ void JSONUILoader::addChildren(QWidget *parent, const QJsonArray &children) {
     }
 }
 
+void JSONUILoader::attachChild(QWidget *parent, std::unique_ptr<QWidget> child,
+                               const QJsonObject &child_object) {
+    attachChild(parent, std::move(child), child_object.value("row").toInt(0),
+                child_object.value("column").toInt(0),
+                child_object.value("rowSpan").toInt(1),
+                child_object.value("columnSpan").toInt(1));
+}
+
+void JSONUILoader::attachChild(QWidget *parent, std::unique_ptr<QWidget> child,
+                               int row, int column, int row_span,
+                               int column_span) {
+    QLayout *layout = parent->layout();
+
+    if (layout) {
+        // **Handle grid layout positioning**
+        if (auto *grid_layout = qobject_cast<QGridLayout *>(layout)) {
+            grid_layout->addWidget(child.release(), row, column, row_span,
+                                   column_span);
+        } else {
+            layout->addWidget(child.release());
+        }
+    } else {
+        child.release()->setParent(parent);
+    }
+}
+
 void JSONUILoader::setupPropertyBindings(QWidget *widget,
                                          const QJsonObject &bindings) {
     if (!widget || !state_manager_) {
@@ -363,35 +859,36 @@ void JSONUILoader::setupPropertyBindings(QWidget *widget,
     }
 
     for (auto it = bindings.begin(); it != bindings.end(); ++it) {
-        const QString &property_name = it.key();
-        const QString &state_key = it.value().toString();
+        bindProperty(widget, it.key(), it.value().toString());
+    }
+}
 
-        // **Create property binding with state manager**
-        try {
-            // This would need to be implemented based on your state system
-            // Example for string properties:
-            if (auto state = state_manager_->getState<QString>(state_key)) {
-                connect(state.get(),
-                        &Binding::ReactivePropertyBase::valueChanged,
-                        [widget, property_name, state]() {
-                            auto value = state->get();
-                            widget->setProperty(
-                                property_name.toUtf8().constData(), value);
-                        });
-
-                // **Set initial value**
-                widget->setProperty(property_name.toUtf8().constData(),
-                                    state->get());
-            }
-        } catch (const std::exception &e) {
-            qWarning() << "Property binding failed:" << property_name
-                       << "to state" << state_key << ":" << e.what();
+void JSONUILoader::bindProperty(QWidget *widget, const QString &property_name,
+                                const QString &state_key) {
+    // **Create property binding with state manager**
+    try {
+        // This would need to be implemented based on your state system
+        // Example for string properties:
+        if (auto state = state_manager_->getState<QString>(state_key)) {
+            connect(state.get(), &Binding::ReactivePropertyBase::valueChanged,
+                    [widget, property_name, state]() {
+                        auto value = state->get();
+                        widget->setProperty(property_name.toUtf8().constData(),
+                                            value);
+                    });
+
+            // **Set initial value**
+            widget->setProperty(property_name.toUtf8().constData(),
+                                state->get());
         }
+    } catch (const std::exception &e) {
+        qWarning() << "Property binding failed:" << property_name
+                   << "to state" << state_key << ":" << e.what();
     }
 }
 
 QVariant JSONUILoader::convertJSONValue(const QJsonValue &value,
-                                        const QString &property_type) {
+                                        const QString &property_type) const {
     // **Check for custom converter**
     if (!property_type.isEmpty()) {
         auto converter_it = property_converters_.find(property_type);
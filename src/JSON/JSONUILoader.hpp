@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QIODevice>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -11,6 +12,7 @@
 #include <memory>
 
 #include "../Binding/StateManager.hpp"
+#include "CompiledUI.hpp"
 
 namespace DeclarativeUI::JSON {
 
@@ -22,6 +24,9 @@ namespace DeclarativeUI::JSON {
  * representation of a user interface into a live QWidget tree. The loader
  * provides:
  *  - loading from files, raw JSON strings, or in-memory QJsonObject,
+ *  - streaming construction from a QIODevice without a QJsonDocument,
+ *  - compiling a definition into a binary UI image, and building widgets
+ *    from a memory-mapped image without parsing JSON,
  *  - validation entry points for JSON structure used by the loader,
  *  - binding to a shared StateManager for reactive property updates,
  *  - registration of named event handlers and custom property converters,
@@ -113,6 +118,68 @@ public:
     [[nodiscard]] std::unique_ptr<QWidget> loadFromObject(
         const QJsonObject &json_object);
 
+    /**
+     * @brief Load UI from a device, creating widgets while it is read.
+     * @param device Open, readable device holding a JSON or JSONC document.
+     * @param source Source identifier used in the lifecycle signals.
+     * @return unique_ptr<QWidget> Root widget; failures throw as in
+     * loadFromFile.
+     *
+     * The document goes through JSONStreamParser rather than QJsonDocument.
+     * Each widget is created when its object ends, so members may come in
+     * any order, and finished children wait as widgets rather than JSON
+     * until their parent is created; the JSON held follows the nesting
+     * depth, not the document size.
+     */
+    [[nodiscard]] std::unique_ptr<QWidget> loadFromDevice(
+        QIODevice &device, const QString &source = "device");
+
+    /**
+     * @brief Compile a UI definition into a binary UI image.
+     * @param json_object Top-level JSON object with references and includes
+     * already resolved, as JSONParser::parseFile() returns it.
+     * @return Image bytes for loadFromImage() or loadFromCompiledFile().
+     *
+     * The tree is validated as loadFromObject() would validate it, and each
+     * property value is converted with this loader's converters and then to
+     * the type of the widget property it is written to. Children whose type
+     * is not registered are dropped with the warning loading them would
+     * give. Properties that are not Qt properties of their widget, and enum
+     * values whose names the property's enum does not know (the factories
+     * read "orientation": "vertical"), are also handed to the widget's
+     * factory, as when loading JSON.
+     * @throws Exceptions::JSONValidationException if the tree is invalid or
+     * a value cannot be stored in an image.
+     */
+    [[nodiscard]] QByteArray compileImage(
+        const QJsonObject &json_object) const;
+
+    /**
+     * @brief Load UI from a binary UI image file written by compileImage().
+     * @param file_path Path of the image.
+     * @return unique_ptr<QWidget> Root widget; failures throw as in
+     * loadFromFile.
+     *
+     * The file is memory-mapped and read in place. Emits loading lifecycle
+     * signals as loadFromFile.
+     */
+    [[nodiscard]] std::unique_ptr<QWidget> loadFromCompiledFile(
+        const QString &file_path);
+
+    /**
+     * @brief Build the widget tree held by an open image.
+     * @param image Image to build from.
+     * @return unique_ptr<QWidget> Root widget.
+     * @throws Exceptions::JSONParsingException if the image is invalid.
+     *
+     * Widgets get the same properties, layouts, events, bindings and
+     * children as from the JSON the image was compiled from. The registered
+     * event handlers and the bound StateManager are those of this loader,
+     * not of the loader that compiled the image.
+     */
+    [[nodiscard]] std::unique_ptr<QWidget> loadFromImage(
+        const CompiledUIImage &image);
+
     /**
      * @brief Validate JSON structure for compatibility with the loader.
      * @param json_object JSON object to validate.
@@ -186,6 +253,8 @@ signals:
     void loadingFailed(const QString &source, const QString &error);
 
 private:
+    class StreamBuilder;
+
     std::shared_ptr<Binding::StateManager> state_manager_;
     std::unordered_map<QString, std::function<void()>> event_handlers_;
     std::unordered_map<QString, std::function<QVariant(const QJsonValue &)>>
@@ -208,6 +277,26 @@ private:
     std::unique_ptr<QWidget> createWidgetFromObject(
         const QJsonObject &widget_object);
 
+    /**
+     * @brief createWidgetFromObject() without the "children" step.
+     * @param widget_object JSON object describing a single widget node.
+     * @return unique_ptr<QWidget> configured widget with no children yet.
+     */
+    std::unique_ptr<QWidget> createWidgetShell(
+        const QJsonObject &widget_object);
+
+    /**
+     * @brief createWidgetFromObject() for the node at index of an image.
+     */
+    std::unique_ptr<QWidget> createWidgetFromImage(
+        const CompiledUIImage &image, quint32 index);
+
+    /**
+     * @brief Describe one widget object, and its subtree, for
+     * CompiledUIWriter.
+     */
+    CompiledUIWriter::Node compileNode(const QJsonObject &widget_object) const;
+
     /**
      * @brief Apply properties from JSON to a widget using the Qt meta-object
      * system.
@@ -230,6 +319,12 @@ private:
      */
     void bindEvents(QWidget *widget, const QJsonObject &events);
 
+    /**
+     * @brief Connect one event of widget to the handler named handler_name.
+     */
+    void bindEvent(QWidget *widget, const QString &event_name,
+                   const QString &handler_name);
+
     /**
      * @brief Create and apply a layout for a parent widget from JSON config.
      * @param parent Parent widget that will receive the layout.
@@ -247,6 +342,23 @@ private:
      */
     void addChildren(QWidget *parent, const QJsonArray &children);
 
+    /**
+     * @brief Add one created child to its parent's layout, or parent it
+     * directly when there is no layout.
+     * @param parent Parent widget.
+     * @param child Created child; ownership passes to parent.
+     * @param child_object The child's JSON, for grid "row"/"column" spans.
+     */
+    void attachChild(QWidget *parent, std::unique_ptr<QWidget> child,
+                     const QJsonObject &child_object);
+
+    /**
+     * @brief attachChild() with the grid cell given directly; the cell is
+     * ignored unless parent has a QGridLayout.
+     */
+    void attachChild(QWidget *parent, std::unique_ptr<QWidget> child, int row,
+                     int column, int row_span, int column_span);
+
     /**
      * @brief Set up declarative property bindings between widget properties and
      * application state.
@@ -259,6 +371,12 @@ private:
      */
     void setupPropertyBindings(QWidget *widget, const QJsonObject &bindings);
 
+    /**
+     * @brief Bind one widget property to state_key of the StateManager.
+     */
+    void bindProperty(QWidget *widget, const QString &property_name,
+                      const QString &state_key);
+
     /**
      * @brief Convert a raw QJsonValue into a QVariant suitable for
      * meta-property assignment.
@@ -272,7 +390,7 @@ private:
      * is provided or when the meta-type requires special handling.
      */
     QVariant convertJSONValue(const QJsonValue &value,
-                              const QString &property_type = "");
+                              const QString &property_type = "") const;
 
     /**
      * @brief Validate a single widget JSON object for required/known fields.
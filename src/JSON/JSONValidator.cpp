@@ -118,7 +118,8 @@ void ValidationContext::throwIfErrors() const {
 
 // **UIJSONValidator Implementation**
 
-UIJSONValidator::UIJSONValidator() {
+UIJSONValidator::UIJSONValidator(std::pmr::memory_resource* resource)
+    : context_(resource) {
     initializeKnownComponents();
     initializeKnownProperties();
     schema_validator_ = std::make_unique<JSONSchemaValidator>();
@@ -385,7 +386,7 @@ UIJSONValidator &UIJSONValidator::registerBuiltinValidators() {
 }
 
 std::vector<ValidationResult> UIJSONValidator::getValidationResults() const {
-    return context_.results;
+    return {context_.results.begin(), context_.results.end()};
 }
 
 std::vector<ValidationResult> UIJSONValidator::getErrors() const {
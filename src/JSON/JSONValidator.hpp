@@ -9,7 +9,9 @@
 #include <concepts>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
+#include <vector>
 #include "../Exceptions/UIExceptions.hpp"
 #include "JSONParser.hpp"
 
@@ -119,13 +121,25 @@ struct ValidationResult {
  *  - results: collected ValidationResult entries produced while validating.
  *
  * Convenience functions are provided to emit results and inspect the context.
+ *
+ * Maps and the result list allocate from a std::pmr resource so a validation
+ * pass can run on a per-operation arena.
  */
 struct ValidationContext {
+    ValidationContext() = default;
+
+    /**
+     * @brief Construct a context whose containers allocate from resource.
+     * @param resource Must outlive the context.
+     */
+    explicit ValidationContext(std::pmr::memory_resource *resource)
+        : variables(resource), custom_validators(resource), results(resource) {}
+
     JSONPath current_path;
     QJsonObject root_object;
     QJsonObject schema;
-    std::unordered_map<QString, QJsonValue> variables;
-    std::unordered_map<QString, std::function<bool(const QJsonValue &)>>
+    std::pmr::unordered_map<QString, QJsonValue> variables;
+    std::pmr::unordered_map<QString, std::function<bool(const QJsonValue &)>>
         custom_validators;
 
     // **Configuration**
@@ -135,7 +149,7 @@ struct ValidationContext {
     int current_depth = 0;
 
     // **Results**
-    std::vector<ValidationResult> results;
+    std::pmr::vector<ValidationResult> results;
 
     /**
      * @brief Append a ValidationResult to the context.
@@ -292,7 +306,12 @@ private:
  */
 class UIJSONValidator {
 public:
-    explicit UIJSONValidator();
+    /**
+     * @param resource Allocation source for the validation context; must
+     * outlive the validator.
+     */
+    explicit UIJSONValidator(
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
     ~UIJSONValidator() = default;
 
     // **Validation methods**
@@ -0,0 +1,452 @@
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTextStream>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../Core/CacheManager.hpp"
+#include "../JSON/JSONParser.hpp"
+
+using namespace DeclarativeUI::Core;
+
+/**
+ * @brief Throughput benchmarks for the LRUCache engine.
+ *
+ * These tests use wall-clock timing over fixed operation counts instead of
+ * QBENCHMARK because they drive the cache from several threads at once.
+ */
+class CachePerformanceTest : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int kKeyCount = 4096;
+    static constexpr int kLookupsPerThread = 200000;
+    static constexpr size_t kTraceCacheSize = 1000;
+    static constexpr int kStartupFileCount = 200;
+
+    using Trace = std::vector<QString>;
+
+    /**
+     * @brief Zipf-distributed key stream over key_space keys.
+     */
+    static Trace makeZipfTrace(int length, int key_space, double skew,
+                               quint32 seed) {
+        std::vector<double> cdf(key_space);
+        double sum = 0.0;
+        for (int i = 0; i < key_space; ++i) {
+            sum += 1.0 / std::pow(i + 1, skew);
+            cdf[i] = sum;
+        }
+
+        QRandomGenerator generator(seed);
+        Trace trace;
+        trace.reserve(length);
+        for (int i = 0; i < length; ++i) {
+            const double point = generator.generateDouble() * sum;
+            const auto rank =
+                std::lower_bound(cdf.begin(), cdf.end(), point) - cdf.begin();
+            trace.push_back(QString("key_%1").arg(rank));
+        }
+        return trace;
+    }
+
+    /**
+     * @brief Zipf traffic interrupted by one-off sequential scans, the shape
+     * produced by bulk preload()/putBatch() calls.
+     */
+    static Trace makeScanTrace(int length, quint32 seed) {
+        Trace zipf = makeZipfTrace(length, 20000, 0.9, seed);
+        Trace trace;
+        trace.reserve(length * 2);
+        int scan_key = 0;
+        for (int i = 0; i < length; ++i) {
+            if (i % 20000 == 10000) {
+                for (int j = 0; j < 3000; ++j) {
+                    trace.push_back(QString("scan_%1").arg(scan_key++));
+                }
+            }
+            trace.push_back(zipf[i]);
+        }
+        return trace;
+    }
+
+    /**
+     * @brief Cyclic access over a working set slightly larger than the cache.
+     */
+    static Trace makeLoopTrace(int length, int loop_size) {
+        Trace trace;
+        trace.reserve(length);
+        for (int i = 0; i < length; ++i) {
+            trace.push_back(QString("loop_%1").arg(i % loop_size));
+        }
+        return trace;
+    }
+
+    /**
+     * @brief Load recorded key streams (one key per line) from the file or
+     * directory named by DECLARATIVEUI_CACHE_TRACE, if set.
+     */
+    static std::map<QString, Trace> loadRecordedTraces() {
+        std::map<QString, Trace> traces;
+        const QString location =
+            qEnvironmentVariable("DECLARATIVEUI_CACHE_TRACE");
+        if (location.isEmpty()) {
+            return traces;
+        }
+
+        QStringList files;
+        QFileInfo info(location);
+        if (info.isDir()) {
+            for (const QFileInfo& entry :
+                 QDir(location).entryInfoList(QDir::Files, QDir::Name)) {
+                files << entry.absoluteFilePath();
+            }
+        } else {
+            files << location;
+        }
+
+        for (const QString& path : files) {
+            QFile file(path);
+            if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                qWarning() << "Cannot open cache trace" << path;
+                continue;
+            }
+            Trace trace;
+            QTextStream stream(&file);
+            while (!stream.atEnd()) {
+                const QString key = stream.readLine().trimmed();
+                if (!key.isEmpty()) {
+                    trace.push_back(key);
+                }
+            }
+            traces[QFileInfo(path).fileName()] = std::move(trace);
+        }
+        return traces;
+    }
+
+    /**
+     * @brief Replay a trace as read-through traffic: miss -> put.
+     * @return Hit ratio.
+     */
+    static double replayTrace(const Trace& trace, EvictionPolicy policy,
+                              size_t shard_count) {
+        LRUCache<QString, QString> cache(kTraceCacheSize, 64, shard_count);
+        cache.setEvictionPolicy(policy);
+
+        size_t hits = 0;
+        for (const QString& key : trace) {
+            if (cache.get(key).has_value()) {
+                ++hits;
+            } else {
+                cache.put(key, key);
+            }
+        }
+        return trace.empty() ? 0.0
+                             : static_cast<double>(hits) / trace.size();
+    }
+
+    /**
+     * @brief A UI definition with a form of labelled inputs, roughly the size
+     * of a typical application screen.
+     */
+    static QByteArray makeUiDefinition(int index) {
+        QJsonArray children;
+        for (int i = 0; i < 40; ++i) {
+            QJsonObject label;
+            label["type"] = "QLabel";
+            label["properties"] = QJsonObject{
+                {"text", QString("Field %1.%2").arg(index).arg(i)},
+                {"styleSheet", "color: #333; font-weight: bold;"}};
+
+            QJsonObject edit;
+            edit["type"] = "QLineEdit";
+            edit["properties"] = QJsonObject{
+                {"placeholderText", QString("Enter value %1").arg(i)},
+                {"maxLength", 64}};
+            edit["bindings"] = QJsonObject{
+                {"text", QString("form_%1.field_%2").arg(index).arg(i)}};
+
+            QJsonObject row;
+            row["type"] = "QWidget";
+            row["layout"] = QJsonObject{{"type", "HBoxLayout"}};
+            row["children"] = QJsonArray{label, edit};
+            children.append(row);
+        }
+
+        QJsonObject root;
+        root["type"] = "QWidget";
+        root["properties"] =
+            QJsonObject{{"windowTitle", QString("Screen %1").arg(index)}};
+        root["layout"] = QJsonObject{{"type", "VBoxLayout"}, {"spacing", 6}};
+        root["children"] = children;
+        return QJsonDocument(root).toJson(QJsonDocument::Indented);
+    }
+
+    /**
+     * @brief Simulate an application start: create a CacheManager with the
+     * persistent tier and load every UI file through JSONParser.
+     * @return Elapsed milliseconds, including store warm-up.
+     */
+    static double measureStartup(const QStringList& files,
+                                 const QString& store_path,
+                                 std::vector<QJsonObject>& results) {
+        QElapsedTimer timer;
+        timer.start();
+
+        auto cache_manager = std::make_shared<CacheManager>();
+        cache_manager->enablePersistentJSONCache(store_path);
+
+        DeclarativeUI::JSON::JSONParser parser;
+        parser.setCacheManager(cache_manager);
+
+        results.clear();
+        for (const QString& file : files) {
+            results.push_back(parser.parseFile(file));
+        }
+        return timer.nsecsElapsed() / 1e6;
+    }
+
+    /**
+     * @brief Run read-only hit traffic against a pre-filled cache.
+     * @return Aggregate lookups per second across all threads.
+     */
+    static double measureHitThroughput(LRUCache<QString, QString>& cache,
+                                       const std::vector<QString>& keys,
+                                       int thread_count,
+                                       std::atomic<size_t>& misses) {
+        std::atomic<bool> start{false};
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t] {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+
+                size_t local_misses = 0;
+                size_t index = static_cast<size_t>(t) * 7919;
+                for (int i = 0; i < kLookupsPerThread; ++i) {
+                    index = (index + 40503) % keys.size();
+                    if (!cache.get(keys[index]).has_value()) {
+                        ++local_misses;
+                    }
+                }
+                misses.fetch_add(local_misses);
+            });
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        start.store(true, std::memory_order_release);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const qint64 elapsed_ns = std::max<qint64>(timer.nsecsElapsed(), 1);
+
+        const double total_ops =
+            static_cast<double>(thread_count) * kLookupsPerThread;
+        return total_ops * 1e9 / static_cast<double>(elapsed_ns);
+    }
+
+private slots:
+    // **Concurrent hit throughput, single lock vs lock-striped shards**
+    void benchmarkConcurrentHitThroughput() {
+        std::vector<QString> keys;
+        keys.reserve(kKeyCount);
+        for (int i = 0; i < kKeyCount; ++i) {
+            keys.push_back(QString("widget_key_%1").arg(i));
+        }
+
+        for (size_t shard_count : {size_t(1), size_t(16)}) {
+            LRUCache<QString, QString> cache(kKeyCount * 2, 64, shard_count);
+            for (const auto& key : keys) {
+                QVERIFY(cache.put(key, key));
+            }
+
+            for (int thread_count : {1, 2, 4, 8, 16}) {
+                std::atomic<size_t> misses{0};
+                const double ops_per_sec =
+                    measureHitThroughput(cache, keys, thread_count, misses);
+
+                qDebug() << "Cache hit throughput: shards =" << shard_count
+                         << "threads =" << thread_count
+                         << "ops/s =" << static_cast<qint64>(ops_per_sec);
+
+                // Working set fits, so every lookup must hit
+                QCOMPARE(misses.load(), size_t(0));
+            }
+
+            QCOMPARE(cache.size(), static_cast<size_t>(kKeyCount));
+        }
+    }
+
+    // **Trace-driven hit ratio comparison across eviction policies**
+    void benchmarkPolicyHitRatios() {
+        std::map<QString, Trace> traces = loadRecordedTraces();
+        traces["zipf_0.9"] = makeZipfTrace(200000, 20000, 0.9, 1);
+        traces["zipf_with_scans"] = makeScanTrace(200000, 2);
+        traces["loop_1.2x"] =
+            makeLoopTrace(100000, static_cast<int>(kTraceCacheSize * 6 / 5));
+
+        const std::vector<std::pair<EvictionPolicy, const char*>> policies = {
+            {EvictionPolicy::LRU, "LRU"},
+            {EvictionPolicy::LFU, "LFU"},
+            {EvictionPolicy::FIFO, "FIFO"},
+            {EvictionPolicy::TTL, "TTL"},
+            {EvictionPolicy::Adaptive, "Adaptive"},
+            {EvictionPolicy::WTinyLFU, "WTinyLFU"}};
+
+        for (const auto& [name, trace] : traces) {
+            for (size_t shard_count : {size_t(1), size_t(4)}) {
+                std::map<EvictionPolicy, double> ratios;
+                for (const auto& [policy, policy_name] : policies) {
+                    QElapsedTimer timer;
+                    timer.start();
+                    ratios[policy] = replayTrace(trace, policy, shard_count);
+                    qDebug() << "Trace" << name << "shards =" << shard_count
+                             << "policy =" << policy_name
+                             << "hit ratio =" << ratios[policy]
+                             << "time =" << timer.elapsed() << "ms";
+                }
+
+                // Admission filtering must not lose to plain recency
+                QVERIFY(ratios[EvictionPolicy::WTinyLFU] + 0.01 >=
+                        ratios[EvictionPolicy::LRU]);
+            }
+        }
+    }
+
+    // **Cold start vs start with a warm persistent JSON cache**
+    void benchmarkPersistentJSONStartup() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString store_path = dir.filePath("json_cache.dcache");
+
+        QStringList files;
+        size_t total_bytes = 0;
+        for (int i = 0; i < kStartupFileCount; ++i) {
+            const QString path = dir.filePath(QString("screen_%1.json").arg(i));
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            const QByteArray content = makeUiDefinition(i);
+            file.write(content);
+            total_bytes += content.size();
+            files << path;
+        }
+
+        std::vector<QJsonObject> cold_results;
+        std::vector<QJsonObject> warm_results;
+
+        // Cold: empty store, every file is read and parsed (and persisted)
+        const double cold_ms = measureStartup(files, store_path, cold_results);
+
+        // Warm: a fresh process image, served from the store without parsing
+        const double warm_ms = measureStartup(files, store_path, warm_results);
+
+        // Warm without content verification trusts mtime and size only
+        QElapsedTimer timer;
+        timer.start();
+        {
+            CacheManager cache_manager;
+            cache_manager.enablePersistentJSONCache(store_path, 64, false);
+        }
+        const double metadata_only_ms = timer.nsecsElapsed() / 1e6;
+
+        qDebug() << "Persistent JSON cache startup:" << kStartupFileCount
+                 << "files," << total_bytes / 1024 << "KiB";
+        qDebug() << "  cold start:" << cold_ms << "ms";
+        qDebug() << "  warm start:" << warm_ms << "ms"
+                 << "speedup =" << (warm_ms > 0 ? cold_ms / warm_ms : 0.0);
+        qDebug() << "  warm-up without content hashing:" << metadata_only_ms
+                 << "ms";
+
+        QCOMPARE(warm_results.size(), cold_results.size());
+        for (size_t i = 0; i < cold_results.size(); ++i) {
+            QCOMPARE(warm_results[i], cold_results[i]);
+        }
+        QVERIFY(warm_ms < cold_ms);
+    }
+
+    // **TTL cleanup cost: proportional to due entries, not cache size**
+    void benchmarkTtlCleanup() {
+        constexpr int kEntries = 200000;
+        constexpr int kDueEvery = 100;  // 1% of the entries expire
+
+        LRUCache<QString, QString> cache(kEntries * 2, 512, 4);
+        for (int i = 0; i < kEntries; ++i) {
+            const auto ttl = i % kDueEvery == 0 ? std::chrono::milliseconds(20)
+                                                : std::chrono::hours(1);
+            cache.put(QString("entry_%1").arg(i), "value", ttl);
+        }
+
+        auto timed_cleanup = [&cache]() {
+            QElapsedTimer timer;
+            timer.start();
+            cache.cleanup();
+            return timer.nsecsElapsed() / 1e6;
+        };
+
+        const double idle_ms = timed_cleanup();
+        QThread::msleep(50);
+        const double due_ms = timed_cleanup();
+
+        qDebug() << "TTL cleanup with" << kEntries << "entries:";
+        qDebug() << "  nothing due:" << idle_ms << "ms";
+        qDebug() << "  " << kEntries / kDueEvery << "due:" << due_ms << "ms";
+
+        QCOMPARE(cache.size(), size_t(kEntries - kEntries / kDueEvery));
+        QCOMPARE(cache.getStatistics().expirations,
+                 size_t(kEntries / kDueEvery));
+    }
+
+    // **Tracked cache memory vs allocator statistics**
+    void benchmarkMemoryAccountingAccuracy() {
+        CacheManager cache_manager;
+        cache_manager.beginMemoryValidation();
+        if (!cache_manager.memoryValidationReport()["supported"].toBool()) {
+            QSKIP("Allocator statistics are unavailable on this platform");
+        }
+
+        // A UI-shaped workload: parsed definitions, file contents, styles
+        for (int i = 0; i < 300; ++i) {
+            const QByteArray content = makeUiDefinition(i);
+            cache_manager.cacheJSON(QString("screen_%1").arg(i),
+                                    QJsonDocument::fromJson(content).object());
+            cache_manager.cacheFileContent(QString("screen_%1.json").arg(i),
+                                           content);
+            cache_manager.cacheStylesheet(
+                QString("style_%1").arg(i),
+                QString("QPushButton#b%1 { color: #%2; padding: 4px; }")
+                    .arg(i)
+                    .arg(i % 0xFFFFFF, 6, 16, QChar('0')));
+        }
+
+        const QJsonObject report = cache_manager.memoryValidationReport();
+        const double accuracy = report["accuracy"].toDouble();
+        qDebug() << "Memory accounting: tracked"
+                 << report["tracked_delta"].toInteger() << "bytes, allocator"
+                 << report["allocator_delta"].toInteger()
+                 << "bytes, accuracy =" << accuracy;
+
+        // The estimators are models of Qt's layouts, not exact; they must be
+        // within a factor of two of what the allocator saw
+        QVERIFY(accuracy > 0.5 && accuracy < 2.0);
+    }
+};
+
+QTEST_MAIN(CachePerformanceTest)
+#include "test_cache_performance.moc"
@@ -1,6 +1,9 @@
 #include <QApplication>
 #include <QElapsedTimer>
+#include <QEventLoop>
 #include <QFuture>
+#include <QFutureInterface>
+#include <QFutureWatcher>
 #include <QRandomGenerator>
 #include <QTest>
 #include <QThread>
@@ -14,14 +17,48 @@
 #include "../Components/Label.hpp"
 #include "../Components/LineEdit.hpp"
 #include "../Core/CacheManager.hpp"
+#include "../Core/Coroutine.hpp"
 #include "../Core/DeclarativeBuilder.hpp"
 #include "../Core/MemoryManager.hpp"
 #include "../Core/ParallelProcessor.hpp"
+#include "../Core/SlabAllocator.hpp"
 
 using namespace DeclarativeUI::Components;
 using namespace DeclarativeUI::Core;
 using namespace DeclarativeUI::Binding;
 
+namespace {
+CoTask<int> coroutineRoundTrips(ThreadPool& pool, int round_trips) {
+    for (int i = 0; i < round_trips; ++i) {
+        co_await resumeOn(pool);
+        co_await resumeOnMainThread();
+    }
+    co_return round_trips;
+}
+
+CoTask<int> inlineStage(int value) { co_return value + 1; }
+
+CoTask<int> coroutineStages(ThreadPool& pool, int stages) {
+    co_await resumeOn(pool);
+    int value = 0;
+    for (int i = 0; i < stages; ++i) {
+        value = co_await inlineStage(value);
+    }
+    co_await resumeOnMainThread();
+    co_return value;
+}
+
+template <typename T>
+void waitOnEventLoop(const QFuture<T>& future) {
+    QEventLoop loop;
+    QFutureWatcher<T> watcher;
+    QObject::connect(&watcher, &QFutureWatcher<T>::finished, &loop,
+                     &QEventLoop::quit);
+    watcher.setFuture(future);
+    loop.exec();
+}
+}  // namespace
+
 class ComponentPerformanceTest : public QObject {
     Q_OBJECT
 
@@ -251,6 +288,86 @@ private slots:
                                       2);  // Less than 50% increase
     }
 
+    void testSlabAllocatorTreeBuild() {
+        // 1 root + 100 rows x (1 row widget + 99 labels) = 10k nodes
+        const int rows = 100;
+        const int labels_per_row = 99;
+        const int nodes = 1 + rows * (1 + labels_per_row);
+
+        auto build_tree = [&]() {
+            auto root = create<QWidget>();
+            root.layout<QVBoxLayout>();
+            for (int r = 0; r < rows; ++r) {
+                root.child<QWidget>([&](DeclarativeBuilder<QWidget>& row) {
+                    row.template layout<QHBoxLayout>();
+                    for (int i = 0; i < labels_per_row; ++i) {
+                        row.template child<QLabel>(
+                            [i](DeclarativeBuilder<QLabel>& label) {
+                                label.property("text", QString::number(i));
+                            });
+                    }
+                });
+            }
+            return root.build();
+        };
+
+        struct Run {
+            qint64 build_ns = 0;
+            size_t general_allocations = 0;  // Hooked objects sent to new
+            size_t slab_allocations = 0;     // Slabs taken from upstream
+            qint64 rss_delta = 0;
+            bool built = false;
+        };
+        ProcessMemorySampler sampler;
+        auto run = [&](bool slab_enabled) {
+            SlabAllocator::set_enabled(slab_enabled);
+            const auto before = SlabAllocator::statistics();
+            const auto rss_before = sampler.sample().rss_bytes;
+
+            QElapsedTimer timer;
+            timer.start();
+            auto tree = build_tree();
+            Run result;
+            result.build_ns = timer.nsecsElapsed();
+
+            const auto after = SlabAllocator::statistics();
+            result.general_allocations =
+                after.fallback_allocations - before.fallback_allocations;
+            result.slab_allocations = after.slab_count - before.slab_count;
+            result.rss_delta = static_cast<qint64>(sampler.sample().rss_bytes) -
+                               static_cast<qint64>(rss_before);
+            result.built = tree != nullptr;
+            return result;
+        };
+
+        // Warm up both paths, then measure
+        run(false);
+        run(true);
+        const Run without_slab = run(false);
+        const Run with_slab = run(true);
+        SlabAllocator::set_enabled(true);
+
+        qDebug() << "Slab allocator," << nodes
+                 << "node DeclarativeBuilder tree:";
+        qDebug() << "  without slab:" << without_slab.build_ns / 1000000.0
+                 << "ms," << without_slab.general_allocations
+                 << "general-purpose allocations, RSS delta"
+                 << without_slab.rss_delta / 1024 << "KB";
+        qDebug() << "  with slab:" << with_slab.build_ns / 1000000.0 << "ms,"
+                 << with_slab.general_allocations
+                 << "general-purpose allocations +"
+                 << with_slab.slab_allocations << "new slabs, RSS delta"
+                 << with_slab.rss_delta / 1024 << "KB";
+
+        // Every UI element goes through the general allocator without slabs;
+        // with them, only the slabs themselves do
+        QVERIFY(without_slab.built && with_slab.built);
+        QVERIFY(without_slab.general_allocations >= size_t(nodes));
+        QVERIFY(with_slab.general_allocations + with_slab.slab_allocations <
+                without_slab.general_allocations);
+        QVERIFY(with_slab.build_ns < 10LL * 1000 * 1000 * 1000);
+    }
+
     void benchmarkCacheManagerOperations() {
         CacheManager cache_manager;
 
@@ -418,6 +535,69 @@ private slots:
         QVERIFY(elapsed < 5000);  // Should complete within 5 seconds
     }
 
+    void testCoroutineHopOverhead() {
+        auto processor = std::make_unique<ParallelProcessor>();
+        const int round_trips = 2000;
+        const int stages = 100000;
+
+        // Existing chain, as in ParallelUICompiler::compileUIAsync: a
+        // QFutureInterface and a processor task per hop to the pool, a
+        // QFutureWatcher signal per hop back
+        QElapsedTimer timer;
+        timer.start();
+        int remaining = round_trips;
+        {
+            QEventLoop loop;
+            QFutureWatcher<int> watcher;
+            auto next = [&]() {
+                QFutureInterface<int> interface;
+                interface.reportStarted();
+                watcher.setFuture(interface.future());
+                processor->submitTask(QString(), TaskPriority::Normal,
+                                      ExecutionContext::ThreadPool,
+                                      [interface]() mutable {
+                                          interface.reportResult(1);
+                                          interface.reportFinished();
+                                      });
+            };
+            connect(&watcher, &QFutureWatcher<int>::finished, &loop, [&]() {
+                if (--remaining == 0) {
+                    loop.quit();
+                } else {
+                    next();
+                }
+            });
+            next();
+            loop.exec();
+        }
+        const qint64 future_chain_ns = timer.nsecsElapsed();
+
+        timer.restart();
+        auto hops =
+            coroutineRoundTrips(processor->threadPool(), round_trips).start();
+        waitOnEventLoop(hops);
+        const qint64 coroutine_ns = timer.nsecsElapsed();
+
+        // Stages that stay on one thread cost no hop at all
+        timer.restart();
+        auto staged = coroutineStages(processor->threadPool(), stages).start();
+        waitOnEventLoop(staged);
+        const qint64 stages_ns = timer.nsecsElapsed();
+
+        qDebug() << "Pool -> main thread round trips:";
+        qDebug() << "  QFutureInterface chain:"
+                 << future_chain_ns / 1000.0 / round_trips << "us per trip";
+        qDebug() << "  coroutine:" << coroutine_ns / 1000.0 / round_trips
+                 << "us per trip";
+        qDebug() << "Coroutine child task on the same thread:"
+                 << static_cast<double>(stages_ns) / stages << "ns per stage";
+
+        QCOMPARE(remaining, 0);
+        QCOMPARE(hops.result(), round_trips);
+        QCOMPARE(staged.result(), stages);
+        QVERIFY(coroutine_ns < 10LL * 1000 * 1000 * 1000);
+    }
+
     // **Stress Testing**
     void testComponentStressTest() {
         const int stress_iterations = 10;
@@ -0,0 +1,513 @@
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QWidget>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "../JSON/JSONParser.hpp"
+#include "../JSON/JSONStreamParser.hpp"
+#include "../JSON/JSONStructuralIndex.hpp"
+#include "../JSON/JSONUILoader.hpp"
+
+using namespace DeclarativeUI::JSON;
+
+/**
+ * @brief Sequential device that generates a JSONC form on demand, so a
+ * document of hundreds of megabytes never exists in memory at once.
+ *
+ * The form is a root widget holding groups of 100 label/line edit rows.
+ */
+class GeneratedFormDevice : public QIODevice {
+public:
+    explicit GeneratedFormDevice(qint64 target_bytes)
+        : target_bytes_(target_bytes) {}
+
+    bool isSequential() const override { return true; }
+    qint64 fieldCount() const { return fields_; }
+
+protected:
+    qint64 readData(char* data, qint64 max_size) override {
+        qint64 written = 0;
+        while (written < max_size) {
+            if (offset_ == pending_.size() && !generate()) {
+                break;
+            }
+            const qint64 n =
+                std::min<qint64>(max_size - written, pending_.size() - offset_);
+            std::memcpy(data + written, pending_.constData() + offset_, n);
+            offset_ += n;
+            written += n;
+        }
+        return written;
+    }
+
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    qint64 target_bytes_;
+    qint64 produced_ = 0;
+    qint64 fields_ = 0;
+    bool finished_ = false;
+    QByteArray pending_;
+    qsizetype offset_ = 0;
+
+    // The next piece of the document into pending_; false at the end
+    bool generate() {
+        if (finished_) {
+            return false;
+        }
+        pending_.clear();
+        offset_ = 0;
+        if (produced_ == 0) {
+            pending_ = "{\n  \"type\": \"QWidget\",\n"
+                       "  \"layout\": {\"type\": \"VBoxLayout\"},\n"
+                       "  \"children\": [\n";
+        } else if (produced_ >= target_bytes_) {
+            pending_ = "  ],\n}\n";
+            finished_ = true;
+        } else {
+            pending_ += "    { // group\n"
+                        "      \"type\": \"QGroupBox\",\n"
+                        "      \"layout\": {\"type\": \"FormLayout\"},\n"
+                        "      \"children\": [\n";
+            for (int row = 0; row < 100; ++row, ++fields_) {
+                const QByteArray id = QByteArray::number(fields_);
+                pending_ += "        {\"type\": \"QLabel\", \"properties\": "
+                            "{\"text\": \"Field " +
+                            id +
+                            "\"}},\n"
+                            "        {\"type\": \"QLineEdit\", "
+                            "\"properties\": {\"objectName\": \"field" +
+                            id + "\", \"maxLength\": 64,}},\n";
+            }
+            pending_ += "      ],\n    },\n";
+        }
+        produced_ += pending_.size();
+        return true;
+    }
+};
+
+/**
+ * @brief Tallies stream events without keeping any of them.
+ */
+class CountingHandler : public JSONStreamHandler {
+public:
+    qint64 objects = 0;
+    qint64 values = 0;
+    qint64 widgets = 0;
+    int max_depth = 0;
+
+    void startObject(const JSONPath& path) override {
+        ++objects;
+        max_depth = std::max(max_depth, int(path.components().size()));
+    }
+    void key(const QString& name, const JSONPath& path) override {
+        // Layouts have a "type" too; a widget's sits in the root or in an
+        // element of "children"
+        if (name != QLatin1String("type")) {
+            return;
+        }
+        const QStringList components = path.components();
+        if (components.size() == 1 ||
+            components[components.size() - 2].startsWith('[')) {
+            ++widgets;
+        }
+    }
+    void value(const QJsonValue&, const JSONPath&) override { ++values; }
+};
+
+/**
+ * @brief Throughput benchmarks for the JSON loading pipeline.
+ *
+ * Inputs are generated JSONC documents of a few megabytes and up, timed
+ * with wall-clock timers since a single pass over 50 MB is already long
+ * enough to measure.
+ */
+class JSONPerformanceTest : public QObject {
+    Q_OBJECT
+
+private:
+    /**
+     * @brief A JSONC UI description of at least target_bytes bytes, with
+     * comments, trailing commas and strings full of comment and comma
+     * look-alikes.
+     */
+    static QByteArray makeJsoncDocument(qsizetype target_bytes) {
+        QByteArray document;
+        document.reserve(target_bytes + 1024);
+        document += "{\n  // Generated screen definition\n  \"widgets\": [\n";
+        for (int i = 0; document.size() < target_bytes; ++i) {
+            document += "    { /* widget ";
+            document += QByteArray::number(i);
+            document += " */\n      \"type\": \"QLabel\",\n"
+                        "      \"text\": \"Item, with // no comment ,]\",\n"
+                        "      \"url\": \"https://example.com/a,b\",\n"
+                        "      \"geometry\": [10, 20, 300, 40,],\n"
+                        "      \"visible\": true, // shown by default\n"
+                        "    },\n";
+        }
+        document += "  ],\n}\n";
+        return document;
+    }
+
+    /**
+     * @brief The QString pipeline JSONParser used before the byte-level
+     * pass: decode, strip comments char by char, regex out trailing
+     * commas, encode again.
+     */
+    static QByteArray legacyPreprocess(const QByteArray& utf8) {
+        const QString source = QString::fromUtf8(utf8);
+        QString result;
+        result.reserve(source.length());
+
+        bool in_string = false;
+        bool escaped = false;
+        bool in_line_comment = false;
+        bool in_block_comment = false;
+        for (int i = 0; i < source.length(); ++i) {
+            const QChar ch = source[i];
+            const QChar next_ch =
+                (i + 1 < source.length()) ? source[i + 1] : QChar();
+            if (in_line_comment) {
+                if (ch == '\n' || ch == '\r') {
+                    in_line_comment = false;
+                    result.append(ch);
+                }
+                continue;
+            }
+            if (in_block_comment) {
+                if (ch == '*' && next_ch == '/') {
+                    in_block_comment = false;
+                    ++i;
+                }
+                continue;
+            }
+            if (!in_string && ch == '/' && next_ch == '/') {
+                in_line_comment = true;
+                ++i;
+                continue;
+            }
+            if (!in_string && ch == '/' && next_ch == '*') {
+                in_block_comment = true;
+                ++i;
+                continue;
+            }
+            if (ch == '"' && !escaped) {
+                in_string = !in_string;
+            }
+            escaped = (ch == '\\' && !escaped);
+            result.append(ch);
+        }
+
+        result.replace(QRegularExpression(R"(,(\s*[}\]]))"), R"(\1)");
+        return result.toUtf8();
+    }
+
+    /**
+     * @brief A form screen of groups of label/line edit rows, written the
+     * way UI files usually are.
+     */
+    static QByteArray makeScreen(int groups, int rows) {
+        QByteArray screen =
+            "{\n  \"type\": \"QWidget\",\n"
+            "  \"properties\": {\"windowTitle\": \"Generated screen\"},\n"
+            "  \"layout\": {\"type\": \"VBoxLayout\", \"spacing\": 6},\n"
+            "  \"children\": [\n";
+        for (int group = 0; group < groups; ++group) {
+            const QByteArray g = QByteArray::number(group);
+            screen += "    {\"type\": \"QGroupBox\", "
+                      "\"properties\": {\"title\": \"Group " +
+                      g +
+                      "\"},\n"
+                      "     \"layout\": {\"type\": \"FormLayout\", "
+                      "\"margins\": [4, 4, 4, 4]},\n"
+                      "     \"children\": [\n";
+            for (int row = 0; row < rows; ++row) {
+                const QByteArray id = g + "_" + QByteArray::number(row);
+                screen += "      {\"type\": \"QLabel\", \"properties\": "
+                          "{\"text\": \"Field " +
+                          id +
+                          "\", \"alignment\": \"AlignRight\", "
+                          "\"toolTip\": \"Help for field " +
+                          id +
+                          "\"}},\n"
+                          "      {\"type\": \"QLineEdit\", \"properties\": "
+                          "{\"objectName\": \"field" +
+                          id +
+                          "\", \"placeholderText\": \"Value\", "
+                          "\"maxLength\": 64, \"enabled\": true}}";
+                screen += row + 1 < rows ? ",\n" : "\n";
+            }
+            screen += group + 1 < groups ? "    ]},\n" : "    ]}\n";
+        }
+        screen += "  ]\n}\n";
+        return screen;
+    }
+
+    template <typename F>
+    static double millisecondsFor(F&& f) {
+        QElapsedTimer timer;
+        timer.start();
+        f();
+        return timer.nsecsElapsed() / 1e6;
+    }
+
+    // Best of a few runs: the first one also pays for page faults
+    template <typename F>
+    static double bestMillisecondsFor(F&& f) {
+        double best = millisecondsFor(f);
+        for (int run = 1; run < 3; ++run) {
+            best = std::min(best, millisecondsFor(f));
+        }
+        return best;
+    }
+
+    // Best of a few loads, each destroyed outside the timing; the widget
+    // count (root included) goes to widget_count
+    template <typename Load>
+    static double bestLoadMilliseconds(Load&& load, int* widget_count) {
+        double best = 0;
+        for (int run = 0; run < 3; ++run) {
+            std::unique_ptr<QWidget> root;
+            const double ms = millisecondsFor([&]() { root = load(); });
+            best = run == 0 ? ms : std::min(best, ms);
+            *widget_count = root->findChildren<QWidget*>().size() + 1;
+        }
+        return best;
+    }
+
+    static double gigabytesPerSecond(qsizetype bytes, double ms) {
+        return static_cast<double>(bytes) / (ms / 1000.0) / 1e9;
+    }
+
+    // Peak resident set size in KiB, or -1 where it cannot be read
+    static qint64 peakResidentKiB() {
+        QFile status("/proc/self/status");
+        if (!status.open(QIODevice::ReadOnly)) {
+            return -1;
+        }
+        for (const QByteArray& line : status.readAll().split('\n')) {
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+            }
+        }
+        return -1;
+    }
+
+    // Restart peak tracking at the current size (Linux 4.0+)
+    static bool resetPeakResident() {
+        QFile clear_refs("/proc/self/clear_refs");
+        return clear_refs.open(QIODevice::WriteOnly) &&
+               clear_refs.write("5") == 1;
+    }
+
+private slots:
+    // **JSONC preprocessing: QString round-trips vs preprocessJson**
+    void benchmarkJsoncPreprocessing() {
+        for (const qsizetype megabytes : {1, 10, 50}) {
+            const QByteArray document = makeJsoncDocument(megabytes << 20);
+            const double mib = static_cast<double>(document.size()) / (1 << 20);
+
+            QByteArray legacy;
+            const double legacy_ms =
+                millisecondsFor([&]() { legacy = legacyPreprocess(document); });
+
+            QByteArray bytes;
+            const double bytes_ms = millisecondsFor([&]() {
+                bytes = document;
+                JSONParser::preprocessJson(bytes);
+            });
+
+            QJsonDocument parsed;
+            const double parse_ms = millisecondsFor(
+                [&]() { parsed = QJsonDocument::fromJson(bytes); });
+            QVERIFY(parsed.isObject());
+
+            // The regex also strips ",]" inside strings, so only the byte
+            // pass must reproduce the strings exactly
+            const QJsonObject widget =
+                parsed.object()["widgets"].toArray().first().toObject();
+            QCOMPARE(widget["text"].toString(),
+                     QString("Item, with // no comment ,]"));
+            QCOMPARE(widget["geometry"].toArray().size(), 4);
+
+            qDebug() << "JSONC preprocessing," << mib << "MiB:";
+            qDebug() << "  QString + regex:" << legacy_ms << "ms ="
+                     << mib / (legacy_ms / 1000.0) << "MiB/s";
+            qDebug() << "  preprocessJson:" << bytes_ms << "ms ="
+                     << mib / (bytes_ms / 1000.0) << "MiB/s"
+                     << "speedup =" << legacy_ms / bytes_ms;
+            qDebug() << "  QJsonDocument::fromJson afterwards:" << parse_ms
+                     << "ms";
+        }
+    }
+
+    // **Stage-1 structural indexing and index-driven parsing**
+    void benchmarkStructuralIndex() {
+        using Backend = JSONStructuralIndex::Backend;
+        for (const qsizetype megabytes : {1, 10, 50}) {
+            const QByteArray document = makeJsoncDocument(megabytes << 20);
+            const qsizetype bytes = document.size();
+            qDebug() << "Structural index," << bytes / (1 << 20) << "MiB:";
+
+            JSONStructuralIndex index;
+            for (Backend backend :
+                 {Backend::Scalar, Backend::SSE42, Backend::AVX2}) {
+                if (!JSONStructuralIndex::isSupported(backend)) {
+                    continue;
+                }
+                const double ms = bestMillisecondsFor(
+                    [&]() { index.build(document, backend); });
+                const char* name = JSONStructuralIndex::backendName(backend);
+                qDebug() << "  stage 1," << name << ":"
+                         << gigabytesPerSecond(bytes, ms) << "GB/s";
+            }
+
+            // The JSONParser path so far: strip, then QJsonDocument
+            QJsonDocument expected;
+            const double current_ms = bestMillisecondsFor([&]() {
+                QByteArray text = document;
+                JSONParser::preprocessJson(text);
+                expected = QJsonDocument::fromJson(text);
+            });
+            QVERIFY(expected.isObject());
+
+            // Index once, then build the document from the positions
+            QJsonDocument parsed;
+            const double indexed_ms = bestMillisecondsFor([&]() {
+                index.build(document);
+                parsed = index.parse(document, true);
+            });
+            QCOMPARE(parsed, expected);
+
+            qDebug() << "  strip + fromJson:"
+                     << gigabytesPerSecond(bytes, current_ms) << "GB/s";
+            qDebug() << "  index + parse:"
+                     << gigabytesPerSecond(bytes, indexed_ms) << "GB/s"
+                     << "speedup =" << current_ms / indexed_ms;
+        }
+    }
+
+    // **Streaming a generated form vs materializing a QJsonDocument**
+    void benchmarkStreamingParser() {
+        for (const qint64 megabytes : {20, 200}) {
+            GeneratedFormDevice device(megabytes << 20);
+            QVERIFY(device.open(QIODevice::ReadOnly));
+
+            const bool tracked = resetPeakResident();
+            const qint64 before_kib = peakResidentKiB();
+            CountingHandler counter;
+            JSONStreamParser parser;
+            bool ok = false;
+            const double stream_ms =
+                millisecondsFor([&]() { ok = parser.parse(device, counter); });
+            QVERIFY2(ok, qPrintable(parser.errorString()));
+            const qint64 stream_kib = peakResidentKiB() - before_kib;
+
+            // Root, groups, and two widgets per field
+            QCOMPARE(counter.widgets,
+                     1 + device.fieldCount() / 100 + 2 * device.fieldCount());
+            QCOMPARE(counter.max_depth, 5);
+
+            qDebug() << "Streaming parse," << megabytes << "MiB,"
+                     << counter.widgets << "widgets:";
+            qDebug() << "  JSONStreamParser:" << stream_ms << "ms ="
+                     << megabytes / (stream_ms / 1000.0) << "MiB/s";
+            if (tracked && before_kib >= 0) {
+                qDebug() << "  peak memory growth:" << stream_kib / 1024.0
+                         << "MiB";
+                // Bounded by depth: one chunk, one token, a few frames
+                QVERIFY(stream_kib < 64 * 1024);
+            }
+
+            if (megabytes > 20) {
+                continue;  // The document path needs several times the size
+            }
+            GeneratedFormDevice whole(megabytes << 20);
+            QVERIFY(whole.open(QIODevice::ReadOnly));
+            resetPeakResident();
+            const qint64 dom_before_kib = peakResidentKiB();
+            QJsonDocument document;
+            const double dom_ms = millisecondsFor([&]() {
+                QByteArray text = whole.readAll();
+                JSONParser::preprocessJson(text);
+                document = QJsonDocument::fromJson(text);
+            });
+            QVERIFY(document.isObject());
+            qDebug() << "  readAll + QJsonDocument:" << dom_ms << "ms ="
+                     << megabytes / (dom_ms / 1000.0) << "MiB/s";
+            if (tracked && dom_before_kib >= 0) {
+                qDebug() << "  peak memory growth:"
+                         << (peakResidentKiB() - dom_before_kib) / 1024.0
+                         << "MiB";
+            }
+        }
+    }
+
+    // **2k-widget screen: loading JSON vs a compiled, mapped UI image**
+    void benchmarkCompiledUILoading() {
+        constexpr int kGroups = 20;
+        constexpr int kRows = 50;
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QByteArray screen = makeScreen(kGroups, kRows);
+        const QString json_path = dir.filePath("screen.json");
+        QFile json_file(json_path);
+        QVERIFY(json_file.open(QIODevice::WriteOnly));
+        json_file.write(screen);
+        json_file.close();
+
+        JSONUILoader loader;
+        QByteArray image;
+        const double compile_ms = millisecondsFor([&]() {
+            image = loader.compileImage(JSONParser().parseFile(json_path));
+        });
+        const QString image_path = dir.filePath("screen.uibin");
+        QFile image_file(image_path);
+        QVERIFY(image_file.open(QIODevice::WriteOnly));
+        image_file.write(image);
+        image_file.close();
+
+        int json_widgets = 0;
+        int parsed_widgets = 0;
+        int image_widgets = 0;
+        const double json_ms = bestLoadMilliseconds(
+            [&]() { return loader.loadFromFile(json_path); }, &json_widgets);
+        const double parsed_ms = bestLoadMilliseconds(
+            [&]() {
+                return loader.loadFromObject(
+                    JSONParser().parseFile(json_path));
+            },
+            &parsed_widgets);
+        const double image_ms = bestLoadMilliseconds(
+            [&]() { return loader.loadFromCompiledFile(image_path); },
+            &image_widgets);
+
+        // Root, groups, and a label and line edit per row
+        QCOMPARE(json_widgets, 1 + kGroups * (1 + 2 * kRows));
+        QCOMPARE(parsed_widgets, json_widgets);
+        QCOMPARE(image_widgets, json_widgets);
+
+        qDebug() << "Screen of" << json_widgets << "widgets,"
+                 << screen.size() / 1024 << "KiB JSON," << image.size() / 1024
+                 << "KiB image:";
+        qDebug() << "  parseFile + compileImage:" << compile_ms << "ms";
+        qDebug() << "  loadFromFile:" << json_ms << "ms";
+        qDebug() << "  parseFile + loadFromObject:" << parsed_ms << "ms";
+        qDebug() << "  loadFromCompiledFile:" << image_ms << "ms"
+                 << "speedup =" << json_ms / image_ms << "/"
+                 << parsed_ms / image_ms;
+    }
+};
+
+QTEST_MAIN(JSONPerformanceTest)
+#include "test_json_performance.moc"
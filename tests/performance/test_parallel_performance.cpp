@@ -0,0 +1,273 @@
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTextStream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../Core/ParallelProcessor.hpp"
+
+using namespace DeclarativeUI::Core;
+
+/**
+ * @brief Throughput and scaling benchmarks for ThreadPool and
+ * ParallelProcessor.
+ *
+ * Wall-clock timing over fixed workloads instead of QBENCHMARK, since each
+ * run spreads over the whole pool. Results are reported, not asserted;
+ * only the computed values are checked.
+ */
+class ParallelPerformanceTest : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int kEmptyTaskCount = 1000000;
+    static constexpr int kFibArgument = 27;
+    static constexpr long kFibResult = 196418;
+    static constexpr int kReadFileCount = 1000;
+
+    static const char* modeName(ThreadPool::SchedulingMode mode) {
+        return mode == ThreadPool::SchedulingMode::WorkStealing
+                   ? "work-stealing"
+                   : "shared-queue";
+    }
+
+    template <typename F>
+    static double secondsFor(F&& f) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    /**
+     * @brief 1, 2, 4, ... threads, up to the hardware concurrency.
+     */
+    static std::vector<size_t> threadCounts() {
+        const size_t hardware =
+            std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        std::vector<size_t> counts;
+        for (size_t count = 1; count < hardware; count *= 2) {
+            counts.push_back(count);
+        }
+        counts.push_back(hardware);
+        return counts;
+    }
+
+    // Fork-join Fibonacci: fork n-1, compute n-2 inline, join
+    static long forkJoinFib(ThreadPool& pool, int n) {
+        if (n < 12) {
+            long a = 0, b = 1;
+            for (int i = 0; i < n; ++i) {
+                const long next = a + b;
+                a = b;
+                b = next;
+            }
+            return a;
+        }
+        auto left = pool.enqueue(TaskPriority::Normal, [&pool, n]() {
+            return forkJoinFib(pool, n - 1);
+        });
+        const long right = forkJoinFib(pool, n - 2);
+        pool.wait_for(left);
+        return left.get() + right;
+    }
+
+private slots:
+    // **1M empty tasks, shared queue vs work stealing**
+    void benchmarkEmptyTaskThroughput() {
+        const size_t threads =
+            std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+        for (auto mode : {ThreadPool::SchedulingMode::SharedQueue,
+                          ThreadPool::SchedulingMode::WorkStealing}) {
+            ThreadPool pool(threads, mode);
+            std::atomic<int> done{0};
+            const double seconds = secondsFor([&]() {
+                for (int i = 0; i < kEmptyTaskCount; ++i) {
+                    pool.post(TaskPriority::Normal, [&done]() {
+                        done.fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+                while (done.load() < kEmptyTaskCount) {
+                    pool.try_run_one();
+                }
+            });
+
+            qDebug() << modeName(mode) << ":" << kEmptyTaskCount
+                     << "empty tasks on" << threads << "threads in"
+                     << seconds * 1000.0 << "ms ="
+                     << kEmptyTaskCount / seconds / 1e6 << "M tasks/s";
+            QCOMPARE(pool.queued_tasks(), size_t(0));
+        }
+    }
+
+    // **Fork-join recursion at 1..N threads in both modes**
+    void benchmarkForkJoinScaling() {
+        for (auto mode : {ThreadPool::SchedulingMode::SharedQueue,
+                          ThreadPool::SchedulingMode::WorkStealing}) {
+            double single_thread_seconds = 0.0;
+            for (size_t threads : threadCounts()) {
+                ThreadPool pool(threads, mode);
+
+                long result = 0;
+                const double seconds = secondsFor([&]() {
+                    auto future = pool.enqueue(TaskPriority::Normal, [&pool]() {
+                        return forkJoinFib(pool, kFibArgument);
+                    });
+                    pool.wait_for(future);
+                    result = future.get();
+                });
+                QCOMPARE(result, kFibResult);
+
+                if (threads == 1) {
+                    single_thread_seconds = seconds;
+                }
+                qDebug() << modeName(mode) << ": fork-join fib("
+                         << kFibArgument << ") on" << threads << "threads in"
+                         << seconds * 1000.0 << "ms, speedup"
+                         << single_thread_seconds / seconds << "x, steals"
+                         << pool.steal_count();
+            }
+        }
+    }
+
+    // **parallelFor / parallelTransformReduce / parallelSort vs serial**
+    void benchmarkDataParallelPrimitives() {
+        ParallelProcessor processor;
+        std::mt19937 random(7);
+
+        for (size_t n = 1000; n <= 10000000; n *= 10) {
+            std::vector<double> values(n);
+            for (double& value : values) {
+                value = static_cast<double>(random() % 1000) / 10.0;
+            }
+
+            // parallelFor: light per-element work
+            std::vector<double> serial_out(n);
+            std::vector<double> parallel_out(n);
+            const double serial_for = secondsFor([&]() {
+                for (size_t i = 0; i < n; ++i) {
+                    serial_out[i] = std::sqrt(values[i]) * 1.5 + 1.0;
+                }
+            });
+            const double parallel_for = secondsFor([&]() {
+                processor.parallelFor(size_t(0), n, [&](size_t i) {
+                    parallel_out[i] = std::sqrt(values[i]) * 1.5 + 1.0;
+                });
+            });
+            QVERIFY(serial_out == parallel_out);
+
+            // parallelTransformReduce: sum of squares
+            double serial_sum = 0.0;
+            const double serial_reduce = secondsFor([&]() {
+                for (double value : values) {
+                    serial_sum += value * value;
+                }
+            });
+            double parallel_sum = 0.0;
+            const double parallel_reduce = secondsFor([&]() {
+                parallel_sum = processor.parallelTransformReduce(
+                    values.begin(), values.end(), 0.0, std::plus<>(),
+                    [](double value) { return value * value; });
+            });
+            QVERIFY(std::abs(serial_sum - parallel_sum) <= serial_sum * 1e-9);
+
+            // parallelSort
+            auto serial_sorted = values;
+            auto parallel_sorted = values;
+            const double serial_sort = secondsFor([&]() {
+                std::sort(serial_sorted.begin(), serial_sorted.end());
+            });
+            const double parallel_sort = secondsFor([&]() {
+                processor.parallelSort(parallel_sorted.begin(),
+                                       parallel_sorted.end());
+            });
+            QVERIFY(serial_sorted == parallel_sorted);
+
+            qDebug() << "n =" << n << ": parallelFor"
+                     << serial_for / parallel_for
+                     << "x, parallelTransformReduce"
+                     << serial_reduce / parallel_reduce << "x, parallelSort"
+                     << serial_sort / parallel_sort << "x ("
+                     << parallel_sort * 1000.0 << "ms)";
+        }
+    }
+
+    // **1k-file batch reads from tmpfs: serial vs decoded vs views**
+    void benchmarkTmpfsFileReads() {
+        // /dev/shm is tmpfs on Linux, so this measures the read path rather
+        // than the disk
+        const QString base =
+            QDir("/dev/shm").exists() ? "/dev/shm" : QDir::tempPath();
+        QTemporaryDir dir(base + "/dui_reads_XXXXXX");
+        QVERIFY(dir.isValid());
+
+        // 2 KiB to 256 KiB, so both read paths of FileView run
+        QStringList paths;
+        qint64 total_bytes = 0;
+        for (int i = 0; i < kReadFileCount; ++i) {
+            const int size = 2048 << (i % 8);
+            const QString path = dir.filePath(QString("ui_%1.json").arg(i));
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write(QByteArray(size, static_cast<char>('a' + i % 26)));
+            paths.append(path);
+            total_bytes += size;
+        }
+        const double megabytes = static_cast<double>(total_bytes) / (1 << 20);
+
+        // The previous implementation: one task decoding every file in turn
+        QStringList serial_contents;
+        const double serial = secondsFor([&]() {
+            for (const QString& path : paths) {
+                QFile file(path);
+                if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                    QTextStream stream(&file);
+                    serial_contents.append(stream.readAll());
+                }
+            }
+        });
+
+        ParallelFileProcessor file_processor;
+        QStringList parallel_contents;
+        const double decoded = secondsFor([&]() {
+            auto future = file_processor.readFilesAsync(paths);
+            future.waitForFinished();
+            parallel_contents = future.result();
+        });
+        QVERIFY(serial_contents == parallel_contents);
+
+        // Touch every byte so mapped pages are actually read in
+        qint64 viewed_bytes = 0;
+        qint64 letters = 0;
+        const double views = secondsFor([&]() {
+            auto future = file_processor.readFileViewsAsync(paths);
+            future.waitForFinished();
+            for (const FileView& view : future.result()) {
+                viewed_bytes += view.size();
+                letters += std::count_if(view.data(), view.data() + view.size(),
+                                         [](char c) { return c >= 'a'; });
+            }
+        });
+        QCOMPARE(viewed_bytes, total_bytes);
+        QCOMPARE(letters, total_bytes);
+
+        qDebug() << kReadFileCount << "files," << megabytes
+                 << "MiB: serial QTextStream" << megabytes / serial
+                 << "MiB/s, readFilesAsync" << megabytes / decoded
+                 << "MiB/s, readFileViewsAsync" << megabytes / views << "MiB/s";
+    }
+};
+
+QTEST_MAIN(ParallelPerformanceTest)
+#include "test_parallel_performance.moc"
@@ -2,7 +2,11 @@
 #include <QApplication>
 #include <QWidget>
 #include <QJsonObject>
+#include <QTemporaryDir>
+#include <atomic>
 #include <memory>
+#include <stdexcept>
+#include <thread>
 
 #include "../../src/Core/CacheManager.hpp"
 
@@ -199,6 +203,535 @@ private slots:
         QCOMPARE(results["key3"], QString("value3"));
         QVERIFY(results.find("nonexistent") == results.end());
     }
+
+    // Test sharded mode with CLOCK recency
+    void testShardedCacheOperations() {
+        LRUCache<QString, QString> cache(8, 1, 3); // Rounded up to 4 shards
+        QCOMPARE(cache.shardCount(), size_t(4));
+
+        // A key that is read between every insert must survive eviction
+        cache.put("hot", "hot_value");
+        for (int i = 0; i < 200; ++i) {
+            cache.put(QString("cold_%1").arg(i), "cold_value");
+            QCOMPARE(cache.get("hot").value_or(QString()), QString("hot_value"));
+        }
+
+        QVERIFY(cache.size() <= 8);
+        auto stats = cache.getStatistics();
+        QCOMPARE(stats.cache_hits, size_t(200));
+        QVERIFY(stats.evictions > 0);
+
+        QVERIFY(cache.remove("hot"));
+        QVERIFY(!cache.contains("hot"));
+
+        cache.clear();
+        QCOMPARE(cache.size(), size_t(0));
+        QCOMPARE(cache.memoryUsage(), size_t(0));
+
+        // Entries larger than a shard's share are still cached, up to the
+        // whole memory limit
+        LRUCache<QString, QByteArray> blobs(100, 1, 16);
+        const QByteArray large(256 * 1024, 'l');  // 4x a 64 KiB share
+        QVERIFY(blobs.put("large", large));
+        QCOMPARE(blobs.get("large").value_or(QByteArray()), large);
+        QVERIFY(!blobs.put("too_large", QByteArray(2 * 1024 * 1024, 't')));
+        QVERIFY(!blobs.contains("too_large"));
+
+        cache_manager->setCacheShardCount("json", 8);
+        QCOMPARE(cache_manager->getCacheStatistics("json")["shard_count"].toInt(), 8);
+        QJsonObject obj;
+        obj["name"] = "sharded";
+        cache_manager->cacheJSON("config", obj);
+        QCOMPARE(cache_manager->getCachedJSON("config")["name"].toString(),
+                 QString("sharded"));
+    }
+
+    // Test that a warm cache recycles slab slots instead of allocating
+    void testWarmPutAllocations() {
+        LRUCache<QString, QString> cache(32, 1);
+
+        // Warm up: fill past capacity so the slab and index reach full size
+        for (int i = 0; i < 64; ++i) {
+            cache.put(QString("warm_%1").arg(i), "value");
+        }
+        auto warm = cache.getStatistics();
+        QVERIFY(warm.storage_allocations > 0);
+
+        // Steady state: every insert evicts one entry and reuses its slot
+        for (int i = 0; i < 1000; ++i) {
+            cache.put(QString("steady_%1").arg(i), "value");
+        }
+        auto steady = cache.getStatistics();
+        QCOMPARE(steady.storage_allocations, warm.storage_allocations);
+        QCOMPARE(steady.slot_reuses - warm.slot_reuses, size_t(1000));
+        QCOMPARE(cache.size(), size_t(32));
+
+        // Overwrites update the slot in place
+        cache.put("steady_999", "updated");
+        QCOMPARE(cache.get("steady_999").value_or(QString()), QString("updated"));
+        QCOMPARE(cache.getStatistics().slot_reuses, steady.slot_reuses);
+    }
+
+    // Test transparent compression and the hot tier
+    void testCompression() {
+        cache_manager->enableCompressionForCache("files", true);
+        cache_manager->enableCompressionForCache("json", true);
+
+        QByteArray content;
+        for (int i = 0; i < 500; ++i) {
+            content += QString("{\"type\": \"QLabel\", \"id\": %1}\n")
+                           .arg(i)
+                           .toUtf8();
+        }
+        cache_manager->cacheFileContent("/ui/main.json", content);
+
+        // First reads inflate, later reads are served from the hot tier
+        for (int i = 0; i < 4; ++i) {
+            QCOMPARE(cache_manager->getCachedFileContent("/ui/main.json"),
+                     content);
+        }
+
+        auto file_stats = cache_manager->getCacheStatistics("files");
+        QVERIFY(file_stats["compression_enabled"].toBool());
+        QCOMPARE(file_stats["compressed_entries"].toInt(), 1);
+        QVERIFY(file_stats["compression_ratio"].toDouble() > 2.0);
+        QCOMPARE(file_stats["decompressions"].toInt(), 2);
+        QCOMPARE(file_stats["hot_tier_hits"].toInt(), 2);
+
+        // Small values stay uncompressed
+        cache_manager->cacheFileContent("/ui/tiny.json", "{}");
+        QCOMPARE(cache_manager->getCachedFileContent("/ui/tiny.json"),
+                 QByteArray("{}"));
+        QCOMPARE(
+            cache_manager->getCacheStatistics("files")["compressed_entries"]
+                .toInt(),
+            1);
+
+        QJsonObject json;
+        for (int i = 0; i < 300; ++i) {
+            json[QString("property_%1").arg(i)] = "repeated value text";
+        }
+        cache_manager->cacheJSON("large", json);
+        QCOMPARE(cache_manager->getCachedJSON("large"), json);
+        QCOMPARE(
+            cache_manager->getCacheStatistics("json")["compressed_entries"]
+                .toInt(),
+            1);
+
+        // Overwriting or removing releases the compressed payload
+        cache_manager->invalidateKey("files", "/ui/main.json");
+        QCOMPARE(
+            cache_manager->getCacheStatistics("files")["compressed_entries"]
+                .toInt(),
+            0);
+    }
+    // Test that W-TinyLFU keeps a hot working set through a bulk load
+    void testTinyLfuScanResistance() {
+        LRUCache<QString, QString> cache(100, 1);
+        cache.setEvictionPolicy(EvictionPolicy::WTinyLFU);
+
+        // Establish a frequently read working set
+        for (int round = 0; round < 5; ++round) {
+            for (int i = 0; i < 50; ++i) {
+                QString key = QString("hot_%1").arg(i);
+                if (!cache.get(key).has_value()) {
+                    cache.put(key, "hot");
+                }
+            }
+        }
+
+        // A one-off preload far larger than the cache
+        std::unordered_map<QString, QString> bulk;
+        for (int i = 0; i < 2000; ++i) {
+            bulk[QString("bulk_%1").arg(i)] = "cold";
+        }
+        cache.putBatch(bulk);
+
+        int survivors = 0;
+        for (int i = 0; i < 50; ++i) {
+            survivors += cache.contains(QString("hot_%1").arg(i)) ? 1 : 0;
+        }
+        QVERIFY(survivors >= 45);
+        QCOMPARE(cache.size(), size_t(100));
+
+        // Switching back to LRU folds the segments into one list
+        cache.setEvictionPolicy(EvictionPolicy::LRU);
+        for (int i = 0; i < 200; ++i) {
+            cache.put(QString("after_%1").arg(i), "value");
+        }
+        QCOMPARE(cache.size(), size_t(100));
+        QVERIFY(!cache.contains("hot_0"));
+    }
+
+    void testPersistentJSONCache() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString store_path = dir.filePath("json.dcache");
+        const QString ui_path = dir.filePath("main.json");
+
+        auto writeFile = [](const QString& path, const QByteArray& content) {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            file.write(content);
+        };
+
+        const QByteArray content = R"({"type": "QLabel", "text": "Hi"})";
+        writeFile(ui_path, content);
+        QJsonObject parsed;
+        parsed["type"] = "QLabel";
+        parsed["text"] = "Hi";
+
+        QVERIFY(cache_manager->enablePersistentJSONCache(store_path));
+        cache_manager->cacheJSONFile(ui_path, content, parsed);
+        QCOMPARE(cache_manager->getCachedJSONFile(ui_path).value(), parsed);
+
+        // A new manager simulates a restart and is warmed from disk
+        cache_manager = std::make_unique<CacheManager>();
+        QVERIFY(cache_manager->enablePersistentJSONCache(store_path));
+        QJsonObject stats =
+            cache_manager->getCacheStatistics()["persistent_json_cache"]
+                .toObject();
+        QCOMPARE(stats["warmed_entries"].toInt(), 1);
+        QCOMPARE(cache_manager->getCachedJSONFile(ui_path).value(), parsed);
+
+        // Editing the file invalidates memory and disk entries
+        writeFile(ui_path, R"({"type": "QLabel", "text": "Changed"})");
+        QVERIFY(!cache_manager->getCachedJSONFile(ui_path).has_value());
+        cache_manager->disablePersistentJSONCache();
+
+        PersistentCacheStore store(store_path);
+        QVERIFY(store.open());
+        QCOMPARE(store.statistics().live_records, size_t(0));
+    }
+
+    void testPersistentStoreRecovery() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString store_path = dir.filePath("store.dcache");
+        const PersistentCacheStamp stamp{1000, 4, 42};
+
+        {
+            PersistentCacheStore store(store_path);
+            QVERIFY(store.open());
+            QVERIFY(store.put("a", stamp, "payload-a"));
+            QVERIFY(store.put("b", stamp, "payload-b"));
+        }
+
+        // Simulate a crash in the middle of an append
+        {
+            QFile file(store_path);
+            QVERIFY(file.open(QIODevice::Append));
+            file.write(QByteArray(20, '\x7f'));
+        }
+
+        PersistentCacheStore store(store_path);
+        QVERIFY(store.open());
+        QCOMPARE(store.statistics().recovered_bytes, size_t(20));
+        QCOMPARE(store.payload("a").value(), QByteArray("payload-a"));
+        QCOMPARE(store.stamp("b").value(), stamp);
+
+        // Size cap: old records are dropped by compaction
+        store.setMaxBytes(64 * 1024);
+        const QByteArray blob(2000, 'x');
+        for (int i = 0; i < 100; ++i) {
+            QVERIFY(store.put(QString("key_%1").arg(i), stamp, blob));
+        }
+        const PersistentCacheStatistics stats = store.statistics();
+        QVERIFY(stats.file_size <= 64 * 1024);
+        QVERIFY(stats.compactions > 0);
+        QVERIFY(!store.contains("key_0"));
+        QCOMPARE(store.payload("key_99").value(), blob);
+    }
+
+    void testGetOrComputeCoalescing() {
+        LRUCache<QString, QString> cache(100, 1, 4);
+        std::atomic<int> loader_runs{0};
+        std::atomic<bool> start{false};
+
+        auto slow_loader = [&]() {
+            ++loader_runs;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            return QString("computed");
+        };
+
+        std::vector<std::thread> threads;
+        std::vector<QString> results(8);
+        for (int i = 0; i < 8; ++i) {
+            threads.emplace_back([&, i]() {
+                while (!start.load()) {
+                    std::this_thread::yield();
+                }
+                results[i] = cache.getOrCompute("shared", slow_loader);
+            });
+        }
+        start.store(true);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        QCOMPARE(loader_runs.load(), 1);
+        for (const QString& result : results) {
+            QCOMPARE(result, QString("computed"));
+        }
+        const auto stats = cache.getStatistics();
+        QCOMPARE(stats.loader_calls, size_t(1));
+        QVERIFY(stats.coalesced_loads >= 1);
+
+        // Later calls are plain hits
+        bool hit = false;
+        QCOMPARE(cache.getOrCompute("shared", slow_loader, &hit),
+                 QString("computed"));
+        QVERIFY(hit);
+        QCOMPARE(loader_runs.load(), 1);
+
+        // Each call is one request: the re-check under the flight lock and
+        // the publishing put() are not counted again
+        const auto counted = cache.getStatistics();
+        QCOMPARE(counted.total_requests, size_t(9));
+        QCOMPARE(counted.cache_misses, size_t(8));
+        QCOMPARE(counted.cache_hits, size_t(1));
+    }
+
+    void testGetOrComputeNegativeCaching() {
+        LRUCache<QString, QString> cache(100, 1);
+        cache.setNegativeCacheTTL(std::chrono::seconds(60));
+
+        int loader_runs = 0;
+        auto failing_loader = [&]() -> QString {
+            ++loader_runs;
+            throw std::runtime_error("missing include");
+        };
+
+        for (int attempt = 0; attempt < 3; ++attempt) {
+            bool threw = false;
+            try {
+                cache.getOrCompute("broken", failing_loader);
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            QVERIFY(threw);
+        }
+        QCOMPARE(loader_runs, 1);
+        QCOMPARE(cache.getStatistics().negative_cache_hits, size_t(2));
+
+        // Inserting the key clears the remembered failure
+        cache.put("broken", "fixed");
+        QCOMPARE(cache.getOrCompute("broken", failing_loader),
+                 QString("fixed"));
+
+        // Without a TTL every call retries
+        LRUCache<QString, QString> retrying(100, 1);
+        loader_runs = 0;
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            try {
+                retrying.getOrCompute("broken", failing_loader);
+            } catch (const std::runtime_error&) {
+            }
+        }
+        QCOMPARE(loader_runs, 2);
+    }
+
+    void testCacheManagerGetOrCompute() {
+        int loader_runs = 0;
+        auto loader = [&]() {
+            ++loader_runs;
+            QJsonObject json;
+            json["type"] = "QPushButton";
+            return json;
+        };
+
+        QJsonObject first = cache_manager->getOrComputeJSON("button", loader);
+        QJsonObject second = cache_manager->getOrComputeJSON("button", loader);
+        QCOMPARE(first, second);
+        QCOMPARE(loader_runs, 1);
+        QCOMPARE(cache_manager->getCachedJSON("button"), first);
+
+        QJsonObject stats = cache_manager->getCacheStatistics();
+        QVERIFY(stats.contains("coalesced_loads"));
+        QCOMPARE(stats["caches"]
+                     .toObject()["json_cache"]
+                     .toObject()["loader_calls"]
+                     .toInt(),
+                 1);
+    }
+
+    void testTimerWheelExpiry() {
+        LRUCache<QString, QString> cache(10000, 10, 4);
+
+        for (int i = 0; i < 500; ++i) {
+            const QString id = QString::number(i);
+            cache.put("short_" + id, "value", std::chrono::milliseconds(30));
+            cache.put("long_" + id, "value", std::chrono::hours(1));
+        }
+        cache.put("forever", "value");
+
+        // The default TTL applies to plain put() calls as well as batches
+        cache.setTTL(std::chrono::milliseconds(30));
+        cache.put("default_ttl", "value");
+        QVERIFY(cache.contains("default_ttl"));
+
+        QThread::msleep(80);
+
+        // Lazy checks hide expired entries before cleanup() runs
+        QVERIFY(!cache.contains("short_0"));
+        QVERIFY(!cache.contains("default_ttl"));
+
+        cache.cleanup();
+        QCOMPARE(cache.size(), size_t(501));
+        QCOMPARE(cache.getStatistics().expirations, size_t(501));
+        QCOMPARE(cache.get("long_499").value_or(QString()), QString("value"));
+        QCOMPARE(cache.get("forever").value_or(QString()), QString("value"));
+
+        // Re-putting an entry reschedules it instead of keeping the old
+        // deadline
+        cache.put("long_0", "value", std::chrono::milliseconds(10));
+        QThread::msleep(40);
+        cache.cleanup();
+        QVERIFY(!cache.contains("long_0"));
+        QCOMPARE(cache.size(), size_t(500));
+    }
+
+    void testSizeEstimators() {
+        const QByteArray bytes(10000, 'x');
+        const size_t bytes_size =
+            CacheSizeEstimator<QByteArray>::estimate(bytes);
+        QVERIFY(bytes_size >= 10000 && bytes_size < 10100);
+        QCOMPARE(CacheSizeEstimator<QByteArray>::estimate(QByteArray()),
+                 size_t(0));
+
+        // QString is charged for capacity, two bytes per code unit
+        QString text;
+        text.reserve(1000);
+        text = "short";
+        QVERIFY(CacheSizeEstimator<QString>::estimate(text) >= 2000);
+        QCOMPARE(CacheSizeEstimator<QVariant>::estimate(QVariant(text)),
+                 CacheSizeEstimator<QString>::estimate(text));
+
+        QJsonObject leaf;
+        leaf["label"] = QString(500, 'a');
+        QJsonObject tree;
+        tree["child"] = leaf;
+        tree["other"] = leaf;
+        QVERIFY(CacheSizeEstimator<QJsonObject>::estimate(tree) >
+                2 * CacheSizeEstimator<QJsonObject>::estimate(leaf));
+        QVERIFY(CacheSizeEstimator<QJsonObject>::estimate(leaf) >= 500);
+
+        // Widgets are charged for their whole subtree
+        auto widget = std::make_shared<QWidget>();
+        const size_t empty_size =
+            CacheSizeEstimator<std::shared_ptr<QWidget>>::estimate(widget);
+        for (int i = 0; i < 10; ++i) {
+            new QWidget(widget.get());
+        }
+        const size_t tree_size =
+            CacheSizeEstimator<std::shared_ptr<QWidget>>::estimate(widget);
+        QVERIFY(tree_size >= empty_size * 10);
+    }
+
+    void testMemoryAccountingAndTrim() {
+        LRUCache<QString, QByteArray> cache(1000, 100);
+        for (int i = 0; i < 100; ++i) {
+            cache.put(QString("blob_%1").arg(i), QByteArray(4096, 'x'));
+        }
+        QVERIFY(cache.memoryUsage() >= 100 * 4096);
+        QVERIFY(cache.getStatistics().storage_bytes > 0);
+
+        // Trimming evicts in policy order until the target is met
+        const size_t target = cache.memoryUsage() / 2;
+        QVERIFY(cache.trimMemory(target) > 0);
+        QVERIFY(cache.memoryUsage() <= target);
+        QVERIFY(cache.contains("blob_99"));
+        QVERIFY(!cache.contains("blob_0"));
+
+        // Fixed storage is counted once, not against every shard's share
+        LRUCache<QString, QByteArray> sharded(1000, 100, 8);
+        for (int i = 0; i < 64; ++i) {
+            sharded.put(QString("blob_%1").arg(i), QByteArray(4096, 'x'));
+        }
+        const size_t storage = sharded.getStatistics().storage_bytes;
+        const size_t sharded_target =
+            storage + (sharded.memoryUsage() - storage) / 2;
+        QVERIFY(sharded.trimMemory(sharded_target) > 0);
+        QVERIFY(sharded.memoryUsage() <= sharded_target);
+        QVERIFY(sharded.size() > 0);
+
+        // The global limit evicts from the largest cache until it fits
+        cache_manager->setGlobalMemoryLimit(1);
+        for (int i = 0; i < 40; ++i) {
+            cache_manager->cacheFileContent(QString("file_%1").arg(i),
+                                            QByteArray(64 * 1024, 'y'));
+        }
+        QVERIFY(cache_manager->getTotalMemoryUsage() > 1024 * 1024);
+        QSignalSpy limit_spy(cache_manager.get(),
+                             &CacheManager::memoryLimitReached);
+        QMetaObject::invokeMethod(cache_manager.get(), "onMemoryPressure",
+                                  Qt::DirectConnection);
+        QCOMPARE(limit_spy.count(), 1);
+        QVERIFY(cache_manager->getTotalMemoryUsage() <= 1024 * 1024);
+        QVERIFY(!cache_manager->getCachedFileContent("file_39").isEmpty());
+    }
+
+    void testRefreshAhead() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath("style.qss");
+        auto writeFile = [](const QString& file_path,
+                            const QByteArray& content) {
+            QFile file(file_path);
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            file.write(content);
+        };
+
+        writeFile(path, "v1");
+        cache_manager->enableRefreshAhead(true, std::chrono::milliseconds(400),
+                                          0.5);
+        QVERIFY(cache_manager->isRefreshAheadEnabled());
+        cache_manager->cacheFileContent(path, "v1");
+
+        // Hits inside the last half of the TTL reload in the background
+        QTest::qWait(250);
+        QCOMPARE(cache_manager->getCachedFileContent(path), QByteArray("v1"));
+        cache_manager->waitForRefreshes();
+        QJsonObject stats =
+            cache_manager->getCacheStatistics()["refresh_ahead"].toObject();
+        QVERIFY(stats["refreshed_in_time"].toInt() >= 1);
+
+        // A changed file is served stale once, then replaced
+        writeFile(path, "version 2");
+        QCOMPARE(cache_manager->getCachedFileContent(path), QByteArray("v1"));
+        cache_manager->waitForRefreshes();
+        QCOMPARE(cache_manager->getCachedFileContent(path),
+                 QByteArray("version 2"));
+        stats = cache_manager->getCacheStatistics()["refresh_ahead"].toObject();
+        QVERIFY(stats["stale_reads"].toInt() >= 1);
+        QVERIFY(stats["served_stale"].toInt() >= 1);
+
+        // getOrComputeFileContent() hits re-read the file, never the loader,
+        // so a loader capturing locals by reference is safe
+        const QString computed_path = dir.filePath("computed.qss");
+        writeFile(computed_path, "on disk");
+        int loads = 0;
+        auto loader = [&]() {
+            ++loads;
+            return QByteArray("on disk");
+        };
+        cache_manager->getOrComputeFileContent(computed_path, loader);
+        QTest::qWait(250);
+        cache_manager->getOrComputeFileContent(computed_path, loader);
+        cache_manager->waitForRefreshes();
+        QCOMPARE(loads, 1);
+
+        writeFile(computed_path, "changed on disk");
+        QCOMPARE(cache_manager->getOrComputeFileContent(computed_path, loader),
+                 QByteArray("on disk"));
+        cache_manager->waitForRefreshes();
+        QCOMPARE(cache_manager->getOrComputeFileContent(computed_path, loader),
+                 QByteArray("changed on disk"));
+        QCOMPARE(loads, 1);
+
+        cache_manager->enableRefreshAhead(false);
+        QVERIFY(!cache_manager->isRefreshAheadEnabled());
+    }
 };
 
 QTEST_MAIN(CacheManagerTest)
@@ -1,19 +1,105 @@
 #include <QApplication>
 #include <QElapsedTimer>
+#include <QFile>
 #include <QFuture>
+#include <QFutureInterface>
+#include <QJsonArray>
 #include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 #include <QThread>
 #include <QtConcurrent>
+#include <algorithm>
+#include <future>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <unordered_map>
 #include <vector>
 
 #include "../Core/CacheManager.hpp"
+#include "../Core/Coroutine.hpp"
 #include "../Core/MemoryManager.hpp"
+#include "../Core/MemoryResource.hpp"
 #include "../Core/ParallelProcessor.hpp"
+#include "../Core/SlabAllocator.hpp"
 
 using namespace DeclarativeUI::Core;
 
+namespace {
+struct SlabNode {
+    DECLARATIVE_UI_SLAB_ALLOCATED
+    explicit SlabNode(int value) : value(value) {}
+    virtual ~SlabNode() = default;
+    int value;
+};
+
+struct LargeSlabNode : SlabNode {
+    using SlabNode::SlabNode;
+    char payload[400] = {};
+};
+
+struct OversizedSlabNode : SlabNode {
+    using SlabNode::SlabNode;
+    char payload[SlabAllocator::kMaxBlockSize] = {};
+};
+
+struct HopTrace {
+    bool on_worker = false;
+    bool child_inline = false;
+    bool back_on_main = false;
+};
+
+CoTask<int> squareOnPool(ThreadPool& pool, int value) {
+    co_await resumeOn(pool);  // Already there when awaited from a worker
+    co_return value * value;
+}
+
+CoTask<int> coroutinePipeline(ParallelProcessor& processor,
+                              QFuture<int> input, HopTrace* trace) {
+    QThread* main_thread = QThread::currentThread();
+    const int base = co_await input;
+
+    co_await resumeOn(processor);
+    QThread* worker = QThread::currentThread();
+    trace->on_worker =
+        worker != main_thread && processor.threadPool().is_worker_thread();
+
+    const int squared = co_await squareOnPool(processor.threadPool(), base);
+    trace->child_inline = QThread::currentThread() == worker;
+
+    co_await resumeOnMainThread();
+    trace->back_on_main = QThread::currentThread() == main_thread;
+    co_return squared + 1;
+}
+
+CoTask<int> failingStep(ThreadPool& pool) {
+    co_await resumeOn(pool);
+    throw std::runtime_error("step failed");
+}
+
+CoTask<QString> catchingParent(ThreadPool& pool) {
+    try {
+        co_await failingStep(pool);
+    } catch (const std::runtime_error& e) {
+        co_return QString(e.what());
+    }
+    co_return QString();
+}
+
+CoTask<int> awaitInput(QFuture<int> input, std::atomic<bool>* resumed) {
+    const int value = co_await input;
+    resumed->store(true);
+    co_return value;
+}
+
+CoTask<int> awaitInputParent(QFuture<int> input, std::atomic<bool>* resumed) {
+    co_return co_await awaitInput(input, resumed);
+}
+}  // namespace
+
 class CoreAdvancedTest : public QObject {
     Q_OBJECT
 
@@ -233,6 +319,463 @@ private slots:
                 initial_stats.total_allocated_bytes);
     }
 
+    void testConcurrentObjectPool() {
+        ConcurrentObjectPool<QString, 64, 8> pool;
+
+        // Nothing is constructed until the first acquisition
+        QCOMPARE(pool.constructed_count(), size_t(0));
+        auto first = pool.acquire(QString("first"));
+        QCOMPARE(*first, QString("first"));
+        QCOMPARE(pool.constructed_count(), size_t(1));
+
+        // A released object is recycled and reinitialized
+        QString* raw = first.get();
+        pool.release(std::move(first));
+        auto again = pool.acquire(QString("again"));
+        QCOMPARE(again.get(), raw);
+        QCOMPARE(*again, QString("again"));
+        pool.release(std::move(again));
+
+        // Objects handed between threads end up back in the depot
+        const int num_threads = 4;
+        const int objects_per_thread = 200;
+        QVector<QFuture<void>> futures;
+        for (int t = 0; t < num_threads; ++t) {
+            futures.append(QtConcurrent::run([&pool, objects_per_thread]() {
+                std::vector<std::unique_ptr<QString>> held;
+                for (int i = 0; i < objects_per_thread; ++i) {
+                    held.push_back(pool.acquire(QString::number(i)));
+                }
+                for (auto& object : held) {
+                    pool.release(std::move(object));
+                }
+                pool.flush_thread_cache();
+            }));
+        }
+        for (auto& future : futures) {
+            future.waitForFinished();
+        }
+        pool.flush_thread_cache();
+
+        QCOMPARE(pool.allocated_count(), size_t(0));
+        QVERIFY(pool.available_count() <= 64);
+        QCOMPARE(pool.constructed_count(), pool.available_count());
+        QVERIFY(pool.pool_hits() >= 1);
+
+        // create_pooled returns objects through the manager's pool
+        auto& memory_manager = MemoryManager::instance();
+        {
+            auto pooled = memory_manager.create_pooled<QString>("pooled");
+            QCOMPARE(*pooled, QString("pooled"));
+        }
+        auto& shared_pool = memory_manager.get_concurrent_pool<QString>();
+        QVERIFY(shared_pool.available_count() >= 1);
+    }
+
+    void testChunkedArena() {
+        ChunkedArena arena(1024, 8192);
+        QCOMPARE(arena.chunk_count(), size_t(1));
+
+        void* aligned = arena.allocate(10, 64);
+        QCOMPARE(reinterpret_cast<uintptr_t>(aligned) % 64, uintptr_t(0));
+
+        // Growing past the first chunk links new chunks in
+        const auto start = arena.mark();
+        for (int i = 0; i < 100; ++i) {
+            arena.create<QString>(QString(64, QChar('a' + i % 26)));
+        }
+        QVERIFY(arena.chunk_count() > 1);
+
+        // Nested scopes roll back and destroy only their own objects
+        struct Counted {
+            explicit Counted(int* counter) : destroyed(counter) {}
+            ~Counted() { ++*destroyed; }
+            int* destroyed;
+        };
+        int destroyed = 0;
+        {
+            ArenaScope outer(arena);
+            arena.create<Counted>(&destroyed);
+            {
+                ArenaScope inner(arena);
+                arena.create<Counted>(&destroyed);
+                arena.create<Counted>(&destroyed);
+            }
+            QCOMPARE(destroyed, 2);
+        }
+        QCOMPARE(destroyed, 3);
+
+        // Rolled-back chunks are reused rather than reallocated
+        const size_t chunks = arena.chunk_count();
+        arena.rollback(start);
+        for (int i = 0; i < 100; ++i) {
+            arena.create<QString>(QString(64, QChar('a' + i % 26)));
+        }
+        QCOMPARE(arena.chunk_count(), chunks);
+
+        arena.reset();
+        QCOMPARE(arena.used_bytes(), size_t(0));
+        QVERIFY(arena.release_unused_chunks() > 0);
+        QCOMPARE(arena.chunk_count(), size_t(1));
+
+        // Concurrent bump allocation hands out disjoint blocks
+        const int num_threads = 4;
+        const int allocations_per_thread = 5000;
+        std::atomic<int> corrupted{0};
+        QVector<QFuture<void>> futures;
+        for (int t = 0; t < num_threads; ++t) {
+            futures.append(QtConcurrent::run([&, t]() {
+                std::vector<int*> blocks;
+                for (int i = 0; i < allocations_per_thread; ++i) {
+                    auto* block = static_cast<int*>(
+                        arena.allocate(4 * sizeof(int), alignof(int)));
+                    std::fill(block, block + 4, t * allocations_per_thread + i);
+                    blocks.push_back(block);
+                }
+                for (int i = 0; i < allocations_per_thread; ++i) {
+                    if (blocks[i][3] != t * allocations_per_thread + i) {
+                        corrupted.fetch_add(1);
+                    }
+                }
+            }));
+        }
+        for (auto& future : futures) {
+            future.waitForFinished();
+        }
+        QCOMPARE(corrupted.load(), 0);
+        QVERIFY(arena.used_bytes() >=
+                num_threads * allocations_per_thread * 4 * sizeof(int));
+
+        // Managed chunked arenas show up in the memory report
+        auto& memory_manager = MemoryManager::instance();
+        auto* frame_arena =
+            memory_manager.create_chunked_arena("test-frame", 4096);
+        QCOMPARE(memory_manager.get_chunked_arena("test-frame"), frame_arena);
+        frame_arena->allocate(128);
+        bool reported = false;
+        for (const auto& value :
+             memory_manager.get_memory_report()["arenas"].toArray()) {
+            reported |= value.toObject()["name"].toString() == "test-frame";
+        }
+        QVERIFY(reported);
+        memory_manager.destroy_arena("test-frame");
+        QVERIFY(memory_manager.get_chunked_arena("test-frame") == nullptr);
+    }
+
+    void testHandleArenaCompaction() {
+        HandleArena arena(4096);
+
+        // Interleave long-lived strings with short-lived blocks
+        std::vector<HandleArena::Handle> kept;
+        std::vector<HandleArena::Handle> dropped;
+        for (int i = 0; i < 400; ++i) {
+            kept.push_back(arena.create<QString>(QString::number(i)));
+            for (int j = 0; j < 3; ++j) {
+                dropped.push_back(arena.allocate(64));
+            }
+        }
+        const auto raw = arena.allocate(sizeof(int), alignof(int));
+        *arena.get<int>(raw) = 42;
+
+        for (const auto& handle : dropped) {
+            arena.free(handle);
+        }
+        QVERIFY(!arena.is_valid(dropped.front()));
+        arena.free(dropped.front());  // Stale handles are ignored
+        const double fragmentation = arena.fragmentation();
+        QVERIFY(fragmentation > 0.5);
+        QVERIFY(arena.needs_compaction());
+
+        // A pinned block stays where it is
+        const HandleArena::Handle pinned_handle = kept[1];
+        HandleArena::Pin pin(arena, pinned_handle);
+        QCOMPARE(pin.get(), arena.resolve(pinned_handle));
+
+        // Incremental steps respect their budget
+        const size_t chunks_before = arena.chunk_count();
+        const size_t step = arena.compact_step(256);
+        QVERIFY(step > 0 && step < 256 + sizeof(QString));
+        arena.compact();
+        QVERIFY(!arena.needs_compaction());
+        QVERIFY(arena.compacted_bytes() > 0);
+        QVERIFY(arena.chunk_count() < chunks_before);
+        QVERIFY(arena.fragmentation() < fragmentation);
+        QCOMPARE(pin.get(), arena.resolve(pinned_handle));
+
+        // Objects were relocated, not just copied
+        for (int i = 0; i < 400; ++i) {
+            QCOMPARE(*arena.get<QString>(kept[i]), QString::number(i));
+        }
+        QCOMPARE(*arena.get<int>(raw), 42);
+        QCOMPARE(arena.live_count(), kept.size() + 1);
+
+        // Freed slots are reused with a new generation
+        arena.free(kept[0]);
+        const auto reused = arena.allocate(16);
+        QCOMPARE(reused.index, kept[0].index);
+        QVERIFY(reused.generation != kept[0].generation);
+        QVERIFY(!arena.is_valid(kept[0]));
+
+        // MemoryManager drives compaction of registered handle arenas
+        auto& memory_manager = MemoryManager::instance();
+        HandleArena* managed =
+            memory_manager.create_handle_arena("test_handles", 4096);
+        QCOMPARE(memory_manager.get_handle_arena("test_handles"), managed);
+        std::vector<HandleArena::Handle> survivors;
+        for (int i = 0; i < 1000; ++i) {
+            const auto handle = managed->allocate(64, alignof(int));
+            *managed->get<int>(handle) = i;
+            if (i % 10 == 0) {
+                survivors.push_back(handle);
+            } else {
+                managed->free(handle);
+            }
+        }
+        QVERIFY(managed->needs_compaction());
+        memory_manager.defragment_arenas();
+        QTRY_VERIFY(!managed->needs_compaction());
+        for (size_t i = 0; i < survivors.size(); ++i) {
+            QCOMPARE(*managed->get<int>(survivors[i]), int(i * 10));
+        }
+
+        bool reported = false;
+        const auto arenas =
+            memory_manager.get_memory_report()["arenas"].toArray();
+        for (const auto& entry : arenas) {
+            const auto info = entry.toObject();
+            if (info["name"].toString() == "test_handles") {
+                reported = info["handle_based"].toBool();
+            }
+        }
+        QVERIFY(reported);
+        memory_manager.destroy_arena("test_handles");
+        QVERIFY(memory_manager.get_handle_arena("test_handles") == nullptr);
+    }
+
+    void testMemoryResources() {
+        // Size-class pool recycles freed nodes
+        SizeClassPoolResource pool(false);
+        {
+            std::pmr::unordered_map<int, QString> map(&pool);
+            for (int i = 0; i < 1000; ++i) {
+                map.emplace(i, QString::number(i));
+            }
+            QVERIFY(pool.in_use_bytes() > 0);
+            const size_t pooled = pool.pooled_bytes();
+            for (int round = 0; round < 10; ++round) {
+                map.erase(round);
+                map.emplace(round, QString::number(round));
+            }
+            QCOMPARE(pool.pooled_bytes(), pooled);
+        }
+        QCOMPARE(pool.in_use_bytes(), size_t(0));
+        QCOMPARE(pool.large_bytes(), size_t(0));
+
+        // Fixed arenas fall back upstream once full
+        MemoryArena fixed(256);
+        ArenaMemoryResource arena_resource(fixed);
+        {
+            std::pmr::vector<int> values(&arena_resource);
+            for (int i = 0; i < 1000; ++i) {
+                values.push_back(i);
+            }
+            QCOMPARE(values[999], 999);
+            QVERIFY(arena_resource.fallback_bytes() > 0);
+        }
+        QCOMPARE(arena_resource.fallback_bytes(), size_t(0));
+
+        // Chunked arena resources are released by scope rollback
+        ChunkedArena chunked(1024);
+        ChunkedArenaResource chunked_resource(chunked);
+        {
+            ArenaScope scope(chunked);
+            std::pmr::vector<QString> names(&chunked_resource);
+            for (int i = 0; i < 500; ++i) {
+                names.emplace_back(QString("item-%1").arg(i));
+            }
+            QVERIFY(chunked.used_bytes() > 0);
+        }
+        QCOMPARE(chunked.used_bytes(), size_t(0));
+
+        // MemoryManager hands out adapters for managed arenas
+        auto& memory_manager = MemoryManager::instance();
+        memory_manager.create_chunked_arena("test-pmr", 4096);
+        auto* managed = memory_manager.get_arena_resource("test-pmr");
+        QVERIFY(managed != nullptr);
+        QCOMPARE(memory_manager.get_arena_resource("test-pmr"), managed);
+        QVERIFY(memory_manager.get_arena_resource("missing") == nullptr);
+        QVERIFY(memory_manager.get_pool_resource() != nullptr);
+        memory_manager.destroy_arena("test-pmr");
+    }
+
+    void testAllocationSampling() {
+        auto& detector = MemoryLeakDetector::instance();
+        auto& memory_manager = MemoryManager::instance();
+        const size_t interval = 16 * 1024;
+        memory_manager.enable_allocation_sampling(true, interval);
+        QCOMPARE(detector.sampling_interval(), interval);
+
+        // Churn that is freed again leaves no live samples behind
+        for (int i = 0; i < 20000; ++i) {
+            auto buffer = std::make_unique<char[]>(128);
+            TRACK_ALLOCATION(buffer.get(), 128);
+            TRACK_DEALLOCATION(buffer.get());
+        }
+        QVERIFY(detector.get_allocation_count() > 0);
+        QVERIFY(memory_manager.get_memory_leaks().empty());
+
+        // Retained blocks are estimated from their weighted samples
+        const size_t block_size = 256;
+        const size_t block_count = 20000;
+        std::vector<std::unique_ptr<char[]>> retained;
+        for (size_t i = 0; i < block_count; ++i) {
+            retained.push_back(std::make_unique<char[]>(block_size));
+            TRACK_ALLOCATION(retained.back().get(), block_size);
+        }
+        const auto leaks = memory_manager.get_memory_leaks();
+        QVERIFY(!leaks.empty());
+        double estimated_bytes = 0.0;
+        for (const auto& leak : leaks) {
+            QVERIFY(leak.weight >= 1.0);
+            estimated_bytes += leak.weight * leak.size;
+        }
+        const double actual_bytes = double(block_size) * block_count;
+        QVERIFY(estimated_bytes > actual_bytes * 0.7);
+        QVERIFY(estimated_bytes < actual_bytes * 1.3);
+
+        // Both sites are aggregated; the retained one has live bytes
+        const auto profile = detector.get_heap_profile();
+        QCOMPARE(profile.size(), size_t(2));
+        QVERIFY(profile.front().live_sampled_count > 0);
+        QCOMPARE(profile.back().live_sampled_count, size_t(0));
+
+        const std::string pprof = detector.export_pprof();
+        QVERIFY(pprof.rfind("heap profile:", 0) == 0);
+        QVERIFY(pprof.find("@ heap_v2/16384") != std::string::npos);
+        const auto json = detector.export_json();
+        QCOMPARE(json["call_sites"].toArray().size(), 2);
+        QVERIFY(memory_manager.get_memory_report().contains(
+            "allocation_sampling"));
+
+        for (const auto& block : retained) {
+            TRACK_DEALLOCATION(block.get());
+        }
+        QVERIFY(memory_manager.get_memory_leaks().empty());
+
+        memory_manager.enable_allocation_sampling(false);
+        memory_manager.enable_leak_detection(false);
+        QCOMPARE(detector.sampling_interval(), size_t(0));
+    }
+
+    void testProcessMemorySampling() {
+        if (!ProcessMemorySampler::is_supported()) {
+            QSKIP("No process memory backend on this platform");
+        }
+
+        ProcessMemorySampler sampler;
+        const auto before = sampler.sample(true);
+        QVERIFY(before.valid);
+        QVERIFY(before.rss_bytes > 0);
+        QVERIFY(before.peak_rss_bytes >= before.rss_bytes);
+
+        // Touched anonymous memory shows up in RSS and the rollup
+        const size_t block_size = 32 * 1024 * 1024;
+        std::vector<char> block(block_size, 1);
+        const auto after = sampler.sample(true);
+        QVERIFY(after.rss_bytes >= before.rss_bytes + block_size / 2);
+        if (after.has_rollup) {
+            QVERIFY(after.anonymous_bytes >=
+                    before.anonymous_bytes + block_size / 2);
+            QVERIFY(after.pss_bytes > 0);
+        }
+        if (after.has_heap_info) {
+            QVERIFY(after.heap_in_use_bytes >= block_size);
+        }
+
+        // Statistics and report carry the sampled values
+        auto& memory_manager = MemoryManager::instance();
+        const auto report = memory_manager.get_memory_report();
+        const auto process = report["process"].toObject();
+        QVERIFY(process["sampled"].toBool());
+        QVERIFY(process["rss_bytes"].toDouble() > 0);
+        const auto stats = memory_manager.get_statistics();
+        QVERIFY(stats.process_rss_bytes > 0);
+        QVERIFY(stats.process_footprint_bytes > 0);
+    }
+
+    void testSlabAllocator() {
+        SlabAllocator::set_enabled(true);
+        const auto before = SlabAllocator::statistics();
+
+        // Subclasses of different sizes share the operators
+        std::vector<std::unique_ptr<SlabNode>> nodes;
+        for (int i = 0; i < 1000; ++i) {
+            if (i % 2 == 0) {
+                nodes.push_back(std::make_unique<SlabNode>(i));
+            } else {
+                nodes.push_back(std::make_unique<LargeSlabNode>(i));
+            }
+        }
+        std::vector<SlabNode*> addresses;
+        for (const auto& node : nodes) {
+            QVERIFY(SlabAllocator::owns(node.get()));
+            addresses.push_back(node.get());
+        }
+        std::sort(addresses.begin(), addresses.end());
+        QVERIFY(std::adjacent_find(addresses.begin(), addresses.end()) ==
+                addresses.end());
+        for (int i = 0; i < 1000; ++i) {
+            QCOMPARE(nodes[i]->value, i);
+        }
+
+        auto after = SlabAllocator::statistics();
+        QVERIFY(after.slab_count > before.slab_count);
+        QCOMPARE(after.reserved_bytes,
+                 after.slab_count * SlabAllocator::kSlabSize);
+        QVERIFY(after.refills > before.refills);
+
+        // Objects freed on another thread are recycled there
+        std::vector<std::unique_ptr<SlabNode>> moved(
+            std::make_move_iterator(nodes.begin() + 500),
+            std::make_move_iterator(nodes.end()));
+        nodes.resize(500);
+        QThread* thread = QThread::create([&moved]() {
+            moved.clear();
+            SlabAllocator::flush_thread_cache();
+        });
+        thread->start();
+        QVERIFY(thread->wait(5000));
+        delete thread;
+        QVERIFY(SlabAllocator::statistics().depot_free_bytes > 0);
+        nodes.clear();
+
+        // Oversized objects and the disabled allocator use operator new
+        const size_t fallbacks = after.fallback_allocations;
+        auto oversized = std::make_unique<OversizedSlabNode>(1);
+        QVERIFY(!SlabAllocator::owns(oversized.get()));
+
+        SlabAllocator::set_enabled(false);
+        auto unmanaged = std::make_unique<SlabNode>(2);
+        QVERIFY(!SlabAllocator::owns(unmanaged.get()));
+        SlabAllocator::set_enabled(true);
+        auto managed = std::make_unique<SlabNode>(3);
+        QVERIFY(SlabAllocator::owns(managed.get()));
+
+        after = SlabAllocator::statistics();
+        QCOMPARE(after.fallback_allocations, fallbacks + 2);
+        QCOMPARE(after.upstream_allocations,
+                 after.slab_count + after.fallback_allocations);
+
+        // Freed after re-enabling: ownership comes from the page map
+        unmanaged.reset();
+        oversized.reset();
+
+        const auto report = MemoryManager::instance().get_memory_report();
+        const auto slab = report["slab_allocator"].toObject();
+        QVERIFY(slab["enabled"].toBool());
+        QVERIFY(slab["slab_count"].toDouble() > 0);
+    }
+
     // **ParallelProcessor Tests**
     void testParallelProcessorCreation() {
         auto processor = std::make_unique<ParallelProcessor>();
@@ -325,6 +868,406 @@ private slots:
         QVERIFY(metrics.contains("active_task_count"));
         QVERIFY(elapsed < 1000);  // Should submit quickly
     }
+
+    void testParallelProcessorTaskGraph() {
+        auto processor = std::make_unique<ParallelProcessor>();
+        auto graph = std::make_shared<TaskGraph>("reload");
+
+        // read -> parse -> {resolve, validate} -> build
+        std::atomic<int> source_version{1};
+        const auto read = graph->addNode("read", [&source_version]() {
+            return QString("v%1").arg(source_version.load());
+        });
+        const auto parse =
+            graph->addNode("parse", [](const QVariantList& inputs) {
+                QThread::msleep(20);
+                return inputs[0].toString() + ":parsed";
+            });
+        const auto resolve =
+            graph->addNode("resolve", [](const QVariantList& inputs) {
+                return inputs[0].toString() + ":resolved";
+            });
+        const auto validate =
+            graph->addNode("validate", [](const QVariantList& inputs) {
+                return !inputs[0].toString().isEmpty();
+            });
+        const auto build =
+            graph->addNode("build", [](const QVariantList& inputs) {
+                return inputs[0].toString() +
+                       (inputs[1].toBool() ? ":valid" : ":invalid");
+            });
+        graph->addEdge(read, parse);
+        graph->addEdge(parse, resolve);
+        graph->addEdge(parse, validate);
+        graph->addEdge(resolve, build);
+        graph->addEdge(validate, build);
+        QVERIFY_EXCEPTION_THROWN(graph->addEdge(build, read),
+                                 std::invalid_argument);
+
+        QSignalSpy completed(processor.get(),
+                             &ParallelProcessor::taskGraphCompleted);
+        auto future = processor->runTaskGraph(graph);
+        future.waitForFinished();
+        auto result = future.result();
+        QVERIFY(result.success);
+        QCOMPARE(result.executed_nodes, size_t(5));
+        QCOMPARE(graph->result(build).toString(),
+                 QString("v1:parsed:resolved:valid"));
+        QVERIFY(result.critical_path.contains("parse"));
+        QCOMPARE(result.critical_path.front(), QString("read"));
+        QCOMPARE(result.critical_path.back(), QString("build"));
+        QVERIFY(result.critical_path_time >= std::chrono::milliseconds(20));
+        QVERIFY(result.critical_path_time <= result.total_work_time);
+        QTRY_COMPARE(completed.count(), 1);
+
+        auto metrics = processor->getPerformanceMetrics();
+        QCOMPARE(metrics["task_graphs_executed"].toInt(), 1);
+        QVERIFY(metrics["last_graph_critical_path_ms"].toDouble() >= 20.0);
+        QCOMPARE(metrics["last_graph_critical_path"].toArray().size(),
+                 result.critical_path.size());
+
+        // Nothing dirty: nothing runs
+        result = processor->runTaskGraph(graph).result();
+        QVERIFY(result.success);
+        QCOMPARE(result.executed_nodes, size_t(0));
+
+        // Changing an input re-runs only the affected subgraph
+        graph->invalidate(resolve);
+        result = processor->runTaskGraph(graph).result();
+        QCOMPARE(result.executed_nodes, size_t(2));
+        QCOMPARE(graph->executionCount(parse), size_t(1));
+        QCOMPARE(graph->executionCount(build), size_t(2));
+
+        source_version = 2;
+        graph->invalidate(read);
+        result = processor->runTaskGraph(graph).result();
+        QCOMPARE(result.executed_nodes, size_t(5));
+        QCOMPARE(graph->result(build).toString(),
+                 QString("v2:parsed:resolved:valid"));
+
+        // Errors cancel everything downstream; independent nodes still run
+        auto failing = std::make_shared<TaskGraph>("failing");
+        const auto broken = failing->addNode(
+            "broken", []() -> int { throw std::runtime_error("bad input"); });
+        const auto consumer = failing->addNode("consumer", []() {});
+        const auto independent = failing->addNode("independent", []() {});
+        failing->addEdge(broken, consumer);
+        result = processor->runTaskGraph(failing).result();
+        QVERIFY(!result.success);
+        QCOMPARE(result.failed_nodes, size_t(1));
+        QCOMPARE(result.cancelled_nodes, size_t(1));
+        QCOMPARE(failing->state(broken), TaskGraph::NodeState::Failed);
+        QCOMPARE(failing->state(consumer), TaskGraph::NodeState::Cancelled);
+        QVERIFY(failing->error(consumer).contains("bad input"));
+        QCOMPARE(failing->state(independent), TaskGraph::NodeState::Completed);
+        QVERIFY(failing->isDirty(broken) && failing->isDirty(consumer));
+
+        // Cancellation stops nodes that have not started
+        auto slow = std::make_shared<TaskGraph>("slow");
+        std::atomic<bool> release{false};
+        const auto first = slow->addNode("first", [&release]() {
+            while (!release.load()) {
+                QThread::msleep(1);
+            }
+        });
+        const auto second = slow->addNode("second", []() {});
+        slow->addEdge(first, second);
+        future = processor->runTaskGraph(slow);
+        QVERIFY_EXCEPTION_THROWN(processor->runTaskGraph(slow),
+                                 std::runtime_error);
+        slow->cancel();
+        release = true;
+        result = future.result();
+        QVERIFY(result.cancelled);
+        QCOMPARE(slow->state(first), TaskGraph::NodeState::Completed);
+        QCOMPARE(slow->state(second), TaskGraph::NodeState::Cancelled);
+    }
+
+    void testThreadPoolWorkStealingLanes() {
+        ThreadPool pool(1, ThreadPool::SchedulingMode::WorkStealing);
+
+        // Keep the only worker busy while the lanes fill up
+        std::promise<void> release;
+        auto blocker = pool.enqueue(TaskPriority::Critical,
+                                    [gate = release.get_future().share()]() {
+                                        gate.wait();
+                                    });
+
+        std::mutex order_mutex;
+        std::vector<TaskPriority> order;
+        for (auto priority : {TaskPriority::Low, TaskPriority::Normal,
+                              TaskPriority::High, TaskPriority::Critical}) {
+            pool.post(priority, [&order_mutex, &order, priority]() {
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(priority);
+            });
+        }
+        auto last = pool.enqueue(TaskPriority::Low, []() { return 42; });
+        QVERIFY(pool.queued_tasks() >= 5);
+        release.set_value();
+
+        // Not wait_for(): helping from this thread could reorder the lanes
+        last.wait();
+        QCOMPARE(last.get(), 42);
+        blocker.get();
+
+        std::lock_guard<std::mutex> lock(order_mutex);
+        QCOMPARE(order.size(), size_t(4));
+        QVERIFY(order[0] == TaskPriority::Critical);
+        QVERIFY(order[1] == TaskPriority::High);
+        QVERIFY(order[2] == TaskPriority::Normal);
+        QVERIFY(order[3] == TaskPriority::Low);
+    }
+
+    void testParallelProcessorSchedulingMode() {
+        auto processor = std::make_unique<ParallelProcessor>();
+
+        // Strict priority ordering unless work stealing is asked for
+        auto metrics = processor->getPerformanceMetrics();
+        QCOMPARE(metrics["scheduling_mode"].toString(),
+                 QString("shared_queue"));
+        QVERIFY(metrics.contains("steal_count"));
+
+        // Refused while tasks are queued
+        QVERIFY(processor->setThreadPoolSize(1));
+        ThreadPool& old_pool = processor->threadPool();
+        std::promise<void> release;
+        auto blocker = old_pool.enqueue(
+            TaskPriority::Normal,
+            [gate = release.get_future().share()]() { gate.wait(); });
+        auto queued = old_pool.enqueue(TaskPriority::Normal, []() {});
+        QVERIFY(!processor->setSchedulingMode(
+            ThreadPool::SchedulingMode::WorkStealing));
+        release.set_value();
+        queued.get();
+        blocker.get();
+
+        // Refused while a task graph runs
+        auto graph = std::make_shared<TaskGraph>("running");
+        std::promise<void> finish;
+        graph->addNode("wait", [gate = finish.get_future().share()]() {
+            gate.wait();
+        });
+        auto run = processor->runTaskGraph(graph);
+        QVERIFY(!processor->setSchedulingMode(
+            ThreadPool::SchedulingMode::WorkStealing));
+        finish.set_value();
+        run.waitForFinished();
+        QVERIFY(run.result().success);
+
+        QVERIFY(processor->setSchedulingMode(
+            ThreadPool::SchedulingMode::WorkStealing));
+        metrics = processor->getPerformanceMetrics();
+        QCOMPARE(metrics["scheduling_mode"].toString(),
+                 QString("work_stealing"));
+        QCOMPARE(metrics["thread_count"].toInt(), 1);
+
+        // The replaced pool is shut down, not destroyed
+        QVERIFY(&processor->threadPool() != &old_pool);
+        QVERIFY(!old_pool.is_running());
+        QVERIFY_EXCEPTION_THROWN(old_pool.post(TaskPriority::Normal, []() {}),
+                                 std::runtime_error);
+        QCOMPARE(processor->threadPool()
+                     .enqueue(TaskPriority::Normal, []() { return 7; })
+                     .get(),
+                 7);
+    }
+
+    void testParallelProcessorDataParallel() {
+        auto processor = std::make_unique<ParallelProcessor>();
+
+        // Every index exactly once, with adaptive and fixed chunking
+        for (size_t grain : {size_t(0), size_t(7)}) {
+            std::vector<std::atomic<int>> visits(100000);
+            processor->parallelFor(
+                0, 100000,
+                [&visits](int i) {
+                    visits[i].fetch_add(1, std::memory_order_relaxed);
+                },
+                grain);
+            QVERIFY(std::all_of(
+                visits.begin(), visits.end(),
+                [](const std::atomic<int>& count) { return count == 1; }));
+        }
+        int empty_calls = 0;
+        processor->parallelFor(5, 5, [&empty_calls](int) { ++empty_calls; });
+        QCOMPARE(empty_calls, 0);
+
+        std::vector<int> values(1000000);
+        std::iota(values.begin(), values.end(), 1);
+        const long long sum = processor->parallelTransformReduce(
+            values.begin(), values.end(), 0LL, std::plus<>(),
+            [](int value) { return static_cast<long long>(value); });
+        QCOMPARE(sum, 1000000LL * 1000001 / 2);
+
+        // Partial results are combined in order
+        std::vector<int> digits(5000);
+        QString expected_text;
+        for (int i = 0; i < 5000; ++i) {
+            digits[i] = i % 10;
+            expected_text += QString::number(i % 10);
+        }
+        const QString text = processor->parallelTransformReduce(
+            digits.begin(), digits.end(), QString(),
+            [](QString left, const QString& right) { return left + right; },
+            [](int digit) { return QString::number(digit); }, 16);
+        QCOMPARE(text, expected_text);
+
+        std::mt19937 random(42);
+        std::vector<int> unsorted(200000);
+        for (int& value : unsorted) {
+            value = static_cast<int>(random() % 100000);
+        }
+        auto expected = unsorted;
+        std::sort(expected.begin(), expected.end());
+        auto sorted = unsorted;
+        processor->parallelSort(sorted.begin(), sorted.end());
+        QVERIFY(sorted == expected);
+        processor->parallelSort(unsorted.begin(), unsorted.end(),
+                                std::greater<>());
+        QVERIFY(std::is_sorted(unsorted.begin(), unsorted.end(),
+                               std::greater<>()));
+
+        QVERIFY_EXCEPTION_THROWN(processor->parallelFor(
+                                     0, 100000,
+                                     [](int i) {
+                                         if (i == 5000) {
+                                             throw std::runtime_error("bad");
+                                         }
+                                     },
+                                     100),
+                                 std::runtime_error);
+
+        // Nested inside a pool task and inside another parallelFor
+        std::atomic<int> inner_total{0};
+        auto nested = processor->threadPool().enqueue(
+            TaskPriority::Normal, [&processor, &inner_total]() {
+                processor->parallelFor(
+                    0, 64,
+                    [&](int) {
+                        processor->parallelFor(
+                            0, 1000,
+                            [&](int) {
+                                inner_total.fetch_add(
+                                    1, std::memory_order_relaxed);
+                            },
+                            10);
+                    },
+                    1);
+            });
+        nested.get();
+        QCOMPARE(inner_total.load(), 64000);
+    }
+
+    void testParallelFileProcessorViews() {
+        ParallelFileProcessor file_processor;
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const QString small_path = dir.filePath("small.json");
+        const QString large_path = dir.filePath("large.json");
+        const QString missing_path = dir.filePath("missing.json");
+        const QByteArray large(FileView::kDefaultMapThreshold * 2, 'x');
+        {
+            QFile small(small_path);
+            QVERIFY(small.open(QIODevice::WriteOnly));
+            small.write("\xEF\xBB\xBF{\r\n}");
+            QFile big(large_path);
+            QVERIFY(big.open(QIODevice::WriteOnly));
+            big.write(large);
+        }
+
+        // Small files are read, large ones mapped; failures keep their slot
+        const QStringList paths = {small_path, large_path, missing_path};
+        auto views_future = file_processor.readFileViewsAsync(paths);
+        views_future.waitForFinished();
+        const QList<FileView> views = views_future.result();
+        QCOMPARE(views.size(), 3);
+
+        QVERIFY(views[0].isValid());
+        QVERIFY(!views[0].isMapped());
+        QCOMPARE(views[0].size(), qsizetype(7));
+        QCOMPARE(views[0].utf8().size(), qsizetype(4));
+        QCOMPARE(views[0].toString(), QString("{\r\n}"));
+
+        QVERIFY(views[1].isValid());
+        QVERIFY(views[1].isMapped());
+        QCOMPARE(views[1].bytes().toByteArray(), large);
+
+        QVERIFY(!views[2].isValid());
+        QCOMPARE(views[2].path(), missing_path);
+        QVERIFY(!views[2].errorString().isEmpty());
+
+        // Decoded reads keep text-mode semantics and the order of the paths
+        auto read_future = file_processor.readFilesAsync(paths);
+        read_future.waitForFinished();
+        const QStringList contents = read_future.result();
+        QCOMPARE(contents.size(), 3);
+        QCOMPARE(contents[0], QString("{\n}"));
+        QCOMPARE(contents[1].size(), large.size());
+        QVERIFY(contents[2].isEmpty());
+    }
+
+    void testCoroutineTasks() {
+        auto processor = std::make_unique<ParallelProcessor>();
+
+        // QFuture -> pool -> child task -> main thread
+        QFutureInterface<int> input;
+        input.reportStarted();
+        HopTrace trace;
+        auto future =
+            coroutinePipeline(*processor, input.future(), &trace).start();
+        QVERIFY(!future.isFinished());  // Lazy up to the first suspension
+        processor->threadPool().post(TaskPriority::Normal, [input]() mutable {
+            input.reportResult(6);
+            input.reportFinished();
+        });
+        QTRY_VERIFY(future.isFinished());
+        QCOMPARE(future.result(), 37);
+        QVERIFY(trace.on_worker);
+        QVERIFY(trace.child_inline);
+        QVERIFY(trace.back_on_main);
+
+        // Exceptions reach the awaiting task, or the started task's future
+        auto caught = catchingParent(processor->threadPool()).start();
+        QTRY_VERIFY(caught.isFinished());
+        QCOMPARE(caught.result(), QString("step failed"));
+        auto failed = failingStep(processor->threadPool()).start();
+        QTRY_VERIFY(failed.isFinished());
+        QVERIFY_EXCEPTION_THROWN(failed.waitForFinished(),
+                                 std::runtime_error);
+
+        // Cancelling the parent cancels the child at its next co_await
+        std::atomic<bool> resumed{false};
+        QFutureInterface<int> gate;
+        gate.reportStarted();
+        auto parent = awaitInputParent(gate.future(), &resumed);
+        const CancellationToken token = parent.token();
+        auto cancelled = std::move(parent).start();
+        token.cancel();
+        gate.reportResult(1);
+        gate.reportFinished();
+        QTRY_VERIFY(cancelled.isFinished());
+        QVERIFY(cancelled.isCanceled());
+        QVERIFY(!resumed.load());
+
+        // Cancelled before starting: the body never runs
+        auto never = awaitInputParent(gate.future(), &resumed);
+        never.cancel();
+        QVERIFY(std::move(never).start().isCanceled());
+        QVERIFY(!resumed.load());
+
+        // A canceled QFuture cancels the task awaiting it
+        QFutureInterface<int> aborted;
+        aborted.reportStarted();
+        auto aborted_task =
+            awaitInputParent(aborted.future(), &resumed).start();
+        aborted.reportCanceled();
+        aborted.reportFinished();
+        QTRY_VERIFY(aborted_task.isFinished());
+        QVERIFY(aborted_task.isCanceled());
+        QVERIFY(!resumed.load());
+    }
 };
 
 QTEST_MAIN(CoreAdvancedTest)
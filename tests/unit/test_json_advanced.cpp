@@ -1,26 +1,65 @@
 #include <QApplication>
+#include <QBuffer>
+#include <QComboBox>
+#include <QDir>
+#include <QGridLayout>
 #include <QJsonArray>
+#include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLabel>
+#include <QLayout>
+#include <QLineEdit>
 #include <QPushButton>
 #include <QSignalSpy>
+#include <QSlider>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QTest>
 #include <QUrl>
 #include <QWidget>
+#include <cstring>
 #include <memory>
 
+#include "../../src/Core/ParallelProcessor.hpp"
 #include "../../src/Exceptions/UIExceptions.hpp"
+#include "../../src/JSON/CompiledUI.hpp"
 #include "../../src/JSON/ComponentRegistry.hpp"
 #include "../../src/JSON/JSONParser.hpp"
+#include "../../src/JSON/JSONStreamParser.hpp"
+#include "../../src/JSON/JSONStructuralIndex.hpp"
 #include "../../src/JSON/JSONUILoader.hpp"
 #include "../../src/JSON/JSONValidator.hpp"
 
 using namespace DeclarativeUI::JSON;
 using namespace DeclarativeUI::Exceptions;
 
+namespace {
+
+// One line per stream event, with the path it was reported at
+class RecordingHandler : public JSONStreamHandler {
+public:
+    QStringList events;
+
+    void startObject(const JSONPath& path) override { record("{", path); }
+    void endObject(const JSONPath& path) override { record("}", path); }
+    void startArray(const JSONPath& path) override { record("[", path); }
+    void endArray(const JSONPath& path) override { record("]", path); }
+    void key(const QString& name, const JSONPath& path) override {
+        record("key " + name, path);
+    }
+    void value(const QJsonValue& value, const JSONPath& path) override {
+        record("value " + value.toVariant().toString(), path);
+    }
+
+private:
+    void record(const QString& event, const JSONPath& path) {
+        events.append(event + " @" + path.toString());
+    }
+};
+
+}  // namespace
+
 /**
  * @brief Comprehensive tests for JSON module functionality
  * 
@@ -89,6 +128,424 @@ private slots:
         }
     }
 
+    // **Test JSONC Preprocessing**
+    void testJSONCPreprocessing() {
+        // Comment markers and ",]" inside strings are data, not syntax
+        QByteArray source = R"({
+            "url": "http://example.com", // line comment
+            "list": [1, 2, /* block */ ],
+            "text": "a,]\",}",
+        })";
+        const qsizetype original_size = source.size();
+        JSONParser::preprocessJson(source);
+        QCOMPARE(source.size(), original_size);
+
+        QJsonParseError error;
+        const QJsonObject object =
+            QJsonDocument::fromJson(source, &error).object();
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(object["url"].toString(), QString("http://example.com"));
+        QCOMPARE(object["list"].toArray().size(), 2);
+        QCOMPARE(object["text"].toString(), QString("a,]\",}"));
+
+        // Only the requested extensions are stripped
+        QByteArray commas_only = "[1, /* kept */ 2,]";
+        JSONParser::preprocessJson(commas_only, false, true);
+        QCOMPARE(commas_only, QByteArray("[1, /* kept */ 2 ]"));
+
+        // Stripped bytes become spaces, so offsets into the original text
+        // (and QJsonParseError offsets) stay valid
+        QByteArray with_comment = "{ /* note */ \"a\": 1, }";
+        const qsizetype value_offset = with_comment.indexOf("\"a\"");
+        JSONParser::preprocessJson(with_comment);
+        QCOMPARE(with_comment.indexOf("\"a\""), value_offset);
+
+        // Files are parsed from their bytes
+        JSONParser parser;
+        const QString path = temp_dir_->filePath("config.jsonc");
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("{\r\n  \"title\": \"Caf\xC3\xA9\", // note\r\n}\r\n");
+        file.close();
+        QCOMPARE(parser.parseFile(path)["title"].toString(),
+                 QString::fromUtf8("Caf\xC3\xA9"));
+    }
+
+    // **Test the SIMD structural index against QJsonDocument**
+    void testStructuralIndex() {
+        // Escapes, comments and strings straddling the 64-byte blocks
+        QByteArray source = "{\n";
+        for (int i = 0; i < 40; ++i) {
+            source += "  \"key" + QByteArray::number(i) + "\": [\"" +
+                      QByteArray(i, '\\').replace("\\", "\\\\") +
+                      "\\\"/*\", " + QByteArray::number(i * 1.5) +
+                      ", true, null], // \"not a string\n" +
+                      "  /* \"nor this\" */\n";
+        }
+        source += "  \"last\": {\"a\": -12e3, \"b\": [],},\n}\n";
+
+        JSONStructuralIndex reference;
+        QVERIFY(reference.build(source, JSONStructuralIndex::Backend::Scalar));
+        QVERIFY(reference.hasComments());
+        for (auto backend : {JSONStructuralIndex::Backend::SSE42,
+                             JSONStructuralIndex::Backend::AVX2}) {
+            if (!JSONStructuralIndex::isSupported(backend)) {
+                continue;
+            }
+            JSONStructuralIndex index;
+            QVERIFY(index.build(source, backend));
+            QCOMPARE(index.positions(), reference.positions());
+        }
+
+        // The index-driven parse matches fromJson on the stripped text
+        const QJsonDocument parsed = reference.parse(source, true);
+        QVERIFY(parsed.isObject());
+        QByteArray stripped = source;
+        reference.strip(stripped, true, true);
+        QJsonParseError error;
+        const QJsonDocument expected =
+            QJsonDocument::fromJson(stripped, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(parsed, expected);
+
+        // Invalid input is rejected with an offset
+        JSONStructuralIndex invalid;
+        QVERIFY(!invalid.build("[\"open"));
+        QVERIFY(invalid.parse("[\"open", true).isNull());
+        qsizetype offset = -1;
+        const QByteArray missing_value = "{\"a\": }";
+        QVERIFY(invalid.build(missing_value));
+        QVERIFY(invalid.parse(missing_value, true, &offset).isNull());
+        QCOMPARE(offset, missing_value.indexOf('}'));
+        const QByteArray trailing = "[1, 2,]";
+        QVERIFY(invalid.build(trailing));
+        QVERIFY(invalid.parse(trailing, false).isNull());
+        QCOMPARE(invalid.parse(trailing, true).array().size(), 2);
+    }
+
+    // **Test the event-driven streaming parser**
+    void testStreamingParser() {
+        const QByteArray source =
+            "{ // form\n"
+            "  \"title\": \"Caf\\u00e9 \\\"A\\\"\",\n"
+            "  \"fields\": [{\"id\": 1, \"on\": true,}, /* gap */ null, "
+            "-2.5e1],\n"
+            "}\n";
+        const QStringList expected = {
+            "{ @",
+            "key title @title",
+            QString::fromUtf8("value Caf\xC3\xA9 \"A\" @title"),
+            "key fields @fields",
+            "[ @fields",
+            "{ @fields.[0]",
+            "key id @fields.[0].id",
+            "value 1 @fields.[0].id",
+            "key on @fields.[0].on",
+            "value true @fields.[0].on",
+            "} @fields.[0]",
+            "value  @fields.[1]",
+            "value -25 @fields.[2]",
+            "] @fields",
+            "} @",
+        };
+
+        JSONStreamParser parser;
+        RecordingHandler in_memory;
+        QVERIFY(parser.parse(source, in_memory));
+        QCOMPARE(in_memory.events, expected);
+
+        // One byte per read puts every token across chunk boundaries
+        QBuffer buffer;
+        buffer.setData(source);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        RecordingHandler chunked;
+        QVERIFY(parser.setChunkSize(1).parse(buffer, chunked));
+        QCOMPARE(chunked.events, expected);
+
+        // Errors stop the parse at an offset
+        RecordingHandler ignored;
+        const QByteArray missing_value = "{\"a\": }";
+        QVERIFY(!parser.parse(missing_value, ignored));
+        QCOMPARE(parser.errorOffset(), qint64(missing_value.indexOf('}')));
+        QVERIFY(!parser.setAllowComments(false).parse(source, ignored));
+        QVERIFY(!parser.errorString().isEmpty());
+
+        // JSONParser turns them into exceptions
+        JSONParser json_parser;
+        QBuffer truncated;
+        truncated.setData("[1, 2");
+        QVERIFY(truncated.open(QIODevice::ReadOnly));
+        QVERIFY_EXCEPTION_THROWN(json_parser.parseStream(truncated, ignored),
+                                 JSONParsingException);
+    }
+
+    // **Test building widgets straight from the event stream**
+    void testJSONUILoaderStreaming() {
+        JSONUILoader loader;
+        QBuffer form;
+        form.setData(R"({
+            "type": "QWidget",
+            "layout": {"type": "VBoxLayout", "spacing": 4},
+            "children": [
+                {"type": "QLabel", "properties": {"text": "Name"}},
+                [1, 2],
+                {"type": "NoSuchWidget"},
+                {"type": "QPushButton", "properties": {"text": "OK"}},
+            ],
+            "properties": {"windowTitle": "Streamed"}, // after the children
+        })");
+        QVERIFY(form.open(QIODevice::ReadOnly));
+
+        QSignalSpy finished(&loader, &JSONUILoader::loadingFinished);
+        auto widget = loader.loadFromDevice(form, "form");
+        QVERIFY(widget != nullptr);
+        QCOMPARE(finished.count(), 1);
+        QCOMPARE(widget->windowTitle(), QString("Streamed"));
+
+        // Invalid children are skipped, the rest land in the layout
+        QVERIFY(widget->layout() != nullptr);
+        QCOMPARE(widget->layout()->count(), 2);
+        const auto labels = widget->findChildren<QLabel*>();
+        QCOMPARE(labels.size(), 1);
+        QCOMPARE(labels.first()->text(), QString("Name"));
+        QCOMPARE(widget->findChildren<QPushButton*>().size(), 1);
+
+        QBuffer truncated;
+        truncated.setData(R"({"type": "QWidget", "children": [)");
+        QVERIFY(truncated.open(QIODevice::ReadOnly));
+        QSignalSpy failed(&loader, &JSONUILoader::loadingFailed);
+        QVERIFY_EXCEPTION_THROWN((void)loader.loadFromDevice(truncated),
+                                 JSONParsingException);
+        QCOMPARE(failed.count(), 1);
+    }
+
+    // **Test streaming a file QJsonDocument wrote, keys in sorted order**
+    void testJSONUILoaderStreamingSortedKeys() {
+        // "children" sorts before "layout" and "type" at every level
+        const QJsonObject form = QJsonDocument::fromJson(R"({
+            "type": "QWidget",
+            "layout": {"type": "GridLayout"},
+            "children": [
+                {"type": "QLabel", "row": 0, "column": 0,
+                 "properties": {"text": "Name"}},
+                {"type": "QWidget", "row": 1, "column": 1,
+                 "layout": {"type": "HBoxLayout"},
+                 "children": [
+                     {"type": "QPushButton", "properties": {"text": "OK"}},
+                     {"type": "NoSuchWidget"}
+                 ]}
+            ]
+        })").object();
+        const QByteArray written = QJsonDocument(form).toJson();
+        QVERIFY(written.indexOf("\"children\"") <
+                written.indexOf("\"type\""));
+
+        JSONUILoader loader;
+        QBuffer device;
+        device.setData(written);
+        QVERIFY(device.open(QIODevice::ReadOnly));
+        auto widget = loader.loadFromDevice(device, "sorted");
+        QVERIFY(widget != nullptr);
+
+        auto* grid = qobject_cast<QGridLayout*>(widget->layout());
+        QVERIFY(grid != nullptr);
+        QCOMPARE(grid->count(), 2);
+        QVERIFY(grid->itemAtPosition(0, 0) != nullptr);
+        QVERIFY(grid->itemAtPosition(1, 1) != nullptr);
+        auto* label = qobject_cast<QLabel*>(
+            grid->itemAtPosition(0, 0)->widget());
+        QVERIFY(label != nullptr);
+        QCOMPARE(label->text(), QString("Name"));
+
+        QWidget* row = grid->itemAtPosition(1, 1)->widget();
+        QVERIFY(row != nullptr);
+        QVERIFY(row->layout() != nullptr);
+        QCOMPARE(row->layout()->count(), 1);
+        QCOMPARE(row->findChildren<QPushButton*>().size(), 1);
+
+        // A sorted document with an unknown root type still fails
+        QBuffer invalid;
+        invalid.setData(QJsonDocument(QJsonObject{
+                                          {"children", QJsonArray()},
+                                          {"type", "NoSuchWidget"}})
+                            .toJson());
+        QVERIFY(invalid.open(QIODevice::ReadOnly));
+        QVERIFY_EXCEPTION_THROWN((void)loader.loadFromDevice(invalid),
+                                 std::exception);
+    }
+
+    void testCompiledUIImage() {
+        const QJsonObject form = QJsonDocument::fromJson(R"({
+            "type": "QWidget",
+            "properties": {"windowTitle": "Compiled"},
+            "layout": {"type": "GridLayout", "spacing": 3,
+                       "margins": [1, 2, 3, 4]},
+            "children": [
+                {"type": "QLabel", "row": 1, "column": 2,
+                 "properties": {"text": "Name", "alignment": "AlignRight"}},
+                {"type": "QLineEdit", "row": 1, "column": 3,
+                 "properties": {"maxLength": 12}},
+                {"type": "QComboBox", "row": 2,
+                 "properties": {"items": ["a", "b", "c"], "currentIndex": 1}},
+                {"type": "NoSuchWidget"}
+            ]
+        })").object();
+
+        JSONUILoader loader;
+        const QByteArray bytes = loader.compileImage(form);
+        const CompiledUIImage image = CompiledUIImage::fromData(bytes);
+        QVERIFY2(image.isValid(), qPrintable(image.errorString()));
+        QCOMPARE(image.nodeCount(), 4u);  // Unknown types are dropped
+
+        // Values already have the property's type
+        const auto line_edit = image.node(2);
+        const auto max_length = image.property(line_edit.first_property);
+        QVERIFY(max_length.kind == CompiledUIImage::ValueKind::Int);
+        QCOMPARE(image.value(max_length), QVariant(12));
+
+        auto widget = loader.loadFromImage(image);
+        QVERIFY(widget != nullptr);
+        QCOMPARE(widget->windowTitle(), QString("Compiled"));
+        auto* grid = qobject_cast<QGridLayout*>(widget->layout());
+        QVERIFY(grid != nullptr);
+        QCOMPARE(grid->count(), 3);
+        QCOMPARE(grid->spacing(), 3);
+        QCOMPARE(grid->contentsMargins(), QMargins(1, 2, 3, 4));
+
+        auto* label = widget->findChild<QLabel*>();
+        QVERIFY(label != nullptr);
+        QCOMPARE(label->text(), QString("Name"));
+        QCOMPARE(label->alignment(), Qt::Alignment(Qt::AlignRight));
+        int row = 0, column = 0, row_span = 0, column_span = 0;
+        grid->getItemPosition(grid->indexOf(label), &row, &column, &row_span,
+                              &column_span);
+        QCOMPARE(row, 1);
+        QCOMPARE(column, 2);
+        QCOMPARE(widget->findChild<QLineEdit*>()->maxLength(), 12);
+        auto* combo = widget->findChild<QComboBox*>();
+        QVERIFY(combo != nullptr);
+        QCOMPARE(combo->count(), 3);  // "items" went to the factory
+        QCOMPARE(combo->currentIndex(), 1);
+
+        // The JSON builds the same widgets
+        auto from_json = loader.loadFromObject(form);
+        QCOMPARE(from_json->findChild<QLabel*>()->alignment(),
+                 label->alignment());
+        QCOMPARE(from_json->findChild<QComboBox*>()->currentIndex(), 1);
+        QCOMPARE(from_json->layout()->count(), grid->count());
+
+        // Enum names only the factory understands build the same widget
+        const QJsonObject slider_form{
+            {"type", "QSlider"},
+            {"properties", QJsonObject{{"orientation", "vertical"}}}};
+        const QByteArray slider_bytes = loader.compileImage(slider_form);
+        auto compiled_slider =
+            loader.loadFromImage(CompiledUIImage::fromData(slider_bytes));
+        auto json_slider = loader.loadFromObject(slider_form);
+        QVERIFY(qobject_cast<QSlider*>(compiled_slider.get()) != nullptr);
+        QVERIFY(qobject_cast<QSlider*>(json_slider.get()) != nullptr);
+        QCOMPARE(qobject_cast<QSlider*>(json_slider.get())->orientation(),
+                 Qt::Vertical);
+        QCOMPARE(qobject_cast<QSlider*>(compiled_slider.get())->orientation(),
+                 Qt::Vertical);
+
+        // From a mapped file, with lifecycle signals
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath("form.uibin");
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(bytes);
+        file.close();
+        QSignalSpy finished(&loader, &JSONUILoader::loadingFinished);
+        auto mapped = loader.loadFromCompiledFile(path);
+        QVERIFY(mapped != nullptr);
+        QCOMPARE(finished.count(), 1);
+        QCOMPARE(mapped->findChildren<QWidget*>().size(),
+                 widget->findChildren<QWidget*>().size());
+
+        // Damaged images and invalid trees are refused
+        QVERIFY(!CompiledUIImage::fromData(bytes.left(bytes.size() - 8))
+                     .isValid());
+        QByteArray extra_child = bytes;
+        CompiledUIImage::Header header;
+        std::memcpy(&header, extra_child.constData(), sizeof(header));
+        char* root_record = extra_child.data() + header.nodes_offset;
+        CompiledUIImage::Node root_node;
+        std::memcpy(&root_node, root_record, sizeof(root_node));
+        ++root_node.child_count;  // More children than the subtree holds
+        std::memcpy(root_record, &root_node, sizeof(root_node));
+        QVERIFY(!CompiledUIImage::fromData(extra_child).isValid());
+        QByteArray wrong_magic = bytes;
+        wrong_magic[0] = 'X';
+        QVERIFY_EXCEPTION_THROWN(
+            (void)loader.loadFromImage(CompiledUIImage::fromData(wrong_magic)),
+            JSONParsingException);
+        QVERIFY_EXCEPTION_THROWN(
+            (void)loader.compileImage(QJsonObject{{"type", "NoSuchWidget"}}),
+            JSONValidationException);
+    }
+
+    // **Test compiling UI files to images on the pool**
+    void testParallelImageCompilation() {
+        using DeclarativeUI::Core::ParallelUICompiler;
+        ParallelUICompiler ui_compiler;
+
+        const QString form_path = temp_dir_->filePath("form.json");
+        QFile form(form_path);
+        QVERIFY(form.open(QIODevice::WriteOnly));
+        form.write(R"({
+            // UI files may be JSONC
+            "type": "QWidget",
+            "layout": {"type": "VBoxLayout"},
+            "children": [{"type": "QLabel", "properties": {"text": "Name"}}],
+        })");
+        form.close();
+        const QString broken_path = temp_dir_->filePath("broken.json");
+        QFile broken(broken_path);
+        QVERIFY(broken.open(QIODevice::WriteOnly));
+        broken.write(R"({"type": "NoSuchWidget"})");
+        broken.close();
+
+        // One image, written where asked
+        const QString image_path = temp_dir_->filePath("single.uibin");
+        auto single = ui_compiler.compileImageAsync(form_path, image_path);
+        single.waitForFinished();
+        QVERIFY(single.result());
+        const CompiledUIImage image = CompiledUIImage::open(image_path);
+        QVERIFY2(image.isValid(), qPrintable(image.errorString()));
+        QCOMPARE(image.nodeCount(), 2u);
+
+        // A batch into another directory leaves failed files out
+        const QString out_dir = temp_dir_->filePath("images");
+        auto batch = ui_compiler.compileImageBatchAsync(
+            {form_path, broken_path}, out_dir);
+        batch.waitForFinished();
+        const QStringList images = batch.result();
+        QCOMPARE(images.size(), 1);
+        QCOMPARE(images[0], QDir(out_dir).filePath("form.uibin"));
+        QCOMPARE(images[0],
+                 ParallelUICompiler::imagePathFor(form_path, out_dir));
+        QVERIFY(CompiledUIImage::open(images[0]).isValid());
+        QVERIFY(!QFile::exists(
+            ParallelUICompiler::imagePathFor(broken_path, out_dir)));
+
+        // Values go through the converters of the loader that was set
+        auto loader = std::make_shared<JSONUILoader>();
+        loader->registerPropertyConverter("text", [](const QJsonValue& value) {
+            return QVariant(value.toString().toUpper());
+        });
+        ui_compiler.setUILoader(loader);
+        const QString converted_path = temp_dir_->filePath("converted.uibin");
+        auto converted =
+            ui_compiler.compileImageAsync(form_path, converted_path);
+        converted.waitForFinished();
+        QVERIFY(converted.result());
+        auto widget = loader->loadFromCompiledFile(converted_path);
+        QVERIFY(widget != nullptr);
+        QCOMPARE(widget->findChild<QLabel*>()->text(), QString("NAME"));
+    }
+
     // **Test JSONParser Error Handling**
     void testJSONParserErrorHandling() {
         JSONParser parser;
@@ -10,10 +10,17 @@
 #include <QThread>
 #include <QTimer>
 #include <QSignalSpy>
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <thread>
 #include <vector>
 #include <memory>
 
+#include "../Core/MemoryManager.hpp"
+
+using namespace DeclarativeUI::Core;
+
 class PerformanceComprehensiveTest : public QObject {
     Q_OBJECT
 
@@ -31,6 +38,8 @@ private slots:
 
     // Memory Performance
     void testMemoryAllocationPerformance();
+    void testObjectPoolContentionPerformance();
+    void testAllocationSamplingOverhead();
 
     // Threading Performance
     void testThreadCreationPerformance();
@@ -241,6 +250,135 @@ void PerformanceComprehensiveTest::testMemoryAllocationPerformance() {
     QVERIFY(deallocation_time < 500); // Should deallocate within 0.5 seconds
 }
 
+namespace {
+struct PooledPayload {
+    std::array<int, 16> data{};
+};
+
+template <typename Pool>
+qint64 runPoolContention(Pool& pool, int num_threads, int iterations) {
+    std::vector<std::thread> threads;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&pool, iterations]() {
+            std::array<std::unique_ptr<PooledPayload>, 4> held;
+            for (int i = 0; i < iterations; ++i) {
+                for (auto& object : held) {
+                    object = pool.acquire();
+                    object->data[0] = i;
+                }
+                for (auto& object : held) {
+                    pool.release(std::move(object));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return timer.nsecsElapsed();
+}
+}  // namespace
+
+void PerformanceComprehensiveTest::testObjectPoolContentionPerformance() {
+    const int num_threads = static_cast<int>(
+        std::clamp(std::thread::hardware_concurrency(), 2u, 8u));
+    const int iterations = 50000;
+    const double operations =
+        2.0 * 4 * iterations * num_threads;  // acquire + release
+
+    ObjectPool<PooledPayload> locked_pool;
+    ConcurrentObjectPool<PooledPayload> concurrent_pool;
+
+    const qint64 locked_ns =
+        runPoolContention(locked_pool, num_threads, iterations);
+    const qint64 concurrent_ns =
+        runPoolContention(concurrent_pool, num_threads, iterations);
+
+    // The manager's hot path: PooledPtr handles from create_pooled
+    auto& memory_manager = MemoryManager::instance();
+    std::vector<std::thread> threads;
+    QElapsedTimer timer;
+    timer.start();
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&memory_manager, iterations]() {
+            for (int i = 0; i < iterations; ++i) {
+                auto a = memory_manager.create_pooled<PooledPayload>();
+                auto b = memory_manager.create_pooled<PooledPayload>();
+                auto c = memory_manager.create_pooled<PooledPayload>();
+                auto d = memory_manager.create_pooled<PooledPayload>();
+                a->data[0] = b->data[0] = c->data[0] = d->data[0] = i;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const qint64 create_pooled_ns = timer.nsecsElapsed();
+
+    qDebug() << "Object Pool Contention Performance (" << num_threads
+             << "threads ):";
+    qDebug() << "  mutex ObjectPool:" << locked_ns / operations << "ns/op";
+    qDebug() << "  ConcurrentObjectPool:" << concurrent_ns / operations
+             << "ns/op";
+    qDebug() << "  create_pooled:" << create_pooled_ns / operations
+             << "ns/op";
+    qDebug() << "  speedup over mutex pool:"
+             << static_cast<double>(locked_ns) / concurrent_ns << "x";
+
+    concurrent_pool.flush_thread_cache();
+    QVERIFY(concurrent_pool.constructed_count() <=
+            1000 + static_cast<size_t>(num_threads) * 2 * 32);
+    QVERIFY(concurrent_ns < 5000LL * 1000 * 1000);
+    QVERIFY(create_pooled_ns < 5000LL * 1000 * 1000);
+}
+
+namespace {
+qint64 runTrackedChurn(int iterations, bool track) {
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        const size_t size = 32 + (i % 32) * 16;
+        auto buffer = std::make_unique<char[]>(size);
+        buffer[0] = static_cast<char>(i);
+        if (track) {
+            TRACK_ALLOCATION(buffer.get(), size);
+            TRACK_DEALLOCATION(buffer.get());
+        }
+    }
+    return timer.nsecsElapsed();
+}
+}  // namespace
+
+void PerformanceComprehensiveTest::testAllocationSamplingOverhead() {
+    const int iterations = 2000000;
+    auto& memory_manager = MemoryManager::instance();
+    memory_manager.enable_allocation_sampling(true);
+
+    runTrackedChurn(iterations / 10, true);  // Warm up
+    const qint64 baseline_ns = runTrackedChurn(iterations, false);
+    const qint64 sampled_ns = runTrackedChurn(iterations, true);
+
+    const auto samples = MemoryLeakDetector::instance().get_allocation_count();
+    memory_manager.enable_allocation_sampling(false);
+    memory_manager.enable_leak_detection(false);
+
+    qDebug() << "Allocation Sampling Overhead:";
+    qDebug() << "  new/delete:" << static_cast<double>(baseline_ns) / iterations
+             << "ns/op";
+    qDebug() << "  new/delete + sampled tracking:"
+             << static_cast<double>(sampled_ns) / iterations << "ns/op";
+    qDebug() << "  samples recorded:" << samples;
+
+    // A bare allocation loop is the worst case; per call the fast path must
+    // stay within a few nanoseconds of the allocator itself
+    QVERIFY(samples > 0);
+    QVERIFY(sampled_ns < baseline_ns * 3 + 100LL * 1000 * 1000);
+}
+
 void PerformanceComprehensiveTest::testThreadCreationPerformance() {
     const int num_threads = 100;
     std::vector<std::unique_ptr<QThread>> threads;